@@ -79,37 +79,44 @@ BError Anisotropy_Uniaxial::MakeCUDAModule(void)
 	return error;
 }
 
-double Anisotropy_Uniaxial::UpdateField(void)
+//FM mesh : add field contribution at non-empty cell idx to Heff, returning the energy density term to be summed (before final scaling)
+double Anisotropy_Uniaxial::UpdateField_FM_Cell(int idx)
 {
-	double energy = 0;
+	double Ms = pMesh->Ms;
+	double K1 = pMesh->K1;
+	double K2 = pMesh->K2;
+	DBL3 mcanis_ea1 = pMesh->mcanis_ea1;
+	pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms, pMesh->K1, K1, pMesh->K2, K2, pMesh->mcanis_ea1, mcanis_ea1);
 
-	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
+	//calculate m.ea dot product
+	double dotprod = (pMesh->M[idx] * mcanis_ea1) / Ms;
 
-#pragma omp parallel for reduction(+:energy)
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+	//update effective field with the anisotropy field
+	DBL3 Heff_value = (2 / (MU0*Ms)) * dotprod * (K1 + 2 * K2 * (1 - dotprod * dotprod)) * mcanis_ea1;
 
-			if (pMesh->M.is_not_empty(idx)) {
+	pMesh->Heff[idx] += Heff_value;
 
-				double Ms = pMesh->Ms;
-				double K1 = pMesh->K1;
-				double K2 = pMesh->K2;
-				DBL3 mcanis_ea1 = pMesh->mcanis_ea1;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->K1, K1, pMesh->K2, K2, pMesh->mcanis_ea1, mcanis_ea1);
+	//update energy (E/V) = K1 * sin^2(theta) + K2 * sin^4(theta) = K1 * [ 1 - dotprod*dotprod ] + K2 * [1 - dotprod * dotprod]^2
+	double energy_ = (K1 + K2 * (1 - dotprod * dotprod)) * (1 - dotprod * dotprod);
 
-				//calculate m.ea dot product
-				double dotprod = (pMesh->M[idx] * mcanis_ea1) / Ms;
+	if (Module_Heff.linear_size()) Module_Heff[idx] = Heff_value;
+	if (Module_energy.linear_size()) Module_energy[idx] = (K1 + K2 * (1 - dotprod * dotprod)) * (1 - dotprod * dotprod);
 
-				//update effective field with the anisotropy field
-				DBL3 Heff_value = (2 / (MU0*Ms)) * dotprod * (K1 + 2 * K2 * (1 - dotprod * dotprod)) * mcanis_ea1;
+	return energy_;
+}
 
-				pMesh->Heff[idx] += Heff_value;
+double Anisotropy_Uniaxial::UpdateField(void)
+{
+	double energy = 0;
 
-				//update energy (E/V) = K1 * sin^2(theta) + K2 * sin^4(theta) = K1 * [ 1 - dotprod*dotprod ] + K2 * [1 - dotprod * dotprod]^2
-				energy += (K1 + K2 * (1 - dotprod * dotprod)) * (1 - dotprod * dotprod);
+	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
 
-				if (Module_Heff.linear_size()) Module_Heff[idx] = Heff_value;
-				if (Module_energy.linear_size()) Module_energy[idx] = (K1 + K2 * (1 - dotprod * dotprod)) * (1 - dotprod * dotprod);
-			}
+		pMesh->cache_parameters_mcoarse(pMesh->Ms, pMesh->K1, pMesh->K2, pMesh->mcanis_ea1);
+
+#pragma omp parallel for reduction(+:energy)
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) energy += UpdateField_FM_Cell(idx);
 		}
 	}
 
@@ -156,6 +163,34 @@ double Anisotropy_Uniaxial::UpdateField(void)
 	return this->energy;
 }
 
+//-------------------Fused local field evaluation
+
+bool Anisotropy_Uniaxial::FusedField_Available(void)
+{
+	return pMesh->GetMeshType() == MESH_FERROMAGNETIC;
+}
+
+void Anisotropy_Uniaxial::FusedField_Prepare(void)
+{
+	pMesh->cache_parameters_mcoarse(pMesh->Ms, pMesh->K1, pMesh->K2, pMesh->mcanis_ea1);
+}
+
+double Anisotropy_Uniaxial::FusedField_Cell(int idx)
+{
+	if (pMesh->M.is_not_empty(idx)) return UpdateField_FM_Cell(idx);
+	else return 0.0;
+}
+
+double Anisotropy_Uniaxial::FusedField_Finish(double energy)
+{
+	if (pMesh->M.get_nonempty_cells()) energy /= pMesh->M.get_nonempty_cells();
+	else energy = 0;
+
+	this->energy = energy;
+
+	return this->energy;
+}
+
 //-------------------Energy methods
 
 //FM Mesh
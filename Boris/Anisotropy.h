@@ -18,6 +18,9 @@ private:
 	//pointer to mesh object holding this effective field module
 	Mesh * pMesh;
 
+	//FM mesh : add field contribution at non-empty cell idx to Heff, returning the energy density term to be summed (before final scaling)
+	double UpdateField_FM_Cell(int idx);
+
 public:
 	
 	Anisotropy_Uniaxial(Mesh *pMesh_);
@@ -40,6 +43,13 @@ public:
 
 	double UpdateField(void);
 
+	//-------------------Fused local field evaluation (see Modules)
+
+	bool FusedField_Available(void);
+	void FusedField_Prepare(void);
+	double FusedField_Cell(int idx);
+	double FusedField_Finish(double energy);
+
 	//-------------------Energy methods
 
 	//FM Mesh
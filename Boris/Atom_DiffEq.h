@@ -43,6 +43,8 @@ protected:
 	OmpReduction<double> dmdt_reduction;
 	OmpReduction<DBL3> dmdt_av_reduction;
 	OmpReduction<double> lte_reduction;
+	//L-BFGS minimizer : maximum search direction length
+	OmpReduction<double> lbfgs_reduction;
 
 	//Used to save starting atomic moments - all evaluation methods do this, even when not needed by the method itself
 	VEC<DBL3> sM1;
@@ -50,11 +52,18 @@ protected:
 	//evaluation scratch spaces
 	VEC<DBL3> sEval0, sEval1, sEval2, sEval3, sEval4, sEval5, sEval6;
 
+	//L-BFGS minimizer : correction pairs in ring buffer slots 0 to LBFGS_MEMORY - 1 held in sEval0 to sEval2 (s vectors) and sEval3 to sEval5 (y vectors), search direction in sEval6
+	VEC<DBL3>& LBFGS_s(int slot) { return (slot == 0 ? sEval0 : (slot == 1 ? sEval1 : sEval2)); }
+	VEC<DBL3>& LBFGS_y(int slot) { return (slot == 0 ? sEval3 : (slot == 1 ? sEval4 : sEval5)); }
+
 	//Thermal field, enabled only for the stochastic equations
 	VEC<DBL3> H_Thermal;
 
-	//random number generator
-	BorisRand prng;
+	//counter-based random number generator for thermal fields : numbers in each cell depend only on seed, cell index and thermal_step, not on the number of threads
+	BorisCBRand prng;
+
+	//incremented every time thermal fields are generated
+	unsigned long long thermal_step = 0;
 
 	Atom_Mesh *paMesh = nullptr;
 
@@ -177,6 +186,17 @@ protected:
 	virtual void RunRKDP54_Step5(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK45
+	virtual void RunLSRK45_Step0_withReductions(void) = 0;
+	virtual void RunLSRK45_Step0(void) = 0;
+	virtual void RunLSRK45_Step1(void) = 0;
+	virtual void RunLSRK45_Step2(void) = 0;
+	virtual void RunLSRK45_Step3(void) = 0;
+	virtual void RunLSRK45_Step4_withReductions(void) = 0;
+	virtual void RunLSRK45_Step4(void) = 0;
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	virtual void RunSD_Start(void) = 0;
@@ -189,6 +209,23 @@ protected:
 	virtual void RunSD_Advance(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+	//0. prime the L-BFGS solver : steepest descent step with stepsize dT, which also starts the first correction pair in given slot
+	virtual void RunLBFGS_Start(int slot) = 0;
+	//1. gradient at the current magnetization : complete the newest correction pair and set search direction to the gradient
+	//must reset lbfgs_dot, lbfgs_dot2 (reduces s.y and y.y for the newest pair) and lbfgs_dirmax before running these across all meshes, also for passes 2 to 4
+	virtual void RunLBFGS_Gradient(void) = 0;
+	//2. transport correction pair in given slot to the current tangent planes, reducing s.q and s.y
+	virtual void RunLBFGS_Project(int slot) = 0;
+	//3. reduce y.q for correction pair in given slot
+	virtual void RunLBFGS_Dot_Y(int slot) = 0;
+	//4. search direction update q += coeff * (s or y in given slot), reducing maximum length of q
+	virtual void RunLBFGS_Update(int slot, double coeff, bool use_s) = 0;
+	//5. set new magnetization vectors along -dT * q, starting the next correction pair in given slot
+	virtual void RunLBFGS_Advance_withReductions(int slot) = 0;
+	virtual void RunLBFGS_Advance(int slot) = 0;
+#endif
+
 	//---------------------------------------- OTHERS
 
 	//Restore atomic moments after a failed step for adaptive time-step methods
@@ -122,6 +122,7 @@ BError Atom_DifferentialEquationCubic::AllocateMemory(void)
 		break;
 
 	case EVAL_RKF56:
+	case EVAL_LBFGS:
 		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval2.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
@@ -131,6 +132,11 @@ BError Atom_DifferentialEquationCubic::AllocateMemory(void)
 		if (!sEval6.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_LSRK45:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
@@ -171,6 +177,8 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
 		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS &&
+		evalMethod != EVAL_LSRK45 &&
 		evalMethod != EVAL_SD) {
 
 		sEval0.clear();
@@ -182,7 +190,9 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKF56 &&
-		evalMethod != EVAL_RKDP54) {
+		evalMethod != EVAL_LBFGS &&
+		evalMethod != EVAL_RKDP54 &&
+		evalMethod != EVAL_LSRK45) {
 
 		sEval1.clear();
 	}
@@ -192,7 +202,8 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval2.clear();
 	}
@@ -201,19 +212,22 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval3.clear();
 		sEval4.clear();
 	}
 
 	if (evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval5.clear();
 	}
 
-	if (evalMethod != EVAL_RKF56) {
+	if (evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval6.clear();
 	}
@@ -238,6 +252,13 @@ BError Atom_DifferentialEquationCubic::UpdateConfiguration(UPDATECONFIG_ cfgMess
 {
 	BError error(CLASS_STR(Atom_DifferentialEquationCubic));
 
+	//seed thermal field generator : if prng_seed is set the same sequence is obtained on every run
+	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_PRNG)) {
+
+		prng.set_seed(paMesh->prng_seed == 0 ? GetSystemTickCount() : paMesh->prng_seed);
+		thermal_step = 0;
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE, UPDATECONFIG_ODE_SOLVER)) {
 
 		error = AllocateMemory();
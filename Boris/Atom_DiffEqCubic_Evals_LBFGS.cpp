@@ -0,0 +1,234 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+//L-BFGS minimizer : see DiffEqFM_Evals_LBFGS.cpp
+
+//--------------------------------------------- L-BFGS Minimizer
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Start(int slot)
+{
+	//search direction is the gradient for the first step
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			double grel = paMesh->grel;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->grel, grel);
+
+			DBL3 m = paMesh->M1[idx] / mu_s;
+
+			//multiplication by grel important : can set grel to zero in entire mesh, or parts of mesh, which results in spins freezing.
+			sEval6[idx] = (GAMMA * grel / 2) * (m ^ (m ^ paMesh->Heff1[idx]));
+		}
+	}
+
+	RunLBFGS_Advance(slot);
+}
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Gradient(void)
+{
+	VEC<DBL3>& s = LBFGS_s(lbfgs_newest);
+	VEC<DBL3>& y = LBFGS_y(lbfgs_newest);
+
+	double _sy = 0.0, _yy = 0.0;
+	lbfgs_reduction.new_minmax_reduction();
+
+#pragma omp parallel for reduction(+:_sy, _yy)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			double grel = paMesh->grel;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->grel, grel);
+
+			DBL3 m = paMesh->M1[idx] / mu_s;
+			DBL3 G = (GAMMA * grel / 2) * (m ^ (m ^ paMesh->Heff1[idx]));
+
+			//complete newest correction pair at the current tangent plane : y holds -G from the previous step
+			s[idx] -= (s[idx] * m) * m;
+			y[idx] = y[idx] - (y[idx] * m) * m + G;
+
+			_sy += s[idx] * y[idx];
+			_yy += y[idx] * y[idx];
+
+			//search direction starts from the gradient
+			sEval6[idx] = G;
+			lbfgs_reduction.reduce_max(G.norm());
+		}
+	}
+
+	lbfgs_reduction.maximum();
+
+	lbfgs_dot += _sy;
+	lbfgs_dot2 += _yy;
+	if (lbfgs_reduction.max > lbfgs_dirmax) lbfgs_dirmax = lbfgs_reduction.max;
+}
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Project(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+	double _sq = 0.0, _sy = 0.0;
+
+#pragma omp parallel for reduction(+:_sq, _sy)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			DBL3 m = paMesh->M1[idx].normalized();
+
+			s[idx] -= (s[idx] * m) * m;
+			y[idx] -= (y[idx] * m) * m;
+
+			_sq += s[idx] * sEval6[idx];
+			_sy += s[idx] * y[idx];
+		}
+	}
+
+	lbfgs_dot += _sq;
+	lbfgs_dot2 += _sy;
+}
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Dot_Y(int slot)
+{
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+	double _yq = 0.0;
+
+#pragma omp parallel for reduction(+:_yq)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			_yq += y[idx] * sEval6[idx];
+		}
+	}
+
+	lbfgs_dot += _yq;
+}
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Update(int slot, double coeff, bool use_s)
+{
+	VEC<DBL3>& v = (use_s ? LBFGS_s(slot) : LBFGS_y(slot));
+
+	lbfgs_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			sEval6[idx] += coeff * v[idx];
+			lbfgs_reduction.reduce_max(sEval6[idx].norm());
+		}
+	}
+
+	lbfgs_reduction.maximum();
+
+	if (lbfgs_reduction.max > lbfgs_dirmax) lbfgs_dirmax = lbfgs_reduction.max;
+}
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Advance_withReductions(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			double grel = paMesh->grel;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->grel, grel);
+
+			DBL3 m = paMesh->M1[idx] / mu_s;
+			DBL3 H = paMesh->Heff1[idx];
+
+			//obtained maximum normalized torque term
+			if (IsNZ(grel)) {
+
+				double _mxh = GetMagnitude(m ^ H) / (conversion * paMesh->M1[idx].norm());
+				mxh_reduction.reduce_max(_mxh);
+			}
+
+			//start next correction pair : step and -G, completed in RunLBFGS_Gradient
+			DBL3 v = -dT * sEval6[idx];
+			s[idx] = v;
+			y[idx] = -(GAMMA * grel / 2) * (m ^ (m ^ H));
+
+			sM1[idx] = paMesh->M1[idx];
+
+			//Cayley transform along tangent vector v : same as the SD update with v = -dT * G
+			double a = (v * v) / 4;
+			m = ((1 - a) * m + v) / (1 + a);
+
+			paMesh->M1[idx] = m * mu_s;
+			paMesh->M1[idx].renormalize(mu_s);
+
+			if (calculate_dmdt && IsNZ(grel)) {
+
+				//obtained maximum dmdt term
+				double Mnorm = paMesh->M1[idx].norm();
+				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * grel * Mnorm * conversion * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+			}
+		}
+	}
+
+	mxh_reduction.maximum();
+	if (calculate_dmdt) dmdt_reduction.maximum();
+}
+
+void Atom_DifferentialEquationCubic::RunLBFGS_Advance(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			double grel = paMesh->grel;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s, paMesh->grel, grel);
+
+			DBL3 m = paMesh->M1[idx] / mu_s;
+
+			//start next correction pair : step and -G, completed in RunLBFGS_Gradient
+			DBL3 v = -dT * sEval6[idx];
+			s[idx] = v;
+			y[idx] = -(GAMMA * grel / 2) * (m ^ (m ^ paMesh->Heff1[idx]));
+
+			sM1[idx] = paMesh->M1[idx];
+
+			//Cayley transform along tangent vector v : same as the SD update with v = -dT * G
+			double a = (v * v) / 4;
+			m = ((1 - a) * m + v) / (1 + a);
+
+			paMesh->M1[idx] = m * mu_s;
+			paMesh->M1[idx].renormalize(mu_s);
+		}
+	}
+}
+
+#endif
+#endif
@@ -0,0 +1,238 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_LSRK
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+//--------------------------------------------- LOW-STORAGE RUNGE KUTTA CARPENTER-KENNEDY (4th order solution, 3rd order embedded error)
+
+//sEval0 is the stage register (dM), sEval1 accumulates the error estimate.
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			//Save current moment for later use
+			sM1[idx] = paMesh->M1[idx];
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//obtain maximum normalized torque term
+				double Mnorm = paMesh->M1[idx].norm();
+				double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+				mxh_reduction.reduce_max(_mxh);
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//start stage and error registers
+				sEval0[idx] = rhs;
+				sEval1[idx] = rhs * LSRK45_E0;
+
+				//Now estimate moment using LSRK first step
+				paMesh->M1[idx] += sEval0[idx] * (LSRK45_B0 * dT);
+			}
+		}
+	}
+
+	if (paMesh->grel.get0()) {
+
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step0(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			//Save current moment for later use
+			sM1[idx] = paMesh->M1[idx];
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//start stage and error registers
+				sEval0[idx] = rhs;
+				sEval1[idx] = rhs * LSRK45_E0;
+
+				//Now estimate moment using LSRK first step
+				paMesh->M1[idx] += sEval0[idx] * (LSRK45_B0 * dT);
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step1(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A1 + rhs;
+			sEval1[idx] += rhs * LSRK45_E1;
+
+			//Now estimate moment using LSRK midle step 1
+			paMesh->M1[idx] += sEval0[idx] * (LSRK45_B1 * dT);
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step2(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A2 + rhs;
+			sEval1[idx] += rhs * LSRK45_E2;
+
+			//Now estimate moment using LSRK midle step 2
+			paMesh->M1[idx] += sEval0[idx] * (LSRK45_B2 * dT);
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step3(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A3 + rhs;
+			sEval1[idx] += rhs * LSRK45_E3;
+
+			//Now estimate moment using LSRK midle step 3
+			paMesh->M1[idx] += sEval0[idx] * (LSRK45_B3 * dT);
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step4_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//LSRK45 : 4th order evaluation
+				sEval0[idx] = sEval0[idx] * LSRK45_A4 + rhs;
+				paMesh->M1[idx] += sEval0[idx] * (LSRK45_B4 * dT);
+
+				//difference from 3rd order embedded evaluation for adaptive time step
+				DBL3 error = (sEval1[idx] + rhs * LSRK45_E4) * dT;
+
+				if (renormalize) {
+
+					double mu_s = paMesh->mu_s;
+					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+					paMesh->M1[idx].renormalize(mu_s);
+				}
+
+				//obtained maximum dmdt term
+				double Mnorm = paMesh->M1[idx].norm();
+				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(error) / paMesh->M1[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+
+	if (paMesh->grel.get0()) {
+
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunLSRK45_Step4(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//LSRK45 : 4th order evaluation
+				sEval0[idx] = sEval0[idx] * LSRK45_A4 + rhs;
+				paMesh->M1[idx] += sEval0[idx] * (LSRK45_B4 * dT);
+
+				//difference from 3rd order embedded evaluation for adaptive time step
+				DBL3 error = (sEval1[idx] + rhs * LSRK45_E4) * dT;
+
+				if (renormalize) {
+
+					double mu_s = paMesh->mu_s;
+					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+					paMesh->M1[idx].renormalize(mu_s);
+				}
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(error) / paMesh->M1[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+}
+
+#endif
+#endif
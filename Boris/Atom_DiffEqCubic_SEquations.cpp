@@ -43,9 +43,14 @@ void Atom_DifferentialEquationCubic::GenerateThermalField(void)
 				//do not include any damping here - this will be included in the stochastic equations
 				double Hth_const = s_eff * sqrt(2 * BOLTZMANN * Temperature / (MUB_MU0 * GAMMA * grel * mu_s * deltaT));
 
-				H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
+				//random numbers in this cell depend only on the seed, cell index and step
+				BorisCBRand::Stream rnd = prng.stream(idx, thermal_step);
+
+				H_Thermal[idx] = Hth_const * rnd.rand_gauss3<DBL3>(0, 1);
 			}
 		}
+
+		thermal_step++;
 	}
 }
 
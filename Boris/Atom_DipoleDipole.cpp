@@ -76,45 +76,14 @@ BError Atom_DipoleDipole::Initialize_Mesh_Transfer(void)
 		Hd.clear();
 	}
 
-	if (paMesh->pSMesh->GetEvaluationSpeedup()) {
+	//make sure to allocate memory for Hdemag if we need it
+	evalspeedup.Configure(paMesh->pSMesh->GetEvaluationSpeedup(), paMesh->pSMesh->GetEvaluationSpeedupTolerance());
+	if (!evalspeedup.Resize_Fields(Hdemag, paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT);
 
-		//make sure to allocate memory for Hdemag if we need it
-		if (paMesh->pSMesh->GetEvaluationSpeedup() >= 6) { if (!Hdemag6.resize(paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-		else Hdemag6.clear();
+	for (int slot = 0; slot < Hdemag.size(); slot++) {
 
-		if (paMesh->pSMesh->GetEvaluationSpeedup() >= 5) { if (!Hdemag5.resize(paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-		else Hdemag5.clear();
-
-		if (paMesh->pSMesh->GetEvaluationSpeedup() >= 4) { if (!Hdemag4.resize(paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-		else Hdemag4.clear();
-
-		if (paMesh->pSMesh->GetEvaluationSpeedup() >= 3) { if (!Hdemag3.resize(paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-		else Hdemag3.clear();
-
-		if (paMesh->pSMesh->GetEvaluationSpeedup() >= 2) { if (!Hdemag2.resize(paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-		else Hdemag2.clear();
-
-		if (paMesh->pSMesh->GetEvaluationSpeedup() >= 1) { if (!Hdemag.resize(paMesh->h_dm, paMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-		else Hdemag.clear();
-
-		if (Hdemag.linear_size()) if (!Hdemag.Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
-		if (Hdemag2.linear_size()) if (!Hdemag2.Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
-		if (Hdemag3.linear_size()) if (!Hdemag3.Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
-		if (Hdemag4.linear_size()) if (!Hdemag4.Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
-		if (Hdemag5.linear_size()) if (!Hdemag5.Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
-		if (Hdemag6.linear_size()) if (!Hdemag6.Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!Hdemag[slot].Initialize_MeshTransfer({}, { &paMesh->Heff1 }, MESHTRANSFERTYPE_ENLARGED)) return error(BERROR_OUTOFMEMORY_CRIT);
 	}
-	else {
-
-		Hdemag.clear();
-		Hdemag2.clear();
-		Hdemag3.clear();
-		Hdemag4.clear();
-		Hdemag5.clear();
-		Hdemag6.clear();
-	}
-
-	num_Hdemag_saved = 0;
 	   
 	return error;
 }
@@ -183,25 +152,20 @@ BError Atom_DipoleDipole::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	}
 
 	//only need to uninitialize if n or h have changed, or pbc settings have changed
-	if (!CheckDimensions(paMesh->n_dm, paMesh->h_dm, demag_pbc_images) || cfgMessage == UPDATECONFIG_MESHCHANGE || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE) {
+	if (!CheckDimensions(paMesh->n_dm, paMesh->h_dm, demag_pbc_images, paMesh->pSMesh->Get_Demag_Single_Precision()) || cfgMessage == UPDATECONFIG_MESHCHANGE || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE) {
 
 		Uninitialize();
 
 		//Set convolution dimensions for embedded multiplication and required PBC conditions
-		error = SetDimensions(paMesh->n_dm, paMesh->h_dm, true, demag_pbc_images);
+		error = SetDimensions(paMesh->n_dm, paMesh->h_dm, true, demag_pbc_images, paMesh->pSMesh->Get_Demag_Single_Precision());
 
 		Hd.clear();
 		M.clear();
 
 		Hdemag.clear();
-		Hdemag2.clear();
-		Hdemag3.clear();
-		Hdemag4.clear();
-		Hdemag5.clear();
-		Hdemag6.clear();
 	}
 
-	num_Hdemag_saved = 0;
+	evalspeedup.Reset();
 
 	//------------------------ CUDA UpdateConfiguration if set
 
@@ -254,11 +218,15 @@ double Atom_DipoleDipole::UpdateField(void)
 	//transfer magnetic moments to macrocell mesh
 	if (using_macrocell) M.transfer_in();
 
+	//what to do at this evaluation : compute field every time if not using evaluation speedup, else as decided by the evaluation speedup history
+	EVALSPEEDUPSTEP_ speedup_step = EVALSPEEDUPSTEP_COMPUTE;
+	if (paMesh->pSMesh->GetEvaluationSpeedup()) speedup_step = evalspeedup.Check_Evaluation(paMesh->pSMesh->Check_Step_Update(), paMesh->pSMesh->Get_EvalStep_Time());
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////// NO SPEEDUP //////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (!paMesh->pSMesh->GetEvaluationSpeedup() || (num_Hdemag_saved < paMesh->pSMesh->GetEvaluationSpeedup() && !paMesh->pSMesh->Check_Step_Update())) {
+	if (speedup_step == EVALSPEEDUPSTEP_COMPUTE) {
 
 		//don't use evaluation speedup
 
@@ -291,417 +259,83 @@ double Atom_DipoleDipole::UpdateField(void)
 	//////////////////////////////////////// EVAL SPEEDUP /////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	else {
+	else if (speedup_step == EVALSPEEDUPSTEP_COMPUTE_AND_SAVE) {
 
 		//use evaluation speedup method (Hdemag will have memory allocated - this was done in the Initialize method)
+		//update required by ODE solver or don't have enough previous evaluations saved to extrapolate : compute field and save it in the slot set by evalspeedup
+		VEC<DBL3>& Hsave = Hdemag[evalspeedup.get_save_slot()];
 
-		//update if required by ODE solver or if we don't have enough previous evaluations saved to extrapolate
-		if (paMesh->pSMesh->Check_Step_Update() || num_Hdemag_saved < paMesh->pSMesh->GetEvaluationSpeedup()) {
-
-			VEC<DBL3>* pHdemag;
-
-			if (num_Hdemag_saved < paMesh->pSMesh->GetEvaluationSpeedup()) {
-
-				//don't have enough evaluations, so save next one
-				switch (num_Hdemag_saved)
-				{
-				case 0:
-					pHdemag = &Hdemag;
-					time_demag1 = paMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 1:
-					pHdemag = &Hdemag2;
-					time_demag2 = paMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 2:
-					pHdemag = &Hdemag3;
-					time_demag3 = paMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 3:
-					pHdemag = &Hdemag4;
-					time_demag4 = paMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 4:
-					pHdemag = &Hdemag5;
-					time_demag5 = paMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 5:
-					pHdemag = &Hdemag6;
-					time_demag6 = paMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				}
-
-				num_Hdemag_saved++;
-			}
-			else {
-
-				//have enough evaluations saved, so just cycle between them now
-
-				//QUINTIC
-				if (paMesh->pSMesh->GetEvaluationSpeedup() == 6) {
-
-					//1, 2, 3, 4, 5, 6 -> next is 1
-					if (time_demag6 > time_demag5 && time_demag5 > time_demag4 && time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 4, 5, 6, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 4, 5, 6, 1, 2 -> next is 3
-					else if (time_demag2 > time_demag3) {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//4, 5, 6, 1, 2, 3 -> next is 4
-					else if (time_demag3 > time_demag4) {
-
-						pHdemag = &Hdemag4;
-						time_demag4 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//5, 6, 1, 2, 3, 4 -> next is 5
-					else if (time_demag4 > time_demag5) {
-
-						pHdemag = &Hdemag5;
-						time_demag5 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					else {
-
-						pHdemag = &Hdemag6;
-						time_demag6 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//QUARTIC
-				else if (paMesh->pSMesh->GetEvaluationSpeedup() == 5) {
-
-					//1, 2, 3, 4, 5 -> next is 1
-					if (time_demag5 > time_demag4 && time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 4, 5, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 4, 5, 1, 2 -> next is 3
-					else if (time_demag2 > time_demag3) {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//4, 5, 1, 2, 3 -> next is 4
-					else if (time_demag3 > time_demag4) {
-
-						pHdemag = &Hdemag4;
-						time_demag4 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					else {
-
-						pHdemag = &Hdemag5;
-						time_demag5 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//CUBIC
-				else if (paMesh->pSMesh->GetEvaluationSpeedup() == 4) {
-
-					//1, 2, 3, 4 -> next is 1
-					if (time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 4, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 4, 1, 2 -> next is 3
-					else if (time_demag2 > time_demag3) {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					else {
-
-						pHdemag = &Hdemag4;
-						time_demag4 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//QUADRATIC
-				else if (paMesh->pSMesh->GetEvaluationSpeedup() == 3) {
-
-					//1, 2, 3 -> next is 1
-					if (time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 1 -> next is 2
-					else if (time_demag3 > time_demag2 && time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 1, 2 -> next is 3, leading to 1, 2, 3 again
-					else {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//LINEAR
-				else if (paMesh->pSMesh->GetEvaluationSpeedup() == 2) {
-
-					//1, 2 -> next is 1
-					if (time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 1 -> next is 2, leading to 1, 2 again
-					else {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = paMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//STEP
-				else {
-
-					pHdemag = &Hdemag;
-				}
-			}
+		//convolute and get "energy" value
+		if (using_macrocell) {
 
 			//convolute and get "energy" value
-			if (using_macrocell) {
-
-				//convolute and get "energy" value
-				if (Module_Heff.linear_size()) Convolute(M, *pHdemag, true, &Module_Heff, &Module_energy);
-				else Convolute(M, *pHdemag, true);
-				//energy not calculated in macrocell mode : would need to correct for use of self demag term in macrocell
-				energy = 0.0;
-			}
-			else {
-
-				//not using macrocell so get moments directly from mesh
-
-				//convolute and get "energy" value
-				if (Module_Heff.linear_size()) energy = Convolute(paMesh->M1, *pHdemag, true, &Module_Heff, &Module_energy);
-				else energy = Convolute(paMesh->M1, *pHdemag, true);
-
-				//finish off energy value
-				if (non_empty_volume) energy *= -MUB_MU0 / (2 * non_empty_volume);
-				else energy = 0;
-			}
-
-			//transfer demagnetising field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
-			pHdemag->transfer_out();
-
-			//subtract self contribution
-			if (using_macrocell) {
-				#pragma omp parallel for
-				for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-					//subtract self contribution: we'll add in again for the new moment, so it least the self contribution is exact
-
-					(*pHdemag)[idx] -= (selfDemagCoeff & M[idx]);
-				}
-			}
-			else {
-
-				#pragma omp parallel for
-				for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-					//subtract self contribution: we'll add in again for the new moment, so it least the self contribution is exact
-
-					(*pHdemag)[idx] -= (selfDemagCoeff & paMesh->M1[idx]);
-				}
-			}
+			if (Module_Heff.linear_size()) Convolute(M, Hsave, true, &Module_Heff, &Module_energy);
+			else Convolute(M, Hsave, true);
+			//energy not calculated in macrocell mode : would need to correct for use of self demag term in macrocell
+			energy = 0.0;
 		}
 		else {
 
-			//not required to update, and we have enough previous evaluations: use previous Hdemag saves to extrapolate for current evaluation
-
-			double a1 = 1.0, a2 = 0.0, a3 = 0.0, a4 = 0.0, a5 = 0.0, a6 = 0.0;
-			double time = paMesh->pSMesh->Get_EvalStep_Time();
-
-			//QUINTIC
-			if (paMesh->pSMesh->GetEvaluationSpeedup() == 6) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4) * (time_demag1 - time_demag5) * (time_demag1 - time_demag6));
-				a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4) * (time_demag2 - time_demag5) * (time_demag2 - time_demag6));
-				a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4) * (time_demag3 - time_demag5) * (time_demag3 - time_demag6));
-				a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag5) * (time - time_demag6) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3) * (time_demag4 - time_demag5) * (time_demag4 - time_demag6));
-				a5 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag6) / ((time_demag5 - time_demag1) * (time_demag5 - time_demag2) * (time_demag5 - time_demag3) * (time_demag5 - time_demag4) * (time_demag5 - time_demag6));
-				a6 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag6 - time_demag1) * (time_demag6 - time_demag2) * (time_demag6 - time_demag3) * (time_demag6 - time_demag4) * (time_demag6 - time_demag5));
-
-				//construct effective field approximation
-				if (using_macrocell) {
-
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						Hd[idx] = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + Hdemag6[idx] * a6 + (selfDemagCoeff & M[idx]);
-					}
-
-					//add to Heff in the atomistic mesh
-					Hd.transfer_out();
-				}
-				else {
-
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						paMesh->Heff1[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + Hdemag6[idx] * a6 + (selfDemagCoeff & paMesh->M1[idx]);
-					}
-				}
-			}
-			//QUARTIC
-			else if (paMesh->pSMesh->GetEvaluationSpeedup() == 5) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4) * (time_demag1 - time_demag5));
-				a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4) * (time_demag2 - time_demag5));
-				a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) * (time - time_demag5) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4) * (time_demag3 - time_demag5));
-				a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag5) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3) * (time_demag4 - time_demag5));
-				a5 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) / ((time_demag5 - time_demag1) * (time_demag5 - time_demag2) * (time_demag5 - time_demag3) * (time_demag5 - time_demag4));
-
-				//construct effective field approximation
-				if (using_macrocell) {
-
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						Hd[idx] = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + (selfDemagCoeff & M[idx]);
-					}
-
-					//add to Heff in the atomistic mesh
-					Hd.transfer_out();
-				}
-				else {
-
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						paMesh->Heff1[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + (selfDemagCoeff & paMesh->M1[idx]);
-					}
-				}
-			}
-			//CUBIC
-			else if (paMesh->pSMesh->GetEvaluationSpeedup() == 4) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4));
-				a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4));
-				a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4));
-				a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3));
+			//not using macrocell so get moments directly from mesh
 
-				//construct effective field approximation
-				if (using_macrocell) {
+			//convolute and get "energy" value
+			if (Module_Heff.linear_size()) energy = Convolute(paMesh->M1, Hsave, true, &Module_Heff, &Module_energy);
+			else energy = Convolute(paMesh->M1, Hsave, true);
 
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			//finish off energy value
+			if (non_empty_volume) energy *= -MUB_MU0 / (2 * non_empty_volume);
+			else energy = 0;
+		}
 
-						Hd[idx] = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + (selfDemagCoeff & M[idx]);
-					}
+		//transfer demagnetising field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
+		Hsave.transfer_out();
 
-					//add to Heff in the atomistic mesh
-					Hd.transfer_out();
-				}
-				else {
+		//subtract self contribution
+		if (using_macrocell) {
+			#pragma omp parallel for
+			for (int idx = 0; idx < Hsave.linear_size(); idx++) {
 
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+				//subtract self contribution: we'll add in again for the new moment, so it least the self contribution is exact
 
-						paMesh->Heff1[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + (selfDemagCoeff & paMesh->M1[idx]);
-					}
-				}
+				Hsave[idx] -= (selfDemagCoeff & M[idx]);
 			}
-			//QUADRATIC
-			else if (paMesh->pSMesh->GetEvaluationSpeedup() == 3) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3));
-				a2 = (time - time_demag1) * (time - time_demag3) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3));
-				a3 = (time - time_demag1) * (time - time_demag2) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2));
-
-				//construct effective field approximation
-				if (using_macrocell) {
-
-					#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-					 	Hd[idx] = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + (selfDemagCoeff & M[idx]);
-					}
+		}
+		else {
 
-					//add to Heff in the atomistic mesh
-					Hd.transfer_out();
-				}
-				else {
+			#pragma omp parallel for
+			for (int idx = 0; idx < Hsave.linear_size(); idx++) {
 
-					#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+				//subtract self contribution: we'll add in again for the new moment, so it least the self contribution is exact
 
-						paMesh->Heff1[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + (selfDemagCoeff & paMesh->M1[idx]);
-					}
-				}
+				Hsave[idx] -= (selfDemagCoeff & paMesh->M1[idx]);
 			}
-			//LINEAR
-			else if (paMesh->pSMesh->GetEvaluationSpeedup() == 2) {
-
-				a1 = (time - time_demag2) / (time_demag1 - time_demag2);
-				a2 = (time - time_demag1) / (time_demag2 - time_demag1);
-
-				//construct effective field approximation
-				if (using_macrocell) {
+		}
 
-					#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+		evalspeedup.Accumulate_Residual(Hdemag);
+		evalspeedup.Save_Done();
+	}
+	else {
 
-						Hd[idx] = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + (selfDemagCoeff & M[idx]);
-					}
+		//not required to update, and we have enough previous evaluations: use previous Hdemag saves to extrapolate for current evaluation
 
-					//add to Heff in the atomistic mesh
-					Hd.transfer_out();
-				}
-				else {
+		//construct effective field approximation
+		if (using_macrocell) {
 
-					#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			#pragma omp parallel for
+			for (int idx = 0; idx < Hd.linear_size(); idx++) {
 
-						paMesh->Heff1[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + (selfDemagCoeff & paMesh->M1[idx]);
-					}
-				}
+				Hd[idx] = evalspeedup.extrapolate(Hdemag, idx) + (selfDemagCoeff & M[idx]);
 			}
-			//STEP
-			else {
-
-				//construct effective field approximation
-				if (using_macrocell) {
-
-					#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
 
-						Hd[idx] = Hdemag[idx] + (selfDemagCoeff & M[idx]);
-					}
-
-					//add to Heff in the atomistic mesh
-					Hd.transfer_out();
-				}
-				else {
+			//add to Heff in the atomistic mesh
+			Hd.transfer_out();
+		}
+		else {
 
-					#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			#pragma omp parallel for
+			for (int idx = 0; idx < paMesh->M1.linear_size(); idx++) {
 
-						paMesh->Heff1[idx] += Hdemag[idx] + (selfDemagCoeff & paMesh->M1[idx]);
-					}
-				}
+				paMesh->Heff1[idx] += evalspeedup.extrapolate(Hdemag, idx) + (selfDemagCoeff & paMesh->M1[idx]);
 			}
 		}
 	}
@@ -45,6 +45,15 @@ private:
 	//2-temperature model : itinerant electrons <-> lattice
 	void IterateHeatEquation_2TM(double dT);
 
+	//before iterating the implicit solver for a time step dT, prime it : store explicit part of the equations (values at start of time step and heat sources)
+	void PrimeHeatEquation_Implicit(double dT, double theta);
+
+	//take a single iteration of the implicit solver for time step dT (CMBND cells not set)
+	DBL2 IterateHeatEquation_Implicit(double dT, double theta);
+
+	//heat source (Joule heating and Q) at cell idx, using given stage time for Q equation if set
+	double Evaluate_HeatSource(int idx, double time);
+
 protected:
 
 	//-------------------Setters
@@ -297,6 +297,193 @@ void Atom_Heat::IterateHeatEquation_2TM(double dT)
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////// IMPLICIT SOLVER ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+//Theta method for both 1TM and 2TM (theta = 0.5 : Crank-Nicolson, theta = 1 : backward Euler). Heat sources are evaluated at the start of the time step.
+//1TM : cro * (T' - T) / dT = theta * K delsq T' + (1 - theta) * K delsq T + S
+//2TM : cro_e * (T' - T) / dT = theta * (K delsq T' - G (T' - Tl')) + (1 - theta) * (K delsq T - G (T - Tl)) + S
+//		cro_l * (Tl' - Tl) / dT = theta * G (T' - Tl') + (1 - theta) * G (T - Tl)
+//The lattice equation is local so Tl' is eliminated in each cell : Tl' = (Tl* + a T') / (1 + a), where Tl* is the explicit part and a = theta * dT * G / cro_l.
+
+//heat source (Joule heating and Q) at cell idx, using given stage time for Q equation if set
+double Atom_Heat::Evaluate_HeatSource(int idx, double time)
+{
+	double source = 0.0;
+
+	//Joule heating if set
+	if (paMesh->E.linear_size()) {
+
+		double joule_eff = paMesh->joule_eff;
+		paMesh->update_parameters_tcoarse(idx, paMesh->joule_eff, joule_eff);
+
+		if (IsNZ(joule_eff)) {
+
+			DBL3 position = paMesh->Temp.cellidx_to_position(idx);
+
+			double elC_value = paMesh->elC.weighted_average(position, paMesh->Temp.h);
+			DBL3 E_value = paMesh->E.weighted_average(position, paMesh->Temp.h);
+
+			source += joule_eff * (elC_value * E_value * E_value);
+		}
+	}
+
+	//heat source contribution if set
+	if (Q_equation.is_set()) {
+
+		DBL3 relpos = paMesh->Temp.cellidx_to_position(idx);
+		source += Q_equation.evaluate(relpos.x, relpos.y, relpos.z, time);
+	}
+	else if (IsNZ(paMesh->Q.get0())) {
+
+		double Q = paMesh->Q;
+		paMesh->update_parameters_tcoarse(idx, paMesh->Q, Q);
+
+		source += Q;
+	}
+
+	return source;
+}
+
+//before iterating the implicit solver for a time step dT, prime it : store explicit part of the equations (values at start of time step and heat sources)
+void Atom_Heat::PrimeHeatEquation_Implicit(double dT, double theta)
+{
+	//1. heat sources at start of time step
+	if (!Q_equation.is_set()) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < paMesh->Temp.linear_size(); idx++) {
+
+			if (paMesh->Temp.is_not_empty(idx)) heatEq_RHS[idx] = Evaluate_HeatSource(idx, 0.0);
+		}
+	}
+	else {
+
+		//text equation evaluated without OpenMP, as for FTCS
+		double time = pSMesh->GetStageTime();
+
+		for (int idx = 0; idx < paMesh->Temp.linear_size(); idx++) {
+
+			if (paMesh->Temp.is_not_empty(idx)) heatEq_RHS[idx] = Evaluate_HeatSource(idx, time);
+		}
+	}
+
+	//2. explicit part of the equations
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->Temp.linear_size(); idx++) {
+
+		if (!paMesh->Temp.is_not_empty(idx)) continue;
+
+		double density = paMesh->density;
+		double shc = paMesh->shc;
+		double thermCond = paMesh->thermCond;
+		paMesh->update_parameters_tcoarse(idx, paMesh->density, density, paMesh->shc, shc, paMesh->thermCond, thermCond);
+
+		double K = thermCond;
+
+		if (tmtype == TMTYPE_2TM) {
+
+			double shc_e = paMesh->shc_e;
+			double G_el = paMesh->G_e;
+			paMesh->update_parameters_tcoarse(idx, paMesh->shc_e, shc_e, paMesh->G_e, G_el);
+
+			double cro_e = density * shc_e;
+			double cro_l = density * (shc - shc_e);
+
+			double coupling = G_el * (paMesh->Temp[idx] - paMesh->Temp_l[idx]);
+
+			if (paMesh->Temp.is_not_cmbnd(idx)) heatEq_RHS[idx] = paMesh->Temp[idx] + dT * ((1 - theta) * (paMesh->Temp.delsq_robin(idx, K) * K - coupling) + heatEq_RHS[idx]) / cro_e;
+			heatEq_RHS_l[idx] = paMesh->Temp_l[idx] + dT * (1 - theta) * coupling / cro_l;
+		}
+		else if (paMesh->Temp.is_not_cmbnd(idx)) {
+
+			double cro = density * shc;
+
+			heatEq_RHS[idx] = paMesh->Temp[idx] + dT * ((1 - theta) * paMesh->Temp.delsq_robin(idx, K) * K + heatEq_RHS[idx]) / cro;
+		}
+	}
+}
+
+//take a single iteration of the implicit solver for time step dT (CMBND cells not set)
+DBL2 Atom_Heat::IterateHeatEquation_Implicit(double dT, double theta)
+{
+	VEC_VC<double>& Temp = paMesh->Temp;
+
+	OmpReduction<double> reduction_change, reduction_value;
+	reduction_change.new_minmax_reduction();
+	reduction_value.new_minmax_reduction();
+
+	//red-black : two passes will be taken
+	for (int rb = 0; rb < 2; rb++) {
+
+#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < Temp.n.y * Temp.n.z; idx_jk++) {
+
+			int j = idx_jk % Temp.n.y;
+			int k = idx_jk / Temp.n.y;
+
+			//red_nudge = true for odd rows and even planes or for even rows and odd planes - have to keep index on the checkerboard pattern
+			bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
+
+			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < Temp.n.x; i += 2) {
+
+				int idx = i + j * Temp.n.x + k * Temp.n.x * Temp.n.y;
+
+				if (!Temp.is_not_empty(idx)) continue;
+
+				double density = paMesh->density;
+				double shc = paMesh->shc;
+				double thermCond = paMesh->thermCond;
+				paMesh->update_parameters_tcoarse(idx, paMesh->density, density, paMesh->shc, shc, paMesh->thermCond, thermCond);
+
+				double K = thermCond;
+
+				//delsq T = diagonal * T[idx] + offdiagonal
+				double diagonal = Temp.delsq_robin_diag(idx, K);
+				double offdiagonal = Temp.delsq_robin(idx, K) - diagonal * Temp[idx];
+
+				double old_value = Temp[idx];
+
+				if (tmtype == TMTYPE_2TM) {
+
+					double shc_e = paMesh->shc_e;
+					double G_el = paMesh->G_e;
+					paMesh->update_parameters_tcoarse(idx, paMesh->shc_e, shc_e, paMesh->G_e, G_el);
+
+					double cro_e = density * shc_e;
+					double cro_l = density * (shc - shc_e);
+
+					double a = theta * dT * G_el / cro_l;
+					double c = theta * dT / cro_e;
+
+					if (Temp.is_not_cmbnd(idx)) {
+
+						Temp[idx] = (heatEq_RHS[idx] + c * (K * offdiagonal + G_el * heatEq_RHS_l[idx] / (1 + a))) / (1 - c * K * diagonal + c * G_el / (1 + a));
+					}
+
+					//lattice temperature follows (also in CMBND cells)
+					paMesh->Temp_l[idx] = (heatEq_RHS_l[idx] + a * Temp[idx]) / (1 + a);
+				}
+				else {
+
+					if (!Temp.is_not_cmbnd(idx)) continue;
+
+					double cro = density * shc;
+					double c = theta * dT * K / cro;
+
+					Temp[idx] = (heatEq_RHS[idx] + c * offdiagonal) / (1 - c * diagonal);
+				}
+
+				reduction_change.reduce_max(fabs(Temp[idx] - old_value));
+				reduction_value.reduce_max(fabs(Temp[idx]));
+			}
+		}
+	}
+
+	return DBL2(reduction_change.maximum(), reduction_value.maximum());
+}
+
 //-------------------CMBND computation methods
 
 //CMBND values set based on continuity of temperature and heat flux
@@ -275,9 +275,6 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Classic(void)
 	///////////////////////////////////////////////////////////////
 	// PARALLEL MONTE-CARLO METROPOLIS
 
-	//make sure number of calls to rand doesn't match the prng period or we're asking for trouble with MC.
-	prng.check_periodicity();
-
 	//red-black : two passes will be taken
 	int rb = 0;
 	while (rb < 2) {
@@ -301,12 +298,15 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Classic(void)
 				//only consider non-empty and non-frozen cells
 				if (M1.is_not_empty(spin_idx) && !M1.is_skipcell(spin_idx)) {
 
+					//random numbers for this move depend only on the seed, spin index and Monte Carlo step (not on the number of threads)
+					BorisCBRand::Stream rnd = mc_prng.stream(spin_idx, mc_step);
+
 					//Picked spin is M1[spin_idx]
 					DBL3 M1_old = M1[spin_idx];
 
 					//obtain rotated spin in a cone around the picked spin
-					double theta_rot = prng.rand() * mc_cone_angledeg * PI / 180.0;
-					double phi_rot = prng.rand() * 2 * PI;
+					double theta_rot = rnd.rand() * mc_cone_angledeg * PI / 180.0;
+					double phi_rot = rnd.rand() * 2 * PI;
 					//Move spin in cone with uniform random probability distribution. This approach only requires 2 random numbers to be generated. 
 					//Also using a Gaussian distribution to move spin around the initial spin is less efficient, requiring more steps to thermalize.
 					DBL3 M1_new = relrotate_polar(M1_old, theta_rot, phi_rot);
@@ -324,7 +324,7 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Classic(void)
 
 						P_accept = exp(-energy_delta / (BOLTZMANN * base_temperature));
 						//uniform random number between 0 and 1
-						P = prng.rand();
+						P = rnd.rand();
 					}
 					else if (energy_delta < 0) P_accept = 1.0;
 
@@ -347,6 +347,8 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Classic(void)
 		mc_acceptance_rate += acceptance_rate;
 		rb++;
 	}
+
+	mc_step++;
 }
 
 void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
@@ -389,9 +391,6 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 
 	//red-black : two passes will be taken : first generate red and black indices for these passes, together with random doubles so we can shuffle them using sort-based shuffle
 	
-	//make sure number of calls to rand doesn't match the prng period or we're asking for trouble with MC.
-	prng.check_periodicity();
-
 	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
 		for (int j = 0; j < n.y; j++) {
@@ -426,7 +425,7 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 
 					int idx_red = (i / 2) + (even_rows + odd_rows) + (even_planes + odd_planes);
 
-					mc_indices_red[idx_red] = { prng.rand(), spin_idx };
+					mc_indices_red[idx_red] = { mc_prng.stream(spin_idx, mc_step, 1).rand(), spin_idx };
 				}
 				else {
 
@@ -449,7 +448,7 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 
 					int idx_black = (i / 2) + (even_rows + odd_rows) + (even_planes + odd_planes);
 
-					mc_indices_black[idx_black] = { prng.rand(), spin_idx };
+					mc_indices_black[idx_black] = { mc_prng.stream(spin_idx, mc_step, 1).rand(), spin_idx };
 				}
 			}
 		}
@@ -492,6 +491,9 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 			//If there are empty cells then make sure to only pair non-empty ones
 			if (M1.is_not_empty(spin_idx1) && M1.is_not_empty(spin_idx2) && !M1.is_skipcell(spin_idx1) && !M1.is_skipcell(spin_idx2)) {
 
+				//random numbers for this move depend only on the seed, first spin index and Monte Carlo step (not on the number of threads)
+				BorisCBRand::Stream rnd = mc_prng.stream(spin_idx1, mc_step);
+
 				//Picked spins are M1[spin_idx1], M1[spin_idx2]
 				DBL3 M_old1 = M1[spin_idx1];
 				DBL3 M_old2 = M1[spin_idx2];
@@ -502,8 +504,8 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 				DBL3 Mrot_old2 = invrotate_polar(M_old2, cmc_n);
 
 				//obtain rotated spin in a cone around the first picked spin
-				double theta_rot = prng.rand() * mc_cone_angledeg * PI / 180.0;
-				double phi_rot = prng.rand() * 2 * PI;
+				double theta_rot = rnd.rand() * mc_cone_angledeg * PI / 180.0;
+				double phi_rot = rnd.rand() * 2 * PI;
 				DBL3 Mrot_new1 = relrotate_polar(Mrot_old1, theta_rot, phi_rot);
 
 				//adjust second spin to keep required total moment direction
@@ -538,7 +540,7 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 							if (cmc_M) P_accept = (cmc_M_new / cmc_M) * (cmc_M_new / cmc_M) * (abs(Mrot_old2.x) / abs(Mrot_new2.x)) * exp(-energy_delta / (BOLTZMANN * base_temperature));
 							else P_accept = (abs(Mrot_old2.x) / abs(Mrot_new2.x)) * exp(-energy_delta / (BOLTZMANN * base_temperature));
 							//uniform random number between 0 and 1
-							P = prng.rand();
+							P = rnd.rand();
 						}
 						else if (energy_delta < 0) P_accept = 1.0;
 
@@ -567,6 +569,8 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 		mc_acceptance_rate += acceptance_rate;
 		rb++;
 	}
+
+	mc_step++;
 }
 
 #endif
\ No newline at end of file
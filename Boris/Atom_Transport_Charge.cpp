@@ -17,12 +17,12 @@ DBL2 Atom_Transport::IterateChargeSolver_SOR(double damping)
 	if (!is_thermoelectric_mesh) {
 
 		//no thermoelectric effect
-		return paMesh->V.IteratePoisson_SOR<Atom_Transport>(&Atom_Transport::Evaluate_ChargeSolver_delsqV_RHS, *this, damping);
+		return paMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Atom_Transport::Evaluate_ChargeSolver_delsqV_RHS(idx); }, damping);
 	}
 	else {
 
 		//include thermoelectric effect
-		return paMesh->V.IteratePoisson_SOR<Atom_Transport>(&Atom_Transport::Evaluate_ChargeSolver_delsqV_Thermoelectric_RHS, &Atom_Transport::NHNeumann_Vdiff_Thermoelectric, *this, damping);
+		return paMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Atom_Transport::Evaluate_ChargeSolver_delsqV_Thermoelectric_RHS(idx); }, [this](int idx) { return Atom_Transport::NHNeumann_Vdiff_Thermoelectric(idx); }, damping);
 	}
 }
 
@@ -17,7 +17,7 @@
 
 DBL2 Atom_Transport::IterateSpinSolver_Charge_SOR(double damping)
 {
-	return paMesh->V.IteratePoisson_SOR<Atom_Transport>(&Atom_Transport::Evaluate_SpinSolver_delsqV_RHS, *this, damping);
+	return paMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Atom_Transport::Evaluate_SpinSolver_delsqV_RHS(idx); }, damping);
 }
 
 //before iterating the spin solver (charge part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
@@ -144,7 +144,7 @@ double Atom_Transport::Evaluate_SpinSolver_delsqV_RHS(int idx) const
 DBL2 Atom_Transport::IterateSpinSolver_Spin_SOR(double damping)
 {
 	//no SHE contribution. Note, SHE is not included in magnetic meshes.
-	return paMesh->S.IteratePoisson_SOR<Atom_Transport>(&Atom_Transport::Evaluate_SpinSolver_delsqS_RHS, *this, damping);
+	return paMesh->S.IteratePoisson_SOR_Func([this](int idx) { return Atom_Transport::Evaluate_SpinSolver_delsqS_RHS(idx); }, damping);
 }
 
 //before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes.
@@ -1313,4 +1313,35 @@ void Simulation::Print_DisplayRenderSettings(void)
 	displayrender_info += "</c>[tc1,1,1,1/tc] Cells Threshold 3 : " + MakeIO(IOI_DISPRENDER_THRESH3, BD.GetRenderThresholds().k);
 
 	BD.DisplayFormattedConsoleMessage(displayrender_info);
-}
\ No newline at end of file
+}
+
+//---------------------------------------------------- PROFILER
+
+void Simulation::Print_Profile(void)
+{
+	BD.DisplayConsoleListing("Profiler : " + std::string(profiler.is_enabled() ? "on" : "off"));
+
+	double iteration_time = profiler.get_stage_time(PROFILE_ITERATION);
+
+	//total time (ms), number of calls, time per call (ms), and percentage of iteration time
+	auto make_line = [&](std::string name, double time, int calls) -> std::string {
+
+		std::string line = name + " : " + ToString(time * 1e3) + " ms, calls : " + ToString(calls) + ", per call : " + ToString(time * 1e3 / calls) + " ms";
+		if (iteration_time > 0.0) line += ", " + ToString(100.0 * time / iteration_time) + " %";
+
+		return line;
+	};
+
+	for (int stage = 0; stage < PROFILE_NUMSTAGES; stage++) {
+
+		if (profiler.get_stage_calls(stage)) BD.DisplayConsoleListing(make_line(Profiler::get_stage_name(stage), profiler.get_stage_time(stage), profiler.get_stage_calls(stage)));
+	}
+
+	for (int moduleID = 0; moduleID < PROFILE_MODULEIDS; moduleID++) {
+
+		if (!profiler.get_module_calls(moduleID)) continue;
+
+		std::string name = (moduleHandles.is_ID_set(moduleID) ? moduleHandles(moduleID) : "module " + ToString(moduleID));
+		BD.DisplayConsoleListing(make_line("  " + name, profiler.get_module_time(moduleID), profiler.get_module_calls(moduleID)));
+	}
+}
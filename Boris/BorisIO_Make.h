@@ -417,6 +417,14 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average lattice temperature</i>"), INT2(IOI_SHOWDATA, DATA_TEMP_L));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Heat solver time step</i>"), INT2(IOI_SHOWDATA, DATA_HEATDT));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Command buffer data extraction</i>"), INT2(IOI_SHOWDATA, DATA_COMMBUFFER));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Disk buffer back-pressure:\n<i><b>number of waits for disk writes, total wait time (s)</i>"), INT2(IOI_SHOWDATA, DATA_DISKBUFFER));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in iteration (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_ITERATION));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in module field updates (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_MODULES));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in ODE evaluation (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_ODE));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in transport solver modules (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_TRANSPORT));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in heat solver modules (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_HEAT));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in super-mesh transfers (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_MESHTRANSFER));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Profiler: total time in saving data (s)</i>"), INT2(IOI_SHOWDATA, DATA_PROFILE_SAVEDATA));
 
 	std::string data_info_generic =
 		std::string("[tc1,1,0,1/tc]<b>Output data</b>") +
@@ -490,6 +498,14 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(data_info_generic + std::string("<i><b>Average lattice temperature</i>"), INT2(IOI_DATA, DATA_TEMP_L));
 	ioInfo.set(data_info_generic + std::string("<i><b>Heat solver time step</i>"), INT2(IOI_DATA, DATA_HEATDT));
 	ioInfo.set(data_info_generic + std::string("<i><b>Command buffer data extraction</i>"), INT2(IOI_DATA, DATA_COMMBUFFER));
+	ioInfo.set(data_info_generic + std::string("<i><b>Disk buffer back-pressure:\n<i><b>number of waits for disk writes, total wait time (s)</i>"), INT2(IOI_DATA, DATA_DISKBUFFER));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in iteration (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_ITERATION));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in module field updates (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_MODULES));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in ODE evaluation (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_ODE));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in transport solver modules (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_TRANSPORT));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in heat solver modules (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_HEAT));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in super-mesh transfers (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_MESHTRANSFER));
+	ioInfo.set(data_info_generic + std::string("<i><b>Profiler: total time in saving data (s)</i>"), INT2(IOI_DATA, DATA_PROFILE_SAVEDATA));
 
 	//Show currently set directory : textId is the directory
 	//IOI_DIRECTORY
@@ -1701,6 +1701,23 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_FUSEDFIELDS:
+		{
+			bool status;
+
+			error = commandSpec.GetParameters(command_fields, status);
+
+			if (!error) {
+
+				StopSimulation();
+				SMesh.Set_Fused_Local_Fields(status);
+			}
+			else if (verbose) BD.DisplayConsoleListing("Fused local field modules evaluation : " + std::string(SMesh.Get_Fused_Local_Fields() ? "on" : "off"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.Get_Fused_Local_Fields()));
+		}
+		break;
+
 		case CMD_MULTICONV:
 		{
 			bool status;
@@ -1801,6 +1818,23 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_DEMAGSPREC:
+		{
+			bool status;
+
+			error = commandSpec.GetParameters(command_fields, status);
+
+			if (!error) {
+
+				StopSimulation();
+				if (!err_hndl.qcall(error, &SuperMesh::Set_Demag_Single_Precision, &SMesh, status)) RefreshScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Mixed precision demag convolution : " + std::string(SMesh.Get_Demag_Single_Precision() ? "on" : "off"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.Get_Demag_Single_Precision()));
+		}
+		break;
+
 		case CMD_ODE:
 		{
 			if (verbose) Print_ODEs();
@@ -1911,6 +1945,26 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_EVALSPEEDUPTOL:
+		{
+			double tolerance;
+
+			error = commandSpec.GetParameters(command_fields, tolerance);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetEvaluationSpeedupTolerance(tolerance);
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Evaluation speedup tolerance : " + ToString(SMesh.GetEvaluationSpeedupTolerance()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetEvaluationSpeedupTolerance()));
+		}
+		break;
+
 		case CMD_SETDT:
 		{
 			double dT;
@@ -2113,15 +2167,15 @@ void Simulation::HandleCommand(std::string command_string)
 			//0 : make new file and save to it immediately
 			if (append_option == 0) {
 
-				//first reset buffer positions
-				savedata_diskbuffer_position = 0;
+				//first reset buffer
+				savedata_diskbuffer.clear();
 
 				//Get the data to save (into buffer)
 				SaveData();
 
 				//and immediately flush buffer, making sure to create new file
 				appendToDataFile = false;
-				if (savedata_diskbuffer_position) SaveData_DiskBufferFlush(&savedata_diskbuffer, &savedata_diskbuffer_position);
+				savedata_diskbuffer.flush();
 			}
 			else {
 
@@ -2133,7 +2187,7 @@ void Simulation::HandleCommand(std::string command_string)
 
 					//if simulation is not running then we want to save immediately - so SaveData() then empty buffer
 					SaveData();
-					if (savedata_diskbuffer_position) SaveData_DiskBufferFlush(&savedata_diskbuffer, &savedata_diskbuffer_position);
+					savedata_diskbuffer.flush();
 				}
 			}
 		}
@@ -3769,6 +3823,37 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_TSOLVERMETHOD:
+		{
+			if (SMesh.IsSuperMeshModuleSet(MODS_STRANSPORT)) {
+
+				std::string method_name;
+
+				error = commandSpec.GetParameters(command_fields, method_name);
+
+				if (!error) {
+
+					StopSimulation();
+
+					if (!SMesh.CallModuleMethod(&STransport::SetSolverMethod, method_name)) error(BERROR_INCORRECTNAME);
+
+					UpdateScreen();
+				}
+				else if (verbose) BD.DisplayConsoleListing(
+					"V solver method : " + SMesh.CallModuleMethod(&STransport::GetSolverMethodName) + " (available: sor, mgv, mgw). Last solve : " + 
+					ToString(SMesh.CallModuleMethod(&STransport::GetItersToConv)) + " iterations in " + 
+					ToString(SMesh.CallModuleMethod(&STransport::GetSolveTime)) + " ms.");
+
+				if (script_client_connected)
+					commSocket.SetSendData(commandSpec.PrepareReturnParameters(
+						SMesh.CallModuleMethod(&STransport::GetSolverMethodName),
+						SMesh.CallModuleMethod(&STransport::GetItersToConv),
+						SMesh.CallModuleMethod(&STransport::GetSolveTime)));
+			}
+			else error(BERROR_INCORRECTACTION);
+		}
+		break;
+
 		case CMD_SETSORDAMPING:
 		{
 			if (SMesh.IsSuperMeshModuleSet(MODS_STRANSPORT)) {
@@ -3956,6 +4041,44 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_HEATSOLVER:
+		{
+			std::string method_name;
+			double errorMax;
+			int maxIterations;
+
+			error = commandSpec.GetParameters(command_fields, method_name, errorMax, maxIterations);
+			if (error == BERROR_PARAMMISMATCH) { 
+				
+				error.reset() = commandSpec.GetParameters(command_fields, method_name); 
+				errorMax = SMesh.CallModuleMethod(&SHeat::GetHeatSolverConvergenceError);
+				maxIterations = SMesh.CallModuleMethod(&SHeat::GetHeatSolverIterationsTimeout);
+			}
+
+			if (!error) {
+
+				StopSimulation();
+
+				if (SMesh.CallModuleMethod(&SHeat::SetHeatSolver, method_name)) SMesh.CallModuleMethod(&SHeat::SetHeatSolverConvergence, errorMax, maxIterations);
+				else error(BERROR_INCORRECTNAME);
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleListing(
+				"Heat equation solver : " + SMesh.CallModuleMethod(&SHeat::GetHeatSolverName) + " (available: ftcs, cn, be). Convergence error : " +
+				ToString(SMesh.CallModuleMethod(&SHeat::GetHeatSolverConvergenceError)) + ", iterations timeout : " +
+				ToString(SMesh.CallModuleMethod(&SHeat::GetHeatSolverIterationsTimeout)) + ". Last implicit time step : " +
+				ToString(SMesh.CallModuleMethod(&SHeat::GetHeatSolverIterations)) + " iterations.");
+
+			if (script_client_connected)
+				commSocket.SetSendData(commandSpec.PrepareReturnParameters(
+					SMesh.CallModuleMethod(&SHeat::GetHeatSolverName),
+					SMesh.CallModuleMethod(&SHeat::GetHeatSolverConvergenceError),
+					SMesh.CallModuleMethod(&SHeat::GetHeatSolverIterationsTimeout),
+					SMesh.CallModuleMethod(&SHeat::GetHeatSolverIterations)));
+		}
+		break;
+
 		case CMD_AMBIENTTEMPERATURE:
 		{
 			double T_ambient;
@@ -4937,6 +5060,28 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_PROFILE:
+		{
+			bool status;
+
+			error = commandSpec.GetParameters(command_fields, status);
+
+			if (!error) {
+
+				profiler.set_enabled(status);
+
+				if (verbose) BD.DisplayConsoleListing("Profiler : " + std::string(profiler.is_enabled() ? "on" : "off"));
+			}
+			else if (verbose) Print_Profile();
+
+			if (script_client_connected)
+				commSocket.SetSendData(commandSpec.PrepareReturnParameters(
+					profiler.get_stage_time(PROFILE_ITERATION), profiler.get_stage_time(PROFILE_MODULES), profiler.get_stage_time(PROFILE_ODE),
+					profiler.get_modules_time({ MOD_TRANSPORT, MOD_TMR, MODS_STRANSPORT }), profiler.get_modules_time({ MOD_HEAT, MODS_SHEAT }),
+					profiler.get_stage_time(PROFILE_MESHTRANSFER), profiler.get_stage_time(PROFILE_SAVEDATA)));
+		}
+		break;
+
 		case CMD_MATERIALSDATABASE:
 		{
 			std::string mdbName;
@@ -5409,6 +5554,23 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_OVF2ASYNC:
+		{
+			bool status;
+
+			error = commandSpec.GetParameters(command_fields, status);
+
+			if (!error) {
+
+				OVF2::write_behind() = status;
+				if (!status) OVF2::WaitForPendingWrites();
+			}
+			else if (verbose) BD.DisplayConsoleListing("Asynchronous OVF2 file writing : " + std::string(OVF2::write_behind() ? "on" : "off"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(OVF2::write_behind()));
+		}
+		break;
+
 		case CMD_SAVEOVF2:
 		{
 			std::string meshName, quantity, parameters;
@@ -5760,6 +5922,59 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_KERNELCACHE:
+		{
+			int maxsize_MB;
+			std::string directory_;
+
+			error = commandSpec.GetParameters(command_fields, maxsize_MB, directory_);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, maxsize_MB); directory_ = ""; }
+
+			if (!error) {
+
+				StopSimulation();
+
+				DemagKernelCache::maxsize_MB() = maxsize_MB;
+
+				if (directory_.length()) {
+
+					directory_ = FixedDirectorySlashes(directory_);
+					if (directory_.substr(directory_.length() - 1) != "/") directory_ += "/";
+					DemagKernelCache::directory() = directory_;
+				}
+
+				Save_Startup_Flags();
+			}
+			else if (verbose && error == BERROR_PARAMOUTOFBOUNDS) PrintCommandUsage(command_name);
+			else if (verbose) {
+
+				if (DemagKernelCache::Enabled()) BD.DisplayConsoleListing("Demag kernel cache : " + ToString(DemagKernelCache::maxsize_MB()) + " MB maximum, in " + DemagKernelCache::directory());
+				else BD.DisplayConsoleListing("Demag kernel cache disabled. Cache directory : " + DemagKernelCache::directory());
+			}
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(DemagKernelCache::maxsize_MB(), DemagKernelCache::directory()));
+		}
+		break;
+
+		case CMD_FFTWPLANNER:
+		{
+			std::string rigor;
+
+			error = commandSpec.GetParameters(command_fields, rigor);
+
+			if (!error) {
+
+				StopSimulation();
+
+				if (FFTWPlanner::set_rigor(rigor)) Save_Startup_Flags();
+				else error(BERROR_INCORRECTNAME);
+			}
+			else if (verbose) BD.DisplayConsoleListing("FFTW planner rigor : " + FFTWPlanner::rigor_name(FFTWPlanner::rigor()) + " (available: estimate, measure, patient, exhaustive).");
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(FFTWPlanner::rigor_name(FFTWPlanner::rigor())));
+		}
+		break;
+
 		case CMD_SERVERPORT:
 		{
 			int port;
@@ -6740,6 +6955,23 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_DP_GETARRAY:
+		{
+			int dp_arr;
+
+			error = commandSpec.GetParameters(command_fields, dp_arr);
+
+			if (!error) {
+
+				BD.DisplayConsoleListing("dpArr[" + ToString(dp_arr) + "] size = " + ToString(dpArr[dp_arr].size()));
+			}
+			else if (verbose) PrintCommandUsage(command_name);
+
+			if (script_client_connected && !error)
+				commSocket.SetSendData_Buffer(dpArr[dp_arr]);
+		}
+		break;
+
 		case CMD_DP_SET:
 		{
 			int dp_arr, index;
@@ -6771,7 +7003,7 @@ void Simulation::HandleCommand(std::string command_string)
 				std::string indexes_string = entries.back();
 
 				if (!GetFilenameDirectory(fileName).length()) fileName = directory + fileName;
-				if (GetFileTermination(fileName) != ".txt") fileName += ".txt";
+				if (GetFileTermination(fileName) != ".txt" && GetFileTermination(fileName) != BINARYDATAFILE_TERMINATION) fileName += ".txt";
 
 				int rows_read;
 
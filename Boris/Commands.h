@@ -95,11 +95,13 @@ enum CMD_
 
 	CMD_MODULES, 
 	CMD_ADDMODULE, CMD_DELMODULE,
+	CMD_FUSEDFIELDS,
 
 	//Demag computation control
 
 	CMD_MULTICONV, CMD_2DMULTICONV, CMD_NCOMMONSTATUS, CMD_NCOMMON, CMD_EXCLUDEMULTICONVDEMAG, 
 	CMD_GPUKERNELS,
+	CMD_DEMAGSPREC,
 
 	//-------------------------------------------ODE-------------------------------------------
 
@@ -107,7 +109,7 @@ enum CMD_
 
 	CMD_ODE, CMD_SETODE, CMD_SETODEEVAL, CMD_SETATOMODE, CMD_SETDT, CMD_ASTEPCTRL, 
 	
-	CMD_EVALSPEEDUP, CMD_SETDTSPEEDUP, CMD_LINKDTSPEEDUP,
+	CMD_EVALSPEEDUP, CMD_SETDTSPEEDUP, CMD_LINKDTSPEEDUP, CMD_EVALSPEEDUPTOL,
 
 	//Stochasticity
 
@@ -142,7 +144,7 @@ enum CMD_
 	
 	CMD_ADDELECTRODE, CMD_DELELECTRODE, CMD_CLEARELECTRODES, CMD_ELECTRODES, CMD_SETDEFAULTELECTRODES, CMD_SETELECTRODERECT, CMD_SETELECTRODEPOTENTIAL, CMD_DESIGNATEGROUND,
 	CMD_SETPOTENTIAL, CMD_SETCURRENT, CMD_SETCURRENTDENSITY, CMD_OPENPOTENTIAL,
-	CMD_SSOLVERCONFIG, CMD_SETSORDAMPING, CMD_STATICTRANSPORTSOLVER, CMD_DISABLETRANSPORTSOLVER,
+	CMD_SSOLVERCONFIG, CMD_TSOLVERMETHOD, CMD_SETSORDAMPING, CMD_STATICTRANSPORTSOLVER, CMD_DISABLETRANSPORTSOLVER,
 	CMD_TMRTYPE,
 	CMD_RAPBIAS_EQUATION, CMD_RAAPBIAS_EQUATION,
 	CMD_TAMREQUATION,
@@ -150,7 +152,7 @@ enum CMD_
 	//-------------------------------------------HEAT SOLVER-------------------------------------------
 
 	CMD_TSOLVERCONFIG, 
-	CMD_TEMPERATURE, CMD_SETHEATDT, CMD_AMBIENTTEMPERATURE, CMD_ROBINALPHA, CMD_INSULATINGSIDES, CMD_TMODEL,
+	CMD_TEMPERATURE, CMD_SETHEATDT, CMD_HEATSOLVER, CMD_AMBIENTTEMPERATURE, CMD_ROBINALPHA, CMD_INSULATINGSIDES, CMD_TMODEL,
 
 	//Mesh related
 
@@ -170,12 +172,13 @@ enum CMD_
 	//-------------------------------------------OTHERS-------------------------------------------
 
 	CMD_OPENMANUAL,
-	CMD_BENCHTIME,
+	CMD_BENCHTIME, CMD_PROFILE,
 	CMD_SHOWLENGHTS, CMD_SHOWMCELLS,
 	CMD_SCRIPTSERVER, CMD_CHECKUPDATES,
 	CMD_FLUSHERRORLOG, CMD_ERRORLOG,
 	CMD_STARTUPUPDATECHECK, CMD_STARTUPSCRIPTSERVER,
 	CMD_THREADS,
+	CMD_KERNELCACHE, CMD_FFTWPLANNER,
 	CMD_SERVERPORT, CMD_SERVERPWD, CMD_SERVERSLEEPMS,
 	CMD_NEWINSTANCE,
 
@@ -193,7 +196,7 @@ enum CMD_
 
 	//-------------------------------------------OVF2 COMMANDS-------------------------------------------
 	
-	CMD_LOADOVF2MAG, CMD_SAVEOVF2MAG, CMD_LOADOVF2FIELD, CMD_SAVEOVF2PARAMVAR, CMD_SAVEOVF2, CMD_LOADOVF2DISP, CMD_LOADOVF2STRAIN, CMD_LOADOVF2TEMP, CMD_LOADOVF2CURR,
+	CMD_LOADOVF2MAG, CMD_SAVEOVF2MAG, CMD_LOADOVF2FIELD, CMD_SAVEOVF2PARAMVAR, CMD_SAVEOVF2, CMD_OVF2ASYNC, CMD_LOADOVF2DISP, CMD_LOADOVF2STRAIN, CMD_LOADOVF2TEMP, CMD_LOADOVF2CURR,
 	CMD_CLEARGLOBALFIELD, CMD_SHIFTGLOBALFIELD,
 
 	//-------------------------------------------TEXT EQUATIONS-------------------------------------------
@@ -216,7 +219,7 @@ enum CMD_
 	
 	//Basic control and input/output
 
-	CMD_DP_CLEARALL, CMD_DP_CLEAR, CMD_DP_SHOWSIZES, CMD_DP_GET, CMD_DP_SET, CMD_DP_LOAD, CMD_DP_SAVE, CMD_DP_SAVEAPPEND, CMD_DP_SAVEASROW, CMD_DP_SAVEAPPENDASROW, CMD_DP_NEWFILE,
+	CMD_DP_CLEARALL, CMD_DP_CLEAR, CMD_DP_SHOWSIZES, CMD_DP_GET, CMD_DP_GETARRAY, CMD_DP_SET, CMD_DP_LOAD, CMD_DP_SAVE, CMD_DP_SAVEAPPEND, CMD_DP_SAVEASROW, CMD_DP_SAVEAPPENDASROW, CMD_DP_NEWFILE,
 
 	//Profile and average extraction
 
@@ -119,7 +119,9 @@
 #define ODE_EVAL_COMPILATION_RKF56
 #define ODE_EVAL_COMPILATION_RKCK
 #define ODE_EVAL_COMPILATION_RKDP
+#define ODE_EVAL_COMPILATION_LSRK
 #define ODE_EVAL_COMPILATION_SD
+#define ODE_EVAL_COMPILATION_LBFGS
 
 //testing
 #elif ODE_EVAL_COMPILATION == ODE_EVAL_COMPILATION_TEST
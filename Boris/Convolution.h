@@ -124,12 +124,13 @@ protected:
 	//-------------------------- CONFIGURATION
 
 	//This methods sets all values from and h, including allocating memory - call this before initializing kernels or doing any convolutions
-	BError SetDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_ = true, INT3 pbc_images_ = INT3());
+	//single_precision_ sets mixed precision convolution (embedded multiplication only), and must only be used with kernels which set single precision kernel copies (DemagKernel, DipoleDipoleKernel)
+	BError SetDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_ = true, INT3 pbc_images_ = INT3(), bool single_precision_ = false);
 
 	//-------------------------- CHECK
 
-	//return true only if both n_ and h_ match the current FFT dimensions (n and h); also number of pbc images must match
-	bool CheckDimensions(SZ3 n_, DBL3 h_, INT3 pbc_images_) { return (n == n_ && h == h_ && pbc_images == pbc_images_); }
+	//return true only if both n_ and h_ match the current FFT dimensions (n and h); also number of pbc images and precision mode must match
+	bool CheckDimensions(SZ3 n_, DBL3 h_, INT3 pbc_images_, bool single_precision_ = false) { return (n == n_ && h == h_ && pbc_images == pbc_images_ && single_precision == (single_precision_ && embed_multiplication)); }
 
 	//-------------------------- RUN-TIME CONVOLUTION
 
@@ -141,6 +142,8 @@ protected:
 	//Return dot product of In with Out
 	double Convolute(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr)
 	{
+		if (single_precision) return Convolute_SP(In, nullptr, Out, nullptr, clearOut, pH, penergy);
+
 		if (n.z == 1) return Convolute_2D(In, Out, clearOut, pH, penergy);
 		else return Convolute_3D(In, Out, clearOut, pH, penergy);
 	}
@@ -152,6 +155,8 @@ protected:
 	//Same as Convolution with (In1 + In2) / 2 as input.
 	double Convolute_AveragedInputs(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr)
 	{
+		if (single_precision) return Convolute_SP(In1, &In2, Out, nullptr, clearOut, pH, penergy);
+
 		if (n.z == 1) return Convolute_2D(In1, In2, Out, clearOut, pH, penergy);
 		else return Convolute_3D(In1, In2, Out, clearOut, pH, penergy);
 	}
@@ -163,6 +168,8 @@ protected:
 	//Same as Convolution with (In1 + In2) / 2 as input and output copied to both Out1 and Out2.
 	double Convolute_AveragedInputs_DuplicatedOutputs(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH = nullptr, VEC<double>* penergy = nullptr)
 	{
+		if (single_precision) return Convolute_SP(In1, &In2, Out1, &Out2, clearOut, pH, penergy);
+
 		if (n.z == 1) return Convolute_2D(In1, In2, Out1, Out2, clearOut, pH, penergy);
 		else return Convolute_3D(In1, In2, Out1, Out2, clearOut, pH, penergy);
 	}
@@ -240,11 +247,11 @@ protected:
 //-------------------------- CONFIGURATION
 
 template <typename Owner, typename Kernel>
-BError Convolution<Owner, Kernel>::SetDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_, INT3 pbc_images_)
+BError Convolution<Owner, Kernel>::SetDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_, INT3 pbc_images_, bool single_precision_)
 {
 	BError error(__FUNCTION__);
 
-	error = SetConvolutionDimensions(n_, h_, embed_multiplication_, pbc_images_);
+	error = SetConvolutionDimensions(n_, h_, embed_multiplication_, pbc_images_, single_precision_);
 	if (!error) error = static_cast<Owner*>(this)->AllocateKernelMemory();
 
 	return error;
@@ -273,7 +280,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
 		//write line to fft array
 		for (int i = 0; i < N.x / 2 + 1; i++) {
@@ -295,13 +302,13 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
+		fftw_execute_dft(plan_fwd_y, pline_zp_y[tn], pline[tn]);
 
 		//3. kernel multiplication on line
 		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3*>(pline[tn]), i);
 
 		//4. ifft on line
-		fftw_execute(plan_inv_y[tn]);
+		fftw_execute_dft(plan_inv_y, pline[tn], pline[tn]);
 
 		//write line to fft array, truncating upper part (from n.y to N.y if different)
 		for (int j = 0; j < n.y; j++) {
@@ -327,7 +334,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//write line to output
 			for (int i = 0; i < n.x; i++) {
@@ -360,7 +367,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 
 			//add line to output
@@ -404,7 +411,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
 		//write line to fft array
 		for (int i = 0; i < N.x / 2 + 1; i++) {
@@ -426,13 +433,13 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
+		fftw_execute_dft(plan_fwd_y, pline_zp_y[tn], pline[tn]);
 
 		//3. kernel multiplication on line
 		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3*>(pline[tn]), i);
 
 		//4. ifft on line
-		fftw_execute(plan_inv_y[tn]);
+		fftw_execute_dft(plan_inv_y, pline[tn], pline[tn]);
 
 		//write line to fft array, truncating upper part (from n.y to N.y if different)
 		for (int j = 0; j < n.y; j++) {
@@ -458,7 +465,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//write line to output
 			for (int i = 0; i < n.x; i++) {
@@ -491,7 +498,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 
 			//add line to output
@@ -535,7 +542,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
 		//write line to fft array
 		for (int i = 0; i < N.x / 2 + 1; i++) {
@@ -557,13 +564,13 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
+		fftw_execute_dft(plan_fwd_y, pline_zp_y[tn], pline[tn]);
 
 		//3. kernel multiplication on line
 		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3*>(pline[tn]), i);
 
 		//4. ifft on line
-		fftw_execute(plan_inv_y[tn]);
+		fftw_execute_dft(plan_inv_y, pline[tn], pline[tn]);
 
 		//write line to fft array, truncating upper part (from n.y to N.y if different)
 		for (int j = 0; j < n.y; j++) {
@@ -589,7 +596,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//write line to output
 			for (int i = 0; i < n.x; i++) {
@@ -623,7 +630,7 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 
 			//add line to output
@@ -656,55 +663,35 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 	//3D
 
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
+	for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int idx_in = i + j * n.x + k * n.x * n.y;
+		int j = jk % n.y;
+		int k = jk / n.y;
 
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-			}
+		int tn = omp_get_thread_num();
 
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+		//write input into fft line (zero padding kept)
+		for (int i = 0; i < n.x; i++) {
 
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+			int idx_in = i + j * n.x + k * n.x * n.y;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
+			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
 		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
 
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+		//fft on line
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+		//write line to fft array
+		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 		}
 	}
 
+	//2. FFTs along y
+	ForwardFFT_y_Tiled(F);
+
 	//3. FFTs along z
 #pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
@@ -719,13 +706,13 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+			fftw_execute_dft(plan_fwd_z, pline_zp_z[tn], pline[tn]);
 
 			//4. kernel multiplication on line
 			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
 
 			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftw_execute_dft(plan_inv_z, pline[tn], pline[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
@@ -736,98 +723,79 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, b
 	}
 
 	//6. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	InverseFFT_y_Tiled(F);
 
 	double dot_product = 0;
 
 	if (clearOut) {
 
 		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+			//write line to output
+			for (int i = 0; i < n.x; i++) {
 
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
 
-					dot_product += In_val * Out_val;
+				Out[i + j * n.x + k * n.x * n.y] = Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				dot_product += In_val * Out_val;
+
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
 	else {
 
 		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+			//add line to output
+			for (int i = 0; i < n.x; i++) {
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
 
-					dot_product += In_val * Out_val;
+				Out[i + j * n.x + k * n.x * n.y] += Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				dot_product += In_val * Out_val;
+
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
@@ -840,55 +808,35 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
 {
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
+	for (int jk = 0; jk < n.y * n.z; jk++) {
 
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
+		int j = jk % n.y;
+		int k = jk / n.y;
 
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-			}
+		int tn = omp_get_thread_num();
 
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+		//write input into fft line (zero padding kept)
+		for (int i = 0; i < n.x; i++) {
 
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+			int idx_in = i + j * n.x + k * n.x * n.y;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
+			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
 		}
-	}
 
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+		//fft on line
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+		//write line to fft array
+		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 		}
 	}
 
+	//2. FFTs along y
+	ForwardFFT_y_Tiled(F);
+
 	//3. FFTs along z
 #pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
@@ -903,13 +851,13 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+			fftw_execute_dft(plan_fwd_z, pline_zp_z[tn], pline[tn]);
 
 			//4. kernel multiplication on line
 			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
 
 			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftw_execute_dft(plan_inv_z, pline[tn], pline[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
@@ -920,98 +868,79 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	}
 
 	//6. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	InverseFFT_y_Tiled(F);
 
 	double dot_product = 0;
 
 	if (clearOut) {
 
 		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+			//write line to output
+			for (int i = 0; i < n.x; i++) {
 
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					dot_product += In_val * Out_val;
+				Out[i + j * n.x + k * n.x * n.y] = Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				dot_product += In_val * Out_val;
+
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
 	else {
 
 		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+			//add line to output
+			for (int i = 0; i < n.x; i++) {
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					dot_product += In_val * Out_val;
+				Out[i + j * n.x + k * n.x * n.y] += Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				dot_product += In_val * Out_val;
+
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
@@ -1024,55 +953,35 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
 {
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
+	for (int jk = 0; jk < n.y * n.z; jk++) {
 
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
+		int j = jk % n.y;
+		int k = jk / n.y;
 
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-			}
+		int tn = omp_get_thread_num();
 
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+		//write input into fft line (zero padding kept)
+		for (int i = 0; i < n.x; i++) {
 
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+			int idx_in = i + j * n.x + k * n.x * n.y;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
+			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
 		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
 
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+		//fft on line
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+		//write line to fft array
+		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 		}
 	}
 
+	//2. FFTs along y
+	ForwardFFT_y_Tiled(F);
+
 	//3. FFTs along z
 #pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
@@ -1087,13 +996,13 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+			fftw_execute_dft(plan_fwd_z, pline_zp_z[tn], pline[tn]);
 
 			//4. kernel multiplication on line
 			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
 
 			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftw_execute_dft(plan_inv_z, pline[tn], pline[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
@@ -1104,100 +1013,81 @@ double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	}
 
 	//6. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	InverseFFT_y_Tiled(F);
 
 	double dot_product = 0;
 
 	if (clearOut) {
 
 		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+			//write line to output
+			for (int i = 0; i < n.x; i++) {
 
-					Out1[i + j * n.x + k * n.x * n.y] = Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] = Out_val;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+
+				Out1[i + j * n.x + k * n.x * n.y] = Out_val;
+				Out2[i + j * n.x + k * n.x * n.y] = Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
 	else {
 
 		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
+
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+			//add line to output
+			for (int i = 0; i < n.x; i++) {
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					Out1[i + j * n.x + k * n.x * n.y] += Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] += Out_val;
+				Out1[i + j * n.x + k * n.x * n.y] += Out_val;
+				Out2[i + j * n.x + k * n.x * n.y] += Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
@@ -1230,7 +1120,7 @@ void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In)
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
 		//write line to fft array
 		for (int i = 0; i < N.x / 2 + 1; i++) {
@@ -1240,26 +1130,7 @@ void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In)
 	}
 
 	//2. FFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array (zero padding kept)
-		for (int j = 0; j < n.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
-
-		//write line to fft array
-		for (int j = 0; j < N.y; j++) {
-
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
+	ForwardFFT_y_Tiled(F);
 }
 
 //SINGLE OUTPUT
@@ -1269,26 +1140,7 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
 {
 	//1. IFFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array
-		for (int j = 0; j < N.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_inv_y[tn]);
-
-		//write line to fft array, truncating upper half
-		for (int j = 0; j < n.y; j++) {
-
-			F2[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
+	InverseFFT_y_Tiled(F2);
 
 	double dot_product = 0;
 
@@ -1307,7 +1159,7 @@ double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In, VEC<DBL3> &Out,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//write line to output
 			for (int i = 0; i < n.x; i++) {
@@ -1340,7 +1192,7 @@ double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In, VEC<DBL3> &Out,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//add line to output
 			for (int i = 0; i < n.x; i++) {
@@ -1385,7 +1237,7 @@ void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2)
 		}
 
 		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
 		//write line to fft array
 		for (int i = 0; i < N.x / 2 + 1; i++) {
@@ -1395,26 +1247,7 @@ void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2)
 	}
 
 	//2. FFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array (zero padding kept)
-		for (int j = 0; j < n.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
-
-		//write line to fft array
-		for (int j = 0; j < N.y; j++) {
-
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
+	ForwardFFT_y_Tiled(F);
 }
 
 //AVERAGED INPUTS, SINGLE OUTPUT
@@ -1424,26 +1257,7 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
 {
 	//1. IFFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array
-		for (int j = 0; j < N.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_inv_y[tn]);
-
-		//write line to fft array, truncating upper half
-		for (int j = 0; j < n.y; j++) {
-
-			F2[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
+	InverseFFT_y_Tiled(F2);
 
 	double dot_product = 0;
 
@@ -1462,7 +1276,7 @@ double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//write line to output
 			for (int i = 0; i < n.x; i++) {
@@ -1495,7 +1309,7 @@ double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//add line to output
 			for (int i = 0; i < n.x; i++) {
@@ -1524,26 +1338,7 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
 {
 	//1. IFFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array
-		for (int j = 0; j < N.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_inv_y[tn]);
-
-		//write line to fft array, truncating upper half
-		for (int j = 0; j < n.y; j++) {
-
-			F2[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
+	InverseFFT_y_Tiled(F2);
 
 	double dot_product = 0;
 
@@ -1562,7 +1357,7 @@ double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//write line to output
 			for (int i = 0; i < n.x; i++) {
@@ -1596,7 +1391,7 @@ double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
 			//add line to output
 			for (int i = 0; i < n.x; i++) {
@@ -1628,55 +1423,35 @@ template <typename Owner, typename Kernel>
 void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In)
 {
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
+	for (int jk = 0; jk < n.y * n.z; jk++) {
 
-			int tn = omp_get_thread_num();
+		int j = jk % n.y;
+		int k = jk / n.y;
 
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
+		int tn = omp_get_thread_num();
 
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-			}
+		//write input into fft line (zero padding kept)
+		for (int i = 0; i < n.x; i++) {
 
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+			int idx_in = i + j * n.x + k * n.x * n.y;
 
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
+			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
 		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
 
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+		//fft on line
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+		//write line to fft array
+		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 		}
 	}
 
+	//2. FFTs along y
+	ForwardFFT_y_Tiled(F);
+
 	//3. FFTs along z
 #pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
@@ -1691,7 +1466,7 @@ void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In)
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+			fftw_execute_dft(plan_fwd_z, pline_zp_z[tn], pline[tn]);
 
 			//write line to fft array
 			for (int k = 0; k < N.z; k++) {
@@ -1722,7 +1497,7 @@ double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In, VEC<DBL3> &Out,
 			}
 
 			//ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftw_execute_dft(plan_inv_z, pline[tn], pline[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
@@ -1733,98 +1508,79 @@ double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In, VEC<DBL3> &Out,
 	}
 
 	//2. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	InverseFFT_y_Tiled(F2);
 
 	double dot_product = 0;
 
 	if (clearOut) {
 
 		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
+
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+			//write line to output
+			for (int i = 0; i < n.x; i++) {
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
 
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+				Out[i + j * n.x + k * n.x * n.y] = Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
 	else {
 
 		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
+
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+			//add line to output
+			for (int i = 0; i < n.x; i++) {
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+				Out[i + j * n.x + k * n.x * n.y] += Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
@@ -1839,55 +1595,35 @@ template <typename Owner, typename Kernel>
 void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2)
 {
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
+	for (int jk = 0; jk < n.y * n.z; jk++) {
 
-			int tn = omp_get_thread_num();
+		int j = jk % n.y;
+		int k = jk / n.y;
 
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-			}
+		int tn = omp_get_thread_num();
 
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+		//write input into fft line (zero padding kept)
+		for (int i = 0; i < n.x; i++) {
 
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+			int idx_in = i + j * n.x + k * n.x * n.y;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
+			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
 		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
 
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+		//fft on line
+		fftw_execute_dft_r2c(plan_fwd_x, pline_zp_x[tn], pline[tn]);
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+		//write line to fft array
+		for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
 		}
 	}
 
+	//2. FFTs along y
+	ForwardFFT_y_Tiled(F);
+
 	//3. FFTs along z
 #pragma omp parallel for
 	for (int j = 0; j < N.y; j++) {
@@ -1902,7 +1638,7 @@ void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2)
 			}
 
 			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+			fftw_execute_dft(plan_fwd_z, pline_zp_z[tn], pline[tn]);
 
 			//write line to fft array
 			for (int k = 0; k < N.z; k++) {
@@ -1933,7 +1669,7 @@ double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftw_execute_dft(plan_inv_z, pline[tn], pline[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
@@ -1944,98 +1680,79 @@ double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	}
 
 	//2. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	InverseFFT_y_Tiled(F2);
 
 	double dot_product = 0;
 
 	if (clearOut) {
 
 		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
+
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				int tn = omp_get_thread_num();
+			int tn = omp_get_thread_num();
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+			//write line to output
+			for (int i = 0; i < n.x; i++) {
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+				Out[i + j * n.x + k * n.x * n.y] = Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
 	else {
 
 		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
+
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+			//add line to output
+			for (int i = 0; i < n.x; i++) {
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+				Out[i + j * n.x + k * n.x * n.y] += Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
@@ -2063,7 +1780,7 @@ double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 			}
 
 			//ifft on line
-			fftw_execute(plan_inv_z[tn]);
+			fftw_execute_dft(plan_inv_z, pline[tn], pline[tn]);
 
 			//write line to fft array, truncating upper half
 			for (int k = 0; k < n.z; k++) {
@@ -2074,100 +1791,81 @@ double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	}
 
 	//2. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	InverseFFT_y_Tiled(F2);
 
 	double dot_product = 0;
 
 	if (clearOut) {
 
 		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+			//write line to output
+			for (int i = 0; i < n.x; i++) {
 
-					Out1[i + j * n.x + k * n.x * n.y] = Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] = Out_val;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					dot_product += In_val * Out_val;
+				Out1[i + j * n.x + k * n.x * n.y] = Out_val;
+				Out2[i + j * n.x + k * n.x * n.y] = Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				dot_product += In_val * Out_val;
+
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
 	else {
 
 		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
 #pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		for (int jk = 0; jk < n.y * n.z; jk++) {
 
-				int tn = omp_get_thread_num();
+			int j = jk % n.y;
+			int k = jk / n.y;
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+			int tn = omp_get_thread_num();
+
+			//write input into fft line
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+			//fft on line
+			fftw_execute_dft_c2r(plan_inv_x, pline[tn], pline_rev_x[tn]);
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+			//add line to output
+			for (int i = 0; i < n.x; i++) {
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
+				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
+				DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
 
-					Out1[i + j * n.x + k * n.x * n.y] += Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] += Out_val;
+				Out1[i + j * n.x + k * n.x * n.y] += Out_val;
+				Out2[i + j * n.x + k * n.x * n.y] += Out_val;
 
-					dot_product += In_val * Out_val;
+				dot_product += In_val * Out_val;
 
-					//capture output effective field and energy with spatial resolution if required
-					if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
-					if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
-				}
+				//capture output effective field and energy with spatial resolution if required
+				if (pH) (*pH)[i + j * n.x + k * n.x * n.y] = Out_val;
+				if (penergy) (*penergy)[i + j * n.x + k * n.x * n.y] = -MU0 * (In_val * Out_val) / 2;
 			}
 		}
 	}
@@ -7,24 +7,24 @@ ConvolutionData::ConvolutionData(void)
 {
 	OmpThreads = omp_get_num_procs();
 	
-	plan_fwd_x.resize(OmpThreads);
-	plan_fwd_y.resize(OmpThreads);
-	plan_fwd_z.resize(OmpThreads);
-	plan_inv_x.resize(OmpThreads);
-	plan_inv_y.resize(OmpThreads);
-	plan_inv_z.resize(OmpThreads);
-	
 	pline_zp_x.resize(OmpThreads);
 	pline_zp_y.resize(OmpThreads);
 	pline_zp_z.resize(OmpThreads);
 	pline.resize(OmpThreads);
 	pline_rev_x.resize(OmpThreads);
+
+	pline_zp_x_sp.resize(OmpThreads);
+	pline_rev_x_sp.resize(OmpThreads);
+	pline_zp_y_sp.resize(OmpThreads);
+	pline_zp_z_sp.resize(OmpThreads);
+	pline_sp.resize(OmpThreads);
 }
 
 ConvolutionData::~ConvolutionData()
 {
 	//clean
 	free_memory();
+	free_memory_sp();
 }
 
 //-------------------------- HELPERS
@@ -34,14 +34,14 @@ void ConvolutionData::free_memory(void)
 	if (fftw_plans_created) {
 
 		//clean
-		for (int idx = 0; idx < OmpThreads; idx++) {
+		fftw_destroy_plan(plan_fwd_x);
+		fftw_destroy_plan(plan_fwd_y);
+		fftw_destroy_plan(plan_fwd_z);
+		fftw_destroy_plan(plan_inv_x);
+		fftw_destroy_plan(plan_inv_y);
+		fftw_destroy_plan(plan_inv_z);
 
-			fftw_destroy_plan(plan_fwd_x[idx]);
-			fftw_destroy_plan(plan_fwd_y[idx]);
-			fftw_destroy_plan(plan_fwd_z[idx]);
-			fftw_destroy_plan(plan_inv_x[idx]);
-			fftw_destroy_plan(plan_inv_y[idx]);
-			fftw_destroy_plan(plan_inv_z[idx]);
+		for (int idx = 0; idx < OmpThreads; idx++) {
 
 			fftw_free((double*)pline_zp_x[idx]);
 			fftw_free((fftw_complex*)pline_zp_y[idx]);
@@ -49,11 +49,72 @@ void ConvolutionData::free_memory(void)
 			fftw_free((fftw_complex*)pline[idx]);
 			fftw_free((double*)pline_rev_x[idx]);
 		}
+
+		destroy_tiled_plans();
 	}
 
 	fftw_plans_created = false;
 }
 
+//make the tiled y-direction fft plans on F (F must be allocated)
+void ConvolutionData::make_tiled_plans(void)
+{
+	destroy_tiled_plans();
+
+	//for 2D with embedded multiplication F only has n.y rows, and the y-direction ffts are done on lines together with the kernel multiplication
+	if (F.n.y != N.y) return;
+
+	int num_cols = N.x / 2 + 1;
+
+	fft_num_tiles = (num_cols + fft_tile_cols - 1) / fft_tile_cols;
+	int rem_cols = num_cols - (fft_num_tiles - 1) * fft_tile_cols;
+
+	int dims_y[1] = { (int)N.y };
+
+	//each tile is a batch of (tile columns) * 3 transforms, consecutive in memory, with stride of a full row along y.
+	//F and F2 need not have the same alignment, neither do the tiles, so plan as unaligned.
+	fftw_complex* pF = reinterpret_cast<fftw_complex*>(F.data());
+
+	plan_fwd_y_tile = fftw_plan_many_dft(1, dims_y, fft_tile_cols * 3,
+		pF, nullptr, num_cols * 3, 1,
+		pF, nullptr, num_cols * 3, 1,
+		FFTW_FORWARD, FFTWPlanner::rigor() | FFTW_UNALIGNED);
+
+	plan_inv_y_tile = fftw_plan_many_dft(1, dims_y, fft_tile_cols * 3,
+		pF, nullptr, num_cols * 3, 1,
+		pF, nullptr, num_cols * 3, 1,
+		FFTW_BACKWARD, FFTWPlanner::rigor() | FFTW_UNALIGNED);
+
+	if (rem_cols != fft_tile_cols) {
+
+		plan_fwd_y_tile_rem = fftw_plan_many_dft(1, dims_y, rem_cols * 3,
+			pF, nullptr, num_cols * 3, 1,
+			pF, nullptr, num_cols * 3, 1,
+			FFTW_FORWARD, FFTWPlanner::rigor() | FFTW_UNALIGNED);
+
+		plan_inv_y_tile_rem = fftw_plan_many_dft(1, dims_y, rem_cols * 3,
+			pF, nullptr, num_cols * 3, 1,
+			pF, nullptr, num_cols * 3, 1,
+			FFTW_BACKWARD, FFTWPlanner::rigor() | FFTW_UNALIGNED);
+	}
+}
+
+//free the tiled y-direction fft plans
+void ConvolutionData::destroy_tiled_plans(void)
+{
+	if (plan_fwd_y_tile) fftw_destroy_plan(plan_fwd_y_tile);
+	if (plan_inv_y_tile) fftw_destroy_plan(plan_inv_y_tile);
+	if (plan_fwd_y_tile_rem) fftw_destroy_plan(plan_fwd_y_tile_rem);
+	if (plan_inv_y_tile_rem) fftw_destroy_plan(plan_inv_y_tile_rem);
+
+	plan_fwd_y_tile = nullptr;
+	plan_inv_y_tile = nullptr;
+	plan_fwd_y_tile_rem = nullptr;
+	plan_inv_y_tile_rem = nullptr;
+
+	fft_num_tiles = 0;
+}
+
 //Allocate memory for F and F2 (if needed) scratch spaces)
 BError ConvolutionData::AllocateScratchSpaces(void)
 {
@@ -97,7 +158,7 @@ BError ConvolutionData::AllocateScratchSpaces(void)
 
 //-------------------------- CONFIGURATION
 
-BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_, INT3 pbc_images)
+BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_, INT3 pbc_images, bool single_precision_)
 {
 	BError error(__FUNCTION__);
 
@@ -167,49 +228,63 @@ BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_mul
 		pline[idx] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
 	}
 
-	//zero fft lines
-	zero_fft_lines();
-
 	//make fft plans
 	int dims_x[1] = { (int)N.x };
 	int dims_y[1] = { (int)N.y };
 	int dims_z[1] = { (int)N.z };
 
-	for (int idx = 0; idx < OmpThreads; idx++) {
+	//plans made on the lines of the first thread, then executed by all threads on their own lines
+	plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
+		pline_zp_x[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTWPlanner::rigor());
+
+	plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
+		pline_zp_y[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, FFTWPlanner::rigor());
+
+	plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
+		pline_zp_z[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_FORWARD, FFTWPlanner::rigor());
+
+	plan_inv_z = fftw_plan_many_dft(1, dims_z, 3,
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_BACKWARD, FFTWPlanner::rigor());
+
+	plan_inv_y = fftw_plan_many_dft(1, dims_y, 3,
+		pline[0], nullptr, 3, 1,
+		pline[0], nullptr, 3, 1,
+		FFTW_BACKWARD, FFTWPlanner::rigor());
+
+	plan_inv_x = fftw_plan_many_dft_c2r(1, dims_x, 3,
+		pline[0], nullptr, 3, 1,
+		pline_rev_x[0], nullptr, 3, 1,
+		FFTWPlanner::rigor());
+
+	//planning can overwrite the lines, and zero padding is expected in the forward lines
+	zero_fft_lines();
 
-		plan_fwd_x[idx] = fftw_plan_many_dft_r2c(1, dims_x, 3,
-			pline_zp_x[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_PATIENT);
-
-		plan_fwd_y[idx] = fftw_plan_many_dft(1, dims_y, 3,
-			pline_zp_y[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_FORWARD, FFTW_PATIENT);
-
-		plan_fwd_z[idx] = fftw_plan_many_dft(1, dims_z, 3,
-			pline_zp_z[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_FORWARD, FFTW_PATIENT);
-
-		plan_inv_z[idx] = fftw_plan_many_dft(1, dims_z, 3,
-			pline[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_BACKWARD, FFTW_PATIENT);
-
-		plan_inv_y[idx] = fftw_plan_many_dft(1, dims_y, 3,
-			pline[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_BACKWARD, FFTW_PATIENT);
-
-		plan_inv_x[idx] = fftw_plan_many_dft_c2r(1, dims_x, 3,
-			pline[idx], nullptr, 3, 1,
-			pline_rev_x[idx], nullptr, 3, 1,
-			FFTW_PATIENT);
-	}
+	//batched y-direction plans (planning overwrites F, but it holds no data yet)
+	make_tiled_plans();
 	
 	fftw_plans_created = true;
 
+	//mixed precision : F_sp used instead of F, which is not needed
+	free_memory_sp();
+
+	single_precision = (single_precision_ && embed_multiplication);
+
+	if (single_precision) {
+
+		destroy_tiled_plans();
+		F.clear();
+
+		error = AllocateSinglePrecision();
+	}
+
 	return error;
 }
 
@@ -242,3 +317,55 @@ void ConvolutionData::zero_fft_lines(void)
 }
 
 //-------------------------- RUN-TIME METHODS
+
+//y-direction ffts on all n.z planes of scratch space S (F or F2, must have N.y rows), done in-place in tiles of x columns.
+//Forward : zero padding from n.y up to N.y is set in each tile before the fft.
+void ConvolutionData::ForwardFFT_y_Tiled(VEC<ReIm3>& S)
+{
+	int num_cols = N.x / 2 + 1;
+
+	//single parallel region over all tiles in all planes
+#pragma omp parallel for
+	for (int tk = 0; tk < fft_num_tiles * n.z; tk++) {
+
+		int t = tk % fft_num_tiles;
+		int k = tk / fft_num_tiles;
+
+		int i_start = t * fft_tile_cols;
+		int i_end = (i_start + fft_tile_cols < num_cols ? i_start + fft_tile_cols : num_cols);
+
+		ReIm3* pTile = S.data() + i_start + k * num_cols * N.y;
+
+		//zero padding
+		for (int j = n.y; j < N.y; j++) {
+			for (int i = 0; i < i_end - i_start; i++) {
+
+				pTile[i + j * num_cols] = ReIm3();
+			}
+		}
+
+		fftw_plan plan = (i_end - i_start == fft_tile_cols ? plan_fwd_y_tile : plan_fwd_y_tile_rem);
+		fftw_execute_dft(plan, reinterpret_cast<fftw_complex*>(pTile), reinterpret_cast<fftw_complex*>(pTile));
+	}
+}
+
+//Inverse : upper part (from n.y up to N.y) is left in S and simply not read afterwards.
+void ConvolutionData::InverseFFT_y_Tiled(VEC<ReIm3>& S)
+{
+	int num_cols = N.x / 2 + 1;
+
+#pragma omp parallel for
+	for (int tk = 0; tk < fft_num_tiles * n.z; tk++) {
+
+		int t = tk % fft_num_tiles;
+		int k = tk / fft_num_tiles;
+
+		int i_start = t * fft_tile_cols;
+		int i_end = (i_start + fft_tile_cols < num_cols ? i_start + fft_tile_cols : num_cols);
+
+		ReIm3* pTile = S.data() + i_start + k * num_cols * N.y;
+
+		fftw_plan plan = (i_end - i_start == fft_tile_cols ? plan_inv_y_tile : plan_inv_y_tile_rem);
+		fftw_execute_dft(plan, reinterpret_cast<fftw_complex*>(pTile), reinterpret_cast<fftw_complex*>(pTile));
+	}
+}
@@ -5,8 +5,10 @@
 #include "ErrorHandler.h"
 
 #include "fftw3.h"
+#include "FFTWPlanner.h"
 
 #pragma comment(lib, "libfftw3-3.lib")
+#pragma comment(lib, "libfftw3f-3.lib")
 
 class ConvolutionData
 {
@@ -41,8 +43,10 @@ protected:
 	//additional scratch space used when embed_multiplication == false
 	VEC<ReIm3> F2;
 
-	std::vector<fftw_plan> plan_fwd_x, plan_fwd_y, plan_fwd_z;
-	std::vector<fftw_plan> plan_inv_x, plan_inv_y, plan_inv_z;
+	//one plan per line shape, shared by all threads : each thread executes it on its own lines with the new-array execute functions (fftw_execute_dft etc.)
+	//all lines are allocated with fftw_alloc so have the same alignment as the lines used for planning
+	fftw_plan plan_fwd_x, plan_fwd_y, plan_fwd_z;
+	fftw_plan plan_inv_x, plan_inv_y, plan_inv_z;
 
 	//forward fft lines with constant zero padding
 	std::vector<double*> pline_zp_x;
@@ -53,6 +57,16 @@ protected:
 
 	//ifft line for real output, to be truncated
 	std::vector<double*> pline_rev_x;
+
+	//y-direction ffts are batched : a plan covers a tile of fft_tile_cols consecutive x columns (all 3 components), executed in-place on F or F2 with fftw_execute_dft.
+	//Only used where the scratch space holds N.y rows (3D, or 2D without embedded multiplication).
+	fftw_plan plan_fwd_y_tile = nullptr, plan_inv_y_tile = nullptr;
+
+	//plans for the last tile if (N.x / 2 + 1) is not divisible by fft_tile_cols
+	fftw_plan plan_fwd_y_tile_rem = nullptr, plan_inv_y_tile_rem = nullptr;
+
+	//number of x columns in a tile, and number of tiles (including last tile) along x
+	int fft_tile_cols = 8, fft_num_tiles = 0;
 	
 	//the flow is:
 	//input -> pline_zp_x -fft-> pline -> F
@@ -61,9 +75,35 @@ protected:
 	//
 	//F -> pline -ifft-> pline -> F
 	//F -> pline -ifft-> pline_rev_x -> output
+	//
+	//where the y-direction fft is not embedded with the kernel multiplication it is done in-place on F (F2) in tiles, without line copies.
 
 	bool fftw_plans_created = false;
 
+	//-------------------------- MIXED PRECISION
+
+	//Mixed precision convolution (embedded multiplication only) : ffts, scratch space and kernels in single precision, with input read from and output added to double precision VECs.
+	//The convolution is memory bandwidth bound for large meshes, so halving the size of the data it works on makes it faster, at the cost of single precision accuracy in the convolution output.
+	//Only available for kernels which set single precision kernel copies (Set_Kernels_SP).
+	bool single_precision = false;
+
+	//single precision scratch space, used instead of F : (N.x/2 + 1) * N.y * n.z for 3D and (N.x/2 + 1) * n.y * 1 for 2D
+	VEC<ReIm3F> F_sp;
+
+	//single precision plans and lines, same as the double precision ones above.
+	//y-direction ffts are not tiled here, but done on lines as for the z direction.
+	fftwf_plan plan_fwd_x_sp, plan_fwd_y_sp, plan_fwd_z_sp;
+	fftwf_plan plan_inv_x_sp, plan_inv_y_sp, plan_inv_z_sp;
+
+	std::vector<float*> pline_zp_x_sp, pline_rev_x_sp;
+	std::vector<fftwf_complex*> pline_zp_y_sp, pline_zp_z_sp, pline_sp;
+
+	//single precision copies of kernels with demag tensor symmetries (Kdiag : Kx, Ky, Kz; Kodiag : Kxy, Kxz, Kyz, real parts only; K2D_odiag : Kxy for 2D)
+	VEC<FLT3> Kdiag_sp, Kodiag_sp;
+	std::vector<float> K2D_odiag_sp;
+
+	bool fftwf_plans_created = false;
+
 private:
 
 	//-------------------------- HELPERS
@@ -74,6 +114,22 @@ private:
 	//Allocate memory for F and F2 (if needed) scratch spaces)
 	BError AllocateScratchSpaces(void);
 
+	//make the tiled y-direction fft plans on F (F must be allocated)
+	void make_tiled_plans(void);
+
+	//free the tiled y-direction fft plans
+	void destroy_tiled_plans(void);
+
+	//free memory allocated for single precision fftw, and single precision scratch space and kernels
+	void free_memory_sp(void);
+
+	//allocate single precision scratch space, lines and plans (dimensions must be set)
+	BError AllocateSinglePrecision(void);
+
+	//kernel multiplications for a single line using single precision kernels, same as for DemagKernel
+	void KernelMultiplication_2D_line_sp(ReIm3F* pline, int i);
+	void KernelMultiplication_3D_line_sp(ReIm3F* pline, int i, int j);
+
 protected:
 
 	//-------------------------- CONSTRUCTORS
@@ -84,11 +140,15 @@ protected:
 
 	//-------------------------- CONFIGURATION
 
-	BError SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_ = true, INT3 pbc_images = INT3());
+	//single_precision_ only takes effect with embed_multiplication_, and must only be set for kernels which call Set_Kernels_SP
+	BError SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_multiplication_ = true, INT3 pbc_images = INT3(), bool single_precision_ = false);
 
 	//zero fftw memory
 	void zero_fft_lines(void);
 
+	//set single precision kernel copies from computed kernels (call after kernel calculation if single_precision) : 3D uses Kdiag and Kodiag, 2D uses Kdiag and K2D_odiag
+	BError Set_Kernels_SP(VEC<DBL3>& Kdiag, VEC<DBL3>& Kodiag, std::vector<double>& K2D_odiag);
+
 	//-------------------------- GETTERS
 
 	//Get pointer to the F scratch space
@@ -96,4 +156,14 @@ protected:
 
 	//-------------------------- RUN-TIME METHODS
 
+	//y-direction ffts on all n.z planes of scratch space S (F or F2, must have N.y rows), done in-place in tiles of x columns.
+	//Forward : zero padding from n.y up to N.y is set in each tile before the fft.
+	void ForwardFFT_y_Tiled(VEC<ReIm3>& S);
+
+	//Inverse : upper part (from n.y up to N.y) is left in S and simply not read afterwards.
+	void InverseFFT_y_Tiled(VEC<ReIm3>& S);
+
+	//mixed precision convolution with embedded multiplication (ConvolutionData_SP.cpp). Return dot product of input with output.
+	//Input is In1, or (In1 + In2) / 2 if pIn2 not null. Output is set (clearOut) or added to Out1, and also to Out2 if pOut2 not null.
+	double Convolute_SP(VEC<DBL3>& In1, VEC<DBL3>* pIn2, VEC<DBL3>& Out1, VEC<DBL3>* pOut2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy);
 };
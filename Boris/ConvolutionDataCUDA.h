@@ -8,6 +8,7 @@
 #include "ErrorHandler.h"
 
 #include "fftw3.h"
+#include "FFTWPlanner.h"
 
 #pragma comment(lib, "libfftw3-3.lib")
 
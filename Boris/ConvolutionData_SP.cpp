@@ -0,0 +1,456 @@
+#include "stdafx.h"
+#include "ConvolutionData.h"
+
+//-------------------------- MIXED PRECISION : CONFIGURATION
+
+//free memory allocated for single precision fftw, and single precision scratch space and kernels
+void ConvolutionData::free_memory_sp(void)
+{
+	if (fftwf_plans_created) {
+
+		fftwf_destroy_plan(plan_fwd_x_sp);
+		fftwf_destroy_plan(plan_fwd_y_sp);
+		fftwf_destroy_plan(plan_fwd_z_sp);
+		fftwf_destroy_plan(plan_inv_x_sp);
+		fftwf_destroy_plan(plan_inv_y_sp);
+		fftwf_destroy_plan(plan_inv_z_sp);
+
+		for (int idx = 0; idx < OmpThreads; idx++) {
+
+			fftwf_free(pline_zp_x_sp[idx]);
+			fftwf_free(pline_zp_y_sp[idx]);
+			fftwf_free(pline_zp_z_sp[idx]);
+			fftwf_free(pline_sp[idx]);
+			fftwf_free(pline_rev_x_sp[idx]);
+		}
+	}
+
+	fftwf_plans_created = false;
+
+	F_sp.clear();
+	Kdiag_sp.clear();
+	Kodiag_sp.clear();
+	K2D_odiag_sp.clear();
+	K2D_odiag_sp.shrink_to_fit();
+}
+
+//allocate single precision scratch space, lines and plans (dimensions must be set)
+BError ConvolutionData::AllocateSinglePrecision(void)
+{
+	BError error(__FUNCTION__);
+
+	//3D : upper y-axis points needed since y ffts are not embedded with the kernel multiplication. 2D : upper y-axis points not needed.
+	if (!F_sp.resize(SZ3(N.x / 2 + 1, (n.z > 1 ? N.y : n.y), n.z))) {
+
+		single_precision = false;
+		return error(BERROR_OUTOFMEMORY_CRIT);
+	}
+
+	for (int idx = 0; idx < OmpThreads; idx++) {
+
+		pline_zp_x_sp[idx] = fftwf_alloc_real(N.x * 3);
+		pline_rev_x_sp[idx] = fftwf_alloc_real(N.x * 3);
+
+		pline_zp_y_sp[idx] = fftwf_alloc_complex(N.y * 3);
+		pline_zp_z_sp[idx] = fftwf_alloc_complex(N.z * 3);
+
+		pline_sp[idx] = fftwf_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+	}
+
+	int dims_x[1] = { (int)N.x };
+	int dims_y[1] = { (int)N.y };
+	int dims_z[1] = { (int)N.z };
+
+	//same plans as for double precision
+	plan_fwd_x_sp = fftwf_plan_many_dft_r2c(1, dims_x, 3,
+		pline_zp_x_sp[0], nullptr, 3, 1,
+		pline_sp[0], nullptr, 3, 1,
+		FFTWPlanner::rigor());
+
+	plan_fwd_y_sp = fftwf_plan_many_dft(1, dims_y, 3,
+		pline_zp_y_sp[0], nullptr, 3, 1,
+		pline_sp[0], nullptr, 3, 1,
+		FFTW_FORWARD, FFTWPlanner::rigor());
+
+	plan_fwd_z_sp = fftwf_plan_many_dft(1, dims_z, 3,
+		pline_zp_z_sp[0], nullptr, 3, 1,
+		pline_sp[0], nullptr, 3, 1,
+		FFTW_FORWARD, FFTWPlanner::rigor());
+
+	plan_inv_z_sp = fftwf_plan_many_dft(1, dims_z, 3,
+		pline_sp[0], nullptr, 3, 1,
+		pline_sp[0], nullptr, 3, 1,
+		FFTW_BACKWARD, FFTWPlanner::rigor());
+
+	plan_inv_y_sp = fftwf_plan_many_dft(1, dims_y, 3,
+		pline_sp[0], nullptr, 3, 1,
+		pline_sp[0], nullptr, 3, 1,
+		FFTW_BACKWARD, FFTWPlanner::rigor());
+
+	plan_inv_x_sp = fftwf_plan_many_dft_c2r(1, dims_x, 3,
+		pline_sp[0], nullptr, 3, 1,
+		pline_rev_x_sp[0], nullptr, 3, 1,
+		FFTWPlanner::rigor());
+
+	fftwf_plans_created = true;
+
+	//planning can overwrite the lines, and zero padding is expected in the forward lines
+	for (int idx = 0; idx < OmpThreads; idx++) {
+
+		for (int i = 0; i < N.x * 3; i++) {
+
+			pline_zp_x_sp[idx][i] = 0.0f;
+			pline_rev_x_sp[idx][i] = 0.0f;
+		}
+
+		for (int j = 0; j < N.y; j++) *reinterpret_cast<ReIm3F*>(pline_zp_y_sp[idx] + j * 3) = ReIm3F();
+		for (int k = 0; k < N.z; k++) *reinterpret_cast<ReIm3F*>(pline_zp_z_sp[idx] + k * 3) = ReIm3F();
+		for (int i = 0; i < maximum(N.x / 2 + 1, N.y, N.z); i++) *reinterpret_cast<ReIm3F*>(pline_sp[idx] + i * 3) = ReIm3F();
+	}
+
+	return error;
+}
+
+//set single precision kernel copies from computed kernels (call after kernel calculation if single_precision) : 3D uses Kdiag and Kodiag, 2D uses Kdiag and K2D_odiag
+BError ConvolutionData::Set_Kernels_SP(VEC<DBL3>& Kdiag, VEC<DBL3>& Kodiag, std::vector<double>& K2D_odiag)
+{
+	BError error(__FUNCTION__);
+
+	if (!single_precision) return error;
+
+	if (!Kdiag_sp.resize(Kdiag.n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < Kdiag.linear_size(); idx++) Kdiag_sp[idx] = FLT3(Kdiag[idx].x, Kdiag[idx].y, Kdiag[idx].z);
+
+	if (n.z > 1) {
+
+		if (!Kodiag_sp.resize(Kodiag.n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+#pragma omp parallel for
+		for (int idx = 0; idx < Kodiag.linear_size(); idx++) Kodiag_sp[idx] = FLT3(Kodiag[idx].x, Kodiag[idx].y, Kodiag[idx].z);
+	}
+	else {
+
+		if (!malloc_vector(K2D_odiag_sp, K2D_odiag.size())) return error(BERROR_OUTOFMEMORY_CRIT);
+
+		for (int idx = 0; idx < K2D_odiag.size(); idx++) K2D_odiag_sp[idx] = (float)K2D_odiag[idx];
+	}
+
+	return error;
+}
+
+//-------------------------- MIXED PRECISION : KERNEL MULTIPLICATION
+
+//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
+void ConvolutionData::KernelMultiplication_2D_line_sp(ReIm3F* pline, int i)
+{
+	//above N.y/2 use kernel symmetries to recover kernel values
+	//diagonal components are even about the N.y/2 point
+	//off-diagonal values are odd about the N.y/2 point
+
+	//j = 0
+	ReIm3F FM = pline[0];
+
+	int idx_start = i;
+
+	pline[0].x = (Kdiag_sp[idx_start].x  * FM.x) + (K2D_odiag_sp[idx_start] * FM.y);
+	pline[0].y = (K2D_odiag_sp[idx_start] * FM.x) + (Kdiag_sp[idx_start].y  * FM.y);
+	pline[0].z = (Kdiag_sp[idx_start].z  * FM.z);
+
+	//points between 1 and N.y / 2 - 1 inclusive
+	for (int j = 1; j < N.y / 2; j++) {
+
+		ReIm3F FM_l = pline[j];
+		ReIm3F FM_h = pline[N.y - j];
+
+		int ker_index = i + j * (N.x / 2 + 1);
+
+		pline[j].x = (Kdiag_sp[ker_index].x  * FM_l.x) + (K2D_odiag_sp[ker_index] * FM_l.y);
+		pline[j].y = (K2D_odiag_sp[ker_index] * FM_l.x) + (Kdiag_sp[ker_index].y  * FM_l.y);
+		pline[j].z = (Kdiag_sp[ker_index].z  * FM_l.z);
+
+		pline[N.y - j].x = (Kdiag_sp[ker_index].x  * FM_h.x) + (-K2D_odiag_sp[ker_index] * FM_h.y);
+		pline[N.y - j].y = (-K2D_odiag_sp[ker_index] * FM_h.x) + (Kdiag_sp[ker_index].y  * FM_h.y);
+		pline[N.y - j].z = (Kdiag_sp[ker_index].z  * FM_h.z);
+	}
+
+	//j = N.y / 2
+	FM = pline[N.y / 2];
+
+	int idx_mid = i + (N.y / 2) * (N.x / 2 + 1);
+
+	pline[N.y / 2].x = (Kdiag_sp[idx_mid].x  * FM.x) + (K2D_odiag_sp[idx_mid] * FM.y);
+	pline[N.y / 2].y = (K2D_odiag_sp[idx_mid] * FM.x) + (Kdiag_sp[idx_mid].y  * FM.y);
+	pline[N.y / 2].z = (Kdiag_sp[idx_mid].z  * FM.z);
+}
+
+//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
+void ConvolutionData::KernelMultiplication_3D_line_sp(ReIm3F* pline, int i, int j)
+{
+	//above N.z/2 and N.y/2 use kernel symmetries to recover kernel values
+	//diagonal components are even about the N.z/2 and N.y/2 points
+	//Kxy is even about N.z/2 and odd about N.y/2
+	//Kxz is odd about N.z/2 and even about N.y/2
+	//Kyz is odd about N.z/2 and odd about N.y/2
+
+	if (j <= N.y / 2) {
+
+		//k = 0
+		ReIm3F FM = pline[0];
+
+		int idx_start = i + j * (N.x / 2 + 1);
+
+		pline[0].x = (Kdiag_sp[idx_start].x * FM.x) + (Kodiag_sp[idx_start].x * FM.y) + (Kodiag_sp[idx_start].y * FM.z);
+		pline[0].y = (Kodiag_sp[idx_start].x * FM.x) + (Kdiag_sp[idx_start].y * FM.y) + (Kodiag_sp[idx_start].z * FM.z);
+		pline[0].z = (Kodiag_sp[idx_start].y * FM.x) + (Kodiag_sp[idx_start].z * FM.y) + (Kdiag_sp[idx_start].z * FM.z);
+
+		//points between 1 and N.z /2 - 1 inclusive
+		for (int k = 1; k < N.z / 2; k++) {
+
+			ReIm3F FM_l = pline[k];
+			ReIm3F FM_h = pline[N.z - k];
+
+			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
+
+			pline[k].x = (Kdiag_sp[ker_index].x * FM_l.x) + (Kodiag_sp[ker_index].x * FM_l.y) + (Kodiag_sp[ker_index].y * FM_l.z);
+			pline[k].y = (Kodiag_sp[ker_index].x * FM_l.x) + (Kdiag_sp[ker_index].y * FM_l.y) + (Kodiag_sp[ker_index].z * FM_l.z);
+			pline[k].z = (Kodiag_sp[ker_index].y * FM_l.x) + (Kodiag_sp[ker_index].z * FM_l.y) + (Kdiag_sp[ker_index].z * FM_l.z);
+
+			pline[N.z - k].x = (Kdiag_sp[ker_index].x * FM_h.x) + (Kodiag_sp[ker_index].x * FM_h.y) + (-Kodiag_sp[ker_index].y * FM_h.z);
+			pline[N.z - k].y = (Kodiag_sp[ker_index].x * FM_h.x) + (Kdiag_sp[ker_index].y * FM_h.y) + (-Kodiag_sp[ker_index].z * FM_h.z);
+			pline[N.z - k].z = (-Kodiag_sp[ker_index].y * FM_h.x) + (-Kodiag_sp[ker_index].z * FM_h.y) + (Kdiag_sp[ker_index].z * FM_h.z);
+		}
+
+		//k = N.z / 2
+		FM = pline[N.z / 2];
+
+		int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
+
+		pline[N.z / 2].x = (Kdiag_sp[idx_mid].x * FM.x) + (Kodiag_sp[idx_mid].x * FM.y) + (Kodiag_sp[idx_mid].y * FM.z);
+		pline[N.z / 2].y = (Kodiag_sp[idx_mid].x * FM.x) + (Kdiag_sp[idx_mid].y * FM.y) + (Kodiag_sp[idx_mid].z * FM.z);
+		pline[N.z / 2].z = (Kodiag_sp[idx_mid].y * FM.x) + (Kodiag_sp[idx_mid].z * FM.y) + (Kdiag_sp[idx_mid].z * FM.z);
+	}
+	else {
+
+		//k = 0
+		ReIm3F FM = pline[0];
+
+		int idx_start = i + (N.y - j) * (N.x / 2 + 1);
+
+		pline[0].x = (Kdiag_sp[idx_start].x * FM.x) + (-Kodiag_sp[idx_start].x * FM.y) + (Kodiag_sp[idx_start].y * FM.z);
+		pline[0].y = (-Kodiag_sp[idx_start].x * FM.x) + (Kdiag_sp[idx_start].y * FM.y) + (-Kodiag_sp[idx_start].z * FM.z);
+		pline[0].z = (Kodiag_sp[idx_start].y * FM.x) + (-Kodiag_sp[idx_start].z * FM.y) + (Kdiag_sp[idx_start].z * FM.z);
+
+		//points between 1 and N.z /2 - 1 inclusive
+		for (int k = 1; k < N.z / 2; k++) {
+
+			ReIm3F FM_l = pline[k];
+			ReIm3F FM_h = pline[N.z - k];
+
+			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
+
+			pline[k].x = (Kdiag_sp[ker_index].x * FM_l.x) + (-Kodiag_sp[ker_index].x * FM_l.y) + (Kodiag_sp[ker_index].y * FM_l.z);
+			pline[k].y = (-Kodiag_sp[ker_index].x * FM_l.x) + (Kdiag_sp[ker_index].y * FM_l.y) + (-Kodiag_sp[ker_index].z * FM_l.z);
+			pline[k].z = (Kodiag_sp[ker_index].y * FM_l.x) + (-Kodiag_sp[ker_index].z * FM_l.y) + (Kdiag_sp[ker_index].z * FM_l.z);
+
+			pline[N.z - k].x = (Kdiag_sp[ker_index].x * FM_h.x) + (-Kodiag_sp[ker_index].x * FM_h.y) + (-Kodiag_sp[ker_index].y * FM_h.z);
+			pline[N.z - k].y = (-Kodiag_sp[ker_index].x * FM_h.x) + (Kdiag_sp[ker_index].y * FM_h.y) + (Kodiag_sp[ker_index].z * FM_h.z);
+			pline[N.z - k].z = (-Kodiag_sp[ker_index].y * FM_h.x) + (Kodiag_sp[ker_index].z * FM_h.y) + (Kdiag_sp[ker_index].z * FM_h.z);
+		}
+
+		//k = N.z / 2
+		FM = pline[N.z / 2];
+
+		int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
+
+		pline[N.z / 2].x = (Kdiag_sp[idx_mid].x * FM.x) + (-Kodiag_sp[idx_mid].x * FM.y) + (Kodiag_sp[idx_mid].y * FM.z);
+		pline[N.z / 2].y = (-Kodiag_sp[idx_mid].x * FM.x) + (Kdiag_sp[idx_mid].y * FM.y) + (-Kodiag_sp[idx_mid].z * FM.z);
+		pline[N.z / 2].z = (Kodiag_sp[idx_mid].y * FM.x) + (-Kodiag_sp[idx_mid].z * FM.y) + (Kdiag_sp[idx_mid].z * FM.z);
+	}
+}
+
+//-------------------------- MIXED PRECISION : RUN-TIME METHODS
+
+//mixed precision convolution with embedded multiplication. Return dot product of input with output.
+//Input is In1, or (In1 + In2) / 2 if pIn2 not null. Output is set (clearOut) or added to Out1, and also to Out2 if pOut2 not null.
+double ConvolutionData::Convolute_SP(VEC<DBL3>& In1, VEC<DBL3>* pIn2, VEC<DBL3>& Out1, VEC<DBL3>* pOut2, bool clearOut, VEC<DBL3>* pH, VEC<double>* penergy)
+{
+	int cols = N.x / 2 + 1;
+
+	//F_sp rows in each plane : N.y for 3D, n.y for 2D
+	int rows = F_sp.n.y;
+
+	//1. FFTs along x
+#pragma omp parallel for
+	for (int jk = 0; jk < n.y * n.z; jk++) {
+
+		int tn = omp_get_thread_num();
+
+		int j = jk % n.y;
+		int k = jk / n.y;
+
+		//write input into fft line (zero padding kept), converting to single precision
+		for (int i = 0; i < n.x; i++) {
+
+			int idx_in = i + jk * n.x;
+
+			DBL3 In_val = (pIn2 ? (In1[idx_in] + (*pIn2)[idx_in]) / 2 : In1[idx_in]);
+
+			*reinterpret_cast<FLT3*>(pline_zp_x_sp[tn] + i * 3) = FLT3(In_val.x, In_val.y, In_val.z);
+		}
+
+		fftwf_execute_dft_r2c(plan_fwd_x_sp, pline_zp_x_sp[tn], pline_sp[tn]);
+
+		for (int i = 0; i < cols; i++) {
+
+			F_sp[i + j * cols + k * cols * rows] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + i * 3);
+		}
+	}
+
+	if (n.z == 1) {
+
+		//2D : 2. FFTs along y, 3. kernel multiplication, 4. IFFTs along y
+#pragma omp parallel for
+		for (int i = 0; i < cols; i++) {
+
+			int tn = omp_get_thread_num();
+
+			for (int j = 0; j < n.y; j++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_zp_y_sp[tn] + j * 3) = F_sp[i + j * cols];
+			}
+
+			fftwf_execute_dft(plan_fwd_y_sp, pline_zp_y_sp[tn], pline_sp[tn]);
+
+			KernelMultiplication_2D_line_sp(reinterpret_cast<ReIm3F*>(pline_sp[tn]), i);
+
+			fftwf_execute_dft(plan_inv_y_sp, pline_sp[tn], pline_sp[tn]);
+
+			for (int j = 0; j < n.y; j++) {
+
+				F_sp[i + j * cols] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3);
+			}
+		}
+	}
+	else {
+
+		//3D : 2. FFTs along y
+#pragma omp parallel for
+		for (int ik = 0; ik < cols * n.z; ik++) {
+
+			int tn = omp_get_thread_num();
+
+			int i = ik % cols;
+			int k = ik / cols;
+
+			for (int j = 0; j < n.y; j++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_zp_y_sp[tn] + j * 3) = F_sp[i + j * cols + k * cols * N.y];
+			}
+
+			fftwf_execute_dft(plan_fwd_y_sp, pline_zp_y_sp[tn], pline_sp[tn]);
+
+			for (int j = 0; j < N.y; j++) {
+
+				F_sp[i + j * cols + k * cols * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3);
+			}
+		}
+
+		//3. FFTs along z, 4. kernel multiplication, 5. IFFTs along z
+#pragma omp parallel for
+		for (int ij = 0; ij < cols * N.y; ij++) {
+
+			int tn = omp_get_thread_num();
+
+			int i = ij % cols;
+			int j = ij / cols;
+
+			for (int k = 0; k < n.z; k++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_zp_z_sp[tn] + k * 3) = F_sp[ij + k * cols * N.y];
+			}
+
+			fftwf_execute_dft(plan_fwd_z_sp, pline_zp_z_sp[tn], pline_sp[tn]);
+
+			KernelMultiplication_3D_line_sp(reinterpret_cast<ReIm3F*>(pline_sp[tn]), i, j);
+
+			fftwf_execute_dft(plan_inv_z_sp, pline_sp[tn], pline_sp[tn]);
+
+			for (int k = 0; k < n.z; k++) {
+
+				F_sp[ij + k * cols * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + k * 3);
+			}
+		}
+
+		//6. IFFTs along y, truncating upper part
+#pragma omp parallel for
+		for (int ik = 0; ik < cols * n.z; ik++) {
+
+			int tn = omp_get_thread_num();
+
+			int i = ik % cols;
+			int k = ik / cols;
+
+			for (int j = 0; j < N.y; j++) {
+
+				*reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3) = F_sp[i + j * cols + k * cols * N.y];
+			}
+
+			fftwf_execute_dft(plan_inv_y_sp, pline_sp[tn], pline_sp[tn]);
+
+			for (int j = 0; j < n.y; j++) {
+
+				F_sp[i + j * cols + k * cols * N.y] = *reinterpret_cast<ReIm3F*>(pline_sp[tn] + j * 3);
+			}
+		}
+	}
+
+	double dot_product = 0;
+
+	//last step. IFFTs along x, with output converted back to double precision
+#pragma omp parallel for reduction(+:dot_product)
+	for (int jk = 0; jk < n.y * n.z; jk++) {
+
+		int tn = omp_get_thread_num();
+
+		int j = jk % n.y;
+		int k = jk / n.y;
+
+		for (int i = 0; i < cols; i++) {
+
+			*reinterpret_cast<ReIm3F*>(pline_sp[tn] + i * 3) = F_sp[i + j * cols + k * cols * rows];
+		}
+
+		fftwf_execute_dft_c2r(plan_inv_x_sp, pline_sp[tn], pline_rev_x_sp[tn]);
+
+		for (int i = 0; i < n.x; i++) {
+
+			int idx_out = i + jk * n.x;
+
+			FLT3 value = *reinterpret_cast<FLT3*>(pline_rev_x_sp[tn] + i * 3);
+
+			DBL3 Out_val = DBL3(value.x, value.y, value.z) / N.dim();
+			DBL3 In_val = (pIn2 ? (In1[idx_out] + (*pIn2)[idx_out]) / 2 : In1[idx_out]);
+
+			if (clearOut) {
+
+				Out1[idx_out] = Out_val;
+				if (pOut2) (*pOut2)[idx_out] = Out_val;
+			}
+			else {
+
+				Out1[idx_out] += Out_val;
+				if (pOut2) (*pOut2)[idx_out] += Out_val;
+			}
+
+			dot_product += In_val * Out_val;
+
+			//capture output effective field and energy with spatial resolution if required
+			if (pH) (*pH)[idx_out] = Out_val;
+			if (penergy) (*penergy)[idx_out] = -MU0 * (In_val * Out_val) / 2;
+		}
+	}
+
+	return dot_product;
+}
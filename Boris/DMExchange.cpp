@@ -94,117 +94,124 @@ BError DMExchange::MakeCUDAModule(void)
 	return error;
 }
 
-double DMExchange::UpdateField(void)
+//FM mesh : add field contribution at non-empty cell idx to Heff, returning the energy density term to be summed (before final scaling)
+double DMExchange::UpdateField_FM_Cell(int idx)
 {
-	double energy = 0;
+	double Ms = pMesh->Ms;
+	double A = pMesh->A;
+	double D = pMesh->D;
+	pMesh->update_parameters_mcoarse_cached(idx, pMesh->A, A, pMesh->D, D, pMesh->Ms, Ms);
 
-	SZ3 n = pMesh->n;
+	double Aconst = 2 * A / (MU0 * Ms * Ms);
+	double Dconst = -2 * D / (MU0 * Ms * Ms);
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	////////////////////////////////////// FERROMAGNETIC MESH /////////////////////////////////////
-	///////////////////////////////////////////////////////////////////////////////////////////////
+	DBL3 Hexch_A, Hexch_D;
 
-	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
+	if (pMesh->M.is_interior(idx)) {
 
-#pragma omp parallel for reduction(+:energy) 
-		for (int idx = 0; idx < n.dim(); idx++) {
+		//interior point : can use cheaper neu versions
 
-			if (pMesh->M.is_not_empty(idx)) {
+		//direct exchange contribution
+		if (pMesh->base_temperature > 0.0 && pMesh->T_Curie > 0.0) {
 
-				double Ms = pMesh->Ms;
-				double A = pMesh->A;
-				double D = pMesh->D;
-				pMesh->update_parameters_mcoarse(idx, pMesh->A, A, pMesh->D, D, pMesh->Ms, Ms);
+			//for finite temperature simulations the magnetization length may have a spatial variation
+			//this will not affect the transverse torque (mxH), but will affect the longitudinal term in the sLLB equation (m.H) and cannot be neglected when close to Tc.
 
-				double Aconst = 2 * A / (MU0 * Ms * Ms);
-				double Dconst = -2 * D / (MU0 * Ms * Ms);
+			DBL33 Mg = pMesh->M.grad_neu(idx);
+			DBL3 dMdx = Mg.x, dMdy = Mg.y, dMdz = Mg.z;
 
-				DBL3 Hexch_A, Hexch_D;
+			double delsq_Msq = 2 * pMesh->M[idx] * (pMesh->M.dxx_neu(idx) + pMesh->M.dyy_neu(idx) + pMesh->M.dzz_neu(idx)) + 2 * (dMdx * dMdx + dMdy * dMdy + dMdz * dMdz);
+			double Mnorm = pMesh->M[idx].norm();
+			Hexch_A = Aconst * (pMesh->M.delsq_neu(idx) - pMesh->M[idx] * delsq_Msq / (2 * Mnorm*Mnorm));
+		}
+		else {
 
-				if (pMesh->M.is_interior(idx)) {
+			//zero temperature simulations : magnetization length could still vary but will only affect mxH term, so not needed for 0K simulations.
+			Hexch_A = Aconst * pMesh->M.delsq_neu(idx);
+		}
 
-					//interior point : can use cheaper neu versions
+		//Dzyaloshinskii-Moriya exchange contribution
 
-					//direct exchange contribution
-					if (pMesh->base_temperature > 0.0 && pMesh->T_Curie > 0.0) {
+		//Hdm, ex = -2D / (mu0*Ms) * curl m
+		Hexch_D = Dconst * pMesh->M.curl_neu(idx);
+	}
+	else {
 
-						//for finite temperature simulations the magnetization length may have a spatial variation
-						//this will not affect the transverse torque (mxH), but will affect the longitudinal term in the sLLB equation (m.H) and cannot be neglected when close to Tc.
+		//Non-homogeneous Neumann boundary conditions apply when using DMI. Required to ensure Brown's condition is fulfilled, i.e. equivalent to m x h -> 0 when relaxing.
+		DBL3 bnd_dm_dx = (D / (2 * A)) * DBL3(0, -pMesh->M[idx].z, pMesh->M[idx].y);
+		DBL3 bnd_dm_dy = (D / (2 * A)) * DBL3(pMesh->M[idx].z, 0, -pMesh->M[idx].x);
+		DBL3 bnd_dm_dz = (D / (2 * A)) * DBL3(-pMesh->M[idx].y, pMesh->M[idx].x, 0);
+		DBL33 bnd_nneu = DBL33(bnd_dm_dx, bnd_dm_dy, bnd_dm_dz);
 
-						DBL33 Mg = pMesh->M.grad_neu(idx);
-						DBL3 dMdx = Mg.x, dMdy = Mg.y, dMdz = Mg.z;
+		//direct exchange contribution
+		//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see below; the delsq_nneu evaluates to zero in the CMBND coupling direction.
+		if (pMesh->base_temperature > 0.0 && pMesh->T_Curie > 0.0) {
 
-						double delsq_Msq = 2 * pMesh->M[idx] * (pMesh->M.dxx_neu(idx) + pMesh->M.dyy_neu(idx) + pMesh->M.dzz_neu(idx)) + 2 * (dMdx * dMdx + dMdy * dMdy + dMdz * dMdz);
-						double Mnorm = pMesh->M[idx].norm();
-						Hexch_A = Aconst * (pMesh->M.delsq_neu(idx) - pMesh->M[idx] * delsq_Msq / (2 * Mnorm*Mnorm));
-					}
-					else {
+			//for finite temperature simulations the magnetization length may have a spatial variation
+			//this will not affect the transverse torque (mxH), but will affect the longitudinal term in the sLLB equation (m.H) and cannot be neglected when close to Tc.
 
-						//zero temperature simulations : magnetization length could still vary but will only affect mxH term, so not needed for 0K simulations.
-						Hexch_A = Aconst * pMesh->M.delsq_neu(idx);
-					}
+			DBL33 Mg = pMesh->M.grad_nneu(idx, bnd_nneu);
+			DBL3 dMdx = Mg.x, dMdy = Mg.y, dMdz = Mg.z;
 
-					//Dzyaloshinskii-Moriya exchange contribution
+			double delsq_Msq = 2 * pMesh->M[idx] * (pMesh->M.dxx_nneu(idx, bnd_nneu) + pMesh->M.dyy_nneu(idx, bnd_nneu) + pMesh->M.dzz_nneu(idx, bnd_nneu)) + 2 * (dMdx * dMdx + dMdy * dMdy + dMdz * dMdz);
+			double Mnorm = pMesh->M[idx].norm();
+			Hexch_A = Aconst * (pMesh->M.delsq_nneu(idx, bnd_nneu) - pMesh->M[idx] * delsq_Msq / (2 * Mnorm*Mnorm));
+		}
+		else {
 
-					//Hdm, ex = -2D / (mu0*Ms) * curl m
-					Hexch_D = Dconst * pMesh->M.curl_neu(idx);
-				}
-				else {
+			//zero temperature simulations : magnetization length could still vary but will only affect mxH term, so not needed for 0K simulations.
+			Hexch_A = Aconst * pMesh->M.delsq_nneu(idx, bnd_nneu);
+		}
 
-					//Non-homogeneous Neumann boundary conditions apply when using DMI. Required to ensure Brown's condition is fulfilled, i.e. equivalent to m x h -> 0 when relaxing.
-					DBL3 bnd_dm_dx = (D / (2 * A)) * DBL3(0, -pMesh->M[idx].z, pMesh->M[idx].y);
-					DBL3 bnd_dm_dy = (D / (2 * A)) * DBL3(pMesh->M[idx].z, 0, -pMesh->M[idx].x);
-					DBL3 bnd_dm_dz = (D / (2 * A)) * DBL3(-pMesh->M[idx].y, pMesh->M[idx].x, 0);
-					DBL33 bnd_nneu = DBL33(bnd_dm_dx, bnd_dm_dy, bnd_dm_dz);
+		//Dzyaloshinskii-Moriya exchange contribution
 
-					//direct exchange contribution
-					//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see below; the delsq_nneu evaluates to zero in the CMBND coupling direction.
-					if (pMesh->base_temperature > 0.0 && pMesh->T_Curie > 0.0) {
+		//Hdm, ex = -2D / (mu0*Ms) * curl m
+		//For cmbnd cells curl_nneu does not evaluate to zero in the CMBND coupling direction, but sided differentials are used - when setting values at CMBND cells for exchange coupled meshes must correct for this.
+		Hexch_D = Dconst * pMesh->M.curl_nneu(idx, bnd_nneu);
+	}
 
-						//for finite temperature simulations the magnetization length may have a spatial variation
-						//this will not affect the transverse torque (mxH), but will affect the longitudinal term in the sLLB equation (m.H) and cannot be neglected when close to Tc.
+	pMesh->Heff[idx] += Hexch_A + Hexch_D;
 
-						DBL33 Mg = pMesh->M.grad_nneu(idx, bnd_nneu);
-						DBL3 dMdx = Mg.x, dMdy = Mg.y, dMdz = Mg.z;
+	double energy_ = pMesh->M[idx] * (Hexch_A + Hexch_D);
 
-						double delsq_Msq = 2 * pMesh->M[idx] * (pMesh->M.dxx_nneu(idx, bnd_nneu) + pMesh->M.dyy_nneu(idx, bnd_nneu) + pMesh->M.dzz_nneu(idx, bnd_nneu)) + 2 * (dMdx * dMdx + dMdy * dMdy + dMdz * dMdz);
-						double Mnorm = pMesh->M[idx].norm();
-						Hexch_A = Aconst * (pMesh->M.delsq_nneu(idx, bnd_nneu) - pMesh->M[idx] * delsq_Msq / (2 * Mnorm*Mnorm));
-					}
-					else {
+	//spatial dependence display of effective field and energy density
+	if (Module_Heff.linear_size() && Module_energy.linear_size()) {
 
-						//zero temperature simulations : magnetization length could still vary but will only affect mxH term, so not needed for 0K simulations.
-						Hexch_A = Aconst * pMesh->M.delsq_nneu(idx, bnd_nneu);
-					}
+		if ((MOD_)pMesh->Get_Module_Heff_Display() == MOD_EXCHANGE) {
 
-					//Dzyaloshinskii-Moriya exchange contribution
+			//total : direct and DMI
+			Module_Heff[idx] = Hexch_A + Hexch_D;
+			Module_energy[idx] = -MU0 * (pMesh->M[idx] * (Hexch_A + Hexch_D)) / 2;
+		}
+		else {
 
-					//Hdm, ex = -2D / (mu0*Ms) * curl m
-					//For cmbnd cells curl_nneu does not evaluate to zero in the CMBND coupling direction, but sided differentials are used - when setting values at CMBND cells for exchange coupled meshes must correct for this.
-					Hexch_D = Dconst * pMesh->M.curl_nneu(idx, bnd_nneu);
-				}
+			//just DMI
+			Module_Heff[idx] = Hexch_D;
+			Module_energy[idx] = -MU0 * (pMesh->M[idx] * Hexch_D) / 2;
+		}
+	}
 
-				pMesh->Heff[idx] += Hexch_A + Hexch_D;
+	return energy_;
+}
 
-				energy += pMesh->M[idx] * (Hexch_A + Hexch_D);
+double DMExchange::UpdateField(void)
+{
+	double energy = 0;
 
-				//spatial dependence display of effective field and energy density
-				if (Module_Heff.linear_size() && Module_energy.linear_size()) {
+	SZ3 n = pMesh->n;
 
-					if ((MOD_)pMesh->Get_Module_Heff_Display() == MOD_EXCHANGE) {
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////// FERROMAGNETIC MESH /////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
 
-						//total : direct and DMI
-						Module_Heff[idx] = Hexch_A + Hexch_D;
-						Module_energy[idx] = -MU0 * (pMesh->M[idx] * (Hexch_A + Hexch_D)) / 2;
-					}
-					else {
+	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
 
-						//just DMI
-						Module_Heff[idx] = Hexch_D;
-						Module_energy[idx] = -MU0 * (pMesh->M[idx] * Hexch_D) / 2;
-					}
-				}
-			}
+		pMesh->cache_parameters_mcoarse(pMesh->A, pMesh->D, pMesh->Ms);
+
+#pragma omp parallel for reduction(+:energy) 
+		for (int idx = 0; idx < n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) energy += UpdateField_FM_Cell(idx);
 		}
 	}
 
@@ -492,6 +499,36 @@ double DMExchange::UpdateField(void)
 	return this->energy;
 }
 
+//-------------------Fused local field evaluation
+
+bool DMExchange::FusedField_Available(void)
+{
+	//coupling to other meshes is added after the main loop, so cannot be fused with other modules
+	return pMesh->GetMeshType() == MESH_FERROMAGNETIC && !pMesh->GetMeshExchangeCoupling();
+}
+
+void DMExchange::FusedField_Prepare(void)
+{
+	pMesh->cache_parameters_mcoarse(pMesh->A, pMesh->D, pMesh->Ms);
+}
+
+double DMExchange::FusedField_Cell(int idx)
+{
+	if (pMesh->M.is_not_empty(idx)) return UpdateField_FM_Cell(idx);
+	else return 0.0;
+}
+
+double DMExchange::FusedField_Finish(double energy)
+{
+	//average energy density, see UpdateField
+	if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * (pMesh->M.get_nonempty_cells()));
+	else energy = 0;
+
+	this->energy = energy;
+
+	return this->energy;
+}
+
 //-------------------Energy methods
 
 //FM Mesh
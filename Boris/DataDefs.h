@@ -50,8 +50,12 @@ enum DATA_
 
 	//Special
 	DATA_COMMBUFFER = 58,
+	DATA_DISKBUFFER = 68,
+
+	//Profiler times
+	DATA_PROFILE_ITERATION = 69, DATA_PROFILE_MODULES = 70, DATA_PROFILE_ODE = 71, DATA_PROFILE_TRANSPORT = 72, DATA_PROFILE_HEAT = 73, DATA_PROFILE_MESHTRANSFER = 74, DATA_PROFILE_SAVEDATA = 75,
 
 	//Previously used by DATA_E_EXCH_MAX, now deleted
 	DATA_RESERVED = 39
 };
-//Current maximum : 67
\ No newline at end of file
+//Current maximum : 75
\ No newline at end of file
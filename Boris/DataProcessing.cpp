@@ -23,9 +23,10 @@ BError DPArrays::load_arrays(std::string fileName, std::vector<int> all_indexes,
 	//check all indexes are valid
 	if(!GoodArrays(all_indexes)) return error(BERROR_INCORRECTARRAYS);
 
-	//load columns from data file
+	//load columns from data file : binary data files are read directly, else parse text
 	std::vector<std::vector<double>> data_cols;
-	ReadDataColumns(fileName, "\t", data_cols, subvec(all_indexes, 0, (int)all_indexes.size() / 2));
+	if (IsBinaryDataFile(fileName)) ReadBinaryDataColumns(fileName, data_cols, subvec(all_indexes, 0, (int)all_indexes.size() / 2));
+	else ReadDataColumns(fileName, "\t", data_cols, subvec(all_indexes, 0, (int)all_indexes.size() / 2));
 
 	//save columns in respective dp arrays
 	for (int idx = 0; idx < (int)data_cols.size(); idx++) {
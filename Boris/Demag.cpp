@@ -65,25 +65,8 @@ BError Demag::Initialize(void)
 	}
 
 	//make sure to allocate memory for Hdemag if we need it
-	if (pMesh->pSMesh->GetEvaluationSpeedup() >= 6) { if (!Hdemag6.resize(pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-	else Hdemag6.clear();
-
-	if (pMesh->pSMesh->GetEvaluationSpeedup() >= 5) { if (!Hdemag5.resize(pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-	else Hdemag5.clear();
-
-	if (pMesh->pSMesh->GetEvaluationSpeedup() >= 4) { if (!Hdemag4.resize(pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-	else Hdemag4.clear();
-
-	if (pMesh->pSMesh->GetEvaluationSpeedup() >= 3) { if (!Hdemag3.resize(pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-	else Hdemag3.clear();
-
-	if (pMesh->pSMesh->GetEvaluationSpeedup() >= 2) { if (!Hdemag2.resize(pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-	else Hdemag2.clear();
-
-	if (pMesh->pSMesh->GetEvaluationSpeedup() >= 1) { if (!Hdemag.resize(pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT); }
-	else Hdemag.clear();
-
-	num_Hdemag_saved = 0;
+	evalspeedup.Configure(pMesh->pSMesh->GetEvaluationSpeedup(), pMesh->pSMesh->GetEvaluationSpeedupTolerance());
+	if (!evalspeedup.Resize_Fields(Hdemag, pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT);
 
 	//Make sure display data has memory allocated (or freed) as required
 	error = Update_Module_Display_VECs(
@@ -103,23 +86,18 @@ BError Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	BError error(CLASS_STR(Demag));
 
 	//only need to uninitialize if n or h have changed, or pbc settings have changed
-	if (!CheckDimensions(pMesh->n, pMesh->h, demag_pbc_images) || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE || cfgMessage == UPDATECONFIG_MESHCHANGE) {
+	if (!CheckDimensions(pMesh->n, pMesh->h, demag_pbc_images, pMesh->pSMesh->Get_Demag_Single_Precision()) || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE || cfgMessage == UPDATECONFIG_MESHCHANGE) {
 		
 		Uninitialize();
 
 		//Set convolution dimensions for embedded multiplication and required PBC conditions
-		error = SetDimensions(pMesh->n, pMesh->h, true, demag_pbc_images);
+		error = SetDimensions(pMesh->n, pMesh->h, true, demag_pbc_images, pMesh->pSMesh->Get_Demag_Single_Precision());
 
 		//if memory needs to be allocated for Hdemag, it will be done through Initialize 
 		Hdemag.clear();
-		Hdemag2.clear();
-		Hdemag3.clear();
-		Hdemag4.clear();
-		Hdemag5.clear();
-		Hdemag6.clear();
 	}
 
-	num_Hdemag_saved = 0;
+	evalspeedup.Reset();
 
 	//------------------------ CUDA UpdateConfiguration if set
 
@@ -169,11 +147,15 @@ BError Demag::MakeCUDAModule(void)
 
 double Demag::UpdateField(void) 
 {
+	//what to do at this evaluation : compute field every time if not using evaluation speedup, else as decided by the evaluation speedup history
+	EVALSPEEDUPSTEP_ speedup_step = EVALSPEEDUPSTEP_COMPUTE;
+	if (pMesh->pSMesh->GetEvaluationSpeedup()) speedup_step = evalspeedup.Check_Evaluation(pMesh->pSMesh->Check_Step_Update(), pMesh->pSMesh->Get_EvalStep_Time());
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////// NO SPEEDUP //////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (!pMesh->pSMesh->GetEvaluationSpeedup() || (num_Hdemag_saved < pMesh->pSMesh->GetEvaluationSpeedup() && !pMesh->pSMesh->Check_Step_Update())) {
+	if (speedup_step == EVALSPEEDUPSTEP_COMPUTE) {
 
 		//don't use evaluation speedup, so no need to use Hdemag (this won't have memory allocated anyway) - or else we are using speedup but don't yet have enough previous evaluations at steps where we should be extrapolating
 
@@ -197,412 +179,78 @@ double Demag::UpdateField(void)
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//////////////////////////////////////// EVAL SPEEDUP /////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
-	
-	else {
-
-		//use evaluation speedup method (Hdemag will have memory allocated - this was done in the Initialize method)
-
-		//update if required by ODE solver or if we don't have enough previous evaluations saved to extrapolate
-		if (pMesh->pSMesh->Check_Step_Update() || num_Hdemag_saved < pMesh->pSMesh->GetEvaluationSpeedup()) {
-
-			VEC<DBL3>* pHdemag;
-
-			if (num_Hdemag_saved < pMesh->pSMesh->GetEvaluationSpeedup()) {
-
-				//don't have enough evaluations, so save next one
-				switch (num_Hdemag_saved)
-				{
-				case 0:
-					pHdemag = &Hdemag;
-					time_demag1 = pMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 1:
-					pHdemag = &Hdemag2;
-					time_demag2 = pMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 2:
-					pHdemag = &Hdemag3;
-					time_demag3 = pMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 3:
-					pHdemag = &Hdemag4;
-					time_demag4 = pMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 4:
-					pHdemag = &Hdemag5;
-					time_demag5 = pMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				case 5:
-					pHdemag = &Hdemag6;
-					time_demag6 = pMesh->pSMesh->Get_EvalStep_Time();
-					break;
-				}
-
-				num_Hdemag_saved++;
-			}
-			else {
-
-				//have enough evaluations saved, so just cycle between them now
-				
-				//QUINTIC
-				if (pMesh->pSMesh->GetEvaluationSpeedup() == 6) {
-
-					//1, 2, 3, 4, 5, 6 -> next is 1
-					if (time_demag6 > time_demag5 && time_demag5 > time_demag4 && time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 4, 5, 6, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 4, 5, 6, 1, 2 -> next is 3
-					else if (time_demag2 > time_demag3) {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//4, 5, 6, 1, 2, 3 -> next is 4
-					else if (time_demag3 > time_demag4) {
-
-						pHdemag = &Hdemag4;
-						time_demag4 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//5, 6, 1, 2, 3, 4 -> next is 5
-					else if (time_demag4 > time_demag5) {
-
-						pHdemag = &Hdemag5;
-						time_demag5 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					else {
-
-						pHdemag = &Hdemag6;
-						time_demag6 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//QUARTIC
-				else if (pMesh->pSMesh->GetEvaluationSpeedup() == 5) {
-
-					//1, 2, 3, 4, 5 -> next is 1
-					if (time_demag5 > time_demag4 && time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 4, 5, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 4, 5, 1, 2 -> next is 3
-					else if (time_demag2 > time_demag3) {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//4, 5, 1, 2, 3 -> next is 4
-					else if (time_demag3 > time_demag4) {
-
-						pHdemag = &Hdemag4;
-						time_demag4 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					else {
-
-						pHdemag = &Hdemag5;
-						time_demag5 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//CUBIC
-				else if (pMesh->pSMesh->GetEvaluationSpeedup() == 4) {
-
-					//1, 2, 3, 4 -> next is 1
-					if (time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 4, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 4, 1, 2 -> next is 3
-					else if (time_demag2 > time_demag3) {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					else {
-
-						pHdemag = &Hdemag4;
-						time_demag4 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//QUADRATIC
-				else if (pMesh->pSMesh->GetEvaluationSpeedup() == 3) {
-
-					//1, 2, 3 -> next is 1
-					if (time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 3, 1 -> next is 2
-					else if (time_demag1 > time_demag2) {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//3, 1, 2 -> next is 3, leading to 1, 2, 3 again
-					else {
-
-						pHdemag = &Hdemag3;
-						time_demag3 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//LINEAR
-				else if (pMesh->pSMesh->GetEvaluationSpeedup() == 2) {
-
-					//1, 2 -> next is 1
-					if (time_demag2 > time_demag1) {
-
-						pHdemag = &Hdemag;
-						time_demag1 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-					//2, 1 -> next is 2, leading to 1, 2 again
-					else {
-
-						pHdemag = &Hdemag2;
-						time_demag2 = pMesh->pSMesh->Get_EvalStep_Time();
-					}
-				}
-				//STEP
-				else {
-
-					pHdemag = &Hdemag;
-				}
-			}
-			
-			//do evaluation
-			if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-				if (Module_Heff.linear_size()) energy = Convolute_AveragedInputs(pMesh->M, pMesh->M2, *pHdemag, true, &Module_Heff, &Module_energy);
-				else energy = Convolute_AveragedInputs(pMesh->M, pMesh->M2, *pHdemag, true);
-			}
-			else {
-
-				if (Module_Heff.linear_size()) energy = Convolute(pMesh->M, *pHdemag, true, &Module_Heff, &Module_energy);
-				else energy = Convolute(pMesh->M, *pHdemag, true);
-			}
-
-			//finish off energy value
-			if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
-			else energy = 0;
 
-			if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+	else if (speedup_step == EVALSPEEDUPSTEP_COMPUTE_AND_SAVE) {
 
-				//add contribution to Heff and Heff2
-#pragma omp parallel for
-				for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-					pMesh->Heff[idx] += (*pHdemag)[idx];
-					pMesh->Heff2[idx] += (*pHdemag)[idx];
-					//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-					(*pHdemag)[idx] -= (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-				}
-			}
-			else {
+		//use evaluation speedup method (Hdemag will have memory allocated - this was done in the Initialize method)
+		//update required by ODE solver or don't have enough previous evaluations saved to extrapolate : compute field and save it in the slot set by evalspeedup
+		VEC<DBL3>& Hsave = Hdemag[evalspeedup.get_save_slot()];
 
-				//add contribution to Heff
-#pragma omp parallel for
-				for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
+		//do evaluation
+		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-					pMesh->Heff[idx] += (*pHdemag)[idx];
-					//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-					(*pHdemag)[idx] -= (selfDemagCoeff & pMesh->M[idx]);
-				}
-			}
+			if (Module_Heff.linear_size()) energy = Convolute_AveragedInputs(pMesh->M, pMesh->M2, Hsave, true, &Module_Heff, &Module_energy);
+			else energy = Convolute_AveragedInputs(pMesh->M, pMesh->M2, Hsave, true);
 		}
 		else {
 
-			//not required to update, and we have enough previous evaluations: use previous Hdemag saves to extrapolate for current evaluation
-
-			double a1 = 1.0, a2 = 0.0, a3 = 0.0, a4 = 0.0, a5 = 0.0, a6 = 0.0;
-			double time = pMesh->pSMesh->Get_EvalStep_Time();
-
-			//QUINTIC
-			if (pMesh->pSMesh->GetEvaluationSpeedup() == 6) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4) * (time_demag1 - time_demag5) * (time_demag1 - time_demag6));
-				a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4) * (time_demag2 - time_demag5) * (time_demag2 - time_demag6));
-				a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4) * (time_demag3 - time_demag5) * (time_demag3 - time_demag6));
-				a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag5) * (time - time_demag6) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3) * (time_demag4 - time_demag5) * (time_demag4 - time_demag6));
-				a5 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag6) / ((time_demag5 - time_demag1) * (time_demag5 - time_demag2) * (time_demag5 - time_demag3) * (time_demag5 - time_demag4) * (time_demag5 - time_demag6));
-				a6 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag6 - time_demag1) * (time_demag6 - time_demag2) * (time_demag6 - time_demag3) * (time_demag6 - time_demag4) * (time_demag6 - time_demag5));
-
-				if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					//add contribution to Heff and Heff2
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						DBL3 Hdemag_value = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + Hdemag6[idx] * a6 + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-						pMesh->Heff[idx] += Hdemag_value;
-						pMesh->Heff2[idx] += Hdemag_value;
-					}
-				}
-				else {
-
-					//add contribution to Heff
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						pMesh->Heff[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + Hdemag6[idx] * a6 + (selfDemagCoeff & pMesh->M[idx]);
-					}
-				}
-			}
-			//QUARTIC
-			else if (pMesh->pSMesh->GetEvaluationSpeedup() == 5) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4) * (time_demag1 - time_demag5));
-				a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4) * (time_demag2 - time_demag5));
-				a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) * (time - time_demag5) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4) * (time_demag3 - time_demag5));
-				a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag5) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3) * (time_demag4 - time_demag5));
-				a5 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) / ((time_demag5 - time_demag1) * (time_demag5 - time_demag2) * (time_demag5 - time_demag3) * (time_demag5 - time_demag4));
-
-				if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					//add contribution to Heff and Heff2
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						DBL3 Hdemag_value = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-						pMesh->Heff[idx] += Hdemag_value;
-						pMesh->Heff2[idx] += Hdemag_value;
-					}
-				}
-				else {
-
-					//add contribution to Heff
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						pMesh->Heff[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + Hdemag5[idx] * a5 + (selfDemagCoeff & pMesh->M[idx]);
-					}
-				}
-			}
-			//CUBIC
-			else if (pMesh->pSMesh->GetEvaluationSpeedup() == 4) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4));
-				a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4));
-				a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4));
-				a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3));
-
-				if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+			if (Module_Heff.linear_size()) energy = Convolute(pMesh->M, Hsave, true, &Module_Heff, &Module_energy);
+			else energy = Convolute(pMesh->M, Hsave, true);
+		}
 
-					//add contribution to Heff and Heff2
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+		//finish off energy value
+		if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
+		else energy = 0;
 
-						DBL3 Hdemag_value = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-						pMesh->Heff[idx] += Hdemag_value;
-						pMesh->Heff2[idx] += Hdemag_value;
-					}
-				}
-				else {
+		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-					//add contribution to Heff
+			//add contribution to Heff and Heff2
 #pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			for (int idx = 0; idx < Hsave.linear_size(); idx++) {
 
-						pMesh->Heff[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + Hdemag4[idx] * a4 + (selfDemagCoeff & pMesh->M[idx]);
-					}
-				}
+				pMesh->Heff[idx] += Hsave[idx];
+				pMesh->Heff2[idx] += Hsave[idx];
+				//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+				Hsave[idx] -= (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
 			}
-			//QUADRATIC
-			else if (pMesh->pSMesh->GetEvaluationSpeedup() == 3) {
-
-				a1 = (time - time_demag2) * (time - time_demag3) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3));
-				a2 = (time - time_demag1) * (time - time_demag3) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3));
-				a3 = (time - time_demag1) * (time - time_demag2) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2));
-
-				if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					//add contribution to Heff and Heff2
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						DBL3 Hdemag_value = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-						pMesh->Heff[idx] += Hdemag_value;
-						pMesh->Heff2[idx] += Hdemag_value;
-					}
-				}
-				else {
+		}
+		else {
 
-					//add contribution to Heff
+			//add contribution to Heff
 #pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			for (int idx = 0; idx < Hsave.linear_size(); idx++) {
 
-						pMesh->Heff[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + Hdemag3[idx] * a3 + (selfDemagCoeff & pMesh->M[idx]);
-					}
-				}
+				pMesh->Heff[idx] += Hsave[idx];
+				//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+				Hsave[idx] -= (selfDemagCoeff & pMesh->M[idx]);
 			}
-			//LINEAR
-			else if (pMesh->pSMesh->GetEvaluationSpeedup() == 2) {
-
-				a1 = (time - time_demag2) / (time_demag1 - time_demag2);
-				a2 = (time - time_demag1) / (time_demag2 - time_demag1);
+		}
 
-				if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+		evalspeedup.Accumulate_Residual(Hdemag);
+		evalspeedup.Save_Done();
+	}
+	else {
 
-					//add contribution to Heff and Heff2
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+		//not required to update, and we have enough previous evaluations: use previous Hdemag saves to extrapolate for current evaluation
 
-						DBL3 Hdemag_value = Hdemag[idx] * a1 + Hdemag2[idx] * a2 + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-						pMesh->Heff[idx] += Hdemag_value;
-						pMesh->Heff2[idx] += Hdemag_value;
-					}
-				}
-				else {
+		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-					//add contribution to Heff
+			//add contribution to Heff and Heff2
 #pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-						pMesh->Heff[idx] += Hdemag[idx] * a1 + Hdemag2[idx] * a2 + (selfDemagCoeff & pMesh->M[idx]);
-					}
-				}
+				DBL3 Hdemag_value = evalspeedup.extrapolate(Hdemag, idx) + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
+				pMesh->Heff[idx] += Hdemag_value;
+				pMesh->Heff2[idx] += Hdemag_value;
 			}
-			//STEP
-			else {
-
-				if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					//add contribution to Heff and Heff2
-#pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
-
-						DBL3 Hdemag_value = Hdemag[idx] + (selfDemagCoeff & (pMesh->M[idx] + pMesh->M2[idx]) / 2);
-						pMesh->Heff[idx] += Hdemag_value;
-						pMesh->Heff2[idx] += Hdemag_value;
-					}
-				}
-				else {
+		}
+		else {
 
-					//add contribution to Heff
+			//add contribution to Heff
 #pragma omp parallel for
-					for (int idx = 0; idx < Hdemag.linear_size(); idx++) {
+			for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-						pMesh->Heff[idx] += Hdemag[idx] + (selfDemagCoeff & pMesh->M[idx]);
-					}
-				}
+				pMesh->Heff[idx] += evalspeedup.extrapolate(Hdemag, idx) + (selfDemagCoeff & pMesh->M[idx]);
 			}
 		}
 	}
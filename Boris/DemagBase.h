@@ -3,6 +3,7 @@
 #include "BorisLib.h"
 #include "Boris_Enums_Defs.h"
 #include "ErrorHandler.h"
+#include "EvalSpeedup.h"
 
 
 
@@ -30,13 +31,11 @@ protected:
 
 	//Evaluation speedup mode data
 
-	//vec for demagnetizing field polynomial extrapolation
-	VEC<DBL3> Hdemag, Hdemag2, Hdemag3, Hdemag4, Hdemag5, Hdemag6;
+	//saved demagnetizing fields for polynomial extrapolation (sized by evalspeedup)
+	std::vector<VEC<DBL3>> Hdemag;
 
-	//times at which evaluations were done, used for extrapolation
-	double time_demag1 = 0.0, time_demag2 = 0.0, time_demag3 = 0.0, time_demag4 = 0.0, time_demag5 = 0.0, time_demag6 = 0.0;
-
-	int num_Hdemag_saved = 0;
+	//history of saved fields : decides when to compute or extrapolate, with extrapolation coefficients
+	EvalSpeedup evalspeedup;
 
 	//-Nxx, -Nyy, -Nzz values at r = r0
 	DBL3 selfDemagCoeff = DBL3();
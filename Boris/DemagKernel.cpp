@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "DemagKernel.h"
+#include "DemagKernelCache.h"
 
 #if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
 
@@ -172,6 +173,15 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 {
 	BError error(__FUNCTION__);
 
+	//-------------- KERNEL CACHE
+
+	//if the kernel for this geometry was already calculated (in this or a previous run) then just load it
+	std::string cache_key = DemagKernelCache::MakeKey("DemagKernel2D", n, N, h / maximum(h.x, h.y, h.z), pbc_images, DBL3(), include_self_demag);
+
+	if (DemagKernelCache::Load(cache_key, {
+		{ Kdiag.data(), Kdiag.linear_size() * sizeof(DBL3) },
+		{ K2D_odiag.data(), K2D_odiag.size() * sizeof(double) } })) return error;
+
 	//-------------- CALCULATE DEMAG TENSOR
 
 	//Demag tensor components
@@ -225,22 +235,22 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -310,6 +320,10 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 	fftw_free((double*)pline_real);
 	fftw_free((double*)pline_real_odiag);
 	fftw_free((fftw_complex*)pline);
+
+	DemagKernelCache::Save(cache_key, {
+		{ Kdiag.data(), Kdiag.linear_size() * sizeof(DBL3) },
+		{ K2D_odiag.data(), K2D_odiag.size() * sizeof(double) } });
 	
 	return error;
 }
@@ -317,6 +331,15 @@ BError DemagKernel::Calculate_Demag_Kernels_2D(bool include_self_demag)
 BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 {
 	BError error(__FUNCTION__);
+
+	//-------------- KERNEL CACHE
+
+	//if the kernel for this geometry was already calculated (in this or a previous run) then just load it
+	std::string cache_key = DemagKernelCache::MakeKey("DemagKernel3D", n, N, h / maximum(h.x, h.y, h.z), pbc_images, DBL3(), include_self_demag);
+
+	if (DemagKernelCache::Load(cache_key, {
+		{ Kdiag.data(), Kdiag.linear_size() * sizeof(DBL3) },
+		{ Kodiag.data(), Kodiag.linear_size() * sizeof(DBL3) } })) return error;
 	
 	//-------------- DEMAG TENSOR
 
@@ -348,17 +371,17 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -512,6 +535,10 @@ BError DemagKernel::Calculate_Demag_Kernels_3D(bool include_self_demag)
 	fftw_free((double*)pline_real);
 	fftw_free((fftw_complex*)pline);
 
+	DemagKernelCache::Save(cache_key, {
+		{ Kdiag.data(), Kdiag.linear_size() * sizeof(DBL3) },
+		{ Kodiag.data(), Kodiag.linear_size() * sizeof(DBL3) } });
+
 	//Done
 	return error;
 }
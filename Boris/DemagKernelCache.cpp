@@ -0,0 +1,158 @@
+#include "stdafx.h"
+#include "DemagKernelCache.h"
+
+#include <sstream>
+#include <iomanip>
+
+//-------------------------- HELPERS
+
+//FNV-1a hash of key, used to form the file name
+std::string DemagKernelCache::hash_key(const std::string& key)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for (unsigned char c : key) {
+
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+	return ss.str();
+}
+
+//remove oldest cached kernels until total size is below the maximum set (but never remove the file to keep)
+void DemagKernelCache::evict_oldest(const std::string& fileName_keep)
+{
+	//ordered by creation time, oldest first
+	std::vector<std::string> fileNames = GetFilesInDirectory(directory(), "", file_termination());
+
+	std::vector<long long> fileSizes(fileNames.size(), 0);
+	long long total_size = 0;
+
+	for (int idx = 0; idx < (int)fileNames.size(); idx++) {
+
+		std::ifstream bdin(fileNames[idx].c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+		if (bdin.is_open()) fileSizes[idx] = (long long)bdin.tellg();
+
+		total_size += fileSizes[idx];
+	}
+
+	long long max_size = (long long)maxsize_MB() * 1024 * 1024;
+
+	for (int idx = 0; idx < (int)fileNames.size() && total_size > max_size; idx++) {
+
+		if (fileNames[idx] == fileName_keep) continue;
+
+		if (std::remove(fileNames[idx].c_str()) == 0) total_size -= fileSizes[idx];
+	}
+}
+
+//-------------------------- KEY
+
+//make a key identifying a kernel : kernel_type distinguishes different kernel classes and 2D / 3D versions
+std::string DemagKernelCache::MakeKey(std::string kernel_type, SZ3 n, SZ3 N, DBL3 hRatios, INT3 pbc_images, DBL3 shift, bool include_self_demag)
+{
+	std::stringstream ss;
+
+	//exact representation of floating point values
+	ss << std::setprecision(17);
+
+	ss << kernel_type
+		<< " n " << n.x << " " << n.y << " " << n.z
+		<< " N " << N.x << " " << N.y << " " << N.z
+		<< " h " << hRatios.x << " " << hRatios.y << " " << hRatios.z
+		<< " pbc " << pbc_images.x << " " << pbc_images.y << " " << pbc_images.z
+		<< " shift " << shift.x << " " << shift.y << " " << shift.z
+		<< " self " << include_self_demag
+		<< " asympt " << ASYMPTOTIC_DISTANCE;
+
+	return ss.str();
+}
+
+//-------------------------- LOAD / SAVE
+
+//load kernel with given key into the given blocks (pointer and size in bytes) : return true only if found and all block sizes match
+bool DemagKernelCache::Load(const std::string& key, const std::vector<std::pair<void*, size_t>>& blocks)
+{
+	if (!Enabled()) return false;
+
+	std::ifstream bdin((directory() + hash_key(key) + file_termination()).c_str(), std::ios::in | std::ios::binary);
+	if (!bdin.is_open()) return false;
+
+	//check stored key matches (guards against hash collisions)
+	size_t key_length = 0;
+	bdin.read(reinterpret_cast<char*>(&key_length), sizeof(size_t));
+	if (!bdin || key_length != key.length()) return false;
+
+	std::string stored_key(key_length, ' ');
+	bdin.read(&stored_key[0], key_length);
+	if (!bdin || stored_key != key) return false;
+
+	size_t num_blocks = 0;
+	bdin.read(reinterpret_cast<char*>(&num_blocks), sizeof(size_t));
+	if (!bdin || num_blocks != blocks.size()) return false;
+
+	//one bulk read per block
+	for (auto& block : blocks) {
+
+		size_t block_size = 0;
+		bdin.read(reinterpret_cast<char*>(&block_size), sizeof(size_t));
+		if (!bdin || block_size != block.second) return false;
+
+		bdin.read(reinterpret_cast<char*>(block.first), block_size);
+		if (!bdin) return false;
+	}
+
+	return true;
+}
+
+//save kernel with given key from the given blocks (pointer and size in bytes)
+void DemagKernelCache::Save(const std::string& key, const std::vector<std::pair<const void*, size_t>>& blocks)
+{
+	if (!Enabled()) return;
+
+	size_t total_size = 0;
+	for (auto& block : blocks) total_size += block.second;
+
+	//don't bother if this kernel alone would exceed the cache size
+	if (total_size > (size_t)maxsize_MB() * 1024 * 1024) return;
+
+	MakeDirectory(directory());
+
+	std::string fileName = directory() + hash_key(key) + file_termination();
+
+	//write to temporary file first then rename, so other instances sharing the cache never read a partially written kernel
+	std::string fileName_temp = fileName + ".tmp";
+
+	std::ofstream bdout(fileName_temp.c_str(), std::ios::out | std::ios::binary);
+	if (!bdout.is_open()) return;
+
+	size_t key_length = key.length();
+	bdout.write(reinterpret_cast<const char*>(&key_length), sizeof(size_t));
+	bdout.write(key.data(), key_length);
+
+	size_t num_blocks = blocks.size();
+	bdout.write(reinterpret_cast<const char*>(&num_blocks), sizeof(size_t));
+
+	for (auto& block : blocks) {
+
+		size_t block_size = block.second;
+		bdout.write(reinterpret_cast<const char*>(&block_size), sizeof(size_t));
+		bdout.write(reinterpret_cast<const char*>(block.first), block_size);
+	}
+
+	bool success = (bool)bdout;
+	bdout.close();
+
+	if (success) {
+
+		std::remove(fileName.c_str());
+		if (std::rename(fileName_temp.c_str(), fileName.c_str()) != 0) std::remove(fileName_temp.c_str());
+	}
+	else std::remove(fileName_temp.c_str());
+
+	evict_oldest(fileName);
+}
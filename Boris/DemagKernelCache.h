@@ -0,0 +1,60 @@
+#pragma once
+
+#include "BorisLib.h"
+#include "DemagTFunc_Defs.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// On-disk cache for demag kernels
+
+//Kernels depend only on the convolution geometry (n, N, cellsize ratios, pbc images, shift, self demag flag), so once calculated they can be saved and re-used.
+//Each kernel is stored in its own file in the cache directory, with file name obtained from a hash of the geometry key (content-addressed); the full key is also stored in the file and checked on loading.
+//Files are written as a sequence of raw blocks (one per kernel array), so loading is a single bulk read per kernel array.
+//When the total size of cached kernels exceeds the set maximum, the oldest files are removed first.
+
+class DemagKernelCache {
+
+private:
+
+	//cached kernel files have this termination
+	static std::string file_termination(void) { return ".bkc"; }
+
+	//FNV-1a hash of key, used to form the file name
+	static std::string hash_key(const std::string& key);
+
+	//remove oldest cached kernels until total size is below the maximum set (but never remove the file to keep)
+	static void evict_oldest(const std::string& fileName_keep);
+
+public:
+
+	//-------------------------- CONFIGURATION
+
+	//cache directory (with terminating slash)
+	static std::string& directory(void)
+	{
+		static std::string directory_ = "";
+		return directory_;
+	}
+
+	//maximum total size of cached kernels in MB : 0 disables the cache
+	static int& maxsize_MB(void)
+	{
+		static int maxsize_MB_ = 0;
+		return maxsize_MB_;
+	}
+
+	static bool Enabled(void) { return maxsize_MB() > 0 && directory().length(); }
+
+	//-------------------------- KEY
+
+	//make a key identifying a kernel : kernel_type distinguishes different kernel classes and 2D / 3D versions
+	static std::string MakeKey(std::string kernel_type, SZ3 n, SZ3 N, DBL3 hRatios, INT3 pbc_images, DBL3 shift, bool include_self_demag);
+
+	//-------------------------- LOAD / SAVE
+
+	//load kernel with given key into the given blocks (pointer and size in bytes) : return true only if found and all block sizes match
+	static bool Load(const std::string& key, const std::vector<std::pair<void*, size_t>>& blocks);
+
+	//save kernel with given key from the given blocks (pointer and size in bytes)
+	static void Save(const std::string& key, const std::vector<std::pair<const void*, size_t>>& blocks);
+};
@@ -281,22 +281,22 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_2D_Self(int index, boo
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -445,12 +445,12 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_2D_zShifted(int index,
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -646,12 +646,12 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_2D_xShifted(int index,
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -817,12 +817,12 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_2D_Complex_Full(int in
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -989,17 +989,17 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_3D_Self(int index, boo
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -1242,17 +1242,17 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_3D_zShifted(int index,
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -1456,17 +1456,17 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_3D_xShifted(int index,
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -1670,17 +1670,17 @@ BError DemagKernelCollectionCUDA::Calculate_Demag_Kernels_3D_Complex_Full(int in
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -208,22 +208,22 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Self(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_x_odiag = fftw_plan_many_dft_r2c(1, dims_x, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y_odiag = fftw_plan_many_dft_r2c(1, dims_y, 1,
 		pline_real_odiag, nullptr, 1, 1,
 		pline_odiag, nullptr, 1, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -331,12 +331,12 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_zShifted(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -488,12 +488,12 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_xShifted(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -628,12 +628,12 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Complex_Full(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -765,17 +765,17 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft_r2c(1, dims_y, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft_r2c(1, dims_z, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -971,17 +971,17 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -1147,17 +1147,17 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_xShifted(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -1323,17 +1323,17 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 	fftw_plan plan_fwd_x = fftw_plan_many_dft_r2c(1, dims_x, 3,
 		pline_real, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_PATIENT);
+		FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_y = fftw_plan_many_dft(1, dims_y, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	fftw_plan plan_fwd_z = fftw_plan_many_dft(1, dims_z, 3,
 		pline, nullptr, 3, 1,
 		pline, nullptr, 3, 1,
-		FFTW_FORWARD, FFTW_PATIENT);
+		FFTW_FORWARD, FFTWPlanner::rigor());
 
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
@@ -157,6 +157,7 @@ BError DifferentialEquationAFM::AllocateMemory(void)
 		break;
 
 	case EVAL_RKF56:
+	case EVAL_LBFGS:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
@@ -173,6 +174,12 @@ BError DifferentialEquationAFM::AllocateMemory(void)
 		if (!sEval6_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_LSRK45:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
@@ -225,6 +232,8 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
 		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS &&
+		evalMethod != EVAL_LSRK45 &&
 		evalMethod != EVAL_SD) {
 
 		sEval0.clear();
@@ -237,18 +246,24 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS &&
+		evalMethod != EVAL_LSRK45) {
 
 		sEval1.clear();
 		sEval1_2.clear();
 	}
 
+	//LSRK45 only keeps an error register for sub-lattice A
+	if (evalMethod == EVAL_LSRK45) sEval1_2.clear();
+
 	if (evalMethod != EVAL_RK4 &&
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval2.clear();
 		sEval2_2.clear();
@@ -258,7 +273,8 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval3.clear();
 		sEval4.clear();
@@ -267,13 +283,15 @@ void DifferentialEquationAFM::CleanupMemory(void)
 	}
 
 	if (evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval5.clear();
 		sEval5_2.clear();
 	}
 
-	if (evalMethod != EVAL_RKF56) {
+	if (evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval6.clear();
 		sEval6_2.clear();
@@ -311,6 +329,13 @@ BError DifferentialEquationAFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 {
 	BError error(CLASS_STR(DifferentialEquationAFM));
 
+	//seed thermal field generator : if prng_seed is set the same sequence is obtained on every run
+	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_PRNG)) {
+
+		prng.set_seed(pMesh->prng_seed == 0 ? GetSystemTickCount() : pMesh->prng_seed);
+		thermal_step = 0;
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE, UPDATECONFIG_ODE_SOLVER)) {
 
 		if (pMesh->link_stochastic) {
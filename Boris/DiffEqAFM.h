@@ -30,6 +30,10 @@ private:
 	//evalution scratch spaces
 	VEC<DBL3> sEval0_2, sEval1_2, sEval2_2, sEval3_2, sEval4_2, sEval5_2, sEval6_2;
 
+	//L-BFGS minimizer : sub-lattice B correction pairs, same slots as in the base class
+	VEC<DBL3>& LBFGS_s_2(int slot) { return (slot == 0 ? sEval0_2 : (slot == 1 ? sEval1_2 : sEval2_2)); }
+	VEC<DBL3>& LBFGS_y_2(int slot) { return (slot == 0 ? sEval3_2 : (slot == 1 ? sEval4_2 : sEval5_2)); }
+
 	//Thermal field and torques, enabled only for the stochastic equations
 	VEC<DBL3> H_Thermal_2, Torque_Thermal_2;
 
@@ -147,6 +151,17 @@ public:
 	void RunRKDP54_Step5(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK45
+	void RunLSRK45_Step0_withReductions(void);
+	void RunLSRK45_Step0(void);
+	void RunLSRK45_Step1(void);
+	void RunLSRK45_Step2(void);
+	void RunLSRK45_Step3(void);
+	void RunLSRK45_Step4_withReductions(void);
+	void RunLSRK45_Step4(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void);
@@ -159,6 +174,23 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+	//0. prime the L-BFGS solver : steepest descent step with stepsize dT, which also starts the first correction pair in given slot
+	void RunLBFGS_Start(int slot);
+	//1. gradient at the current magnetization : complete the newest correction pair and set search direction to the gradient
+	//must reset lbfgs_dot, lbfgs_dot2 (reduces s.y and y.y for the newest pair) and lbfgs_dirmax before running these across all meshes, also for passes 2 to 4
+	void RunLBFGS_Gradient(void);
+	//2. transport correction pair in given slot to the current tangent planes, reducing s.q and s.y
+	void RunLBFGS_Project(int slot);
+	//3. reduce y.q for correction pair in given slot
+	void RunLBFGS_Dot_Y(int slot);
+	//4. search direction update q += coeff * (s or y in given slot), reducing maximum length of q
+	void RunLBFGS_Update(int slot, double coeff, bool use_s);
+	//5. set new magnetization vectors along -dT * q, starting the next correction pair in given slot
+	void RunLBFGS_Advance_withReductions(int slot);
+	void RunLBFGS_Advance(int slot);
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -345,6 +377,17 @@ public:
 	void RunRKDP54_Step5(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK45
+	void RunLSRK45_Step0_withReductions(void) {}
+	void RunLSRK45_Step0(void) {}
+	void RunLSRK45_Step1(void) {}
+	void RunLSRK45_Step2(void) {}
+	void RunLSRK45_Step3(void) {}
+	void RunLSRK45_Step4_withReductions(void) {}
+	void RunLSRK45_Step4(void) {}
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void) {}
@@ -357,6 +400,23 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+	//0. prime the L-BFGS solver : steepest descent step with stepsize dT, which also starts the first correction pair in given slot
+	void RunLBFGS_Start(int slot) {}
+	//1. gradient at the current magnetization : complete the newest correction pair and set search direction to the gradient
+	//must reset lbfgs_dot, lbfgs_dot2 (reduces s.y and y.y for the newest pair) and lbfgs_dirmax before running these across all meshes, also for passes 2 to 4
+	void RunLBFGS_Gradient(void) {}
+	//2. transport correction pair in given slot to the current tangent planes, reducing s.q and s.y
+	void RunLBFGS_Project(int slot) {}
+	//3. reduce y.q for correction pair in given slot
+	void RunLBFGS_Dot_Y(int slot) {}
+	//4. search direction update q += coeff * (s or y in given slot), reducing maximum length of q
+	void RunLBFGS_Update(int slot, double coeff, bool use_s) {}
+	//5. set new magnetization vectors along -dT * q, starting the next correction pair in given slot
+	void RunLBFGS_Advance_withReductions(int slot) {}
+	void RunLBFGS_Advance(int slot) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
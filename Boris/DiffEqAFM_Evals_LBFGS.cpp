@@ -0,0 +1,297 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//L-BFGS minimizer : see DiffEqFM_Evals_LBFGS.cpp
+//Both sub-lattices are part of the same minimization problem, so their contributions are added to the same dot products.
+
+//--------------------------------------------- L-BFGS Minimizer
+
+void DifferentialEquationAFM::RunLBFGS_Start(int slot)
+{
+	//search direction is the gradient for the first step
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			DBL2 grel_AFM = pMesh->grel_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+			DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+			DBL3 m2 = pMesh->M2[idx] / Ms_AFM.j;
+
+			sEval6[idx] = (GAMMA * grel_AFM.i / 2) * (m ^ (m ^ pMesh->Heff[idx]));
+			sEval6_2[idx] = (GAMMA * grel_AFM.j / 2) * (m2 ^ (m2 ^ pMesh->Heff2[idx]));
+		}
+	}
+
+	RunLBFGS_Advance(slot);
+}
+
+void DifferentialEquationAFM::RunLBFGS_Gradient(void)
+{
+	VEC<DBL3>& s = LBFGS_s(lbfgs_newest);
+	VEC<DBL3>& y = LBFGS_y(lbfgs_newest);
+	VEC<DBL3>& s2 = LBFGS_s_2(lbfgs_newest);
+	VEC<DBL3>& y2 = LBFGS_y_2(lbfgs_newest);
+
+	double _sy = 0.0, _yy = 0.0;
+	lbfgs_reduction.new_minmax_reduction();
+
+#pragma omp parallel for reduction(+:_sy, _yy)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			DBL2 grel_AFM = pMesh->grel_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+			DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+			DBL3 m2 = pMesh->M2[idx] / Ms_AFM.j;
+
+			DBL3 G = (GAMMA * grel_AFM.i / 2) * (m ^ (m ^ pMesh->Heff[idx]));
+			DBL3 G2 = (GAMMA * grel_AFM.j / 2) * (m2 ^ (m2 ^ pMesh->Heff2[idx]));
+
+			//complete newest correction pair at the current tangent planes : y holds -G from the previous step
+			s[idx] -= (s[idx] * m) * m;
+			y[idx] = y[idx] - (y[idx] * m) * m + G;
+
+			s2[idx] -= (s2[idx] * m2) * m2;
+			y2[idx] = y2[idx] - (y2[idx] * m2) * m2 + G2;
+
+			_sy += s[idx] * y[idx] + s2[idx] * y2[idx];
+			_yy += y[idx] * y[idx] + y2[idx] * y2[idx];
+
+			//search direction starts from the gradient
+			sEval6[idx] = G;
+			sEval6_2[idx] = G2;
+			lbfgs_reduction.reduce_max(maximum(G.norm(), G2.norm()));
+		}
+	}
+
+	lbfgs_reduction.maximum();
+
+	lbfgs_dot += _sy;
+	lbfgs_dot2 += _yy;
+	if (lbfgs_reduction.max > lbfgs_dirmax) lbfgs_dirmax = lbfgs_reduction.max;
+}
+
+void DifferentialEquationAFM::RunLBFGS_Project(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+	VEC<DBL3>& s2 = LBFGS_s_2(slot);
+	VEC<DBL3>& y2 = LBFGS_y_2(slot);
+
+	double _sq = 0.0, _sy = 0.0;
+
+#pragma omp parallel for reduction(+:_sq, _sy)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL3 m = pMesh->M[idx].normalized();
+			DBL3 m2 = pMesh->M2[idx].normalized();
+
+			s[idx] -= (s[idx] * m) * m;
+			y[idx] -= (y[idx] * m) * m;
+
+			s2[idx] -= (s2[idx] * m2) * m2;
+			y2[idx] -= (y2[idx] * m2) * m2;
+
+			_sq += s[idx] * sEval6[idx] + s2[idx] * sEval6_2[idx];
+			_sy += s[idx] * y[idx] + s2[idx] * y2[idx];
+		}
+	}
+
+	lbfgs_dot += _sq;
+	lbfgs_dot2 += _sy;
+}
+
+void DifferentialEquationAFM::RunLBFGS_Dot_Y(int slot)
+{
+	VEC<DBL3>& y = LBFGS_y(slot);
+	VEC<DBL3>& y2 = LBFGS_y_2(slot);
+
+	double _yq = 0.0;
+
+#pragma omp parallel for reduction(+:_yq)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			_yq += y[idx] * sEval6[idx] + y2[idx] * sEval6_2[idx];
+		}
+	}
+
+	lbfgs_dot += _yq;
+}
+
+void DifferentialEquationAFM::RunLBFGS_Update(int slot, double coeff, bool use_s)
+{
+	VEC<DBL3>& v = (use_s ? LBFGS_s(slot) : LBFGS_y(slot));
+	VEC<DBL3>& v2 = (use_s ? LBFGS_s_2(slot) : LBFGS_y_2(slot));
+
+	lbfgs_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			sEval6[idx] += coeff * v[idx];
+			sEval6_2[idx] += coeff * v2[idx];
+			lbfgs_reduction.reduce_max(maximum(sEval6[idx].norm(), sEval6_2[idx].norm()));
+		}
+	}
+
+	lbfgs_reduction.maximum();
+
+	if (lbfgs_reduction.max > lbfgs_dirmax) lbfgs_dirmax = lbfgs_reduction.max;
+}
+
+void DifferentialEquationAFM::RunLBFGS_Advance_withReductions(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+	VEC<DBL3>& s2 = LBFGS_s_2(slot);
+	VEC<DBL3>& y2 = LBFGS_y_2(slot);
+
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 grel_AFM = pMesh->grel_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+				DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+				DBL3 H = pMesh->Heff[idx];
+
+				DBL3 m2 = pMesh->M2[idx] / Ms_AFM.j;
+				DBL3 H2 = pMesh->Heff2[idx];
+
+				//obtained maximum normalized torque term
+				if (IsNZ(grel_AFM.i)) {
+
+					double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
+					mxh_reduction.reduce_max(_mxh);
+				}
+
+				//start next correction pair : step and -G, completed in RunLBFGS_Gradient
+				DBL3 v = -dT * sEval6[idx];
+				DBL3 v2 = -dT * sEval6_2[idx];
+				s[idx] = v;
+				s2[idx] = v2;
+				y[idx] = -(GAMMA * grel_AFM.i / 2) * (m ^ (m ^ H));
+				y2[idx] = -(GAMMA * grel_AFM.j / 2) * (m2 ^ (m2 ^ H2));
+
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				//Cayley transform along tangent vectors v, v2
+				double a = (v * v) / 4;
+				double a2 = (v2 * v2) / 4;
+				m = ((1 - a) * m + v) / (1 + a);
+				m2 = ((1 - a2) * m2 + v2) / (1 + a2);
+
+				pMesh->M[idx] = m * Ms_AFM.i;
+				pMesh->M2[idx] = m2 * Ms_AFM.j;
+
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+
+				if (calculate_dmdt && IsNZ(grel_AFM.i)) {
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * grel_AFM.i * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	mxh_reduction.maximum();
+	if (calculate_dmdt) dmdt_reduction.maximum();
+}
+
+void DifferentialEquationAFM::RunLBFGS_Advance(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+	VEC<DBL3>& s2 = LBFGS_s_2(slot);
+	VEC<DBL3>& y2 = LBFGS_y_2(slot);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				DBL2 grel_AFM = pMesh->grel_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->grel_AFM, grel_AFM);
+
+				DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+				DBL3 m2 = pMesh->M2[idx] / Ms_AFM.j;
+
+				//start next correction pair : step and -G, completed in RunLBFGS_Gradient
+				DBL3 v = -dT * sEval6[idx];
+				DBL3 v2 = -dT * sEval6_2[idx];
+				s[idx] = v;
+				s2[idx] = v2;
+				y[idx] = -(GAMMA * grel_AFM.i / 2) * (m ^ (m ^ pMesh->Heff[idx]));
+				y2[idx] = -(GAMMA * grel_AFM.j / 2) * (m2 ^ (m2 ^ pMesh->Heff2[idx]));
+
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+
+				//Cayley transform along tangent vectors v, v2
+				double a = (v * v) / 4;
+				double a2 = (v2 * v2) / 4;
+				m = ((1 - a) * m + v) / (1 + a);
+				m2 = ((1 - a2) * m2 + v2) / (1 + a2);
+
+				pMesh->M[idx] = m * Ms_AFM.i;
+				pMesh->M2[idx] = m2 * Ms_AFM.j;
+
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+}
+
+#endif
+#endif
@@ -0,0 +1,266 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_LSRK
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//--------------------------------------------- LOW-STORAGE RUNGE KUTTA CARPENTER-KENNEDY (4th order solution, 3rd order embedded error)
+
+//sEval0 and sEval0_2 are the stage registers (dM) for the two sub-lattices, sEval1 accumulates the error estimate (sub-lattice A only, as for the other methods).
+
+void DifferentialEquationAFM::RunLSRK45_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//Save current magnetization for later use
+			sM1[idx] = pMesh->M[idx];
+			sM1_2[idx] = pMesh->M2[idx];
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//obtain maximum normalized torque term
+				double Mnorm = pMesh->M[idx].norm();
+				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+				mxh_reduction.reduce_max(_mxh);
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//start stage and error registers
+				sEval0[idx] = rhs;
+				sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				sEval1[idx] = rhs * LSRK45_E0;
+
+				//Now estimate magnetization using LSRK first step
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B0 * dT);
+				pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B0 * dT);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK45_Step0(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//Save current magnetization for later use
+			sM1[idx] = pMesh->M[idx];
+			sM1_2[idx] = pMesh->M2[idx];
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//start stage and error registers
+				sEval0[idx] = rhs;
+				sEval0_2[idx] = Equation_Eval_2[omp_get_thread_num()];
+				sEval1[idx] = rhs * LSRK45_E0;
+
+				//Now estimate magnetization using LSRK first step
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B0 * dT);
+				pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B0 * dT);
+			}
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK45_Step1(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A1 + rhs;
+			sEval0_2[idx] = sEval0_2[idx] * LSRK45_A1 + Equation_Eval_2[omp_get_thread_num()];
+			sEval1[idx] += rhs * LSRK45_E1;
+
+			//Now estimate magnetization using LSRK midle step 1
+			pMesh->M[idx] += sEval0[idx] * (LSRK45_B1 * dT);
+			pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B1 * dT);
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK45_Step2(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A2 + rhs;
+			sEval0_2[idx] = sEval0_2[idx] * LSRK45_A2 + Equation_Eval_2[omp_get_thread_num()];
+			sEval1[idx] += rhs * LSRK45_E2;
+
+			//Now estimate magnetization using LSRK midle step 2
+			pMesh->M[idx] += sEval0[idx] * (LSRK45_B2 * dT);
+			pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B2 * dT);
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK45_Step3(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A3 + rhs;
+			sEval0_2[idx] = sEval0_2[idx] * LSRK45_A3 + Equation_Eval_2[omp_get_thread_num()];
+			sEval1[idx] += rhs * LSRK45_E3;
+
+			//Now estimate magnetization using LSRK midle step 3
+			pMesh->M[idx] += sEval0[idx] * (LSRK45_B3 * dT);
+			pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B3 * dT);
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunLSRK45_Step4_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//LSRK45 : 4th order evaluation
+				sEval0[idx] = sEval0[idx] * LSRK45_A4 + rhs;
+				sEval0_2[idx] = sEval0_2[idx] * LSRK45_A4 + Equation_Eval_2[omp_get_thread_num()];
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B4 * dT);
+				pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B4 * dT);
+
+				//difference from 3rd order embedded evaluation for adaptive time step
+				DBL3 error = (sEval1[idx] + rhs * LSRK45_E4) * dT;
+
+				if (renormalize) {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+
+				//obtained maximum dmdt term
+				double Mnorm = pMesh->M[idx].norm();
+				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(error) / pMesh->M[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+}
+
+void DifferentialEquationAFM::RunLSRK45_Step4(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//LSRK45 : 4th order evaluation
+				sEval0[idx] = sEval0[idx] * LSRK45_A4 + rhs;
+				sEval0_2[idx] = sEval0_2[idx] * LSRK45_A4 + Equation_Eval_2[omp_get_thread_num()];
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B4 * dT);
+				pMesh->M2[idx] += sEval0_2[idx] * (LSRK45_B4 * dT);
+
+				//difference from 3rd order embedded evaluation for adaptive time step
+				DBL3 error = (sEval1[idx] + rhs * LSRK45_E4) * dT;
+
+				if (renormalize) {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(error) / pMesh->M[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+}
+
+#endif
+#endif
@@ -39,10 +39,15 @@ void DifferentialEquationAFM::GenerateThermalField(void)
 				double Hth_const = s_eff * sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.i * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().i * deltaT));
 				double Hth_const_2 = s_eff * sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.j * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().j * deltaT));
 
-				H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-				H_Thermal_2[idx] = Hth_const_2 * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
+				//random numbers in this cell depend only on the seed, cell index and step
+				BorisCBRand::Stream rnd = prng.stream(idx, thermal_step);
+
+				H_Thermal[idx] = Hth_const * rnd.rand_gauss3<DBL3>(0, 1);
+				H_Thermal_2[idx] = Hth_const_2 * rnd.rand_gauss3<DBL3>(0, 1);
 			}
 		}
+
+		thermal_step++;
 	}
 }
 
@@ -78,8 +83,11 @@ void DifferentialEquationAFM::GenerateThermalField_and_Torque(void)
 				double Hth_const = s_eff * sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.i * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().i * deltaT));
 				double Hth_const_2 = s_eff * sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.j * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().j * deltaT));
 
-				H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-				H_Thermal_2[idx] = Hth_const_2 * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
+				//random numbers in this cell depend only on the seed, cell index and step
+				BorisCBRand::Stream rnd = prng.stream(idx, thermal_step);
+
+				H_Thermal[idx] = Hth_const * rnd.rand_gauss3<DBL3>(0, 1);
+				H_Thermal_2[idx] = Hth_const_2 * rnd.rand_gauss3<DBL3>(0, 1);
 
 				//2. Thermal Torque
 
@@ -87,10 +95,12 @@ void DifferentialEquationAFM::GenerateThermalField_and_Torque(void)
 				double Tth_const = s_eff * sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel.i * pMesh->Ms_AFM.get0().i / (MU0 * pMesh->h_s.dim() * deltaT));
 				double Tth_const_2 = s_eff * sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel.j * pMesh->Ms_AFM.get0().j / (MU0 * pMesh->h_s.dim() * deltaT));
 
-				Torque_Thermal[idx] = Tth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-				Torque_Thermal_2[idx] = Tth_const_2 * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
+				Torque_Thermal[idx] = Tth_const * rnd.rand_gauss3<DBL3>(0, 1);
+				Torque_Thermal_2[idx] = Tth_const_2 * rnd.rand_gauss3<DBL3>(0, 1);
 			}
 		}
+
+		thermal_step++;
 	}
 }
 
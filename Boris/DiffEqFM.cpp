@@ -6,6 +6,9 @@
 #include "Mesh_Ferromagnetic.h"
 #include "MeshParamsControl.h"
 
+//equations are defined inline, and the virtual equation methods must also be available here (constructor / destructor)
+#include "DiffEqFM_Equations.h"
+
 DifferentialEquationFM::DifferentialEquationFM(FMesh *pMesh):
 	DifferentialEquation(pMesh)
 {
@@ -122,6 +125,7 @@ BError DifferentialEquationFM::AllocateMemory(void)
 		break;
 
 	case EVAL_RKF56:
+	case EVAL_LBFGS:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
@@ -131,6 +135,11 @@ BError DifferentialEquationFM::AllocateMemory(void)
 		if (!sEval6.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_LSRK45:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
@@ -178,6 +187,8 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
 		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS &&
+		evalMethod != EVAL_LSRK45 &&
 		evalMethod != EVAL_SD) {
 
 		sEval0.clear();
@@ -189,7 +200,9 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS &&
+		evalMethod != EVAL_LSRK45) {
 
 		sEval1.clear();
 	}
@@ -199,7 +212,8 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval2.clear();
 	}
@@ -208,19 +222,22 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF45 &&
 		evalMethod != EVAL_RKCK45 &&
 		evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval3.clear();
 		sEval4.clear();
 	}
 
 	if (evalMethod != EVAL_RKDP54 &&
-		evalMethod != EVAL_RKF56) {
+		evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval5.clear();
 	}
 
-	if (evalMethod != EVAL_RKF56) {
+	if (evalMethod != EVAL_RKF56 &&
+		evalMethod != EVAL_LBFGS) {
 
 		sEval6.clear();
 	}
@@ -254,6 +271,13 @@ BError DifferentialEquationFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 {
 	BError error(CLASS_STR(DifferentialEquationFM));
 	
+	//seed thermal field generator : if prng_seed is set the same sequence is obtained on every run
+	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_PRNG)) {
+
+		prng.set_seed(pMesh->prng_seed == 0 ? GetSystemTickCount() : pMesh->prng_seed);
+		thermal_step = 0;
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE, UPDATECONFIG_ODE_SOLVER)) {
 
 		if (pMesh->link_stochastic) {
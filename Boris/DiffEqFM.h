@@ -10,11 +10,138 @@ class FMesh;
 #include "DiffEqFMCUDA.h"
 #endif
 
+//call instantiation of templated solver method for the currently set equation (equation_type)
+#define RUN_EQUATION_T(method) \
+Cache_Equation_Parameters(); \
+switch (equation_type) { \
+case EQ_LLG: method<EQ_LLG>(); break; \
+case EQ_LLGSTATIC: method<EQ_LLGSTATIC>(); break; \
+case EQ_LLGSTT: method<EQ_LLGSTT>(); break; \
+case EQ_LLB: method<EQ_LLB>(); break; \
+case EQ_LLBSTT: method<EQ_LLBSTT>(); break; \
+case EQ_SLLG: method<EQ_SLLG>(); break; \
+case EQ_SLLGSTT: method<EQ_SLLGSTT>(); break; \
+case EQ_SLLB: method<EQ_SLLB>(); break; \
+case EQ_SLLBSTT: method<EQ_SLLBSTT>(); break; \
+}
+
 class DifferentialEquationFM :
 	public DifferentialEquation
 {
 private:
 
+	//---------------------------------------- TEMPLATED SOLVER METHODS : DiffEqFM_Evals_*.cpp
+
+	//Solver methods with the equation selected at compile time (eq_type is an EQ_ value), so it can be inlined in the evaluation loops.
+	//The public solver methods call the instantiation for the currently set equation using RUN_EQUATION_T.
+
+#ifdef ODE_EVAL_COMPILATION_EULER
+	template <int eq_type> void RunEuler_withReductions_T(void);
+	template <int eq_type> void RunEuler_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_TEULER
+	template <int eq_type> void RunTEuler_Step0_withReductions_T(void);
+	template <int eq_type> void RunTEuler_Step0_T(void);
+	template <int eq_type> void RunTEuler_Step1_withReductions_T(void);
+	template <int eq_type> void RunTEuler_Step1_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_AHEUN
+	template <int eq_type> void RunAHeun_Step0_withReductions_T(void);
+	template <int eq_type> void RunAHeun_Step0_T(void);
+	template <int eq_type> void RunAHeun_Step1_withReductions_T(void);
+	template <int eq_type> void RunAHeun_Step1_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ABM
+	template <int eq_type> void RunABM_Predictor_withReductions_T(void);
+	template <int eq_type> void RunABM_Predictor_T(void);
+	template <int eq_type> void RunABM_Corrector_withReductions_T(void);
+	template <int eq_type> void RunABM_Corrector_T(void);
+	template <int eq_type> void RunABM_TEuler0_T(void);
+	template <int eq_type> void RunABM_TEuler1_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RK23
+	template <int eq_type> void RunRK23_Step0_withReductions_T(void);
+	template <int eq_type> void RunRK23_Step0_T(void);
+	template <int eq_type> void RunRK23_Step1_T(void);
+	template <int eq_type> void RunRK23_Step2_withReductions_T(void);
+	template <int eq_type> void RunRK23_Step2_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RK4
+	template <int eq_type> void RunRK4_Step0_withReductions_T(void);
+	template <int eq_type> void RunRK4_Step0_T(void);
+	template <int eq_type> void RunRK4_Step1_T(void);
+	template <int eq_type> void RunRK4_Step2_T(void);
+	template <int eq_type> void RunRK4_Step3_withReductions_T(void);
+	template <int eq_type> void RunRK4_Step3_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKF45
+	template <int eq_type> void RunRKF45_Step0_withReductions_T(void);
+	template <int eq_type> void RunRKF45_Step0_T(void);
+	template <int eq_type> void RunRKF45_Step1_T(void);
+	template <int eq_type> void RunRKF45_Step2_T(void);
+	template <int eq_type> void RunRKF45_Step3_T(void);
+	template <int eq_type> void RunRKF45_Step4_T(void);
+	template <int eq_type> void RunRKF45_Step5_withReductions_T(void);
+	template <int eq_type> void RunRKF45_Step5_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKF56
+	template <int eq_type> void RunRKF56_Step0_withReductions_T(void);
+	template <int eq_type> void RunRKF56_Step0_T(void);
+	template <int eq_type> void RunRKF56_Step1_T(void);
+	template <int eq_type> void RunRKF56_Step2_T(void);
+	template <int eq_type> void RunRKF56_Step3_T(void);
+	template <int eq_type> void RunRKF56_Step4_T(void);
+	template <int eq_type> void RunRKF56_Step5_T(void);
+	template <int eq_type> void RunRKF56_Step6_T(void);
+	template <int eq_type> void RunRKF56_Step7_withReductions_T(void);
+	template <int eq_type> void RunRKF56_Step7_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKCK
+	template <int eq_type> void RunRKCK45_Step0_withReductions_T(void);
+	template <int eq_type> void RunRKCK45_Step0_T(void);
+	template <int eq_type> void RunRKCK45_Step1_T(void);
+	template <int eq_type> void RunRKCK45_Step2_T(void);
+	template <int eq_type> void RunRKCK45_Step3_T(void);
+	template <int eq_type> void RunRKCK45_Step4_T(void);
+	template <int eq_type> void RunRKCK45_Step5_withReductions_T(void);
+	template <int eq_type> void RunRKCK45_Step5_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKDP
+	template <int eq_type> void RunRKDP54_Step0_withReductions_T(void);
+	template <int eq_type> void RunRKDP54_Step0_T(void);
+	template <int eq_type> void RunRKDP54_Step1_T(void);
+	template <int eq_type> void RunRKDP54_Step2_T(void);
+	template <int eq_type> void RunRKDP54_Step3_T(void);
+	template <int eq_type> void RunRKDP54_Step4_T(void);
+	template <int eq_type> void RunRKDP54_Step5_withReductions_T(void);
+	template <int eq_type> void RunRKDP54_Step5_T(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	template <int eq_type> void RunLSRK45_Step0_withReductions_T(void);
+	template <int eq_type> void RunLSRK45_Step0_T(void);
+	template <int eq_type> void RunLSRK45_Step1_T(void);
+	template <int eq_type> void RunLSRK45_Step2_T(void);
+	template <int eq_type> void RunLSRK45_Step3_T(void);
+	template <int eq_type> void RunLSRK45_Step4_withReductions_T(void);
+	template <int eq_type> void RunLSRK45_Step4_T(void);
+#endif
+
+	//evaluate the equation identified by eq_type (specializations in DiffEqFM_Equations.h)
+	template <int eq_type> DBL3 Equation_T(int idx);
+
+	//resolve spatially or temperature dependent parameters used by the evaluation methods and the set equation (LLG and SLLG types) before the evaluation loops (DiffEqFM_Equations.h)
+	void Cache_Equation_Parameters(void);
+
 public:
 
 	DifferentialEquationFM(FMesh *pMesh);
@@ -125,6 +252,17 @@ public:
 	void RunRKDP54_Step5(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK45
+	void RunLSRK45_Step0_withReductions(void);
+	void RunLSRK45_Step0(void);
+	void RunLSRK45_Step1(void);
+	void RunLSRK45_Step2(void);
+	void RunLSRK45_Step3(void);
+	void RunLSRK45_Step4_withReductions(void);
+	void RunLSRK45_Step4(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void);
@@ -137,7 +275,24 @@ public:
 	void RunSD_Advance(void);
 #endif
 
-	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+	//0. prime the L-BFGS solver : steepest descent step with stepsize dT, which also starts the first correction pair in given slot
+	void RunLBFGS_Start(int slot);
+	//1. gradient at the current magnetization : complete the newest correction pair and set search direction to the gradient
+	//must reset lbfgs_dot, lbfgs_dot2 (reduces s.y and y.y for the newest pair) and lbfgs_dirmax before running these across all meshes, also for passes 2 to 4
+	void RunLBFGS_Gradient(void);
+	//2. transport correction pair in given slot to the current tangent planes, reducing s.q and s.y
+	void RunLBFGS_Project(int slot);
+	//3. reduce y.q for correction pair in given slot
+	void RunLBFGS_Dot_Y(int slot);
+	//4. search direction update q += coeff * (s or y in given slot), reducing maximum length of q
+	void RunLBFGS_Update(int slot, double coeff, bool use_s);
+	//5. set new magnetization vectors along -dT * q, starting the next correction pair in given slot
+	void RunLBFGS_Advance_withReductions(int slot);
+	void RunLBFGS_Advance(int slot);
+#endif
+
+	//---------------------------------------- EQUATIONS : DiffEqFM_Equations.h
 
 	//Landau-Lifshitz-Gilbert equation
 	DBL3 LLG(int idx);
@@ -321,6 +476,17 @@ public:
 	void RunRKDP54_Step5(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LSRK
+	//LSRK45
+	void RunLSRK45_Step0_withReductions(void) {}
+	void RunLSRK45_Step0(void) {}
+	void RunLSRK45_Step1(void) {}
+	void RunLSRK45_Step2(void) {}
+	void RunLSRK45_Step3(void) {}
+	void RunLSRK45_Step4_withReductions(void) {}
+	void RunLSRK45_Step4(void) {}
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_SD
 	//0. prime the SD solver
 	void RunSD_Start(void) {}
@@ -333,6 +499,23 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+	//0. prime the L-BFGS solver : steepest descent step with stepsize dT, which also starts the first correction pair in given slot
+	void RunLBFGS_Start(int slot) {}
+	//1. gradient at the current magnetization : complete the newest correction pair and set search direction to the gradient
+	//must reset lbfgs_dot, lbfgs_dot2 (reduces s.y and y.y for the newest pair) and lbfgs_dirmax before running these across all meshes, also for passes 2 to 4
+	void RunLBFGS_Gradient(void) {}
+	//2. transport correction pair in given slot to the current tangent planes, reducing s.q and s.y
+	void RunLBFGS_Project(int slot) {}
+	//3. reduce y.q for correction pair in given slot
+	void RunLBFGS_Dot_Y(int slot) {}
+	//4. search direction update q += coeff * (s or y in given slot), reducing maximum length of q
+	void RunLBFGS_Update(int slot, double coeff, bool use_s) {}
+	//5. set new magnetization vectors along -dT * q, starting the next correction pair in given slot
+	void RunLBFGS_Advance_withReductions(int slot) {}
+	void RunLBFGS_Advance(int slot) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
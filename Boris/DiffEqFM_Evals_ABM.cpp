@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- ADAMS-BASHFORTH-MOULTON
 
-void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunABM_Predictor_withReductions_T(void)
 {
 	mxh_reduction.new_minmax_reduction();
 
@@ -30,7 +32,7 @@ void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
 				mxh_reduction.reduce_max(_mxh);
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
 				if (alternator) {
@@ -58,7 +60,13 @@ void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunABM_Predictor(void)
+void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
+{
+	RUN_EQUATION_T(RunABM_Predictor_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunABM_Predictor_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -71,7 +79,7 @@ void DifferentialEquationFM::RunABM_Predictor(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
 				if (alternator) {
@@ -89,7 +97,13 @@ void DifferentialEquationFM::RunABM_Predictor(void)
 	}
 }
 
-void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
+void DifferentialEquationFM::RunABM_Predictor(void)
+{
+	RUN_EQUATION_T(RunABM_Predictor_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunABM_Corrector_withReductions_T(void)
 {
 	dmdt_reduction.new_minmax_reduction();
 	lte_reduction.new_minmax_reduction();
@@ -102,7 +116,7 @@ void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//First save predicted magnetization for lte calculation
 				DBL3 saveM = pMesh->M[idx];
@@ -120,7 +134,7 @@ void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -136,7 +150,7 @@ void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -155,7 +169,13 @@ void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunABM_Corrector(void)
+void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
+{
+	RUN_EQUATION_T(RunABM_Corrector_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunABM_Corrector_T(void)
 {
 	lte_reduction.new_minmax_reduction();
 
@@ -167,7 +187,7 @@ void DifferentialEquationFM::RunABM_Corrector(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//First save predicted magnetization for lte calculation
 				DBL3 saveM = pMesh->M[idx];
@@ -185,7 +205,7 @@ void DifferentialEquationFM::RunABM_Corrector(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -196,7 +216,7 @@ void DifferentialEquationFM::RunABM_Corrector(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -205,7 +225,13 @@ void DifferentialEquationFM::RunABM_Corrector(void)
 	lte_reduction.maximum();
 }
 
-void DifferentialEquationFM::RunABM_TEuler0(void)
+void DifferentialEquationFM::RunABM_Corrector(void)
+{
+	RUN_EQUATION_T(RunABM_Corrector_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunABM_TEuler0_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -218,7 +244,7 @@ void DifferentialEquationFM::RunABM_TEuler0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				sEval0[idx] = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += sEval0[idx] * dT;
@@ -227,7 +253,13 @@ void DifferentialEquationFM::RunABM_TEuler0(void)
 	}
 }
 
-void DifferentialEquationFM::RunABM_TEuler1(void)
+void DifferentialEquationFM::RunABM_TEuler0(void)
+{
+	RUN_EQUATION_T(RunABM_TEuler0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunABM_TEuler1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -235,7 +267,7 @@ void DifferentialEquationFM::RunABM_TEuler1(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			DBL3 rhs = CALLFP(this, equation)(idx);
+			DBL3 rhs = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using the second trapezoidal Euler step equation
 			pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
@@ -243,5 +275,10 @@ void DifferentialEquationFM::RunABM_TEuler1(void)
 	}
 }
 
+void DifferentialEquationFM::RunABM_TEuler1(void)
+{
+	RUN_EQUATION_T(RunABM_TEuler1_T);
+}
+
 #endif
 #endif
\ No newline at end of file
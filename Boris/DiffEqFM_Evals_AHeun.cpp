@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- TRAPEZOIDAL EULER
 
-void DifferentialEquationFM::RunAHeun_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunAHeun_Step0_withReductions_T(void)
 {
 	mxh_av_reduction.new_average_reduction();
 
@@ -33,7 +35,7 @@ void DifferentialEquationFM::RunAHeun_Step0_withReductions(void)
 				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += rhs * dT;
@@ -50,7 +52,13 @@ void DifferentialEquationFM::RunAHeun_Step0_withReductions(void)
 	else mxh_reduction.max = 0.0;
 }
 
-void DifferentialEquationFM::RunAHeun_Step0(void)
+void DifferentialEquationFM::RunAHeun_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunAHeun_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunAHeun_Step0_T(void)
 {
 	//Trapezoidal Euler can be used for stochastic equations - generate thermal VECs at the start
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
@@ -67,7 +75,7 @@ void DifferentialEquationFM::RunAHeun_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += rhs * dT;
@@ -76,7 +84,13 @@ void DifferentialEquationFM::RunAHeun_Step0(void)
 	}
 }
 
-void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
+void DifferentialEquationFM::RunAHeun_Step0(void)
+{
+	RUN_EQUATION_T(RunAHeun_Step0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunAHeun_Step1_withReductions_T(void)
 {
 	dmdt_av_reduction.new_average_reduction();
 	lte_reduction.new_minmax_reduction();
@@ -89,7 +103,7 @@ void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//First save predicted magnetization for lte calculation
 				DBL3 saveM = pMesh->M[idx];
@@ -100,7 +114,7 @@ void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -115,7 +129,7 @@ void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -134,7 +148,13 @@ void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunAHeun_Step1(void)
+void DifferentialEquationFM::RunAHeun_Step1_withReductions(void)
+{
+	RUN_EQUATION_T(RunAHeun_Step1_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunAHeun_Step1_T(void)
 {
 	lte_reduction.new_minmax_reduction();
 
@@ -146,7 +166,7 @@ void DifferentialEquationFM::RunAHeun_Step1(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//First save predicted magnetization for lte calculation
 				DBL3 saveM = pMesh->M[idx];
@@ -157,7 +177,7 @@ void DifferentialEquationFM::RunAHeun_Step1(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -168,7 +188,7 @@ void DifferentialEquationFM::RunAHeun_Step1(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -177,5 +197,10 @@ void DifferentialEquationFM::RunAHeun_Step1(void)
 	lte_reduction.maximum();
 }
 
+void DifferentialEquationFM::RunAHeun_Step1(void)
+{
+	RUN_EQUATION_T(RunAHeun_Step1_T);
+}
+
 #endif
 #endif
\ No newline at end of file
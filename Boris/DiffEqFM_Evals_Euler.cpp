@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- EULER
 
-void DifferentialEquationFM::RunEuler_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunEuler_withReductions_T(void)
 {
 	mxh_av_reduction.new_average_reduction();
 	dmdt_av_reduction.new_average_reduction();
@@ -34,7 +36,7 @@ void DifferentialEquationFM::RunEuler_withReductions(void)
 				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += rhs * dT;
@@ -42,7 +44,7 @@ void DifferentialEquationFM::RunEuler_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -51,7 +53,7 @@ void DifferentialEquationFM::RunEuler_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 			}
 		}
@@ -71,7 +73,13 @@ void DifferentialEquationFM::RunEuler_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunEuler(void)
+void DifferentialEquationFM::RunEuler_withReductions(void)
+{
+	RUN_EQUATION_T(RunEuler_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunEuler_T(void)
 {
 	//Euler can be used for stochastic equations
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
@@ -88,7 +96,7 @@ void DifferentialEquationFM::RunEuler(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += rhs * dT;
@@ -96,19 +104,24 @@ void DifferentialEquationFM::RunEuler(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 			}
 		}
 	}
 }
 
+void DifferentialEquationFM::RunEuler(void)
+{
+	RUN_EQUATION_T(RunEuler_T);
+}
+
 #endif
 #endif
\ No newline at end of file
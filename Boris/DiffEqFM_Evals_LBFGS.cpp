@@ -0,0 +1,252 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+//Limited-memory BFGS energy minimizer on the unit sphere (two-loop recursion, Nocedal and Wright, Numerical Optimization, algorithm 7.4), no line search : one effective field evaluation per iteration as for SD.
+//The gradient is the SD torque G = (gamma/2) m x (m x Heff), so dT has the same meaning as the SD stepsize. Steps are taken with the same Cayley transform used for SD, so the norm is conserved.
+//Stored correction pairs are tangent vectors at previous magnetization values : they are transported to the current tangent planes by projection before use (vector transport, see Absil et al., Optimization Algorithms on Matrix Manifolds).
+//The ring buffer slot bookkeeping, curvature checks and stepsize scaling are done in the Iterate method; the methods here only stream through the mesh and reduce dot products.
+
+//--------------------------------------------- L-BFGS Minimizer
+
+void DifferentialEquationFM::RunLBFGS_Start(int slot)
+{
+	//search direction is the gradient for the first step
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			double grel = pMesh->grel;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+			DBL3 m = pMesh->M[idx] / Ms;
+
+			//multiplication by grel important : can set grel to zero in entire mesh, or parts of mesh, which results in spins freezing.
+			sEval6[idx] = (GAMMA * grel / 2) * (m ^ (m ^ pMesh->Heff[idx]));
+		}
+	}
+
+	RunLBFGS_Advance(slot);
+}
+
+void DifferentialEquationFM::RunLBFGS_Gradient(void)
+{
+	VEC<DBL3>& s = LBFGS_s(lbfgs_newest);
+	VEC<DBL3>& y = LBFGS_y(lbfgs_newest);
+
+	double _sy = 0.0, _yy = 0.0;
+	lbfgs_reduction.new_minmax_reduction();
+
+#pragma omp parallel for reduction(+:_sy, _yy)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			double grel = pMesh->grel;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+			DBL3 m = pMesh->M[idx] / Ms;
+			DBL3 G = (GAMMA * grel / 2) * (m ^ (m ^ pMesh->Heff[idx]));
+
+			//complete newest correction pair at the current tangent plane : y holds -G from the previous step
+			s[idx] -= (s[idx] * m) * m;
+			y[idx] = y[idx] - (y[idx] * m) * m + G;
+
+			_sy += s[idx] * y[idx];
+			_yy += y[idx] * y[idx];
+
+			//search direction starts from the gradient
+			sEval6[idx] = G;
+			lbfgs_reduction.reduce_max(G.norm());
+		}
+	}
+
+	lbfgs_reduction.maximum();
+
+	lbfgs_dot += _sy;
+	lbfgs_dot2 += _yy;
+	if (lbfgs_reduction.max > lbfgs_dirmax) lbfgs_dirmax = lbfgs_reduction.max;
+}
+
+void DifferentialEquationFM::RunLBFGS_Project(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+	double _sq = 0.0, _sy = 0.0;
+
+#pragma omp parallel for reduction(+:_sq, _sy)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL3 m = pMesh->M[idx].normalized();
+
+			s[idx] -= (s[idx] * m) * m;
+			y[idx] -= (y[idx] * m) * m;
+
+			_sq += s[idx] * sEval6[idx];
+			_sy += s[idx] * y[idx];
+		}
+	}
+
+	lbfgs_dot += _sq;
+	lbfgs_dot2 += _sy;
+}
+
+void DifferentialEquationFM::RunLBFGS_Dot_Y(int slot)
+{
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+	double _yq = 0.0;
+
+#pragma omp parallel for reduction(+:_yq)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			_yq += y[idx] * sEval6[idx];
+		}
+	}
+
+	lbfgs_dot += _yq;
+}
+
+void DifferentialEquationFM::RunLBFGS_Update(int slot, double coeff, bool use_s)
+{
+	VEC<DBL3>& v = (use_s ? LBFGS_s(slot) : LBFGS_y(slot));
+
+	lbfgs_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			sEval6[idx] += coeff * v[idx];
+			lbfgs_reduction.reduce_max(sEval6[idx].norm());
+		}
+	}
+
+	lbfgs_reduction.maximum();
+
+	if (lbfgs_reduction.max > lbfgs_dirmax) lbfgs_dirmax = lbfgs_reduction.max;
+}
+
+void DifferentialEquationFM::RunLBFGS_Advance_withReductions(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				double Ms = pMesh->Ms;
+				double grel = pMesh->grel;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+				DBL3 m = pMesh->M[idx] / Ms;
+				DBL3 H = pMesh->Heff[idx];
+
+				//obtained maximum normalized torque term
+				if (IsNZ(grel)) {
+
+					double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
+					mxh_reduction.reduce_max(_mxh);
+				}
+
+				//start next correction pair : step and -G, completed in RunLBFGS_Gradient
+				DBL3 v = -dT * sEval6[idx];
+				s[idx] = v;
+				y[idx] = -(GAMMA * grel / 2) * (m ^ (m ^ H));
+
+				sM1[idx] = pMesh->M[idx];
+
+				//Cayley transform along tangent vector v : same as the SD update with v = -dT * G
+				double a = (v * v) / 4;
+				m = ((1 - a) * m + v) / (1 + a);
+
+				pMesh->M[idx] = m * Ms;
+				pMesh->M[idx].renormalize(Ms);
+
+				if (calculate_dmdt && IsNZ(grel)) {
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * grel * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	mxh_reduction.maximum();
+	if (calculate_dmdt) dmdt_reduction.maximum();
+}
+
+void DifferentialEquationFM::RunLBFGS_Advance(int slot)
+{
+	VEC<DBL3>& s = LBFGS_s(slot);
+	VEC<DBL3>& y = LBFGS_y(slot);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				double Ms = pMesh->Ms;
+				double grel = pMesh->grel;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->grel, grel);
+
+				DBL3 m = pMesh->M[idx] / Ms;
+
+				//start next correction pair : step and -G, completed in RunLBFGS_Gradient
+				DBL3 v = -dT * sEval6[idx];
+				s[idx] = v;
+				y[idx] = -(GAMMA * grel / 2) * (m ^ (m ^ pMesh->Heff[idx]));
+
+				sM1[idx] = pMesh->M[idx];
+
+				//Cayley transform along tangent vector v : same as the SD update with v = -dT * G
+				double a = (v * v) / 4;
+				m = ((1 - a) * m + v) / (1 + a);
+
+				pMesh->M[idx] = m * Ms;
+				pMesh->M[idx].renormalize(Ms);
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+}
+
+#endif
+#endif
@@ -0,0 +1,289 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_LSRK
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
+
+//--------------------------------------------- LOW-STORAGE RUNGE KUTTA CARPENTER-KENNEDY (4th order solution, 3rd order embedded error)
+
+//sEval0 is the stage register (dM), sEval1 accumulates the error estimate. sM1 only kept to restore a failed step and for dM/dt.
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step0_withReductions_T(void)
+{
+	mxh_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//Save current magnetization for later use
+			sM1[idx] = pMesh->M[idx];
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//obtain maximum normalized torque term
+				double Mnorm = pMesh->M[idx].norm();
+				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+				mxh_reduction.reduce_max(_mxh);
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = Equation_T<eq_type>(idx);
+
+				//start stage and error registers
+				sEval0[idx] = rhs;
+				sEval1[idx] = rhs * LSRK45_E0;
+
+				//Now estimate magnetization using LSRK first step
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B0 * dT);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunLSRK45_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step0_T(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//Save current magnetization for later use
+			sM1[idx] = pMesh->M[idx];
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = Equation_T<eq_type>(idx);
+
+				//start stage and error registers
+				sEval0[idx] = rhs;
+				sEval1[idx] = rhs * LSRK45_E0;
+
+				//Now estimate magnetization using LSRK first step
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B0 * dT);
+			}
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK45_Step0(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step1_T(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = Equation_T<eq_type>(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A1 + rhs;
+			sEval1[idx] += rhs * LSRK45_E1;
+
+			//Now estimate magnetization using LSRK midle step 1
+			pMesh->M[idx] += sEval0[idx] * (LSRK45_B1 * dT);
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK45_Step1(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step1_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step2_T(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = Equation_T<eq_type>(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A2 + rhs;
+			sEval1[idx] += rhs * LSRK45_E2;
+
+			//Now estimate magnetization using LSRK midle step 2
+			pMesh->M[idx] += sEval0[idx] * (LSRK45_B2 * dT);
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK45_Step2(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step2_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step3_T(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = Equation_T<eq_type>(idx);
+
+			sEval0[idx] = sEval0[idx] * LSRK45_A3 + rhs;
+			sEval1[idx] += rhs * LSRK45_E3;
+
+			//Now estimate magnetization using LSRK midle step 3
+			pMesh->M[idx] += sEval0[idx] * (LSRK45_B3 * dT);
+		}
+	}
+}
+
+void DifferentialEquationFM::RunLSRK45_Step3(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step3_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step4_withReductions_T(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = Equation_T<eq_type>(idx);
+
+				//LSRK45 : 4th order evaluation
+				sEval0[idx] = sEval0[idx] * LSRK45_A4 + rhs;
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B4 * dT);
+
+				//difference from 3rd order embedded evaluation for adaptive time step
+				DBL3 error = (sEval1[idx] + rhs * LSRK45_E4) * dT;
+
+				if (renormalize) {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+
+				//obtained maximum dmdt term
+				double Mnorm = pMesh->M[idx].norm();
+				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(error) / pMesh->M[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+
+	lte_reduction.maximum();
+}
+
+void DifferentialEquationFM::RunLSRK45_Step4_withReductions(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step4_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunLSRK45_Step4_T(void)
+{
+	lte_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = Equation_T<eq_type>(idx);
+
+				//LSRK45 : 4th order evaluation
+				sEval0[idx] = sEval0[idx] * LSRK45_A4 + rhs;
+				pMesh->M[idx] += sEval0[idx] * (LSRK45_B4 * dT);
+
+				//difference from 3rd order embedded evaluation for adaptive time step
+				DBL3 error = (sEval1[idx] + rhs * LSRK45_E4) * dT;
+
+				if (renormalize) {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(error) / pMesh->M[idx].norm();
+				lte_reduction.reduce_max(_lte);
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	lte_reduction.maximum();
+}
+
+void DifferentialEquationFM::RunLSRK45_Step4(void)
+{
+	RUN_EQUATION_T(RunLSRK45_Step4_T);
+}
+
+#endif
+#endif
@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- RUNGE KUTTA 23 (Bogacki-Shampine) (2nd order adaptive step with FSAL, 3rd order evaluation)
 
-void DifferentialEquationFM::RunRK23_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRK23_Step0_withReductions_T(void)
 {
 	mxh_reduction.new_minmax_reduction();
 	lte_reduction.new_minmax_reduction();
@@ -28,7 +30,7 @@ void DifferentialEquationFM::RunRK23_Step0_withReductions(void)
 				mxh_reduction.reduce_max(_mxh);
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//2nd order evaluation for adaptive step
 				DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
@@ -56,7 +58,13 @@ void DifferentialEquationFM::RunRK23_Step0_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK23_Step0(void)
+void DifferentialEquationFM::RunRK23_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunRK23_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK23_Step0_T(void)
 {
 	//lte reductions needed for adaptive time step
 	lte_reduction.new_minmax_reduction();
@@ -69,7 +77,7 @@ void DifferentialEquationFM::RunRK23_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//2nd order evaluation for adaptive step
 				DBL3 prediction = sM1[idx] + (7 * sEval0[idx] / 24 + 1 * sEval1[idx] / 4 + 1 * sEval2[idx] / 3 + 1 * rhs / 8) * dT;
@@ -87,6 +95,11 @@ void DifferentialEquationFM::RunRK23_Step0(void)
 	lte_reduction.maximum();
 }
 
+void DifferentialEquationFM::RunRK23_Step0(void)
+{
+	RUN_EQUATION_T(RunRK23_Step0_T);
+}
+
 void DifferentialEquationFM::RunRK23_Step0_Advance(void)
 {
 #pragma omp parallel for
@@ -106,7 +119,8 @@ void DifferentialEquationFM::RunRK23_Step0_Advance(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK23_Step1(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRK23_Step1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -114,7 +128,7 @@ void DifferentialEquationFM::RunRK23_Step1(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			sEval1[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RK23 midle step 1
 			pMesh->M[idx] = sM1[idx] + 3 * sEval1[idx] * dT / 4;
@@ -122,7 +136,13 @@ void DifferentialEquationFM::RunRK23_Step1(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
+void DifferentialEquationFM::RunRK23_Step1(void)
+{
+	RUN_EQUATION_T(RunRK23_Step1_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK23_Step2_withReductions_T(void)
 {
 	dmdt_reduction.new_minmax_reduction();
 
@@ -134,7 +154,7 @@ void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval2[idx] = CALLFP(this, equation)(idx);
+				sEval2[idx] = Equation_T<eq_type>(idx);
 
 				//Now calculate 3rd order evaluation
 				pMesh->M[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
@@ -142,7 +162,7 @@ void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -154,7 +174,7 @@ void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -171,7 +191,13 @@ void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK23_Step2(void)
+void DifferentialEquationFM::RunRK23_Step2_withReductions(void)
+{
+	RUN_EQUATION_T(RunRK23_Step2_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK23_Step2_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -181,7 +207,7 @@ void DifferentialEquationFM::RunRK23_Step2(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval2[idx] = CALLFP(this, equation)(idx);
+				sEval2[idx] = Equation_T<eq_type>(idx);
 
 				//Now calculate 3rd order evaluation
 				pMesh->M[idx] = sM1[idx] + (2 * sEval0[idx] / 9 + 1 * sEval1[idx] / 3 + 4 * sEval2[idx] / 9) * dT;
@@ -189,19 +215,24 @@ void DifferentialEquationFM::RunRK23_Step2(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
 }
 
+void DifferentialEquationFM::RunRK23_Step2(void)
+{
+	RUN_EQUATION_T(RunRK23_Step2_T);
+}
+
 #endif
 #endif
\ No newline at end of file
@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- RK4
 
-void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRK4_Step0_withReductions_T(void)
 {
 	bool stochastic = H_Thermal.linear_size() != 0;
 
@@ -39,7 +41,7 @@ void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
 					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
 					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
+					sEval0[idx] = Equation_T<eq_type>(idx);
 
 					//Now estimate magnetization using RK4 midle step
 					pMesh->M[idx] += sEval0[idx] * (dT / 2);
@@ -80,7 +82,7 @@ void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
 					mxh_reduction.reduce_max(_mxh);
 
 					//First evaluate RHS of set equation at the current time step
-					sEval0[idx] = CALLFP(this, equation)(idx);
+					sEval0[idx] = Equation_T<eq_type>(idx);
 
 					//Now estimate magnetization using RK4 midle step
 					pMesh->M[idx] += sEval0[idx] * (dT / 2);
@@ -100,7 +102,13 @@ void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK4_Step0(void)
+void DifferentialEquationFM::RunRK4_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunRK4_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK4_Step0_T(void)
 {
 	//RK4 can be used for stochastic equations - generate thermal VECs at the start
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
@@ -117,7 +125,7 @@ void DifferentialEquationFM::RunRK4_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				sEval0[idx] = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using RK4 midle step
 				pMesh->M[idx] += sEval0[idx] * (dT / 2);
@@ -126,7 +134,13 @@ void DifferentialEquationFM::RunRK4_Step0(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK4_Step1(void)
+void DifferentialEquationFM::RunRK4_Step0(void)
+{
+	RUN_EQUATION_T(RunRK4_Step0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK4_Step1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -134,7 +148,7 @@ void DifferentialEquationFM::RunRK4_Step1(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			sEval1[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RK4 midle step
 			pMesh->M[idx] = sM1[idx] + sEval1[idx] * (dT / 2);
@@ -142,7 +156,13 @@ void DifferentialEquationFM::RunRK4_Step1(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK4_Step2(void)
+void DifferentialEquationFM::RunRK4_Step1(void)
+{
+	RUN_EQUATION_T(RunRK4_Step1_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK4_Step2_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -150,7 +170,7 @@ void DifferentialEquationFM::RunRK4_Step2(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+			sEval2[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RK4 last step
 			pMesh->M[idx] = sM1[idx] + sEval2[idx] * dT;
@@ -158,7 +178,13 @@ void DifferentialEquationFM::RunRK4_Step2(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
+void DifferentialEquationFM::RunRK4_Step2(void)
+{
+	RUN_EQUATION_T(RunRK4_Step2_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK4_Step3_withReductions_T(void)
 {
 	bool stochastic = H_Thermal.linear_size() != 0;
 
@@ -176,7 +202,7 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 				if (!pMesh->M.is_skipcell(idx)) {
 
 					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
+					DBL3 rhs = Equation_T<eq_type>(idx);
 
 					//Now estimate magnetization using previous RK4 evaluations
 					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
@@ -184,7 +210,7 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 					if (renormalize) {
 
 						double Ms = pMesh->Ms;
-						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 						pMesh->M[idx].renormalize(Ms);
 					}
 
@@ -195,7 +221,7 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 				else {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
@@ -225,7 +251,7 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 				if (!pMesh->M.is_skipcell(idx)) {
 
 					//First evaluate RHS of set equation at the current time step
-					DBL3 rhs = CALLFP(this, equation)(idx);
+					DBL3 rhs = Equation_T<eq_type>(idx);
 
 					//Now estimate magnetization using previous RK4 evaluations
 					pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
@@ -233,7 +259,7 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 					if (renormalize) {
 
 						double Ms = pMesh->Ms;
-						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 						pMesh->M[idx].renormalize(Ms);
 					}
 
@@ -245,7 +271,7 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 				else {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
@@ -263,7 +289,13 @@ void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRK4_Step3(void)
+void DifferentialEquationFM::RunRK4_Step3_withReductions(void)
+{
+	RUN_EQUATION_T(RunRK4_Step3_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRK4_Step3_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -273,7 +305,7 @@ void DifferentialEquationFM::RunRK4_Step3(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using previous RK4 evaluations
 				pMesh->M[idx] = sM1[idx] + (sEval0[idx] + 2 * sEval1[idx] + 2 * sEval2[idx] + rhs) * (dT / 6);
@@ -281,19 +313,24 @@ void DifferentialEquationFM::RunRK4_Step3(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
 }
 
+void DifferentialEquationFM::RunRK4_Step3(void)
+{
+	RUN_EQUATION_T(RunRK4_Step3_T);
+}
+
 #endif
 #endif
\ No newline at end of file
@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- RUNGE KUTTA DORMAND-PRINCE (4th order solution, 5th order error)
 
-void DifferentialEquationFM::RunRKDP54_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step0_withReductions_T(void)
 {
 	mxh_reduction.new_minmax_reduction();
 	lte_reduction.new_minmax_reduction();
@@ -28,7 +30,7 @@ void DifferentialEquationFM::RunRKDP54_Step0_withReductions(void)
 				mxh_reduction.reduce_max(_mxh);
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
 				DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
@@ -56,7 +58,13 @@ void DifferentialEquationFM::RunRKDP54_Step0_withReductions(void)
 	lte_reduction.maximum();
 }
 
-void DifferentialEquationFM::RunRKDP54_Step0(void)
+void DifferentialEquationFM::RunRKDP54_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step0_T(void)
 {
 	lte_reduction.new_minmax_reduction();
 
@@ -68,7 +76,7 @@ void DifferentialEquationFM::RunRKDP54_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now calculate 5th order evaluation for adaptive time step -> FSAL property (a full pass required for this to be valid)
 				DBL3 prediction = sM1[idx] + (5179 * sEval0[idx] / 57600 + 7571 * sEval2[idx] / 16695 + 393 * sEval3[idx] / 640 - 92097 * sEval4[idx] / 339200 + 187 * sEval5[idx] / 2100 + rhs / 40) * dT;
@@ -86,6 +94,11 @@ void DifferentialEquationFM::RunRKDP54_Step0(void)
 	lte_reduction.maximum();
 }
 
+void DifferentialEquationFM::RunRKDP54_Step0(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step0_T);
+}
+
 void DifferentialEquationFM::RunRKDP54_Step0_Advance(void)
 {
 #pragma omp parallel for
@@ -105,7 +118,8 @@ void DifferentialEquationFM::RunRKDP54_Step0_Advance(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKDP54_Step1(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -113,7 +127,7 @@ void DifferentialEquationFM::RunRKDP54_Step1(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			sEval1[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKDP midle step 1
 			pMesh->M[idx] = sM1[idx] + (3 * sEval0[idx] / 40 + 9 * sEval1[idx] / 40) * dT;
@@ -121,7 +135,13 @@ void DifferentialEquationFM::RunRKDP54_Step1(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKDP54_Step2(void)
+void DifferentialEquationFM::RunRKDP54_Step1(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step1_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step2_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -129,7 +149,7 @@ void DifferentialEquationFM::RunRKDP54_Step2(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+			sEval2[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKDP midle step 2
 			pMesh->M[idx] = sM1[idx] + (44 * sEval0[idx] / 45 - 56 * sEval1[idx] / 15 + 32 * sEval2[idx] / 9) * dT;
@@ -137,7 +157,13 @@ void DifferentialEquationFM::RunRKDP54_Step2(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKDP54_Step3(void)
+void DifferentialEquationFM::RunRKDP54_Step2(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step2_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step3_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -145,7 +171,7 @@ void DifferentialEquationFM::RunRKDP54_Step3(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval3[idx] = CALLFP(this, equation)(idx);
+			sEval3[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKDP midle step 3
 			pMesh->M[idx] = sM1[idx] + (19372 * sEval0[idx] / 6561 - 25360 * sEval1[idx] / 2187 + 64448 * sEval2[idx] / 6561 - 212 * sEval3[idx] / 729) * dT;
@@ -153,7 +179,13 @@ void DifferentialEquationFM::RunRKDP54_Step3(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKDP54_Step4(void)
+void DifferentialEquationFM::RunRKDP54_Step3(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step3_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step4_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -161,7 +193,7 @@ void DifferentialEquationFM::RunRKDP54_Step4(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval4[idx] = CALLFP(this, equation)(idx);
+			sEval4[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKDP midle step 4
 			pMesh->M[idx] = sM1[idx] + (9017 * sEval0[idx] / 3168 - 355 * sEval1[idx] / 33 + 46732 * sEval2[idx] / 5247 + 49 * sEval3[idx] / 176 - 5103 * sEval4[idx] / 18656) * dT;
@@ -169,7 +201,13 @@ void DifferentialEquationFM::RunRKDP54_Step4(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKDP54_Step5_withReductions(void)
+void DifferentialEquationFM::RunRKDP54_Step4(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step4_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step5_withReductions_T(void)
 {
 	dmdt_reduction.new_minmax_reduction();
 
@@ -181,7 +219,7 @@ void DifferentialEquationFM::RunRKDP54_Step5_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval5[idx] = CALLFP(this, equation)(idx);
+				sEval5[idx] = Equation_T<eq_type>(idx);
 
 				//RKDP54 : 5th order evaluation
 				pMesh->M[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
@@ -189,7 +227,7 @@ void DifferentialEquationFM::RunRKDP54_Step5_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -201,7 +239,7 @@ void DifferentialEquationFM::RunRKDP54_Step5_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -218,7 +256,13 @@ void DifferentialEquationFM::RunRKDP54_Step5_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKDP54_Step5(void)
+void DifferentialEquationFM::RunRKDP54_Step5_withReductions(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step5_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKDP54_Step5_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -228,7 +272,7 @@ void DifferentialEquationFM::RunRKDP54_Step5(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval5[idx] = CALLFP(this, equation)(idx);
+				sEval5[idx] = Equation_T<eq_type>(idx);
 
 				//RKDP54 : 5th order evaluation
 				pMesh->M[idx] = sM1[idx] + (35 * sEval0[idx] / 384 + 500 * sEval2[idx] / 1113 + 125 * sEval3[idx] / 192 - 2187 * sEval4[idx] / 6784 + 11 * sEval5[idx] / 84) * dT;
@@ -236,19 +280,24 @@ void DifferentialEquationFM::RunRKDP54_Step5(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
 }
 
+void DifferentialEquationFM::RunRKDP54_Step5(void)
+{
+	RUN_EQUATION_T(RunRKDP54_Step5_T);
+}
+
 #endif
 #endif
\ No newline at end of file
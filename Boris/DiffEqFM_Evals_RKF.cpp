@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- RUNGE KUTTA FEHLBERG (4th order solution, 5th order error)
 
-void DifferentialEquationFM::RunRKF45_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step0_withReductions_T(void)
 {
 	mxh_reduction.new_minmax_reduction();
 
@@ -30,7 +32,7 @@ void DifferentialEquationFM::RunRKF45_Step0_withReductions(void)
 				mxh_reduction.reduce_max(_mxh);
 
 				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				sEval0[idx] = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using RKF first step
 				pMesh->M[idx] += sEval0[idx] * (2 * dT / 9);
@@ -49,7 +51,13 @@ void DifferentialEquationFM::RunRKF45_Step0_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF45_Step0(void)
+void DifferentialEquationFM::RunRKF45_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step0_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -62,7 +70,7 @@ void DifferentialEquationFM::RunRKF45_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				sEval0[idx] = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using RKF first step
 				pMesh->M[idx] += sEval0[idx] * (2 * dT / 9);
@@ -71,7 +79,13 @@ void DifferentialEquationFM::RunRKF45_Step0(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF45_Step1(void)
+void DifferentialEquationFM::RunRKF45_Step0(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -79,7 +93,7 @@ void DifferentialEquationFM::RunRKF45_Step1(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			sEval1[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 1
 			pMesh->M[idx] = sM1[idx] + (sEval0[idx] / 12 + sEval1[idx] / 4) * dT;
@@ -87,7 +101,13 @@ void DifferentialEquationFM::RunRKF45_Step1(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF45_Step2(void)
+void DifferentialEquationFM::RunRKF45_Step1(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step1_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step2_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -95,7 +115,7 @@ void DifferentialEquationFM::RunRKF45_Step2(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+			sEval2[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 2
 			pMesh->M[idx] = sM1[idx] + (69 * sEval0[idx] / 128 - 243 * sEval1[idx] / 128 + 135 * sEval2[idx] / 64) * dT;
@@ -103,7 +123,13 @@ void DifferentialEquationFM::RunRKF45_Step2(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF45_Step3(void)
+void DifferentialEquationFM::RunRKF45_Step2(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step2_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step3_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -111,7 +137,7 @@ void DifferentialEquationFM::RunRKF45_Step3(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval3[idx] = CALLFP(this, equation)(idx);
+			sEval3[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 3
 			pMesh->M[idx] = sM1[idx] + (-17 * sEval0[idx] / 12 + 27 * sEval1[idx] / 4 - 27 * sEval2[idx] / 5 + 16 * sEval3[idx] / 15) * dT;
@@ -119,7 +145,13 @@ void DifferentialEquationFM::RunRKF45_Step3(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF45_Step4(void)
+void DifferentialEquationFM::RunRKF45_Step3(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step3_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step4_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -127,7 +159,7 @@ void DifferentialEquationFM::RunRKF45_Step4(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval4[idx] = CALLFP(this, equation)(idx);
+			sEval4[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 4
 			pMesh->M[idx] = sM1[idx] + (65 * sEval0[idx] / 432 - 5 * sEval1[idx] / 16 + 13 * sEval2[idx] / 16 + 4 * sEval3[idx] / 27 + 5 * sEval4[idx] / 144) * dT;
@@ -135,7 +167,13 @@ void DifferentialEquationFM::RunRKF45_Step4(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF45_Step5_withReductions(void)
+void DifferentialEquationFM::RunRKF45_Step4(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step4_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step5_withReductions_T(void)
 {
 	dmdt_reduction.new_minmax_reduction();
 	lte_reduction.new_minmax_reduction();
@@ -148,7 +186,7 @@ void DifferentialEquationFM::RunRKF45_Step5_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//4th order evaluation
 				pMesh->M[idx] = sM1[idx] + (sEval0[idx] / 9 + 9 * sEval2[idx] / 20 + 16 * sEval3[idx] / 45 + sEval4[idx] / 12) * dT;
@@ -159,7 +197,7 @@ void DifferentialEquationFM::RunRKF45_Step5_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -175,7 +213,7 @@ void DifferentialEquationFM::RunRKF45_Step5_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -194,7 +232,13 @@ void DifferentialEquationFM::RunRKF45_Step5_withReductions(void)
 	lte_reduction.maximum();
 }
 
-void DifferentialEquationFM::RunRKF45_Step5(void)
+void DifferentialEquationFM::RunRKF45_Step5_withReductions(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step5_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF45_Step5_T(void)
 {
 	lte_reduction.new_minmax_reduction();
 
@@ -206,7 +250,7 @@ void DifferentialEquationFM::RunRKF45_Step5(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//4th order evaluation
 				pMesh->M[idx] = sM1[idx] + (sEval0[idx] / 9 + 9 * sEval2[idx] / 20 + 16 * sEval3[idx] / 45 + sEval4[idx] / 12) * dT;
@@ -217,7 +261,7 @@ void DifferentialEquationFM::RunRKF45_Step5(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -228,7 +272,7 @@ void DifferentialEquationFM::RunRKF45_Step5(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -237,5 +281,10 @@ void DifferentialEquationFM::RunRKF45_Step5(void)
 	lte_reduction.maximum();
 }
 
+void DifferentialEquationFM::RunRKF45_Step5(void)
+{
+	RUN_EQUATION_T(RunRKF45_Step5_T);
+}
+
 #endif
 #endif
\ No newline at end of file
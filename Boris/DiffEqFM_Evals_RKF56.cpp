@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- RUNGE KUTTA FEHLBERG (4th order solution, 5th order error)
 
-void DifferentialEquationFM::RunRKF56_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step0_withReductions_T(void)
 {
 	mxh_reduction.new_minmax_reduction();
 
@@ -30,7 +32,7 @@ void DifferentialEquationFM::RunRKF56_Step0_withReductions(void)
 				mxh_reduction.reduce_max(_mxh);
 
 				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				sEval0[idx] = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using RKF first step
 				pMesh->M[idx] += sEval0[idx] * (dT / 6);
@@ -49,7 +51,13 @@ void DifferentialEquationFM::RunRKF56_Step0_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step0(void)
+void DifferentialEquationFM::RunRKF56_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step0_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -62,7 +70,7 @@ void DifferentialEquationFM::RunRKF56_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+				sEval0[idx] = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using RKF first step
 				pMesh->M[idx] += sEval0[idx] * (dT / 6);
@@ -71,7 +79,13 @@ void DifferentialEquationFM::RunRKF56_Step0(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step1(void)
+void DifferentialEquationFM::RunRKF56_Step0(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -79,7 +93,7 @@ void DifferentialEquationFM::RunRKF56_Step1(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval1[idx] = CALLFP(this, equation)(idx);
+			sEval1[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 1
 			pMesh->M[idx] = sM1[idx] + (4 * sEval0[idx] + 16 * sEval1[idx]) * dT / 75;
@@ -87,7 +101,13 @@ void DifferentialEquationFM::RunRKF56_Step1(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step2(void)
+void DifferentialEquationFM::RunRKF56_Step1(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step1_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step2_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -95,7 +115,7 @@ void DifferentialEquationFM::RunRKF56_Step2(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval2[idx] = CALLFP(this, equation)(idx);
+			sEval2[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 2
 			pMesh->M[idx] = sM1[idx] + (5 * sEval0[idx] / 6 - 8 * sEval1[idx] / 3 + 5 * sEval2[idx] / 2) * dT;
@@ -103,7 +123,13 @@ void DifferentialEquationFM::RunRKF56_Step2(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step3(void)
+void DifferentialEquationFM::RunRKF56_Step2(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step2_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step3_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -111,7 +137,7 @@ void DifferentialEquationFM::RunRKF56_Step3(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval3[idx] = CALLFP(this, equation)(idx);
+			sEval3[idx] = Equation_T<eq_type>(idx);
 
 			//Now estimate magnetization using RKF midle step 3
 			pMesh->M[idx] = sM1[idx] + (-8 * sEval0[idx] / 5 + 144 * sEval1[idx] / 25 - 4 * sEval2[idx] + 16 * sEval3[idx] / 25) * dT;
@@ -119,7 +145,13 @@ void DifferentialEquationFM::RunRKF56_Step3(void)
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step4(void)
+void DifferentialEquationFM::RunRKF56_Step3(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step3_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step4_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -127,14 +159,20 @@ void DifferentialEquationFM::RunRKF56_Step4(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval4[idx] = CALLFP(this, equation)(idx);
+			sEval4[idx] = Equation_T<eq_type>(idx);
 
 			pMesh->M[idx] = sM1[idx] + (361 * sEval0[idx] / 320 - 18 * sEval1[idx] / 5 + 407 * sEval2[idx] / 128 - 11 * sEval3[idx] / 80 + 55 * sEval4[idx] / 128) * dT;
 		}
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step5(void)
+void DifferentialEquationFM::RunRKF56_Step4(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step4_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step5_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -142,14 +180,20 @@ void DifferentialEquationFM::RunRKF56_Step5(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval5[idx] = CALLFP(this, equation)(idx);
+			sEval5[idx] = Equation_T<eq_type>(idx);
 
 			pMesh->M[idx] = sM1[idx] + (-11 * sEval0[idx] / 640 + 11 * sEval2[idx] / 256 - 11 * sEval3[idx] / 160 + 11 * sEval4[idx] / 256) * dT;
 		}
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step6(void)
+void DifferentialEquationFM::RunRKF56_Step5(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step5_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step6_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -157,14 +201,20 @@ void DifferentialEquationFM::RunRKF56_Step6(void)
 		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
 			//First evaluate RHS of set equation at the current time step
-			sEval6[idx] = CALLFP(this, equation)(idx);
+			sEval6[idx] = Equation_T<eq_type>(idx);
 
 			pMesh->M[idx] = sM1[idx] + (93 * sEval0[idx] / 640 - 18 * sEval1[idx] / 5 + 803 * sEval2[idx] / 256 - 11 * sEval3[idx] / 160 + 99 * sEval4[idx] / 256 + sEval6[idx]) * dT;
 		}
 	}
 }
 
-void DifferentialEquationFM::RunRKF56_Step7_withReductions(void)
+void DifferentialEquationFM::RunRKF56_Step6(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step6_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step7_withReductions_T(void)
 {
 	dmdt_reduction.new_minmax_reduction();
 	lte_reduction.new_minmax_reduction();
@@ -177,7 +227,7 @@ void DifferentialEquationFM::RunRKF56_Step7_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//5th order evaluation
 				pMesh->M[idx] = sM1[idx] + (31 * sEval0[idx] / 384 + 1125 * sEval2[idx] / 2816 + 9 * sEval3[idx] / 32 + 125 * sEval4[idx] / 768 + 5 * sEval5[idx] / 66) * dT;
@@ -188,7 +238,7 @@ void DifferentialEquationFM::RunRKF56_Step7_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -204,7 +254,7 @@ void DifferentialEquationFM::RunRKF56_Step7_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -223,7 +273,13 @@ void DifferentialEquationFM::RunRKF56_Step7_withReductions(void)
 	lte_reduction.maximum();
 }
 
-void DifferentialEquationFM::RunRKF56_Step7(void)
+void DifferentialEquationFM::RunRKF56_Step7_withReductions(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step7_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunRKF56_Step7_T(void)
 {
 	lte_reduction.new_minmax_reduction();
 
@@ -235,7 +291,7 @@ void DifferentialEquationFM::RunRKF56_Step7(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//5th order evaluation
 				pMesh->M[idx] = sM1[idx] + (31 * sEval0[idx] / 384 + 1125 * sEval2[idx] / 2816 + 9 * sEval3[idx] / 32 + 125 * sEval4[idx] / 768 + 5 * sEval5[idx] / 66) * dT;
@@ -246,7 +302,7 @@ void DifferentialEquationFM::RunRKF56_Step7(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -257,7 +313,7 @@ void DifferentialEquationFM::RunRKF56_Step7(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -266,5 +322,10 @@ void DifferentialEquationFM::RunRKF56_Step7(void)
 	lte_reduction.maximum();
 }
 
+void DifferentialEquationFM::RunRKF56_Step7(void)
+{
+	RUN_EQUATION_T(RunRKF56_Step7_T);
+}
+
 #endif
 #endif
\ No newline at end of file
@@ -7,10 +7,12 @@
 #include "Mesh_Ferromagnetic.h"
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
+#include "DiffEqFM_Equations.h"
 
 //--------------------------------------------- TRAPEZOIDAL EULER
 
-void DifferentialEquationFM::RunTEuler_Step0_withReductions(void)
+template <int eq_type>
+void DifferentialEquationFM::RunTEuler_Step0_withReductions_T(void)
 {
 	mxh_av_reduction.new_average_reduction();
 
@@ -33,7 +35,7 @@ void DifferentialEquationFM::RunTEuler_Step0_withReductions(void)
 				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += rhs * dT;
@@ -50,7 +52,13 @@ void DifferentialEquationFM::RunTEuler_Step0_withReductions(void)
 	else mxh_reduction.max = 0.0;
 }
 
-void DifferentialEquationFM::RunTEuler_Step0(void)
+void DifferentialEquationFM::RunTEuler_Step0_withReductions(void)
+{
+	RUN_EQUATION_T(RunTEuler_Step0_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunTEuler_Step0_T(void)
 {
 	//Trapezoidal Euler can be used for stochastic equations - generate thermal VECs at the start
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
@@ -67,7 +75,7 @@ void DifferentialEquationFM::RunTEuler_Step0(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization for the next time step
 				pMesh->M[idx] += rhs * dT;
@@ -76,7 +84,13 @@ void DifferentialEquationFM::RunTEuler_Step0(void)
 	}
 }
 
-void DifferentialEquationFM::RunTEuler_Step1_withReductions(void)
+void DifferentialEquationFM::RunTEuler_Step0(void)
+{
+	RUN_EQUATION_T(RunTEuler_Step0_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunTEuler_Step1_withReductions_T(void)
 {
 	dmdt_av_reduction.new_average_reduction();
 
@@ -88,7 +102,7 @@ void DifferentialEquationFM::RunTEuler_Step1_withReductions(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using the second trapezoidal Euler step equation
 				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
@@ -96,7 +110,7 @@ void DifferentialEquationFM::RunTEuler_Step1_withReductions(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 
@@ -107,7 +121,7 @@ void DifferentialEquationFM::RunTEuler_Step1_withReductions(void)
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
@@ -124,7 +138,13 @@ void DifferentialEquationFM::RunTEuler_Step1_withReductions(void)
 	}
 }
 
-void DifferentialEquationFM::RunTEuler_Step1(void)
+void DifferentialEquationFM::RunTEuler_Step1_withReductions(void)
+{
+	RUN_EQUATION_T(RunTEuler_Step1_withReductions_T);
+}
+
+template <int eq_type>
+void DifferentialEquationFM::RunTEuler_Step1_T(void)
 {
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -134,7 +154,7 @@ void DifferentialEquationFM::RunTEuler_Step1(void)
 			if (!pMesh->M.is_skipcell(idx)) {
 
 				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+				DBL3 rhs = Equation_T<eq_type>(idx);
 
 				//Now estimate magnetization using the second trapezoidal Euler step equation
 				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
@@ -142,19 +162,24 @@ void DifferentialEquationFM::RunTEuler_Step1(void)
 				if (renormalize) {
 
 					double Ms = pMesh->Ms;
-					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
 			}
 			else {
 
 				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->update_parameters_mcoarse_cached(idx, pMesh->Ms, Ms);
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
 	}
 }
 
+void DifferentialEquationFM::RunTEuler_Step1(void)
+{
+	RUN_EQUATION_T(RunTEuler_Step1_T);
+}
+
 #endif
 #endif
\ No newline at end of file
@@ -15,6 +15,7 @@ vector_lut<DifferentialEquation*> ODECommon::pODE;
 int ODECommon::setODE = ODE_LLG;
 
 Equation ODECommon::equation;
+int ODECommon::equation_type = EQ_LLG;
 
 //-----------------------------------Evaluation method modifiers
 
@@ -48,7 +49,7 @@ ODECommon::ODECommon(bool called_from_derived) :
 			VINFO(dT), VINFO(dTstoch), VINFO(time_stoch), VINFO(link_dTstoch),
 			VINFO(dTspeedup), VINFO(time_speedup), VINFO(link_dTspeedup),
 			VINFO(err_high_fail), VINFO(dT_increase), VINFO(dT_min), VINFO(dT_max), VINFO(eval_method_order),
-			VINFO(use_evaluation_speedup),
+			VINFO(use_evaluation_speedup), VINFO(evaluation_speedup_tolerance),
 			VINFO(moving_mesh), VINFO(moving_mesh_antisymmetric), VINFO(moving_mesh_threshold), VINFO(moving_mesh_dwshift)
 		}, {})
 {
@@ -82,14 +83,14 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 
 	//use a function pointer to assign equation to solve
 	//this approach saves on having to write out the evaluation methods for every equation, with possible impact on performance due to equation evaluation not being manually inlined
-	//tests for typical problems show this has virtually no impact on performance! Maybe the compiler has inlined the code for all the different equations used? (could check this)
-	//Or maybe the overhead from function calls is just insignificant for typical problems
+	//The ferromagnetic evaluation methods instead use equation_type to select a template instantiation with the equation resolved at compile time, so it can be inlined in the evaluation loops (see DiffEqFM_Equations.h)
 
 	switch (setODE_) {
 
 	case ODE_LLG:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLG;
+		equation_type = EQ_LLG;
 		renormalize = true;
 		solve_spin_current_mm = false;
 		break;
@@ -97,6 +98,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLGSTATIC:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLGStatic;
+		equation_type = EQ_LLGSTATIC;
 		renormalize = true;
 		solve_spin_current_mm = false;
 		break;
@@ -104,6 +106,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLGSTATICSA:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLGStatic;
+		equation_type = EQ_LLGSTATIC;
 		renormalize = true;
 		solve_spin_current_mm = true;
 		break;
@@ -111,6 +114,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLGSTT:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLGSTT;
+		equation_type = EQ_LLGSTT;
 		renormalize = true;
 		solve_spin_current_mm = false;
 		break;
@@ -118,6 +122,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLB:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLB;
+		equation_type = EQ_LLB;
 		renormalize = false;
 		solve_spin_current_mm = false;
 		break;
@@ -125,6 +130,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLBSTT:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLBSTT;
+		equation_type = EQ_LLBSTT;
 		renormalize = false;
 		solve_spin_current_mm = false;
 		break;
@@ -132,6 +138,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_SLLG:
 		setODE = setODE_;
 		equation = &DifferentialEquation::SLLG;
+		equation_type = EQ_SLLG;
 		renormalize = true;
 		solve_spin_current_mm = false;
 		break;
@@ -139,6 +146,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_SLLGSTT:
 		setODE = setODE_;
 		equation = &DifferentialEquation::SLLGSTT;
+		equation_type = EQ_SLLGSTT;
 		renormalize = true;
 		solve_spin_current_mm = false;
 		break;
@@ -146,6 +154,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_SLLB:
 		setODE = setODE_;
 		equation = &DifferentialEquation::SLLB;
+		equation_type = EQ_SLLB;
 		renormalize = false;
 		solve_spin_current_mm = false;
 		break;
@@ -153,6 +162,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_SLLBSTT:
 		setODE = setODE_;
 		equation = &DifferentialEquation::SLLBSTT;
+		equation_type = EQ_SLLBSTT;
 		renormalize = false;
 		solve_spin_current_mm = false;
 		break;
@@ -160,6 +170,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLGSA:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLG;
+		equation_type = EQ_LLG;
 		renormalize = true;
 		solve_spin_current_mm = true;
 		break;
@@ -167,6 +178,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_SLLGSA:
 		setODE = setODE_;
 		equation = &DifferentialEquation::SLLG;
+		equation_type = EQ_SLLG;
 		renormalize = true;
 		solve_spin_current_mm = true;
 		break;
@@ -174,6 +186,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_LLBSA:
 		setODE = setODE_;
 		equation = &DifferentialEquation::LLB;
+		equation_type = EQ_LLB;
 		renormalize = false;
 		solve_spin_current_mm = true;
 		break;
@@ -181,6 +194,7 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 	case ODE_SLLBSA:
 		setODE = setODE_;
 		equation = &DifferentialEquation::SLLB;
+		equation_type = EQ_SLLB;
 		renormalize = false;
 		solve_spin_current_mm = true;
 		break;
@@ -31,7 +31,7 @@ class ODECommon :
 	double, double, double, bool,
 	double, double, bool,
 	double, double, double, double, int,
-	int,
+	int, double,
 	bool, bool, double, double>,
 	std::tuple<>>,
 	public ODECommon_Base
@@ -59,6 +59,9 @@ protected:
 	//function pointer to equation to solve
 	static Equation equation;
 
+	//equation function pointed to by equation, as an EQ_ value : evaluation methods use this to select an instantiation with the equation resolved at compile time
+	static int equation_type;
+
 	//-----------------------------------Evaluation method modifiers
 
 	//only renormalize M after solving for a time step for some equations. For LLB type equations must not renormalize.
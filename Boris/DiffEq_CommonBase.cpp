@@ -46,6 +46,8 @@ int ODECommon_Base::evalStep = 0;
 
 int ODECommon_Base::use_evaluation_speedup = (int)EVALSPEEDUP_NONE;
 
+double ODECommon_Base::evaluation_speedup_tolerance = 0.0;
+
 //-----------------------------------mxh and dmdt
 
 double ODECommon_Base::mxh = 1.0;
@@ -74,6 +76,13 @@ bool ODECommon_Base::primed = false;
 
 int ODECommon_Base::sd_reset_consecutive_iters = 0;
 
+double ODECommon_Base::lbfgs_rho[LBFGS_MEMORY] = {};
+int ODECommon_Base::lbfgs_newest = 0;
+
+double ODECommon_Base::lbfgs_dot = 0.0;
+double ODECommon_Base::lbfgs_dot2 = 0.0;
+double ODECommon_Base::lbfgs_dirmax = 0.0;
+
 //-----------------------------------Moving mesh data
 
 bool ODECommon_Base::moving_mesh = false;
@@ -91,6 +91,9 @@ protected:
 	//this takes on a value from EVALSPEEDUP_ enum
 	static int use_evaluation_speedup;
 
+	//relative tolerance for the extrapolation residual in evaluation speedup mode : if set (not zero), step updates are skipped whilst the extrapolation residual is within tolerance
+	static double evaluation_speedup_tolerance;
+
 	//-----------------------------------mxh and dmdt
 
 	//to avoid calculating mxh every single iteration whether it's needed or not, only calculate it if this flag is set
@@ -139,6 +142,13 @@ protected:
 	//when we have to reset steepest descent keep track of it, so we can increase the reset time if we have to reset every iteration: can get stuck otherwise
 	static int sd_reset_consecutive_iters;
 
+	//L-BFGS minimizer : 1 / (s.y) for each correction pair in the ring buffer (0 if the pair must not be used), and slot of the newest pair
+	static double lbfgs_rho[LBFGS_MEMORY];
+	static int lbfgs_newest;
+
+	//L-BFGS minimizer : dot products and maximum search direction length reduced across all meshes (reset before running a pass over all meshes)
+	static double lbfgs_dot, lbfgs_dot2, lbfgs_dirmax;
+
 	//-----------------------------------Moving mesh data
 
 	//use moving mesh algorithm?
@@ -245,6 +255,7 @@ public:
 	void SetAdaptiveTimeStepCtrl(double err_high_fail, double dT_increase, double dT_min, double dT_max);
 
 	void SetEvaluationSpeedup(int status) { if (status >= EVALSPEEDUP_NONE && status < EVALSPEEDUP_NUMENTRIES) use_evaluation_speedup = status; }
+	void SetEvaluationSpeedupTolerance(double tolerance) { if (tolerance >= 0.0) evaluation_speedup_tolerance = tolerance; }
 
 	//----------------------------------- Moving Mesh Methods : DiffEq_CommonBase_MovingMesh.cpp
 
@@ -289,6 +300,7 @@ public:
 	bool SolveSpinCurrent(void) { return solve_spin_current_mm || solve_spin_current_a; }
 
 	int GetEvaluationSpeedup(void) { return use_evaluation_speedup; }
+	double GetEvaluationSpeedupTolerance(void) { return evaluation_speedup_tolerance; }
 
 	//----------------------------------- Value Getters
 
@@ -83,6 +83,16 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 	}
 	break;
 
+	case EVAL_LBFGS:
+	{
+		//as for SD : conservative starting stepsize, used for the first step and when the correction pairs have to be discarded
+		dT = LBFGS_DEFAULT_DT;
+		dT_min = LBFGS_MINDT;
+		dT_max = LBFGS_MAXDT;
+		eval_method_order = 1;
+	}
+	break;
+
 	default:
 	case EVAL_RKF45:
 	{
@@ -120,6 +130,18 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 	}
 	break;
 
+	case EVAL_LSRK45:
+	{
+		dT = LSRK_DEFAULT_DT;
+
+		err_high_fail = LSRK_RELERRFAIL;
+		dT_increase = LSRK_DTINCREASE;
+		dT_max = LSRK_MAXDT;
+		dT_min = LSRK_MINDT;
+		eval_method_order = 4;
+	}
+	break;
+
 	case EVAL_RKF56:
 	{
 		dT = RKF_DEFAULT_DT;
@@ -1398,6 +1398,152 @@ void ODECommon_Base::Iterate(void)
 	}
 	break;
 
+	case EVAL_LSRK45:
+	{
+#ifdef ODE_EVAL_COMPILATION_LSRK
+		switch (evalStep) {
+
+		case 0:
+		{
+			if (calculate_mxh) {
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK45_Step0_withReductions();
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK45_Step0_withReductions();
+				}
+
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+			else {
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK45_Step0();
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK45_Step0();
+				}
+			}
+
+			evalStep++;
+			available = false;
+		}
+		break;
+
+		case 1:
+		{
+			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+				podeSolver->pODE[idx]->RunLSRK45_Step1();
+			}
+
+			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLSRK45_Step1();
+			}
+
+			evalStep++;
+		}
+		break;
+
+		case 2:
+		{
+			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+				podeSolver->pODE[idx]->RunLSRK45_Step2();
+			}
+
+			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLSRK45_Step2();
+			}
+
+			evalStep++;
+		}
+		break;
+
+		case 3:
+		{
+			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+				podeSolver->pODE[idx]->RunLSRK45_Step3();
+			}
+
+			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLSRK45_Step3();
+			}
+
+			evalStep++;
+		}
+		break;
+
+		case 4:
+		{
+			if (calculate_dmdt) {
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK45_Step4_withReductions();
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK45_Step4_withReductions();
+				}
+
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+			else {
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLSRK45_Step4();
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLSRK45_Step4();
+				}
+			}
+
+			evalStep = 0;
+			time += dT;
+			stagetime += dT;
+			iteration++;
+			stageiteration++;
+			available = true;
+			dT_last = dT;
+
+			lte = 0.0;
+			podeSolver->Set_lte();
+			patom_odeSolver->Set_lte();
+
+			if (!SetAdaptiveTimeStep()) {
+
+				podeSolver->Restore();
+				patom_odeSolver->Restore();
+			}
+		}
+		break;
+		}
+#endif
+	}
+	break;
+
 	case EVAL_SD:
 	{
 #ifdef ODE_EVAL_COMPILATION_SD
@@ -1533,6 +1679,209 @@ void ODECommon_Base::Iterate(void)
 #endif
 	}
 	break;
+
+	case EVAL_LBFGS:
+	{
+#ifdef ODE_EVAL_COMPILATION_LBFGS
+		available = true;
+		dT_last = dT;
+
+		if (primed) {
+
+			//1. gradient at current magnetization, which also completes the newest correction pair (s.y and y.y reduced)
+			lbfgs_dot = 0.0;
+			lbfgs_dot2 = 0.0;
+			lbfgs_dirmax = 0.0;
+
+			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+				podeSolver->pODE[idx]->RunLBFGS_Gradient();
+			}
+
+			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLBFGS_Gradient();
+			}
+
+			//2. initial inverse Hessian scaling from the newest pair (Barzilai-Borwein stepsize). If the curvature condition fails discard all pairs and reset as for SD.
+			if (lbfgs_dot > 0.0 && lbfgs_dot2 > 0.0) {
+
+				dT = lbfgs_dot / lbfgs_dot2;
+				if (dT < dT_min) dT = dT_min;
+				if (dT > dT_max) dT = dT_max;
+				sd_reset_consecutive_iters = 0;
+			}
+			else {
+
+				for (int slot = 0; slot < LBFGS_MEMORY; slot++) lbfgs_rho[slot] = 0.0;
+
+				dT = (++sd_reset_consecutive_iters) * dT_min;
+				if (dT > dT_max) dT = dT_max;
+			}
+
+			//3. two-loop recursion, first loop from newest to oldest pair. Pairs are transported to the current tangent planes first, and dropped if s.y is no longer positive.
+			double alpha[LBFGS_MEMORY];
+
+			for (int i = 0; i < LBFGS_MEMORY; i++) {
+
+				int slot = (lbfgs_newest - i + LBFGS_MEMORY) % LBFGS_MEMORY;
+				if (lbfgs_rho[slot] <= 0.0) continue;
+
+				lbfgs_dot = 0.0;
+				lbfgs_dot2 = 0.0;
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLBFGS_Project(slot);
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLBFGS_Project(slot);
+				}
+
+				if (lbfgs_dot2 <= 0.0) {
+
+					lbfgs_rho[slot] = 0.0;
+					continue;
+				}
+
+				lbfgs_rho[slot] = 1.0 / lbfgs_dot2;
+				alpha[slot] = lbfgs_rho[slot] * lbfgs_dot;
+
+				lbfgs_dirmax = 0.0;
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLBFGS_Update(slot, -alpha[slot], false);
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLBFGS_Update(slot, -alpha[slot], false);
+				}
+			}
+
+			//second loop from oldest to newest pair. The search direction is kept divided by the initial scaling dT, so the step is -dT * q as for the SD stepsize.
+			for (int i = LBFGS_MEMORY - 1; i >= 0; i--) {
+
+				int slot = (lbfgs_newest - i + LBFGS_MEMORY) % LBFGS_MEMORY;
+				if (lbfgs_rho[slot] <= 0.0) continue;
+
+				lbfgs_dot = 0.0;
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLBFGS_Dot_Y(slot);
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLBFGS_Dot_Y(slot);
+				}
+
+				double beta = lbfgs_rho[slot] * dT * lbfgs_dot;
+
+				lbfgs_dirmax = 0.0;
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLBFGS_Update(slot, (alpha[slot] - beta) / dT, true);
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLBFGS_Update(slot, (alpha[slot] - beta) / dT, true);
+				}
+			}
+
+			//4. no line search : only limit the maximum rotation in any cell
+			if (dT * lbfgs_dirmax > LBFGS_MAXROTATION) dT = LBFGS_MAXROTATION / lbfgs_dirmax;
+
+			//5. set new magnetization vectors, starting the next correction pair in the oldest slot (not needed anymore)
+			int slot = (lbfgs_newest + 1) % LBFGS_MEMORY;
+
+			if (calculate_mxh || calculate_dmdt) {
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLBFGS_Advance_withReductions(slot);
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLBFGS_Advance_withReductions(slot);
+				}
+
+				if (calculate_mxh) {
+
+					calculate_mxh = false;
+					mxh = 0.0;
+					podeSolver->Set_mxh();
+					patom_odeSolver->Set_mxh();
+				}
+
+				if (calculate_dmdt) {
+
+					calculate_dmdt = false;
+					dmdt = 0.0;
+					podeSolver->Set_dmdt();
+					patom_odeSolver->Set_dmdt();
+				}
+			}
+			else {
+
+				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+					podeSolver->pODE[idx]->RunLBFGS_Advance(slot);
+				}
+
+				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+					patom_odeSolver->pODE[idx]->RunLBFGS_Advance(slot);
+				}
+			}
+
+			//new pair is usable once completed in the next gradient pass
+			lbfgs_newest = slot;
+			lbfgs_rho[slot] = 1.0;
+
+			iteration++;
+			stageiteration++;
+			time += dT;
+			stagetime += dT;
+		}
+		else {
+
+			dT = dT_min;
+
+			//0. prime the L-BFGS solver with a steepest descent step
+			for (int slot = 0; slot < LBFGS_MEMORY; slot++) lbfgs_rho[slot] = 0.0;
+
+			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+				podeSolver->pODE[idx]->RunLBFGS_Start(0);
+			}
+
+			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+				patom_odeSolver->pODE[idx]->RunLBFGS_Start(0);
+			}
+
+			lbfgs_newest = 0;
+			lbfgs_rho[0] = 1.0;
+
+			evalStep = 0;
+			iteration++;
+			stageiteration++;
+			time += dT;
+			stagetime += dT;
+			sd_reset_consecutive_iters = 0;
+			primed = true;
+		}
+#endif
+	}
+	break;
 	}
 }
 
@@ -1566,6 +1915,9 @@ double ODECommon_Base::Get_EvalStep_Time(void)
 	//RKDP54
 	static double evaltime_rkdp54[6] = { 0.0, 0.2, 0.3, 0.8, 8.0 / 9, 1.0 };
 
+	//LSRK45
+	static double evaltime_lsrk45[5] = { 0.0, 0.14965902199922912, 0.37040095736420475, 0.62225576313444320, 0.95828213067469026 };
+
 	switch (evalMethod) {
 
 	case EVAL_EULER:
@@ -1605,6 +1957,7 @@ double ODECommon_Base::Get_EvalStep_Time(void)
 	break;
 
 	case EVAL_SD:
+	case EVAL_LBFGS:
 	{
 		return time;
 	}
@@ -1633,6 +1986,12 @@ double ODECommon_Base::Get_EvalStep_Time(void)
 		return time + dT * evaltime_rkdp54[evalStep];
 	}
 	break;
+
+	case EVAL_LSRK45:
+	{
+		return time + dT * evaltime_lsrk45[evalStep];
+	}
+	break;
 	}
 
 	return time;
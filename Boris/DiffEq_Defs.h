@@ -62,11 +62,46 @@
 #define RKDP_MINDT	1e-15
 #define RKDP_DEFAULT_DT	0.5e-12
 
+//fixed parameters for LSRK45 adaptive time step
+#define LSRK_RELERRFAIL	1e-4
+#define LSRK_DTINCREASE	2
+#define LSRK_MAXDT	3e-12
+#define LSRK_MINDT	1e-15
+#define LSRK_DEFAULT_DT	0.5e-12
+
+//LSRK45 : Carpenter-Kennedy 5-stage 4th order 2N-storage scheme, written as dM = A * dM + rhs; M += B * dM * dT for each stage.
+//The embedded 3rd order solution uses bhat5 = 3/20 (close to the minimum norm choice, all bhat positive); error weights E = b - bhat are accumulated in a single register.
+#define LSRK45_A1	(-567301805773.0 / 1357537059087)
+#define LSRK45_A2	(-2404267990393.0 / 2016746695238)
+#define LSRK45_A3	(-3550918686646.0 / 2091501179385)
+#define LSRK45_A4	(-1275806237668.0 / 842570457699)
+
+#define LSRK45_B0	(1432997174477.0 / 9575080441755)
+#define LSRK45_B1	(5161836677717.0 / 13612068292357)
+#define LSRK45_B2	(1720146321549.0 / 2090206949498)
+#define LSRK45_B3	(3134564353537.0 / 4481467310338)
+#define LSRK45_B4	(2277821191437.0 / 14882151754819)
+
+#define LSRK45_E0	(-0.097783829131691938)
+#define LSRK45_E1	(0.21024997699401271)
+#define LSRK45_E2	(-0.14885396642924567)
+#define LSRK45_E3	(0.033330570598772917)
+#define LSRK45_E4	(0.0030572479681519925)
+
 //default dT -> for the SD solver this acts as the starting timestep and the value it resets to when needed
 #define SD_DEFAULT_DT	1e-15
 #define SD_MAXDT	1e-9
 #define SD_MINDT	SD_DEFAULT_DT
 
+//L-BFGS minimizer : dT is the initial inverse Hessian scaling (same units as the SD stepsize), starting and reset values as for SD.
+//Number of stored correction pairs is fixed by the available evaluation buffers (sEval0 to sEval5), sEval6 holds the search direction.
+#define LBFGS_MEMORY	3
+#define LBFGS_DEFAULT_DT	SD_DEFAULT_DT
+#define LBFGS_MAXDT	SD_MAXDT
+#define LBFGS_MINDT	SD_MINDT
+//maximum rotation angle (radians) allowed in any cell for one step - the quasi-Newton step is scaled down to respect this
+#define LBFGS_MAXROTATION	0.3
+
 //difficult to simulate when temperature is very close to the Curie temperature due to numerical instability, especially with stochastic equations. instead use an epsilon approach (units of Kelvin).
 #define TCURIE_EPSILON	0.5
 
@@ -90,6 +125,19 @@ enum ODE_ {
 	ODE_LLGSTATIC, ODE_LLGSTATICSA
 };
 
+//Equation functions used to evaluate the set ODE_ (several ODE_ entries share the same equation function, e.g. ODE_LLG and ODE_LLGSA).
+//Used to select the equation at compile time in the evaluation methods, so it can be inlined there.
+enum EQ_ {
+
+	EQ_LLG, EQ_LLGSTATIC, EQ_LLGSTT,
+
+	EQ_LLB, EQ_LLBSTT,
+
+	EQ_SLLG, EQ_SLLGSTT,
+
+	EQ_SLLB, EQ_SLLBSTT
+};
+
 //ODE evaluation methods enum - to keep bsm files backward compatible add new entries at the end
 enum EVAL_ { 
 
@@ -110,13 +158,16 @@ enum EVAL_ {
 	//Adaptive embedded error estimator, 4th order
 	EVAL_RKF45 = 4, EVAL_RKCK45 = 8, 
 
+	//Adaptive embedded error estimator, 4th order, low-storage (2N registers plus error register)
+	EVAL_LSRK45 = 11,
+
 	//Adaptive embedded error estimator, 5th order
 	EVAL_RKDP54 = 9, EVAL_RKF56 = 10,
 
 	//Energy minimizers
-	EVAL_SD = 6
+	EVAL_SD = 6, EVAL_LBFGS = 12
 
-}; //Current maximum : 10
+}; //Current maximum : 12
 
 //EVALSPEEDUP_NONE : evaluate all fields every step (default)
 //EVALSPEEDUP_STEP : use previously computed demag field
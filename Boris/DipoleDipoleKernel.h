@@ -57,8 +57,12 @@ protected:
 	//this initializes the convolution kernels for the given mesh dimensions. 2D is for n.z == 1.
 	BError Calculate_DipoleDipole_Kernels(bool include_self_demag = true)
 	{
-		if (n.z == 1) return Calculate_DipoleDipole_Kernels_2D(include_self_demag);
-		else return Calculate_DipoleDipole_Kernels_3D(include_self_demag);
+		BError error = (n.z == 1 ? Calculate_DipoleDipole_Kernels_2D(include_self_demag) : Calculate_DipoleDipole_Kernels_3D(include_self_demag));
+
+		//mixed precision convolution : also need single precision kernel copies
+		if (!error && single_precision) error = Set_Kernels_SP(Kdiag, Kodiag, K2D_odiag);
+
+		return error;
 	}
 
 	//-------------------------- RUN-TIME KERNEL MULTIPLICATION
@@ -0,0 +1,207 @@
+#include "stdafx.h"
+#include "EvalSpeedup.h"
+
+//-------------------Configuration
+
+//set evaluation speedup level and residual tolerance (0 to disable error control), clearing the history if changed. Fields must then be sized with Resize_Fields.
+void EvalSpeedup::Configure(int level_, double tolerance_)
+{
+	level = (level_ > EVALSPEEDUP_NONE && level_ < EVALSPEEDUP_NUMENTRIES ? level_ : 0);
+	tolerance = (tolerance_ > 0.0 ? tolerance_ : 0.0);
+
+	num_slots = (level ? level + (tolerance > 0.0) : 0);
+
+	Reset();
+}
+
+//clear saved fields history (e.g. after fields reallocated, or discontinuous change)
+void EvalSpeedup::Reset(void)
+{
+	history.clear();
+	time_saved.assign(num_slots, 0.0);
+
+	num_points = level;
+	eval_points = 0;
+
+	skip_interval = 0;
+	steps_skipped = 0;
+	residual_points = 0;
+
+	num_computations = 0;
+	num_extrapolations = 0;
+	last_residual = 0.0;
+}
+
+//size the saved fields for the configured level (cleared if disabled) : return false if out of memory
+bool EvalSpeedup::Resize_Fields(std::vector<VEC<DBL3>>& Hsaved, DBL3 h, Rect rect)
+{
+	Hsaved.clear();
+	Hsaved.resize(num_slots);
+
+	for (int slot = 0; slot < num_slots; slot++) {
+
+		if (!Hsaved[slot].resize(h, rect)) {
+
+			Hsaved.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//-------------------Evaluation
+
+//Lagrange coefficients for extrapolation to time from num saved fields (history[0] to history[num - 1]) : return false if saved times coincide (can't extrapolate)
+bool EvalSpeedup::Lagrange_Coefficients(double time, int num, double* coeff)
+{
+	for (int j = 0; j < num; j++) {
+
+		double time_j = time_saved[history[j]];
+
+		coeff[j] = 1.0;
+
+		for (int m = 0; m < num; m++) {
+
+			if (m == j) continue;
+
+			double time_m = time_saved[history[m]];
+			if (time_j == time_m) return false;
+
+			coeff[j] *= (time - time_m) / (time_j - time_m);
+		}
+	}
+
+	return true;
+}
+
+//decide what to do at the current evaluation, given step update recommendation from the ODE solver (Check_Step_Update) and evaluation time (Get_EvalStep_Time)
+EVALSPEEDUPSTEP_ EvalSpeedup::Check_Evaluation(bool step_update, double time)
+{
+	//not configured for evaluation speedup
+	if (!level) return EVALSPEEDUPSTEP_COMPUTE;
+
+	bool extrapolate_field = ((int)history.size() >= level);
+
+	//not enough saved fields yet : compute, and save if at a step update
+	if (!extrapolate_field && !step_update) return EVALSPEEDUPSTEP_COMPUTE;
+
+	//step update : compute and save, unless error control allows skipping it
+	if (step_update) {
+
+		if (extrapolate_field && steps_skipped < skip_interval) steps_skipped++;
+		else extrapolate_field = false;
+	}
+
+	if (extrapolate_field) {
+
+		eval_points = num_points;
+
+		//coinciding save times (e.g. time reset) : use the most recent save only
+		if (!Lagrange_Coefficients(time, eval_points, points_coeff)) {
+
+			eval_points = 1;
+			points_coeff[0] = 1.0;
+		}
+
+		for (int p = 0; p < eval_points; p++) points_slot[p] = history[p];
+
+		num_extrapolations++;
+
+		return EVALSPEEDUPSTEP_EXTRAPOLATE;
+	}
+
+	steps_skipped = 0;
+
+	//next unused slot, else overwrite the oldest save
+	bool history_full = ((int)history.size() == num_slots);
+	save_slot = (history_full ? history.back() : (int)history.size());
+
+	//with error control, set extrapolation coefficients from previous saves to the time of this field so residual can be measured
+	residual_points = 0;
+
+	if (error_control()) {
+
+		int available_points = std::min((int)history.size() - (int)history_full, level);
+
+		for (int num = 1; num <= available_points; num++) {
+
+			if (!Lagrange_Coefficients(time, num, coeff_residual[num - 1])) break;
+			residual_points = num;
+		}
+
+		if (residual_points) residual_max.assign(omp_get_num_procs() * (EVALSPEEDUP_NUMENTRIES + 1), 0.0);
+	}
+
+	time_saved[save_slot] = time;
+
+	return EVALSPEEDUPSTEP_COMPUTE_AND_SAVE;
+}
+
+//with error control, measure extrapolation residual for field just saved in a field set (call for all field sets controlled by this history, then Save_Done)
+void EvalSpeedup::Accumulate_Residual(std::vector<VEC<DBL3>>& Hsaved)
+{
+	if (!residual_points) return;
+
+	VEC<DBL3>& Hnew = Hsaved[save_slot];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < Hnew.linear_size(); idx++) {
+
+		double* pmax = &residual_max[omp_get_thread_num() * (EVALSPEEDUP_NUMENTRIES + 1)];
+
+		DBL3 value = Hnew[idx];
+
+		double value2 = value * value;
+		if (value2 > pmax[EVALSPEEDUP_NUMENTRIES]) pmax[EVALSPEEDUP_NUMENTRIES] = value2;
+
+		for (int num = 1; num <= residual_points; num++) {
+
+			DBL3 difference = value;
+			for (int j = 0; j < num; j++) difference -= Hsaved[history[j]][idx] * coeff_residual[num - 1][j];
+
+			double difference2 = difference * difference;
+			if (difference2 > pmax[num - 1]) pmax[num - 1] = difference2;
+		}
+	}
+}
+
+//field has been saved (in all field sets controlled by this history)
+void EvalSpeedup::Save_Done(void)
+{
+	if ((int)history.size() == num_slots) history.pop_back();
+	history.insert(history.begin(), save_slot);
+
+	num_computations++;
+
+	if (!residual_points) return;
+
+	//combine thread results
+	double max_field2 = 0.0;
+	double max_difference2[EVALSPEEDUP_NUMENTRIES] = {};
+
+	for (int tn = 0; tn < omp_get_num_procs(); tn++) {
+
+		double* pmax = &residual_max[tn * (EVALSPEEDUP_NUMENTRIES + 1)];
+
+		max_field2 = std::max(max_field2, pmax[EVALSPEEDUP_NUMENTRIES]);
+		for (int num = 1; num <= residual_points; num++) max_difference2[num - 1] = std::max(max_difference2[num - 1], pmax[num - 1]);
+	}
+
+	//only adapt once residual could be checked for all numbers of points (not while history is still filling up)
+	if (max_field2 > 0.0 && residual_points == level) {
+
+		//use number of points with smallest residual from now on (fewer points preferred if equal)
+		int best_num = 1;
+		for (int num = 2; num <= residual_points; num++) if (max_difference2[num - 1] < max_difference2[best_num - 1]) best_num = num;
+
+		num_points = best_num;
+		last_residual = sqrt(max_difference2[best_num - 1] / max_field2);
+
+		//skip more step updates while residual within tolerance, else fewer
+		if (last_residual <= tolerance) skip_interval = std::min(skip_interval + 1, max_skip);
+		else skip_interval /= 2;
+	}
+
+	residual_points = 0;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "BorisLib.h"
+#include "DiffEq_Defs.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Field history for evaluation speedup mode, used by modules computing long-range fields (demag, dipole-dipole, Oersted).
+//
+//	Fields computed at step updates are saved in a ring buffer, together with the times they were computed at. At other evaluations the field is
+//	obtained by polynomial (Lagrange) extrapolation from the most recent saved fields, using as many points as set by the evaluation speedup level.
+//	The saved fields themselves are held by the module (std::vector<VEC<DBL3>>, sized here), since some modules need mesh transfers on them,
+//	and a single history can control several field sets (e.g. one per mesh for multilayered convolution).
+//
+//	Error control (tolerance > 0) : every time a field is computed the extrapolation residual is also measured, i.e. the maximum difference between the
+//	computed field and the field extrapolated to the same time from previous saves, relative to the maximum computed field. This is done for all numbers of points up to the set level,
+//	and the one with smallest residual is used for subsequent extrapolations (adaptive order). If the residual is within tolerance, step updates are skipped
+//	(extrapolating instead) with the number of skipped step updates increasing after each successful check, else it is reduced.
+//	With zero tolerance every step update computes the field, and the set level is always used.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//what to do with the field at the current evaluation
+enum EVALSPEEDUPSTEP_ {
+
+	//compute field, no need to save it (not yet enough saved fields to extrapolate at this evaluation)
+	EVALSPEEDUPSTEP_COMPUTE,
+
+	//compute field and save it in the slot given by get_save_slot (Hsaved[slot], without self contribution if any), then call Save_Done
+	EVALSPEEDUPSTEP_COMPUTE_AND_SAVE,
+
+	//extrapolate field from saved fields using extrapolate
+	EVALSPEEDUPSTEP_EXTRAPOLATE
+};
+
+class EvalSpeedup {
+
+private:
+
+	//maximum number of step updates skipped when extrapolation residual is within tolerance
+	static const int max_skip = 8;
+
+	//evaluation speedup level : number of points for extrapolation (1 for step, 2 for linear, etc.). 0 if disabled.
+	int level = 0;
+
+	//relative tolerance for extrapolation residual (0 to disable error control)
+	double tolerance = 0.0;
+
+	//number of slots for saved fields : level, plus one with error control (the field being computed mustn't overwrite a saved field before the residual is checked)
+	int num_slots = 0;
+
+	//slots with saved fields, most recent first, and time each slot was saved at
+	std::vector<int> history;
+	std::vector<double> time_saved;
+
+	//slot to save field being computed (set by Check_Evaluation)
+	int save_slot = 0;
+
+	//number of points currently used for extrapolation (level, or adaptive with error control)
+	int num_points = 0;
+
+	//extrapolation for the current evaluation : number of points, saved fields slots and their coefficients
+	int eval_points = 0;
+	int points_slot[EVALSPEEDUP_NUMENTRIES];
+	double points_coeff[EVALSPEEDUP_NUMENTRIES];
+
+	//----------------- Error control
+
+	//number of step updates to skip after a field computation, and number skipped so far
+	int skip_interval = 0;
+	int steps_skipped = 0;
+
+	//extrapolation coefficients to the time of the field being computed, for num points (1 up to level) : coeff_residual[num - 1][j] for history[j]
+	double coeff_residual[EVALSPEEDUP_NUMENTRIES][EVALSPEEDUP_NUMENTRIES];
+
+	//number of previous saves residual can be checked for at this field computation
+	int residual_points = 0;
+
+	//per-thread maximum squared difference for each number of points (index num - 1), followed by maximum squared computed field : OmpThreads * (EVALSPEEDUP_NUMENTRIES + 1) entries
+	std::vector<double> residual_max;
+
+	//statistics : number of field computations and extrapolations done, and last measured residual (smallest over numbers of points)
+	int num_computations = 0, num_extrapolations = 0;
+	double last_residual = 0.0;
+
+private:
+
+	//Lagrange coefficients for extrapolation to time from num saved fields (history[0] to history[num - 1]) : return false if saved times coincide (can't extrapolate)
+	bool Lagrange_Coefficients(double time, int num, double* coeff);
+
+public:
+
+	EvalSpeedup(void) {}
+
+	//-------------------Configuration
+
+	//set evaluation speedup level and residual tolerance (0 to disable error control), clearing the history if changed. Fields must then be sized with Resize_Fields.
+	void Configure(int level_, double tolerance_);
+
+	//clear saved fields history (e.g. after fields reallocated, or discontinuous change)
+	void Reset(void);
+
+	//size the saved fields for the configured level (cleared if disabled) : return false if out of memory
+	//NOTE : the vector is cleared before being resized, since VEC cannot be copied once a mesh transfer has been initialized on it
+	bool Resize_Fields(std::vector<VEC<DBL3>>& Hsaved, DBL3 h, Rect rect);
+
+	//-------------------Evaluation
+
+	//decide what to do at the current evaluation, given step update recommendation from the ODE solver (Check_Step_Update) and evaluation time (Get_EvalStep_Time)
+	//Call once per evaluation (always EVALSPEEDUPSTEP_COMPUTE if not configured for evaluation speedup).
+	EVALSPEEDUPSTEP_ Check_Evaluation(bool step_update, double time);
+
+	//slot to save the field being computed in (EVALSPEEDUPSTEP_COMPUTE_AND_SAVE)
+	int get_save_slot(void) { return save_slot; }
+
+	//with error control, measure extrapolation residual for field just saved in a field set (call for all field sets controlled by this history, then Save_Done)
+	void Accumulate_Residual(std::vector<VEC<DBL3>>& Hsaved);
+
+	//field has been saved (in all field sets controlled by this history)
+	void Save_Done(void);
+
+	//extrapolated field at the current evaluation (EVALSPEEDUPSTEP_EXTRAPOLATE) in given cell, without the self contribution
+	DBL3 extrapolate(std::vector<VEC<DBL3>>& Hsaved, int idx)
+	{
+		DBL3 value = Hsaved[points_slot[0]][idx] * points_coeff[0];
+		for (int p = 1; p < eval_points; p++) value += Hsaved[points_slot[p]][idx] * points_coeff[p];
+		return value;
+	}
+
+	//-------------------Getters
+
+	bool error_control(void) { return tolerance > 0.0; }
+
+	int get_num_points(void) { return num_points; }
+	int get_skip_interval(void) { return skip_interval; }
+
+	int get_num_computations(void) { return num_computations; }
+	int get_num_extrapolations(void) { return num_extrapolations; }
+	double get_last_residual(void) { return last_residual; }
+};
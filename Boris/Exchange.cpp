@@ -105,53 +105,60 @@ BError Exch_6ngbr_Neu::MakeCUDAModule(void)
 	return error;
 }
 
-double Exch_6ngbr_Neu::UpdateField(void) 
+//FM mesh : add field contribution at non-empty cell idx to Heff, returning the energy density term to be summed (before final scaling)
+double Exch_6ngbr_Neu::UpdateField_FM_Cell(int idx)
 {
-	double energy = 0;
+	double Ms = pMesh->Ms;
+	double A = pMesh->A;
+	pMesh->update_parameters_mcoarse_cached(idx, pMesh->A, A, pMesh->Ms, Ms);
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	////////////////////////////////////// FERROMAGNETIC MESH /////////////////////////////////////
-	///////////////////////////////////////////////////////////////////////////////////////////////
+	//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see below; the delsq_neu evaluates to zero in the CMBND coupling direction.
+	DBL3 Hexch;
 
-	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
+	if (pMesh->base_temperature > 0.0 && pMesh->T_Curie > 0.0) {
 
-#pragma omp parallel for reduction(+:energy)
-		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		//for finite temperature simulations the magnetization length may have a spatial variation
+		//this will not affect the transverse torque (mxH), but will affect the longitudinal term in the sLLB equation (m.H) and cannot be neglected when close to Tc.
 
-			if (pMesh->M.is_not_empty(idx)) {
+		DBL33 Mg = pMesh->M.grad_neu(idx);
+		DBL3 dMdx = Mg.x, dMdy = Mg.y, dMdz = Mg.z;
 
-				double Ms = pMesh->Ms;
-				double A = pMesh->A;
-				pMesh->update_parameters_mcoarse(idx, pMesh->A, A, pMesh->Ms, Ms);
+		double delsq_Msq = 2 * pMesh->M[idx] * (pMesh->M.dxx_neu(idx) + pMesh->M.dyy_neu(idx) + pMesh->M.dzz_neu(idx)) + 2 * (dMdx * dMdx + dMdy * dMdy + dMdz * dMdz);
+		double Mnorm = pMesh->M[idx].norm();
+		Hexch = (2 * A / (MU0*Ms*Ms)) * (pMesh->M.delsq_neu(idx) - pMesh->M[idx] * delsq_Msq / (2 * Mnorm*Mnorm));
+	}
+	else {
 
-				//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see below; the delsq_neu evaluates to zero in the CMBND coupling direction.
-				DBL3 Hexch;
+		//zero temperature simulations : magnetization length could still vary but will only affect mxH term, so not needed for 0K simulations.
+		Hexch = (2 * A / (MU0*Ms*Ms)) * pMesh->M.delsq_neu(idx);
+	}
 
-				if (pMesh->base_temperature > 0.0 && pMesh->T_Curie > 0.0) {
+	pMesh->Heff[idx] += Hexch;
 
-					//for finite temperature simulations the magnetization length may have a spatial variation
-					//this will not affect the transverse torque (mxH), but will affect the longitudinal term in the sLLB equation (m.H) and cannot be neglected when close to Tc.
+	double energy_ = pMesh->M[idx] * Hexch;
 
-					DBL33 Mg = pMesh->M.grad_neu(idx);
-					DBL3 dMdx = Mg.x, dMdy = Mg.y, dMdz = Mg.z;
+	if (Module_Heff.linear_size()) Module_Heff[idx] = Hexch;
+	if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * (pMesh->M[idx] * Hexch) / 2;
 
-					double delsq_Msq = 2 * pMesh->M[idx] * (pMesh->M.dxx_neu(idx) + pMesh->M.dyy_neu(idx) + pMesh->M.dzz_neu(idx)) + 2 * (dMdx * dMdx + dMdy * dMdy + dMdz * dMdz);
-					double Mnorm = pMesh->M[idx].norm();
-					Hexch = (2 * A / (MU0*Ms*Ms)) * (pMesh->M.delsq_neu(idx) - pMesh->M[idx] * delsq_Msq / (2 * Mnorm*Mnorm));
-				}
-				else {
+	return energy_;
+}
 
-					//zero temperature simulations : magnetization length could still vary but will only affect mxH term, so not needed for 0K simulations.
-					Hexch = (2 * A / (MU0*Ms*Ms)) * pMesh->M.delsq_neu(idx);
-				}
+double Exch_6ngbr_Neu::UpdateField(void) 
+{
+	double energy = 0;
 
-				pMesh->Heff[idx] += Hexch;
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////// FERROMAGNETIC MESH /////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
 
-				energy += pMesh->M[idx] * Hexch;
+	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
 
-				if (Module_Heff.linear_size()) Module_Heff[idx] = Hexch;
-				if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * (pMesh->M[idx] * Hexch) / 2;
-			}
+		pMesh->cache_parameters_mcoarse(pMesh->A, pMesh->Ms);
+
+#pragma omp parallel for reduction(+:energy)
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) energy += UpdateField_FM_Cell(idx);
 		}
 	}
 
@@ -309,6 +316,36 @@ double Exch_6ngbr_Neu::UpdateField(void)
 	return this->energy;
 }
 
+//-------------------Fused local field evaluation
+
+bool Exch_6ngbr_Neu::FusedField_Available(void)
+{
+	//coupling to other meshes is added after the main loop, so cannot be fused with other modules
+	return pMesh->GetMeshType() == MESH_FERROMAGNETIC && !pMesh->GetMeshExchangeCoupling();
+}
+
+void Exch_6ngbr_Neu::FusedField_Prepare(void)
+{
+	pMesh->cache_parameters_mcoarse(pMesh->A, pMesh->Ms);
+}
+
+double Exch_6ngbr_Neu::FusedField_Cell(int idx)
+{
+	if (pMesh->M.is_not_empty(idx)) return UpdateField_FM_Cell(idx);
+	else return 0.0;
+}
+
+double Exch_6ngbr_Neu::FusedField_Finish(double energy)
+{
+	//average energy density, see UpdateField
+	if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * (pMesh->M.get_nonempty_cells()));
+	else energy = 0;
+
+	this->energy = energy;
+
+	return this->energy;
+}
+
 //-------------------Energy methods
 
 //FM mesh
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+
+#include "fftw3.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// FFTW planner settings shared by all fftw plans made in the program (convolution and kernel calculations)
+
+class FFTWPlanner {
+
+public:
+
+	//planner rigor flag used for all plans : FFTW_ESTIMATE, FFTW_MEASURE, FFTW_PATIENT (default) or FFTW_EXHAUSTIVE
+	static unsigned& rigor(void)
+	{
+		static unsigned rigor_ = FFTW_PATIENT;
+		return rigor_;
+	}
+
+	//names of rigor flags as used in the fftwplanner command
+	static std::string rigor_name(unsigned rigor_flag)
+	{
+		if (rigor_flag == FFTW_ESTIMATE) return "estimate";
+		else if (rigor_flag == FFTW_MEASURE) return "measure";
+		else if (rigor_flag == FFTW_EXHAUSTIVE) return "exhaustive";
+		else return "patient";
+	}
+
+	//set rigor flag from name : return false if name not recognized
+	static bool set_rigor(std::string name)
+	{
+		if (name == "estimate") rigor() = FFTW_ESTIMATE;
+		else if (name == "measure") rigor() = FFTW_MEASURE;
+		else if (name == "patient") rigor() = FFTW_PATIENT;
+		else if (name == "exhaustive") rigor() = FFTW_EXHAUSTIVE;
+		else return false;
+
+		return true;
+	}
+
+	//Wisdom accumulated by the planner is kept between program runs : import on startup, export on exit.
+	//With wisdom available, making a plan for a previously seen shape (at same or lower rigor) is almost instant.
+	static bool ImportWisdom(std::string fileName) { return fftw_import_wisdom_from_filename(fileName.c_str()); }
+	static bool ExportWisdom(std::string fileName) { return fftw_export_wisdom_to_filename(fileName.c_str()); }
+};
@@ -173,6 +173,13 @@ BError Heat::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 		//allocate memory for the heatEq_RHS auxiliary vector
 		if (success) success = malloc_vector(heatEq_RHS, pMesh->n_t.dim(), 0.0);
+
+		//implicit solvers with 2-temperature model also need the lattice auxiliary vector
+		if (success) {
+
+			if (tmtype == TMTYPE_2TM) success = malloc_vector(heatEq_RHS_l, pMesh->n_t.dim(), 0.0);
+			else heatEq_RHS_l.clear();
+		}
 	}
 
 	if (!success) return error(BERROR_OUTOFMEMORY_CRIT);
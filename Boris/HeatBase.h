@@ -34,8 +34,12 @@ protected:
 	int tmtype;
 
 	//evaluate heat equation and store result here. After this is done advance time for temperature based on values stored here.
+	//For implicit solvers this holds the explicit part of the (electron) temperature equation for the current time step.
 	std::vector<double> heatEq_RHS;
 
+	//implicit solvers with 2-temperature model only : explicit part of the lattice temperature equation for the current time step
+	std::vector<double> heatEq_RHS_l;
+
 	//ambient temperature and alpha boundary value used in Robin boundary conditions (Newton's law of cooling):
 	//Flux in direction of surface normal = alpha_boundary * (T_boundary - T_ambient)
 	//Note : alpha_boundary = 0 results in insulating boundary
@@ -64,6 +68,16 @@ protected:
 	//2-temperature model : itinerant electrons <-> lattice
 	virtual void IterateHeatEquation_2TM(double dT) = 0;
 
+	//Implicit time step (theta method : theta = 0.5 for Crank-Nicolson, theta = 1 for backward Euler), for both 1TM and 2TM.
+	//The implicit equations are solved with red-black Gauss-Seidel iterations, with CMBND cells set by SHeat after each iteration.
+
+	//before iterating the implicit solver for a time step dT, prime it : store explicit part of the equations (values at start of time step and heat sources)
+	virtual void PrimeHeatEquation_Implicit(double dT, double theta) = 0;
+
+	//take a single iteration of the implicit solver for time step dT (CMBND cells not set)
+	//Return un-normalized error (maximum change in temperature from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
+	virtual DBL2 IterateHeatEquation_Implicit(double dT, double theta) = 0;
+
 	//------------------Others
 
 	void SetRobinBoundaryConditions(void);
@@ -33,6 +33,8 @@ void Heat::SetBaseTemperature(double Temperature, bool force_set_uniform)
 			pMesh->Temp.setnonempty(Temperature);
 
 			if (pMesh->Temp_l.linear_size()) pMesh->Temp_l.setnonempty(Temperature);
+
+			pMesh->Temperature_Changed();
 		}
 	}
 	else {
@@ -54,6 +56,8 @@ void Heat::SetBaseTemperature(double Temperature, bool force_set_uniform)
 				}
 			}
 		}
+
+		pMesh->Temperature_Changed();
 	}
 }
 
@@ -83,6 +87,8 @@ void Heat::SetFromGlobalTemperature(VEC<double>& globalTemp)
 			if (pMesh->Temp_l.linear_size()) pMesh->Temp_l[idx] = pMesh->Temp[idx];
 		}
 	}
+
+	pMesh->Temperature_Changed();
 }
 
 //-------------------Others
@@ -108,6 +114,8 @@ void Heat::MoveMesh_Heat(double x_shift)
 	pMesh->Temp.shift_x(x_shift, shift_rect);
 
 	if (pMesh->Temp_l.linear_size()) pMesh->Temp_l.shift_x(x_shift, shift_rect);
+
+	pMesh->Temperature_Changed();
 }
 
 #endif
\ No newline at end of file
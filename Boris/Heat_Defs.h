@@ -14,3 +14,19 @@ enum TMTYPE_ {
 	TMTYPE_2TM,
 	TMTYPE_NUMMODELS
 };
+
+//heat equation time integration method :
+
+//FTCS : explicit forward time centered space (default). Time step limited by the diffusion stability bound.
+
+//CN : Crank-Nicolson (implicit, unconditionally stable, second order in time)
+
+//BE : backward Euler (implicit, unconditionally stable, first order in time but strongly damped so better suited to very large time steps)
+
+enum HEATSOLVER_ {
+
+	HEATSOLVER_FTCS = 0,
+	HEATSOLVER_CN,
+	HEATSOLVER_BE,
+	HEATSOLVER_NUMOPTIONS
+};
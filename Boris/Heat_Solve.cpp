@@ -84,9 +84,16 @@ void Heat::IterateHeatEquation_1TM(double dT)
 
 		double time = pSMesh->GetStageTime();
 
+		//heat source evaluated for a whole row along x in one call (relative x positions are the same for all rows)
+		std::vector<double> x_row(pMesh->n_t.x), Q_row(pMesh->n_t.x);
+		for (int i = 0; i < pMesh->n_t.x; i++) x_row[i] = (i + 0.5) * pMesh->h_t.x;
+
 		//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
 		for (int j = 0; j < pMesh->n_t.y; j++) {
 			for (int k = 0; k < pMesh->n_t.z; k++) {
+
+				Q_equation.evaluate_many(pMesh->n_t.x, x_row.data(), (j + 0.5) * pMesh->h_t.y, (k + 0.5) * pMesh->h_t.z, time, Q_row.data());
+
 				for (int i = 0; i < pMesh->n_t.x; i++) {
 
 					int idx = i + j * pMesh->n_t.x + k * pMesh->n_t.x*pMesh->n_t.y;
@@ -123,8 +130,7 @@ void Heat::IterateHeatEquation_1TM(double dT)
 					}
 
 					//add heat source contribution
-					DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h_t;
-					double Q = Q_equation.evaluate(relpos.x, relpos.y, relpos.z, time);
+					double Q = Q_row[i];
 
 					heatEq_RHS[idx] += Q / cro;
 				}
@@ -225,9 +231,16 @@ void Heat::IterateHeatEquation_2TM(double dT)
 
 		double time = pSMesh->GetStageTime();
 
+		//heat source evaluated for a whole row along x in one call (relative x positions are the same for all rows)
+		std::vector<double> x_row(pMesh->n_t.x), Q_row(pMesh->n_t.x);
+		for (int i = 0; i < pMesh->n_t.x; i++) x_row[i] = (i + 0.5) * pMesh->h_t.x;
+
 		//1. First solve the RHS of the heat equation (centered space) : dT/dt = k del_sq T + j^2, where k = K/ c*ro , j^2 = Jc^2 / (c*ro*sigma)
 		for (int j = 0; j < pMesh->n_t.y; j++) {
 			for (int k = 0; k < pMesh->n_t.z; k++) {
+
+				Q_equation.evaluate_many(pMesh->n_t.x, x_row.data(), (j + 0.5) * pMesh->h_t.y, (k + 0.5) * pMesh->h_t.z, time, Q_row.data());
+
 				for (int i = 0; i < pMesh->n_t.x; i++) {
 
 					int idx = i + j * pMesh->n_t.x + k * pMesh->n_t.x*pMesh->n_t.y;
@@ -270,8 +283,7 @@ void Heat::IterateHeatEquation_2TM(double dT)
 						}
 
 						//add heat source contribution
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h_t;
-						double Q = Q_equation.evaluate(relpos.x, relpos.y, relpos.z, time);
+						double Q = Q_row[i];
 
 						heatEq_RHS[idx] += Q / cro_e;
 					}
@@ -297,6 +309,193 @@ void Heat::IterateHeatEquation_2TM(double dT)
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////// IMPLICIT SOLVER ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+//Theta method for both 1TM and 2TM (theta = 0.5 : Crank-Nicolson, theta = 1 : backward Euler). Heat sources are evaluated at the start of the time step.
+//1TM : cro * (T' - T) / dT = theta * K delsq T' + (1 - theta) * K delsq T + S
+//2TM : cro_e * (T' - T) / dT = theta * (K delsq T' - G (T' - Tl')) + (1 - theta) * (K delsq T - G (T - Tl)) + S
+//		cro_l * (Tl' - Tl) / dT = theta * G (T' - Tl') + (1 - theta) * G (T - Tl)
+//The lattice equation is local so Tl' is eliminated in each cell : Tl' = (Tl* + a T') / (1 + a), where Tl* is the explicit part and a = theta * dT * G / cro_l.
+
+//heat source (Joule heating and Q) at cell idx, using given stage time for Q equation if set
+double Heat::Evaluate_HeatSource(int idx, double time)
+{
+	double source = 0.0;
+
+	//Joule heating if set
+	if (pMesh->E.linear_size()) {
+
+		double joule_eff = pMesh->joule_eff;
+		pMesh->update_parameters_tcoarse(idx, pMesh->joule_eff, joule_eff);
+
+		if (IsNZ(joule_eff)) {
+
+			DBL3 position = pMesh->Temp.cellidx_to_position(idx);
+
+			double elC_value = pMesh->elC.weighted_average(position, pMesh->Temp.h);
+			DBL3 E_value = pMesh->E.weighted_average(position, pMesh->Temp.h);
+
+			source += joule_eff * (elC_value * E_value * E_value);
+		}
+	}
+
+	//heat source contribution if set
+	if (Q_equation.is_set()) {
+
+		DBL3 relpos = pMesh->Temp.cellidx_to_position(idx);
+		source += Q_equation.evaluate(relpos.x, relpos.y, relpos.z, time);
+	}
+	else if (IsNZ(pMesh->Q.get0())) {
+
+		double Q = pMesh->Q;
+		pMesh->update_parameters_tcoarse(idx, pMesh->Q, Q);
+
+		source += Q;
+	}
+
+	return source;
+}
+
+//before iterating the implicit solver for a time step dT, prime it : store explicit part of the equations (values at start of time step and heat sources)
+void Heat::PrimeHeatEquation_Implicit(double dT, double theta)
+{
+	//1. heat sources at start of time step
+	if (!Q_equation.is_set()) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
+
+			if (pMesh->Temp.is_not_empty(idx)) heatEq_RHS[idx] = Evaluate_HeatSource(idx, 0.0);
+		}
+	}
+	else {
+
+		//text equation evaluated without OpenMP, as for FTCS
+		double time = pSMesh->GetStageTime();
+
+		for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
+
+			if (pMesh->Temp.is_not_empty(idx)) heatEq_RHS[idx] = Evaluate_HeatSource(idx, time);
+		}
+	}
+
+	//2. explicit part of the equations
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->Temp.linear_size(); idx++) {
+
+		if (!pMesh->Temp.is_not_empty(idx)) continue;
+
+		double density = pMesh->density;
+		double shc = pMesh->shc;
+		double thermCond = pMesh->thermCond;
+		pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->thermCond, thermCond);
+
+		double K = thermCond;
+
+		if (tmtype == TMTYPE_2TM) {
+
+			double shc_e = pMesh->shc_e;
+			double G_el = pMesh->G_e;
+			pMesh->update_parameters_tcoarse(idx, pMesh->shc_e, shc_e, pMesh->G_e, G_el);
+
+			double cro_e = density * shc_e;
+			double cro_l = density * (shc - shc_e);
+
+			double coupling = G_el * (pMesh->Temp[idx] - pMesh->Temp_l[idx]);
+
+			if (pMesh->Temp.is_not_cmbnd(idx)) heatEq_RHS[idx] = pMesh->Temp[idx] + dT * ((1 - theta) * (pMesh->Temp.delsq_robin(idx, K) * K - coupling) + heatEq_RHS[idx]) / cro_e;
+			heatEq_RHS_l[idx] = pMesh->Temp_l[idx] + dT * (1 - theta) * coupling / cro_l;
+		}
+		else if (pMesh->Temp.is_not_cmbnd(idx)) {
+
+			double cro = density * shc;
+
+			heatEq_RHS[idx] = pMesh->Temp[idx] + dT * ((1 - theta) * pMesh->Temp.delsq_robin(idx, K) * K + heatEq_RHS[idx]) / cro;
+		}
+	}
+}
+
+//take a single iteration of the implicit solver for time step dT (CMBND cells not set)
+DBL2 Heat::IterateHeatEquation_Implicit(double dT, double theta)
+{
+	VEC_VC<double>& Temp = pMesh->Temp;
+
+	OmpReduction<double> reduction_change, reduction_value;
+	reduction_change.new_minmax_reduction();
+	reduction_value.new_minmax_reduction();
+
+	//red-black : two passes will be taken
+	for (int rb = 0; rb < 2; rb++) {
+
+#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < Temp.n.y * Temp.n.z; idx_jk++) {
+
+			int j = idx_jk % Temp.n.y;
+			int k = idx_jk / Temp.n.y;
+
+			//red_nudge = true for odd rows and even planes or for even rows and odd planes - have to keep index on the checkerboard pattern
+			bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
+
+			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < Temp.n.x; i += 2) {
+
+				int idx = i + j * Temp.n.x + k * Temp.n.x * Temp.n.y;
+
+				if (!Temp.is_not_empty(idx)) continue;
+
+				double density = pMesh->density;
+				double shc = pMesh->shc;
+				double thermCond = pMesh->thermCond;
+				pMesh->update_parameters_tcoarse(idx, pMesh->density, density, pMesh->shc, shc, pMesh->thermCond, thermCond);
+
+				double K = thermCond;
+
+				//delsq T = diagonal * T[idx] + offdiagonal
+				double diagonal = Temp.delsq_robin_diag(idx, K);
+				double offdiagonal = Temp.delsq_robin(idx, K) - diagonal * Temp[idx];
+
+				double old_value = Temp[idx];
+
+				if (tmtype == TMTYPE_2TM) {
+
+					double shc_e = pMesh->shc_e;
+					double G_el = pMesh->G_e;
+					pMesh->update_parameters_tcoarse(idx, pMesh->shc_e, shc_e, pMesh->G_e, G_el);
+
+					double cro_e = density * shc_e;
+					double cro_l = density * (shc - shc_e);
+
+					double a = theta * dT * G_el / cro_l;
+					double c = theta * dT / cro_e;
+
+					if (Temp.is_not_cmbnd(idx)) {
+
+						Temp[idx] = (heatEq_RHS[idx] + c * (K * offdiagonal + G_el * heatEq_RHS_l[idx] / (1 + a))) / (1 - c * K * diagonal + c * G_el / (1 + a));
+					}
+
+					//lattice temperature follows (also in CMBND cells)
+					pMesh->Temp_l[idx] = (heatEq_RHS_l[idx] + a * Temp[idx]) / (1 + a);
+				}
+				else {
+
+					if (!Temp.is_not_cmbnd(idx)) continue;
+
+					double cro = density * shc;
+					double c = theta * dT * K / cro;
+
+					Temp[idx] = (heatEq_RHS[idx] + c * offdiagonal) / (1 - c * diagonal);
+				}
+
+				reduction_change.reduce_max(fabs(Temp[idx] - old_value));
+				reduction_value.reduce_max(fabs(Temp[idx]));
+			}
+		}
+	}
+
+	return DBL2(reduction_change.maximum(), reduction_value.maximum());
+}
+
 //-------------------CMBND computation methods
 
 //CMBND values set based on continuity of temperature and heat flux
@@ -112,22 +112,35 @@ void MElastic::Set_Strain_From_Formula(void)
 {
 	double time = pSMesh->GetStageTime();
 
-	for (int k = 0; k < pMesh->n_m.k; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < pMesh->n_m.j; j++) {
-			for (int i = 0; i < pMesh->n_m.i; i++) {
+	//equations evaluated for a whole row along x in one call (relative x positions are the same for all rows)
+	std::vector<double> x_row(pMesh->n_m.i);
+	for (int i = 0; i < pMesh->n_m.i; i++) x_row[i] = (i + 0.5) * pMesh->h_m.x;
+
+#pragma omp parallel
+	{
+		std::vector<DBL3> Sd_row(pMesh->n_m.i), Sod_row(pMesh->n_m.i);
+
+		for (int k = 0; k < pMesh->n_m.k; k++) {
+#pragma omp for
+			for (int j = 0; j < pMesh->n_m.j; j++) {
+
+				double y = (j + 0.5) * pMesh->h_m.y, z = (k + 0.5) * pMesh->h_m.z;
+
+				if (Sd_equation.is_set_vector()) Sd_equation.evaluate_vector_many(pMesh->n_m.i, x_row.data(), y, z, time, Sd_row.data());
+				if (Sod_equation.is_set_vector()) Sod_equation.evaluate_vector_many(pMesh->n_m.i, x_row.data(), y, z, time, Sod_row.data());
 
-				int idx = i + j * pMesh->n_m.i + k * pMesh->n_m.i * pMesh->n_m.j;
+				for (int i = 0; i < pMesh->n_m.i; i++) {
 
-				if (pMesh->u_disp.is_empty(idx)) continue;
+					int idx = i + j * pMesh->n_m.i + k * pMesh->n_m.i * pMesh->n_m.j;
 
-				DBL3 pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h_m;
+					if (pMesh->u_disp.is_empty(idx)) continue;
 
-				if (Sd_equation.is_set_vector()) pMesh->strain_diag[idx] = Sd_equation.evaluate_vector(pos.x, pos.y, pos.z, time);
-				else pMesh->strain_diag[idx] = DBL3();
+					if (Sd_equation.is_set_vector()) pMesh->strain_diag[idx] = Sd_row[i];
+					else pMesh->strain_diag[idx] = DBL3();
 
-				if (Sod_equation.is_set_vector()) pMesh->strain_odiag[idx] = Sod_equation.evaluate_vector(pos.x, pos.y, pos.z, time);
-				else pMesh->strain_odiag[idx] = DBL3();
+					if (Sod_equation.is_set_vector()) pMesh->strain_odiag[idx] = Sod_row[i];
+					else pMesh->strain_odiag[idx] = DBL3();
+				}
 			}
 		}
 	}
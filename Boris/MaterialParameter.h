@@ -14,6 +14,20 @@
 #include "mGPUConfig.h"
 #endif
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//Per-cell values of a material parameter with spatial and temperature dependence resolved. Held by the parameter, but set and checked by the mesh (see Mesh::cache_parameters_mcoarse).
+
+template <typename PType>
+struct MatPCache {
+
+	//resolved value in each cell : empty if not cached
+	std::vector<PType> values;
+
+	//mesh cache stamps (parameters and temperature) and stage time the values were resolved for
+	unsigned int params_stamp = 0, temperature_stamp = 0;
+	double stime = 0.0;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 //Class holding a single material parameter with any associated temperature dependence and spatial variation.
 //This is designed to be used just as the type stored (PType) would be used on its own in mathematical equations.
@@ -106,6 +120,9 @@ private:
 	//spatial scaling setting info : text with ";" separators. First field is the scaling set type (e.g. none, custom, random, jagged, etc.); The other fields are parameters for spatial generators.
 	std::string s_scaling_info = vargenerator_descriptor.get_key_from_ID(MATPVAR_NONE);
 
+	//values resolved at M cells (not part of the object state)
+	MatPCache<PType> mcoarse_cache;
+
 private:
 
 	//---------Output value update : CUDA helpers
@@ -264,6 +281,9 @@ public:
 	//get current output value (at base temperature with no spatial scaling)
 	PType get_current(void) const { return current_value; }
 
+	//resolved values at M cells, managed by the mesh
+	MatPCache<PType>& get_mcoarse_cache(void) { return mcoarse_cache; }
+
 	//get spatial scaling value : 1.0 if not set.
 	SType get_s_scaling_value(const DBL3& position, double stime);
 
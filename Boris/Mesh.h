@@ -125,6 +125,12 @@ private:
 	template <typename PType, typename SType>
 	void update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value);
 
+	//CACHED VALUES AT M COARSENESS
+
+	//resolve values of a single parameter in all M cells if it has a spatial or temperature dependence, unless already resolved with same inputs
+	template <typename PType, typename SType>
+	void cache_parameters_mcoarse_single(MatP<PType, SType>& matp);
+
 	//UPDATER E COARSENESS - PRIVATE
 
 	//SPATIAL DEPENDENCE ONLY - NO POSITION YET
@@ -254,6 +260,25 @@ public:
 	template <typename ... MeshParam_List>
 	void update_parameters_mcoarse(int mcell_idx, MeshParam_List& ... params);
 
+	//UPDATER M COARSENESS WITH CACHED VALUES - PUBLIC
+
+	//Resolve values of given parameters (e.g. pMesh->A, pMesh->Ms) in all M cells where they have a spatial or temperature dependence, so update_parameters_mcoarse_cached can read them as plain arrays.
+	//Values are only resolved again if parameter values, the temperature, or the stage time (for spatial equations) have changed since.
+	//Call before a loop which uses update_parameters_mcoarse_cached on the same parameters (not thread safe, call outside of parallel regions).
+	template <typename PType, typename SType, typename ... MatP_List>
+	void cache_parameters_mcoarse(MatP<PType, SType>& matp, MatP_List& ... params);
+
+	//end of parameters list
+	void cache_parameters_mcoarse(void) {}
+
+	//Same as update_parameters_mcoarse, but reading values resolved by cache_parameters_mcoarse (which must have been called before with the same parameters)
+	template <typename PType, typename SType, typename ... MeshParam_List>
+	void update_parameters_mcoarse_cached(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params);
+
+	//single parameter version
+	template <typename PType, typename SType>
+	void update_parameters_mcoarse_cached(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value);
+
 	//UPDATER E COARSENESS - PUBLIC
 
 	//Update parameter values if temperature dependent at the given cell index - M cell index; position not calculated
@@ -6,6 +6,7 @@ int MeshBase::meshIdCounter = 0;
 
 MeshBase::MeshBase(MESH_ meshType, SuperMesh *pSMesh_) :
 	prng(GetSystemTickCount()),
+	mc_prng(GetSystemTickCount()),
 	pSMesh(pSMesh_)
 {
 	this->meshType = meshType;
@@ -126,9 +126,13 @@ protected:
 
 	// MONTE-CARLO DATA
 
-	//random number generator - used by Monte Carlo methods
+	//random number generator - used by serial Monte Carlo methods
 	BorisRand prng;
 
+	//counter-based random number generator - used by parallel Monte Carlo methods, with mc_step incremented every Monte Carlo step
+	BorisCBRand mc_prng;
+	unsigned long long mc_step = 0;
+
 	//Monte-Carlo current cone angle (vary to reach MONTECARLO_TARGETACCEPTANCE)
 	double mc_cone_angledeg = 30.0;
 
@@ -149,6 +153,11 @@ protected:
 	//Constrained Monte-Carlo direction
 	DBL3 cmc_n = DBL3(1.0, 0.0, 0.0);
 
+	//----- Parameters cache
+
+	//stamps for per-cell parameter values cached in mesh parameters (see Mesh::cache_parameters_mcoarse) : incremented when parameter values may have changed, and when the temperature may have changed
+	unsigned int params_cache_stamp = 1, temperature_cache_stamp = 1;
+
 public:
 
 #if COMPILECUDA == 1
@@ -261,6 +270,10 @@ public:
 	//call when a configuration change has occurred - some objects might need to be updated accordingly
 	virtual BError UpdateConfiguration(UPDATECONFIG_ cfgMessage) = 0;
 
+	//cached per-cell parameter values must be resolved again : call when parameter values may have changed (including base temperature), or when the Temp VEC has been changed
+	void Parameters_Changed(void) { params_cache_stamp++; }
+	void Temperature_Changed(void) { temperature_cache_stamp++; }
+
 	//This is a "softer" version of UpdateConfiguration, which can be used any time and doesn't require the object to be Uninitialized; 
 	//this will typically involve changing a value across multiple objects, thus better to call this method rather than try to remember which objects need the value changed.
 	virtual void UpdateConfiguration_Values(UPDATECONFIG_ cfgMessage) = 0;
@@ -365,6 +378,9 @@ public:
 	//update computational state of all modules in this mesh; return total energy density -> each module will have a contribution, so sum it
 	double UpdateModules(void);
 
+	//evaluate modules pMod[idx_start] to pMod[idx_end] inclusive (all must have FusedField_Available() true) in a single sweep over the mesh; return their total energy density
+	double UpdateModules_Fused(int idx_start, int idx_end);
+
 	//update MOD_TRANSPORT module only if set
 	virtual void UpdateTransportSolver(void) = 0;
 
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "MeshBase.h"
 #include "SuperMesh.h"
+#include "Profiler.h"
 
 //----------------------------------- MODULES CONTROL
 
@@ -55,6 +56,10 @@ BError MeshBase::InitializeAllModules(void)
 		if (error) return error;
 	}
 
+	//parameters and temperature could have been changed in any way since the last run
+	Parameters_Changed();
+	Temperature_Changed();
+
 	return error;
 }
 
@@ -87,6 +92,22 @@ double MeshBase::UpdateModules(void)
 	//Update effective field by adding in contributions from each set module
 	for (int idx = 0; idx < (int)pMod.size(); idx++) {
 
+		//consecutive modules with local fields can be evaluated in a single sweep if enabled (keeping the order of modules, so the effective field is the same)
+		if (pSMesh->Get_Fused_Local_Fields() && pMod[idx]->FusedField_Available()) {
+
+			int idx_end = idx;
+			while (idx_end + 1 < (int)pMod.size() && pMod[idx_end + 1]->FusedField_Available()) idx_end++;
+
+			if (idx_end > idx) {
+
+				energy += UpdateModules_Fused(idx, idx_end);
+				idx = idx_end;
+				continue;
+			}
+		}
+
+		ProfileScope profile_module((MOD_)pMod.get_ID_from_index(idx));
+
 		//if for a module it doesn't make sense to contribute to the total energy density, then it should return zero.
 		energy += pMod[idx]->UpdateField();
 	}
@@ -94,6 +115,58 @@ double MeshBase::UpdateModules(void)
 	return energy;
 }
 
+double MeshBase::UpdateModules_Fused(int idx_start, int idx_end)
+{
+	int num_modules = idx_end - idx_start + 1;
+
+	//fused modules cannot be timed separately by the profiler : the sweep time is shared equally between them
+	bool profile = profiler.is_enabled();
+	std::chrono::steady_clock::time_point profile_start;
+	if (profile) profile_start = std::chrono::steady_clock::now();
+
+	//energy density terms summed separately for each thread and module : thread sums combined in thread order at the end so result doesn't depend on thread timings
+	std::vector<double> energy_tn(OmpThreads * num_modules, 0.0);
+
+	for (int midx = 0; midx < num_modules; midx++) pMod[idx_start + midx]->FusedField_Prepare();
+
+#pragma omp parallel
+	{
+		int tn = omp_get_thread_num();
+
+		std::vector<double> energy_(num_modules, 0.0);
+
+#pragma omp for
+		for (int idx = 0; idx < n.dim(); idx++) {
+
+			//all field contributions at this cell, in module order
+			for (int midx = 0; midx < num_modules; midx++) {
+
+				energy_[midx] += pMod[idx_start + midx]->FusedField_Cell(idx);
+			}
+		}
+
+		for (int midx = 0; midx < num_modules; midx++) energy_tn[tn * num_modules + midx] = energy_[midx];
+	}
+
+	double energy = 0.0;
+
+	for (int midx = 0; midx < num_modules; midx++) {
+
+		double energy_module = 0.0;
+		for (int tn = 0; tn < OmpThreads; tn++) energy_module += energy_tn[tn * num_modules + midx];
+
+		energy += pMod[idx_start + midx]->FusedField_Finish(energy_module);
+	}
+
+	if (profile) {
+
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - profile_start).count();
+		for (int midx = 0; midx < num_modules; midx++) profiler.add_module_time(pMod.get_ID_from_index(idx_start + midx), time / num_modules);
+	}
+
+	return energy;
+}
+
 #if COMPILECUDA == 1
 void MeshBase::UpdateModulesCUDA(void)
 {
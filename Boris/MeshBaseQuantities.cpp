@@ -16,6 +16,7 @@ void MeshBase::SetTempFromData(VEC<double>& data, const Rect& dstRect)
 
 	//copy values in data, as well as shape
 	Temp.copy_values(data, dstRect);
+	Temperature_Changed();
 
 #if COMPILECUDA == 1
 	//refresh gpu memory
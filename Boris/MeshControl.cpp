@@ -59,6 +59,9 @@ void Mesh::Shift_Mesh_Rectangle(DBL3 shift)
 {
 	meshRect += shift;
 
+	//cached parameter values could depend on cell positions
+	Parameters_Changed();
+
 	//1. Magnetization
 	if (M.linear_size()) M.shift_rect_start(shift);
 	if (M2.linear_size()) M2.shift_rect_start(shift);
@@ -22,6 +22,7 @@ void Mesh::SetBaseTemperature(double Temperature, bool clear_equation)
 
 	//update parameter current values : if they have a temperature dependence set the base temperature will change their values
 	update_parameters();
+	Parameters_Changed();
 
 	//1a. reset Temp VEC to base temperature
 	CallModuleMethod(&HeatBase::SetBaseTemperature, Temperature, true);
@@ -139,6 +139,83 @@ void Mesh::update_parameters_mcoarse(int mcell_idx, MeshParam_List& ... params)
 	}
 }
 
+//////////////////////////////////////////////////
+////////////////////////////////////M COARSENESS - CACHED VALUES
+
+//resolve values of a single parameter in all M cells if it has a spatial or temperature dependence, unless already resolved with same inputs
+template <typename PType, typename SType>
+void Mesh::cache_parameters_mcoarse_single(MatP<PType, SType>& matp)
+{
+	MatPCache<PType>& cache = matp.get_mcoarse_cache();
+
+	bool temperature_dependence = (matp.is_tdep() && Temp.linear_size());
+
+	//nothing to resolve : value read from the parameter directly
+	if (!matp.is_sdep() && !temperature_dependence) {
+
+		if (cache.values.size()) clear_vector(cache.values);
+		return;
+	}
+
+	double stime = pSMesh->GetStageTime();
+
+	//still valid? Spatial equations can depend on the stage time.
+	if (cache.values.size() == M.linear_size() &&
+		cache.params_stamp == params_cache_stamp &&
+		(!temperature_dependence || cache.temperature_stamp == temperature_cache_stamp) &&
+		(!matp.is_s_equation_set() || cache.stime == stime)) return;
+
+	//out of memory : update_parameters_mcoarse_cached falls back to update_parameters_mcoarse
+	if (!malloc_vector(cache.values, M.linear_size())) {
+
+		clear_vector(cache.values);
+		return;
+	}
+
+#pragma omp parallel for
+	for (int idx = 0; idx < M.linear_size(); idx++) {
+
+		PType value = matp;
+		update_parameters_mcoarse(idx, matp, value);
+		cache.values[idx] = value;
+	}
+
+	cache.params_stamp = params_cache_stamp;
+	cache.temperature_stamp = temperature_cache_stamp;
+	cache.stime = stime;
+}
+
+//UPDATER M COARSENESS WITH CACHED VALUES - PUBLIC
+
+//Resolve values of given parameters in all M cells where they have a spatial or temperature dependence, so update_parameters_mcoarse_cached can read them as plain arrays.
+template <typename PType, typename SType, typename ... MatP_List>
+void Mesh::cache_parameters_mcoarse(MatP<PType, SType>& matp, MatP_List& ... params)
+{
+	cache_parameters_mcoarse_single(matp);
+
+	cache_parameters_mcoarse(params...);
+}
+
+//Same as update_parameters_mcoarse, but reading values resolved by cache_parameters_mcoarse
+template <typename PType, typename SType, typename ... MeshParam_List>
+void Mesh::update_parameters_mcoarse_cached(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
+{
+	update_parameters_mcoarse_cached(mcell_idx, matp, matp_value);
+
+	update_parameters_mcoarse_cached(mcell_idx, params...);
+}
+
+//single parameter version
+template <typename PType, typename SType>
+void Mesh::update_parameters_mcoarse_cached(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value)
+{
+	std::vector<PType>& values = matp.get_mcoarse_cache().values;
+
+	if (values.size()) matp_value = values[mcell_idx];
+	//not cached : either no dependence (matp_value already set from the parameter), or couldn't allocate cache
+	else if (matp.is_sdep() || matp.is_tdep()) update_parameters_mcoarse(mcell_idx, matp, matp_value);
+}
+
 //////////////////////////////////////////////////
 ////////////////////////////////////E COARSENESS
 
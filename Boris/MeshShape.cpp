@@ -46,7 +46,11 @@ BError Mesh::copy_mesh_data(MeshBase& copy_this)
 	if (elC.linear_size() && pcopy_this->elC.linear_size()) elC.copy_values(pcopy_this->elC);
 
 	//3. shape temperature
-	if (Temp.linear_size() && pcopy_this->Temp.linear_size()) Temp.copy_values(pcopy_this->Temp);
+	if (Temp.linear_size() && pcopy_this->Temp.linear_size()) {
+
+		Temp.copy_values(pcopy_this->Temp);
+		Temperature_Changed();
+	}
 
 #if COMPILECUDA == 1
 	//if CUDA on then load back to gpu
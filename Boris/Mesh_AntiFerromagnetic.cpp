@@ -181,6 +181,13 @@ BError AFMesh::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	//Mesh specific configuration
 	///////////////////////////////////////////////////////
 
+	//seed parallel Monte Carlo generator : if prng_seed is set the same sequence is obtained on every run
+	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_PRNG)) {
+
+		mc_prng.set_seed(prng_seed == 0 ? GetSystemTickCount() : prng_seed);
+		mc_step = 0;
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE)) {
 
 		n = round(meshRect / h);
@@ -51,9 +51,6 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 	///////////////////////////////////////////////////////////////
 	// PARALLEL MONTE-CARLO METROPOLIS
 
-	//make sure number of calls to rand doesn't match the prng period or we're asking for trouble with MC.
-	prng.check_periodicity();
-
 	//red-black : two passes will be taken
 	int rb = 0;
 	while (rb < 2) {
@@ -77,6 +74,9 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 				//only consider non-empty and non-frozen cells
 				if (M.is_not_empty(spin_idx) && !M.is_skipcell(spin_idx)) {
 
+					//random numbers for this move depend only on the seed, spin index and Monte Carlo step (not on the number of threads)
+					BorisCBRand::Stream rnd = mc_prng.stream(spin_idx, mc_step);
+
 					DBL2 MsAFM_val = Ms_AFM;
 					DBL2 susrelAFM_val = susrel_AFM;
 					update_parameters_mcoarse(spin_idx, Ms_AFM, MsAFM_val, susrel_AFM, susrelAFM_val);
@@ -103,8 +103,8 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 					DBL3 M_old_A = M[spin_idx];
 
 					//obtain rotated spin in a cone around the picked spin
-					double theta_rot = prng.rand() * mc_cone_angledeg * PI / 180.0;
-					double phi_rot = prng.rand() * 2 * PI;
+					double theta_rot = rnd.rand() * mc_cone_angledeg * PI / 180.0;
+					double phi_rot = rnd.rand() * 2 * PI;
 					//Move spin in cone with uniform random probability distribution.
 					DBL3 M_new_A = relrotate_polar(M_old_A, theta_rot, phi_rot);
 
@@ -113,7 +113,7 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 
 						double sigma = 2 * me_A*sqrt(susrelAFM_val.i*BOLTZMANN*Temperature / (h.dim() * Ms0_AFM.i));
 						if (Temperature >= T_Curie || sigma > 0.03) sigma = 0.03;
-						M_new_A *= 1 + (prng.rand() * 2 * sigma - sigma);
+						M_new_A *= 1 + (rnd.rand() * 2 * sigma - sigma);
 					}
 
 					//Sub-lattice B : move spin
@@ -122,8 +122,8 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 					DBL3 M_old_B = M2[spin_idx];
 
 					//obtain rotated spin in a cone around the picked spin
-					theta_rot = prng.rand() * mc_cone_angledeg * PI / 180.0;
-					phi_rot = prng.rand() * 2 * PI;
+					theta_rot = rnd.rand() * mc_cone_angledeg * PI / 180.0;
+					phi_rot = rnd.rand() * 2 * PI;
 					//Move spin in cone with uniform random probability distribution.
 					DBL3 M_new_B = relrotate_polar(M_old_B, theta_rot, phi_rot);
 
@@ -132,7 +132,7 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 
 						double sigma = 2 * me_B*sqrt(susrelAFM_val.j*BOLTZMANN*Temperature / (h.dim() * Ms0_AFM.j));
 						if (Temperature >= T_Curie || sigma > 0.03) sigma = 0.03;
-						M_new_B *= 1 + (prng.rand() * 2 * sigma - sigma);
+						M_new_B *= 1 + (rnd.rand() * 2 * sigma - sigma);
 					}
 
 					////////////////////
@@ -189,7 +189,7 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 						double Mratio = (M_new_A*M_new_A) / (M_old_A*M_old_A);
 						P_accept = Mratio * Mratio * exp(-energy_delta.i / (BOLTZMANN * Temperature));
 						//uniform random number between 0 and 1
-						P = prng.rand();
+						P = rnd.rand();
 					}
 					else if (energy_delta < 0) P_accept = 1.0;
 
@@ -254,7 +254,7 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 						double Mratio = (M_new_B*M_new_B) / (M_old_B*M_old_B);
 						P_accept = Mratio * Mratio * exp(-energy_delta.j / (BOLTZMANN * Temperature));
 						//uniform random number between 0 and 1
-						P = prng.rand();
+						P = rnd.rand();
 					}
 					else if (energy_delta < 0) P_accept = 1.0;
 
@@ -270,6 +270,8 @@ void AFMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 		mc_acceptance_rate += acceptance_rate;
 		rb++;
 	}
+
+	mc_step++;
 }
 
 #endif
@@ -174,6 +174,16 @@ BError FMesh::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	//Mesh specific configuration
 	///////////////////////////////////////////////////////
 
+	//parameters, or mesh dimensions, could have changed
+	Parameters_Changed();
+
+	//seed parallel Monte Carlo generator : if prng_seed is set the same sequence is obtained on every run
+	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_PRNG)) {
+
+		mc_prng.set_seed(prng_seed == 0 ? GetSystemTickCount() : prng_seed);
+		mc_step = 0;
+	}
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE)) {
 
 		n = round(meshRect / h);
@@ -246,6 +256,8 @@ void FMesh::UpdateConfiguration_Values(UPDATECONFIG_ cfgMessage)
 	//Update configuration in this mesh
 	///////////////////////////////////////////////////////
 
+	Parameters_Changed();
+
 	if (cfgMessage == UPDATECONFIG_TEQUATION_CONSTANTS) {
 
 		//Update text equations other than those used in mesh parameters
@@ -467,6 +479,8 @@ double FMesh::CheckMoveMesh(void)
 
 void FMesh::SetCurieTemperature(double Tc, bool set_default_dependences)
 {
+	Parameters_Changed();
+
 	//Curie temperature is a constant in mesh parameter equations, so update them
 	if (Tc != T_Curie) update_all_meshparam_equations();
 
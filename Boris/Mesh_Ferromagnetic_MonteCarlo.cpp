@@ -51,9 +51,6 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 	///////////////////////////////////////////////////////////////
 	// PARALLEL MONTE-CARLO METROPOLIS
 
-	//make sure number of calls to rand doesn't match the prng period or we're asking for trouble with MC.
-	prng.check_periodicity();
-
 	//red-black : two passes will be taken
 	int rb = 0;
 	while (rb < 2) {
@@ -63,8 +60,6 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 #pragma omp parallel for reduction(+:acceptance_rate)
 		for (int idx_jk = 0; idx_jk < M.n.y * M.n.z; idx_jk++) {
 
-			if (rb == 0) prng.rand();
-
 			int j = idx_jk % M.n.y;
 			int k = (idx_jk / M.n.y) % M.n.z;
 
@@ -79,6 +74,9 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 				//only consider non-empty and non-frozen cells
 				if (M.is_not_empty(spin_idx) && !M.is_skipcell(spin_idx)) {
 
+					//random numbers for this move depend only on the seed, spin index and Monte Carlo step (not on the number of threads)
+					BorisCBRand::Stream rnd = mc_prng.stream(spin_idx, mc_step);
+
 					double Ms_val = Ms;
 					double susrel_val = susrel;
 					update_parameters_mcoarse(spin_idx, Ms, Ms_val, susrel, susrel_val);
@@ -94,8 +92,8 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 					DBL3 M_old = M[spin_idx];
 
 					//obtain rotated spin in a cone around the picked spin
-					double theta_rot = prng.rand() * mc_cone_angledeg * PI / 180.0;
-					double phi_rot = prng.rand() * 2 * PI;
+					double theta_rot = rnd.rand() * mc_cone_angledeg * PI / 180.0;
+					double phi_rot = rnd.rand() * 2 * PI;
 					//Move spin in cone with uniform random probability distribution.
 					DBL3 M_new = relrotate_polar(M_old, theta_rot, phi_rot);
 
@@ -104,7 +102,7 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 
 						double sigma = 2 * me*sqrt(susrel_val*BOLTZMANN*Temperature / (h.dim() * Ms0));
 						if (Temperature >= T_Curie || sigma > 0.03) sigma = 0.03;
-						M_new *= 1 + (prng.rand() * 2 * sigma - sigma);
+						M_new *= 1 + (rnd.rand() * 2 * sigma - sigma);
 					}
 
 					//1. Find energy change
@@ -142,7 +140,7 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 						double Mratio = (M_new*M_new) / (M_old*M_old);
 						P_accept = Mratio * Mratio * exp(-energy_delta / (BOLTZMANN * Temperature));
 						//uniform random number between 0 and 1
-						P = prng.rand();
+						P = rnd.rand();
 					}
 					else if (energy_delta < 0) P_accept = 1.0;
 
@@ -160,6 +158,8 @@ void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
 		mc_acceptance_rate += acceptance_rate;
 		rb++;
 	}
+
+	mc_step++;
 }
 
 #endif
\ No newline at end of file
@@ -126,6 +126,23 @@ public:
 	//return total volume energy density -> each module will have a contribution, so sum it
 	virtual double UpdateField(void) = 0;
 
+	//-------------------------- Fused local field evaluation
+
+	//Modules with a purely local field (on-site or nearest-neighbour) can implement these so that consecutive such modules are evaluated in a single sweep over the mesh (see MeshBase::UpdateModules).
+	//The per-cell calculation must be the one used by UpdateField, so both paths give identical effective fields.
+
+	//true if the module can currently be evaluated cell by cell
+	virtual bool FusedField_Available(void) { return false; }
+
+	//before the sweep (outside the parallel region) : prepare anything needed by FusedField_Cell, e.g. cached parameter values
+	virtual void FusedField_Prepare(void) {}
+
+	//add field contribution at cell idx to Heff (also Module_Heff and Module_energy if used), returning the energy density term to be summed (before final scaling)
+	virtual double FusedField_Cell(int idx) { return 0.0; }
+
+	//after the sweep : final energy density value from the summed energy density terms, as returned by UpdateField
+	virtual double FusedField_Finish(double energy) { return 0.0; }
+
 #if COMPILECUDA == 1
 	//Only call this if cuda is switched on : if cuda on call UpdateFieldCUDA chain, if cuda off call UpdateField chain.
 	void UpdateFieldCUDA(void) { if (pModuleCUDA) pModuleCUDA->UpdateField(); }
@@ -1,6 +1,137 @@
 #include "stdafx.h"
 #include "OVF2_Handlers.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Background writer for OVF2 files (write-behind) : files are written one at a time, in the order queued.
+
+class OVF2_Writer {
+
+public:
+
+	struct Job {
+
+		std::string fileName;
+		std::ofstream bdout;
+
+		std::string header;
+		std::vector<char> data_block;
+		std::string footer;
+
+		void write(void)
+		{
+			bdout.write(header.data(), header.length());
+			if (data_block.size()) bdout.write(&data_block[0], data_block.size());
+			bdout.write(footer.data(), footer.length());
+			bdout.close();
+		}
+	};
+
+private:
+
+	//maximum memory held by queued jobs before push blocks (bytes)
+	const size_t max_queued_bytes = (size_t)1024 * 1024 * 1024;
+
+	std::thread worker;
+
+	std::mutex queue_mutex;
+	std::condition_variable queue_cv;
+
+	std::deque<Job> jobs;
+	size_t queued_bytes = 0;
+
+	//file name of job currently being written (empty if none)
+	std::string active_fileName;
+
+	bool exit_worker = false;
+
+private:
+
+	OVF2_Writer(void) { worker = std::thread(&OVF2_Writer::run, this); }
+
+	void run(void)
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+
+		while (true) {
+
+			queue_cv.wait(lock, [&] { return exit_worker || jobs.size(); });
+
+			if (jobs.empty()) break;
+
+			Job job = std::move(jobs.front());
+			jobs.pop_front();
+			active_fileName = job.fileName;
+
+			lock.unlock();
+			job.write();
+			lock.lock();
+
+			queued_bytes -= job.data_block.size();
+			active_fileName.clear();
+			queue_cv.notify_all();
+		}
+	}
+
+	bool is_pending(const std::string& fileName)
+	{
+		if (!fileName.length()) return jobs.size() || active_fileName.length();
+
+		if (active_fileName == fileName) return true;
+		for (auto& job : jobs) if (job.fileName == fileName) return true;
+
+		return false;
+	}
+
+public:
+
+	~OVF2_Writer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			exit_worker = true;
+		}
+
+		queue_cv.notify_all();
+		worker.join();
+	}
+
+	static OVF2_Writer& get(void)
+	{
+		static OVF2_Writer writer;
+		return writer;
+	}
+
+	void push(Job&& job)
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+
+		//limit memory held by snapshots waiting to be written
+		queue_cv.wait(lock, [&] { return jobs.empty() || queued_bytes + job.data_block.size() <= max_queued_bytes; });
+
+		queued_bytes += job.data_block.size();
+		jobs.push_back(std::move(job));
+
+		queue_cv.notify_all();
+	}
+
+	//wait until given file written (all files if empty)
+	void wait(std::string fileName)
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+
+		queue_cv.wait(lock, [&] { return !is_pending(fileName); });
+	}
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 OVF2::OVF2(void)
 {
 	headers.push_back("# OOMMF OVF 2.0", OVF2_HEADER);
@@ -31,6 +162,100 @@ OVF2::OVF2(void)
 	data_headers.push_back("text", DATA_TEXT);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//make OVF2 file header, up to and including the begin data line
+std::string OVF2::make_header(std::string fileName, Rect rect, SZ3 n, DBL3 h, int valuedim, std::string data_type)
+{
+	ExtractFilenameDirectory(fileName);
+
+	std::stringstream ss;
+
+	ss << headers(OVF2_HEADER) << std::endl;
+	ss << "#" << std::endl;
+	ss << "# Segment count: 1" << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(BEGIN_SEGMENT) << std::endl;
+	ss << headers(BEGIN_HEADER) << std::endl;
+	ss << "#" << std::endl;
+	ss << "# Title: " << fileName << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(MESHUNIT) + "m" << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(MESHTYPE) + "rectangular" << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(XMIN) + ToString(rect.s.x) << std::endl;
+	ss << headers(YMIN) + ToString(rect.s.y) << std::endl;
+	ss << headers(ZMIN) + ToString(rect.s.z) << std::endl;
+	ss << headers(XMAX) + ToString(rect.e.x) << std::endl;
+	ss << headers(YMAX) + ToString(rect.e.y) << std::endl;
+	ss << headers(ZMAX) + ToString(rect.e.z) << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(XNODES) + ToString(n.x) << std::endl;
+	ss << headers(YNODES) + ToString(n.y) << std::endl;
+	ss << headers(ZNODES) + ToString(n.z) << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(XSTEP) + ToString(h.x) << std::endl;
+	ss << headers(YSTEP) + ToString(h.y) << std::endl;
+	ss << headers(ZSTEP) + ToString(h.z) << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(VALUEDIM) + ToString(valuedim) << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(END_HEADER) << std::endl;
+	ss << "#" << std::endl;
+	ss << headers(BEGIN_DATA) + data_type << std::endl;
+
+	return ss.str();
+}
+
+//concatenate formatted text rows into data block
+void OVF2::text_to_block(std::vector<std::string>& rows, std::vector<char>& data_block)
+{
+	size_t size = 0;
+	for (int idx = 0; idx < rows.size(); idx++) size += rows[idx].length();
+
+	data_block.resize(size);
+
+	size_t position = 0;
+	for (int idx = 0; idx < rows.size(); idx++) {
+
+		if (rows[idx].length()) std::memcpy(&data_block[position], rows[idx].data(), rows[idx].length());
+		position += rows[idx].length();
+	}
+}
+
+//write file with given header and data block (data block is taken). File is opened here so errors can be reported, but with write-behind enabled it is written on a background thread.
+BError OVF2::write_file(std::string fileName, std::string header, std::vector<char>& data_block, std::string data_type)
+{
+	BError error(__FUNCTION__);
+
+	//a file with the same name may still be queued for writing
+	WaitForPendingWrites(fileName);
+
+	std::ofstream bdout;
+	bdout.open(fileName.c_str(), std::ios::out | std::ios::binary);
+
+	if (!bdout.is_open()) return error(BERROR_COULDNOTOPENFILE);
+
+	OVF2_Writer::Job job;
+	job.fileName = fileName;
+	job.bdout = std::move(bdout);
+	job.header = header;
+	job.data_block.swap(data_block);
+	job.footer = headers(END_DATA) + data_type + "\n" + headers(END_SEGMENT) + "\n";
+
+	if (write_behind()) OVF2_Writer::get().push(std::move(job));
+	else job.write();
+
+	return error;
+}
+
+//wait until files queued for writing on the background thread have been written : only given file if specified, else all
+void OVF2::WaitForPendingWrites(std::string fileName)
+{
+	OVF2_Writer::get().wait(fileName);
+}
+
 template BError OVF2::Read_OVF2_SCA(std::string fileName, VEC<float>& data);
 template BError OVF2::Read_OVF2_SCA(std::string fileName, VEC<double>& data);
 template BError OVF2::Read_OVF2_SCA(std::string fileName, VEC_VC<float>& data);
@@ -42,6 +267,9 @@ BError OVF2::Read_OVF2_SCA(std::string fileName, VECType& data)
 {
 	BError error(__FUNCTION__);
 
+	//the file could still be queued for writing
+	WaitForPendingWrites(fileName);
+
 	std::ifstream bdin;
 	bdin.open(fileName.c_str(), std::ios::in | std::ios::binary);
 
@@ -313,27 +541,46 @@ BError OVF2::Read_OVF2_SCA(std::string fileName, VECType& data)
 					return error(BERROR_COULDNOTLOADFILE);
 				}
 
-				for (int k = 0; k < n.z; k++) {
-					for (int j = 0; j < n.y; j++) {
-						for (int i = 0; i < n.x; i++) {
+				if (data_bytes == 4 || data_bytes == 8) {
 
-							if (data_bytes == 4) {
+					//binary data : single bulk read, then convert in parallel
+					std::vector<char> data_block((size_t)n.dim() * data_bytes);
 
-								float V;
+					bdin.read(&data_block[0], data_block.size());
 
-								bdin.read(reinterpret_cast<char*>(&V), sizeof(float));
+					if (!bdin) {
 
-								data[INT3(i, j, k)] = V;
-							}
-							else if (data_bytes == 8) {
+						data.clear();
+						bdin.close();
+						return error(BERROR_COULDNOTLOADFILE);
+					}
 
-								double V;
+					if (data_bytes == 4) {
 
-								bdin.read(reinterpret_cast<char*>(&V), sizeof(double));
+						float* pblock = reinterpret_cast<float*>(&data_block[0]);
 
-								data[INT3(i, j, k)] = V;
-							}
-							else if (data_bytes == 1) {
+#pragma omp parallel for
+						for (int idx = 0; idx < n.dim(); idx++) {
+
+							data[idx] = pblock[idx];
+						}
+					}
+					else {
+
+						double* pblock = reinterpret_cast<double*>(&data_block[0]);
+
+#pragma omp parallel for
+						for (int idx = 0; idx < n.dim(); idx++) {
+
+							data[idx] = pblock[idx];
+						}
+					}
+				}
+				else {
+
+					for (int k = 0; k < n.z; k++) {
+						for (int j = 0; j < n.y; j++) {
+							for (int i = 0; i < n.x; i++) {
 
 								read_line(bdin, line);
 
@@ -365,6 +612,9 @@ BError OVF2::Read_OVF2_VEC(std::string fileName, VECType& data)
 {
 	BError error(__FUNCTION__);
 
+	//the file could still be queued for writing
+	WaitForPendingWrites(fileName);
+
 	std::ifstream bdin;
 	bdin.open(fileName.c_str(), std::ios::in | std::ios::binary);
 
@@ -636,31 +886,46 @@ BError OVF2::Read_OVF2_VEC(std::string fileName, VECType& data)
 					return error(BERROR_COULDNOTLOADFILE);
 				}
 
-				for (int k = 0; k < n.z; k++) {
-					for (int j = 0; j < n.y; j++) {
-						for (int i = 0; i < n.x; i++) {
+				if (data_bytes == 4 || data_bytes == 8) {
 
-							if (data_bytes == 4) {
+					//binary data : single bulk read, then convert in parallel
+					std::vector<char> data_block((size_t)n.dim() * 3 * data_bytes);
 
-								float Vx, Vy, Vz;
+					bdin.read(&data_block[0], data_block.size());
 
-								bdin.read(reinterpret_cast<char*>(&Vx), sizeof(float));
-								bdin.read(reinterpret_cast<char*>(&Vy), sizeof(float));
-								bdin.read(reinterpret_cast<char*>(&Vz), sizeof(float));
+					if (!bdin) {
 
-								data[INT3(i, j, k)] = FLT3(Vx, Vy, Vz);
-							}
-							else if (data_bytes == 8) {
+						data.clear();
+						bdin.close();
+						return error(BERROR_COULDNOTLOADFILE);
+					}
 
-								double Vx, Vy, Vz;
+					if (data_bytes == 4) {
 
-								bdin.read(reinterpret_cast<char*>(&Vx), sizeof(double));
-								bdin.read(reinterpret_cast<char*>(&Vy), sizeof(double));
-								bdin.read(reinterpret_cast<char*>(&Vz), sizeof(double));
+						FLT3* pblock = reinterpret_cast<FLT3*>(&data_block[0]);
 
-								data[INT3(i, j, k)] = DBL3(Vx, Vy, Vz);
-							}
-							else if (data_bytes == 1) {
+#pragma omp parallel for
+						for (int idx = 0; idx < n.dim(); idx++) {
+
+							data[idx] = pblock[idx];
+						}
+					}
+					else {
+
+						DBL3* pblock = reinterpret_cast<DBL3*>(&data_block[0]);
+
+#pragma omp parallel for
+						for (int idx = 0; idx < n.dim(); idx++) {
+
+							data[idx] = pblock[idx];
+						}
+					}
+				}
+				else {
+
+					for (int k = 0; k < n.z; k++) {
+						for (int j = 0; j < n.y; j++) {
+							for (int i = 0; i < n.x; i++) {
 
 								read_line(bdin, line);
 
@@ -707,94 +972,63 @@ BError OVF2::Write_OVF2_VEC(std::string fileName, VECType& data, std::string dat
 	else if (data_type == "text") data_type = data_headers(DATA_TEXT);
 	else return error(BERROR_INCORRECTNAME);
 
-	std::ofstream bdout;
-	bdout.open(fileName.c_str(), std::ios::out | std::ios::binary);
-
-	ExtractFilenameDirectory(fileName);
-
-	bdout << headers(OVF2_HEADER) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << "# Segment count: 1" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(BEGIN_SEGMENT) << std::endl;
-	bdout << headers(BEGIN_HEADER) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << "# Title: " << fileName << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(MESHUNIT) + "m" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(MESHTYPE) + "rectangular" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(XMIN) + ToString(data.rect.s.x) << std::endl;
-	bdout << headers(YMIN) + ToString(data.rect.s.y) << std::endl;
-	bdout << headers(ZMIN) + ToString(data.rect.s.z) << std::endl;
-	bdout << headers(XMAX) + ToString(data.rect.e.x) << std::endl;
-	bdout << headers(YMAX) + ToString(data.rect.e.y) << std::endl;
-	bdout << headers(ZMAX) + ToString(data.rect.e.z) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(XNODES) + ToString(data.n.x) << std::endl;
-	bdout << headers(YNODES) + ToString(data.n.y) << std::endl;
-	bdout << headers(ZNODES) + ToString(data.n.z) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(XSTEP) + ToString(data.h.x) << std::endl;
-	bdout << headers(YSTEP) + ToString(data.h.y) << std::endl;
-	bdout << headers(ZSTEP) + ToString(data.h.z) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(VALUEDIM) + "3" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(END_HEADER) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(BEGIN_DATA) + data_type << std::endl;
+	//copy data out into a contiguous block in file layout, converting and normalizing in parallel
+	std::vector<char> data_block;
 
 	if (data_type == data_headers(DATA_BINARY4)) {
 
 		float value = 1234567.0;
 
-		char* binary_data = reinterpret_cast<char*>(&value);
-		bdout.write(binary_data, sizeof(float));
+		data_block.resize(sizeof(float) + data.linear_size() * sizeof(FLT3));
+		std::memcpy(&data_block[0], &value, sizeof(float));
+
+		FLT3* pblock = reinterpret_cast<FLT3*>(&data_block[sizeof(float)]);
+
+#pragma omp parallel for
+		for (int idx = 0; idx < data.linear_size(); idx++) {
+
+			pblock[idx] = data[idx] / norm;
+		}
 	}
 	else if (data_type == data_headers(DATA_BINARY8)) {
 
 		double value = 123456789012345.0;
 
-		char* binary_data = reinterpret_cast<char*>(&value);
-		bdout.write(binary_data, sizeof(double));
-	}
+		data_block.resize(sizeof(double) + data.linear_size() * sizeof(DBL3));
+		std::memcpy(&data_block[0], &value, sizeof(double));
 
-	for (int k = 0; k < data.n.z; k++) {
-		for (int j = 0; j < data.n.y; j++) {
-			for (int i = 0; i < data.n.x; i++) {
+		DBL3* pblock = reinterpret_cast<DBL3*>(&data_block[sizeof(double)]);
 
-				if (data_type == data_headers(DATA_BINARY4)) {
+#pragma omp parallel for
+		for (int idx = 0; idx < data.linear_size(); idx++) {
 
-					FLT3 value = data[INT3(i, j, k)] / norm;
+			pblock[idx] = data[idx] / norm;
+		}
+	}
+	else {
 
-					char* binary_data = reinterpret_cast<char*>(&value);
-					bdout.write(binary_data, sizeof(FLT3));
-				}
-				else if (data_type == data_headers(DATA_BINARY8)) {
+		//text : format each row separately in parallel, then concatenate
+		std::vector<std::string> rows(data.n.y * data.n.z);
 
-					DBL3 value = data[INT3(i, j, k)] / norm;
-						
-					char* binary_data = reinterpret_cast<char*>(&value);
-					bdout.write(binary_data, sizeof(DBL3));
-				}
-				else {
+#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < data.n.y * data.n.z; idx_jk++) {
 
-					DBL3 value = data[INT3(i, j, k)] / norm;
+			std::stringstream ss;
 
-					bdout << value.x << " " << value.y << " " << value.z << std::endl;
-				}
+			for (int i = 0; i < data.n.x; i++) {
+
+				DBL3 value = data[i + idx_jk * data.n.x] / norm;
+
+				ss << value.x << " " << value.y << " " << value.z << std::endl;
 			}
-		}
-	}
 
-	bdout << headers(END_DATA) + data_type << std::endl;
-	bdout << headers(END_SEGMENT) << std::endl;
+			rows[idx_jk] = ss.str();
+		}
 
-	bdout.close();
+		text_to_block(rows, data_block);
+	}
 
-	return error;
+	return write_file(fileName, make_header(fileName, data.rect, data.n, data.h, 3, data_type), data_block, data_type);
 }
 
 template BError OVF2::Write_OVF2_SCA(std::string fileName, VEC<float>& data, std::string data_type);
@@ -814,90 +1048,59 @@ BError OVF2::Write_OVF2_SCA(std::string fileName, VECType& data, std::string dat
 	else if (data_type == "text") data_type = data_headers(DATA_TEXT);
 	else return error(BERROR_INCORRECTNAME);
 
-	std::ofstream bdout;
-	bdout.open(fileName.c_str(), std::ios::out | std::ios::binary);
-
-	ExtractFilenameDirectory(fileName);
-
-	bdout << headers(OVF2_HEADER) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << "# Segment count: 1" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(BEGIN_SEGMENT) << std::endl;
-	bdout << headers(BEGIN_HEADER) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << "# Title: " << fileName << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(MESHUNIT) + "m" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(MESHTYPE) + "rectangular" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(XMIN) + ToString(data.rect.s.x) << std::endl;
-	bdout << headers(YMIN) + ToString(data.rect.s.y) << std::endl;
-	bdout << headers(ZMIN) + ToString(data.rect.s.z) << std::endl;
-	bdout << headers(XMAX) + ToString(data.rect.e.x) << std::endl;
-	bdout << headers(YMAX) + ToString(data.rect.e.y) << std::endl;
-	bdout << headers(ZMAX) + ToString(data.rect.e.z) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(XNODES) + ToString(data.n.x) << std::endl;
-	bdout << headers(YNODES) + ToString(data.n.y) << std::endl;
-	bdout << headers(ZNODES) + ToString(data.n.z) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(XSTEP) + ToString(data.h.x) << std::endl;
-	bdout << headers(YSTEP) + ToString(data.h.y) << std::endl;
-	bdout << headers(ZSTEP) + ToString(data.h.z) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(VALUEDIM) + "1" << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(END_HEADER) << std::endl;
-	bdout << "#" << std::endl;
-	bdout << headers(BEGIN_DATA) + data_type << std::endl;
+	//copy data out into a contiguous block in file layout, converting in parallel
+	std::vector<char> data_block;
 
 	if (data_type == data_headers(DATA_BINARY4)) {
 
 		float value = 1234567.0;
 
-		char* binary_data = reinterpret_cast<char*>(&value);
-		bdout.write(binary_data, sizeof(float));
+		data_block.resize(sizeof(float) + data.linear_size() * sizeof(float));
+		std::memcpy(&data_block[0], &value, sizeof(float));
+
+		float* pblock = reinterpret_cast<float*>(&data_block[sizeof(float)]);
+
+#pragma omp parallel for
+		for (int idx = 0; idx < data.linear_size(); idx++) {
+
+			pblock[idx] = data[idx];
+		}
 	}
 	else if (data_type == data_headers(DATA_BINARY8)) {
 
 		double value = 123456789012345.0;
 
-		char* binary_data = reinterpret_cast<char*>(&value);
-		bdout.write(binary_data, sizeof(double));
-	}
+		data_block.resize(sizeof(double) + data.linear_size() * sizeof(double));
+		std::memcpy(&data_block[0], &value, sizeof(double));
 
-	for (int k = 0; k < data.n.z; k++) {
-		for (int j = 0; j < data.n.y; j++) {
-			for (int i = 0; i < data.n.x; i++) {
+		double* pblock = reinterpret_cast<double*>(&data_block[sizeof(double)]);
 
-				if (data_type == data_headers(DATA_BINARY4)) {
+#pragma omp parallel for
+		for (int idx = 0; idx < data.linear_size(); idx++) {
 
-					float value = data[INT3(i, j, k)];
+			pblock[idx] = data[idx];
+		}
+	}
+	else {
 
-					char* binary_data = reinterpret_cast<char*>(&value);
-					bdout.write(binary_data, sizeof(float));
-				}
-				else if (data_type == data_headers(DATA_BINARY8)) {
+		//text : format each row separately in parallel, then concatenate
+		std::vector<std::string> rows(data.n.y * data.n.z);
 
-					double value = data[INT3(i, j, k)];
+#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < data.n.y * data.n.z; idx_jk++) {
 
-					char* binary_data = reinterpret_cast<char*>(&value);
-					bdout.write(binary_data, sizeof(double));
-				}
-				else {
+			std::stringstream ss;
 
-					bdout << data[INT3(i, j, k)] << std::endl;
-				}
+			for (int i = 0; i < data.n.x; i++) {
+
+				ss << data[i + idx_jk * data.n.x] << std::endl;
 			}
-		}
-	}
 
-	bdout << headers(END_DATA) + data_type << std::endl;
-	bdout << headers(END_SEGMENT) << std::endl;
+			rows[idx_jk] = ss.str();
+		}
 
-	bdout.close();
+		text_to_block(rows, data_block);
+	}
 
-	return error;
-}
\ No newline at end of file
+	return write_file(fileName, make_header(fileName, data.rect, data.n, data.h, 1, data_type), data_block, data_type);
+}
@@ -16,10 +16,35 @@ class OVF2 {
 
 	vector_lut<std::string> data_headers;
 
+private:
+
+	//make OVF2 file header, up to and including the begin data line
+	std::string make_header(std::string fileName, Rect rect, SZ3 n, DBL3 h, int valuedim, std::string data_type);
+
+	//concatenate formatted text rows into data block
+	void text_to_block(std::vector<std::string>& rows, std::vector<char>& data_block);
+
+	//write file with given header and data block (data block is taken). File is opened here so errors can be reported, but with write-behind enabled it is written on a background thread.
+	BError write_file(std::string fileName, std::string header, std::vector<char>& data_block, std::string data_type);
+
 public:
 
 	OVF2(void);
 
+	//-------------------------- Write-behind
+
+	//if enabled, once the data has been copied out the file is written on a background thread, so Write_OVF2_SCA and Write_OVF2_VEC return without waiting for the disk
+	static bool& write_behind(void)
+	{
+		static bool write_behind_ = true;
+		return write_behind_;
+	}
+
+	//wait until files queued for writing on the background thread have been written : only given file if specified, else all
+	static void WaitForPendingWrites(std::string fileName = "");
+
+	//-------------------------- Read / Write
+
 	//read an OOMMF OVF2 file containing uniform scalar data, and set the data VEC from it
 	template <typename VECType>
 	BError Read_OVF2_SCA(std::string fileName, VECType& data);
@@ -76,6 +76,10 @@ BError Oersted::Initialize(void)
 
 	oefield_computed = false;
 
+	//allocate memory for saved fields if using evaluation speedup
+	evalspeedup.Configure(pSMesh->GetEvaluationSpeedup(), pSMesh->GetEvaluationSpeedupTolerance());
+	if (!evalspeedup.Resize_Fields(Hoe, pSMesh->h_e, pSMesh->sMeshRect_e)) return error(BERROR_OUTOFMEMORY_CRIT);
+
 	return error;
 }
 
@@ -111,6 +115,10 @@ BError Oersted::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 	oefield_computed = false;
 
+	//if memory needs to be allocated for saved fields, it will be done through Initialize
+	Hoe.clear();
+	evalspeedup.Reset();
+
 	//------------------------ CUDA UpdateConfiguration if set
 
 #if COMPILECUDA == 1
@@ -142,10 +150,40 @@ double Oersted::UpdateField(void)
 	//only recalculate Oersted field if there was a significant change in current density (judged based on transport solver iterations)
 	if (pSMesh->CallModuleMethod(&STransport::Transport_Recalculated) || !oefield_computed) {
 
-		//transfer values from invidual Jc meshes to sm_Vals
-		sm_Vals.transfer_in_multiplied();
+		//in evaluation speedup mode the convolution can be replaced by extrapolation from previously saved fields
+		EVALSPEEDUPSTEP_ speedup_step = EVALSPEEDUPSTEP_COMPUTE;
+
+		if (Hoe.size()) speedup_step = evalspeedup.Check_Evaluation(pSMesh->Check_Step_Update(), pSMesh->Get_EvalStep_Time());
+
+		if (speedup_step == EVALSPEEDUPSTEP_EXTRAPOLATE) {
+
+			#pragma omp parallel for
+			for (int idx = 0; idx < sm_Vals.linear_size(); idx++) {
+
+				sm_Vals[idx] = evalspeedup.extrapolate(Hoe, idx);
+			}
+		}
+		else {
+
+			//transfer values from invidual Jc meshes to sm_Vals
+			sm_Vals.transfer_in_multiplied();
 
-		Convolute(sm_Vals, sm_Vals, true);
+			Convolute(sm_Vals, sm_Vals, true);
+
+			if (speedup_step == EVALSPEEDUPSTEP_COMPUTE_AND_SAVE) {
+
+				VEC<DBL3>& Hoe_save = Hoe[evalspeedup.get_save_slot()];
+
+				#pragma omp parallel for
+				for (int idx = 0; idx < sm_Vals.linear_size(); idx++) {
+
+					Hoe_save[idx] = sm_Vals[idx];
+				}
+
+				evalspeedup.Accumulate_Residual(Hoe);
+				evalspeedup.Save_Done();
+			}
+		}
 
 		//transfer to individual Heff meshes
 		sm_Vals.transfer_out();
@@ -154,6 +192,9 @@ double Oersted::UpdateField(void)
 	}
 	else {
 
+		//current density not changing : saved fields can't be used for extrapolation when it starts changing again
+		if (Hoe.size()) evalspeedup.Reset();
+
 		//transfer to individual Heff meshes
 		sm_Vals.transfer_out();
 	}
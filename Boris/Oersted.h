@@ -13,6 +13,7 @@ class SuperMesh;
 
 #include "Convolution.h"
 #include "OerstedKernel.h"
+#include "EvalSpeedup.h"
 
 #if COMPILECUDA == 1
 #include "OerstedCUDA.h"
@@ -42,6 +43,13 @@ private:
 	//don't need to compute Oe field every iteration, only when a significant change in Jc occurs; but do need to compute it initially.
 	bool oefield_computed = false;
 
+	//Evaluation speedup mode data : used when the current density changes every evaluation (e.g. time-dependent drive)
+
+	//saved Oersted fields for polynomial extrapolation
+	std::vector<VEC<DBL3>> Hoe;
+
+	EvalSpeedup evalspeedup;
+
 public:
 
 	Oersted(SuperMesh *pSMesh_);
@@ -0,0 +1,46 @@
+#include "stdafx.h"
+#include "Profiler.h"
+
+//the simulation profiler
+Profiler profiler;
+
+void Profiler::reset(void)
+{
+	for (int stage = 0; stage < PROFILE_NUMSTAGES; stage++) {
+
+		stage_time[stage] = 0.0;
+		stage_calls[stage] = 0;
+	}
+
+	for (int moduleID = 0; moduleID < PROFILE_MODULEIDS; moduleID++) {
+
+		module_time[moduleID] = 0.0;
+		module_calls[moduleID] = 0;
+	}
+}
+
+//total time in a set of modules (e.g. all transport modules)
+double Profiler::get_modules_time(std::vector<int> moduleIDs) const
+{
+	double time = 0.0;
+
+	for (int moduleID : moduleIDs) time += get_module_time(moduleID);
+
+	return time;
+}
+
+//name of stage for profiler report
+std::string Profiler::get_stage_name(int stage)
+{
+	switch (stage) {
+
+	case PROFILE_ITERATION: return "Iteration";
+	case PROFILE_MODULES: return "Modules";
+	case PROFILE_ODE: return "ODE evaluation";
+	case PROFILE_MOVINGMESH: return "Moving mesh";
+	case PROFILE_MESHTRANSFER: return "Mesh transfer";
+	case PROFILE_SAVEDATA: return "Save data";
+	}
+
+	return "";
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "BorisLib.h"
+#include "ModulesDefs.h"
+
+#include <chrono>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Lightweight timing profiler for the simulation loop : wall time accumulated by scoped timers (ProfileScope) placed around simulation stages, and around module field updates (by module id).
+//	Disabled by default, in which case a ProfileScope only checks a flag. Enabling it resets all timers.
+//	Timers are only started and stopped on the simulation thread (not inside OpenMP parallel regions).
+//	Stages can be nested (e.g. module updates are contained in the iteration time), so stage times don't add up to the iteration time.
+//	For CUDA computations kernels are launched asynchronously, so only the iteration time is meaningful there.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//simulation stages timed by the profiler (module field updates are also timed individually by module id)
+enum PROFILE_ {
+
+	//a full simulation iteration (SuperMesh::AdvanceTime, or Monte Carlo step), including everything below except saving data
+	PROFILE_ITERATION,
+
+	//all module field updates, in meshes and super-mesh
+	PROFILE_MODULES,
+
+	//ODE evaluation stages (Run*_Step* methods in all meshes)
+	PROFILE_ODE,
+
+	//moving mesh algorithm
+	PROFILE_MOVINGMESH,
+
+	//mesh transfers to and from super-mesh convolution (part of super-mesh demag module time)
+	PROFILE_MESHTRANSFER,
+
+	//saving simulation data
+	PROFILE_SAVEDATA,
+
+	PROFILE_NUMSTAGES
+};
+
+//number of module ids which can be timed : must exceed the highest MOD_ value (see ModulesDefs.h)
+#define PROFILE_MODULEIDS	30
+
+class Profiler {
+
+private:
+
+	bool enabled = false;
+
+	//accumulated wall time (s) and number of timed calls for each stage
+	double stage_time[PROFILE_NUMSTAGES];
+	int stage_calls[PROFILE_NUMSTAGES];
+
+	//accumulated wall time (s) and number of timed calls for each module id (summed over all meshes with the module)
+	double module_time[PROFILE_MODULEIDS];
+	int module_calls[PROFILE_MODULEIDS];
+
+public:
+
+	Profiler(void) { reset(); }
+
+	//--------------------------------------------
+
+	//enable (resetting all timers, also if already enabled) or disable profiling
+	void set_enabled(bool status) { if (status) reset(); enabled = status; }
+	bool is_enabled(void) const { return enabled; }
+
+	void reset(void);
+
+	//--------------------------------------------
+
+	void add_stage_time(int stage, double time) { stage_time[stage] += time; stage_calls[stage]++; }
+	void add_module_time(int moduleID, double time) { if (moduleID >= 0 && moduleID < PROFILE_MODULEIDS) { module_time[moduleID] += time; module_calls[moduleID]++; } }
+
+	//--------------------------------------------
+
+	double get_stage_time(int stage) const { return stage_time[stage]; }
+	int get_stage_calls(int stage) const { return stage_calls[stage]; }
+
+	double get_module_time(int moduleID) const { return (moduleID >= 0 && moduleID < PROFILE_MODULEIDS ? module_time[moduleID] : 0.0); }
+	int get_module_calls(int moduleID) const { return (moduleID >= 0 && moduleID < PROFILE_MODULEIDS ? module_calls[moduleID] : 0); }
+
+	//total time in a set of modules (e.g. all transport modules)
+	double get_modules_time(std::vector<int> moduleIDs) const;
+
+	//name of stage for profiler report
+	static std::string get_stage_name(int stage);
+};
+
+//the simulation profiler
+extern Profiler profiler;
+
+//Scoped timer : time from construction to destruction is added to a profiler stage, or to a module id, if the profiler is enabled at construction.
+class ProfileScope {
+
+private:
+
+	//stage, or module id if for_module
+	int id;
+	bool for_module;
+
+	bool active;
+
+	std::chrono::steady_clock::time_point start;
+
+public:
+
+	ProfileScope(PROFILE_ stage) :
+		id(stage), for_module(false), active(profiler.is_enabled())
+	{
+		if (active) start = std::chrono::steady_clock::now();
+	}
+
+	ProfileScope(MOD_ moduleID) :
+		id(moduleID), for_module(true), active(profiler.is_enabled())
+	{
+		if (active) start = std::chrono::steady_clock::now();
+	}
+
+	~ProfileScope()
+	{
+		if (!active) return;
+
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (for_module) profiler.add_module_time(id, time);
+		else profiler.add_stage_time(id, time);
+	}
+};
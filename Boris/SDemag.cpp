@@ -4,6 +4,7 @@
 #ifdef MODULE_COMPILATION_SDEMAG
 
 #include "SuperMesh.h"
+#include "Profiler.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -489,6 +490,9 @@ BError SDemag::Initialize(void)
 			//now everything is set correctly, ready to calculate demag kernel collections
 		}
 
+		//evaluation speedup history shared by all SDemag_Demag modules, which size their saved fields from it (multi-layered convolution only)
+		evalspeedup.Configure(pSMesh->GetEvaluationSpeedup(), pSMesh->GetEvaluationSpeedupTolerance());
+
 		//initialized ok.
 		initialized = true;
 	}
@@ -507,7 +511,7 @@ BError SDemag::Initialize(void)
 		}
 	}
 
-	num_Hdemag_saved = 0;
+	evalspeedup.Reset();
 
 	return error;
 }
@@ -653,10 +657,10 @@ BError SDemag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 			//for super-mesh convolution just need a single convolution and sm_Vals to be sized correctly
 
 			//only need to uninitialize if n_fm or h_fm have changed
-			if (!CheckDimensions(pSMesh->n_fm, pSMesh->h_fm, demag_pbc_images) || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE || cfgMessage == UPDATECONFIG_MESHCHANGE) {
+			if (!CheckDimensions(pSMesh->n_fm, pSMesh->h_fm, demag_pbc_images, pSMesh->Get_Demag_Single_Precision()) || cfgMessage == UPDATECONFIG_DEMAG_CONVCHANGE || cfgMessage == UPDATECONFIG_MESHCHANGE) {
 
 				Uninitialize();
-				error = SetDimensions(pSMesh->n_fm, pSMesh->h_fm, true, demag_pbc_images);
+				error = SetDimensions(pSMesh->n_fm, pSMesh->h_fm, true, demag_pbc_images, pSMesh->Get_Demag_Single_Precision());
 
 				if (!sm_Vals.resize(pSMesh->h_fm, pSMesh->sMeshRect_fm)) return error(BERROR_OUTOFMEMORY_CRIT);
 			}
@@ -748,9 +752,13 @@ double SDemag::UpdateField(void)
 		if (!antiferromagnetic_meshes_present) {
 
 			//transfer values from invidual M meshes to sm_Vals
-			if (sm_Vals.size_transfer_in()) sm_Vals.transfer_in();
-			//transfer from atomistic mesh (if any) - clear input only if there was no transfer from micromagnetic meshes, else add in
-			if (sm_Vals.size_transfer2_in()) sm_Vals.transfer2_in(sm_Vals.size_transfer_in() == 0);
+			{
+				ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+
+				if (sm_Vals.size_transfer_in()) sm_Vals.transfer_in();
+				//transfer from atomistic mesh (if any) - clear input only if there was no transfer from micromagnetic meshes, else add in
+				if (sm_Vals.size_transfer2_in()) sm_Vals.transfer2_in(sm_Vals.size_transfer_in() == 0);
+			}
 
 			//convolution with demag kernels, output overwrites in sm_Vals
 			energy = Convolute(sm_Vals, sm_Vals, true);
@@ -759,15 +767,23 @@ double SDemag::UpdateField(void)
 			energy *= -MU0 / (2 * non_empty_cells);
 
 			//transfer to individual Heff meshes (micromagnetic and atomistc meshes)
-			if (sm_Vals.size_transfer_out()) sm_Vals.transfer_out();
-			if (sm_Vals.size_transfer2_out()) sm_Vals.transfer2_out();
+			{
+				ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+
+				if (sm_Vals.size_transfer_out()) sm_Vals.transfer_out();
+				if (sm_Vals.size_transfer2_out()) sm_Vals.transfer2_out();
+			}
 		}
 		else {
 
 			//transfer values from invidual M meshes to sm_Vals
-			if (sm_Vals.size_transfer_in()) sm_Vals.transfer_in_averaged();
-			//transfer from atomistic mesh (if any) - clear input only if there was no transfer from micromagnetic meshes, else add in
-			if (sm_Vals.size_transfer2_in()) sm_Vals.transfer_in(sm_Vals.size_transfer_in() == 0);
+			{
+				ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+
+				if (sm_Vals.size_transfer_in()) sm_Vals.transfer_in_averaged();
+				//transfer from atomistic mesh (if any) - clear input only if there was no transfer from micromagnetic meshes, else add in
+				if (sm_Vals.size_transfer2_in()) sm_Vals.transfer_in(sm_Vals.size_transfer_in() == 0);
+			}
 
 			//convolution with demag kernels, output overwrites in sm_Vals
 			energy = Convolute(sm_Vals, sm_Vals, true);
@@ -776,8 +792,12 @@ double SDemag::UpdateField(void)
 			energy *= -MU0 / (2 * non_empty_cells);
 
 			//transfer to individual Heff meshes
-			if (sm_Vals.size_transfer_out()) sm_Vals.transfer_out_duplicated();
-			if (sm_Vals.size_transfer2_out()) sm_Vals.transfer2_out();
+			{
+				ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+
+				if (sm_Vals.size_transfer_out()) sm_Vals.transfer_out_duplicated();
+				if (sm_Vals.size_transfer2_out()) sm_Vals.transfer2_out();
+			}
 		}
 	}
 
@@ -787,62 +807,77 @@ double SDemag::UpdateField(void)
 
 	else {
 
-		//Forward FFT for all ferromagnetic meshes
-		for (int idx = 0; idx < pSDemag_Demag.size(); idx++) {
+		//what to do at this evaluation : always compute if evaluation speedup not enabled
+		EVALSPEEDUPSTEP_ speedup_step = EVALSPEEDUPSTEP_COMPUTE;
 
-			///////////////////////////////////////////////////////////////////////////////////////////////
-			//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-			///////////////////////////////////////////////////////////////////////////////////////////////
+		if (pSMesh->GetEvaluationSpeedup()) speedup_step = evalspeedup.Check_Evaluation(pSMesh->Check_Step_Update(), pSMesh->Get_EvalStep_Time());
 
-			if (pSDemag_Demag[idx]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+		//when extrapolating the convolution is not needed at all
+		if (speedup_step != EVALSPEEDUPSTEP_EXTRAPOLATE) {
 
-				if (pSDemag_Demag[idx]->do_transfer) {
+			//Forward FFT for all ferromagnetic meshes
+			for (int idx = 0; idx < pSDemag_Demag.size(); idx++) {
 
-					//transfer from M to common meshing
-					pSDemag_Demag[idx]->transfer.transfer_in_averaged();
+				///////////////////////////////////////////////////////////////////////////////////////////////
+				//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
+				///////////////////////////////////////////////////////////////////////////////////////////////
 
-					//do forward FFT
-					pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
-				}
-				else {
+				if (pSDemag_Demag[idx]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-					pSDemag_Demag[idx]->ForwardFFT_AveragedInputs(pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->M2);
-				}
-			}
+					if (pSDemag_Demag[idx]->do_transfer) {
 
-			///////////////////////////////////////////////////////////////////////////////////////////////
-			///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-			///////////////////////////////////////////////////////////////////////////////////////////////
+						//transfer from M to common meshing
+						{
+							ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+							pSDemag_Demag[idx]->transfer.transfer_in_averaged();
+						}
 
-			else {
+						//do forward FFT
+						pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
+					}
+					else {
 
-				if (pSDemag_Demag[idx]->do_transfer) {
+						pSDemag_Demag[idx]->ForwardFFT_AveragedInputs(pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->M2);
+					}
+				}
 
-					//transfer from M to common meshing
-					pSDemag_Demag[idx]->transfer.transfer_in();
+				///////////////////////////////////////////////////////////////////////////////////////////////
+				///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
+				///////////////////////////////////////////////////////////////////////////////////////////////
 
-					//do forward FFT
-					pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
-				}
 				else {
 
-					//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
-					pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->pMesh->M);
+					if (pSDemag_Demag[idx]->do_transfer) {
+
+						//transfer from M to common meshing
+						{
+							ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+							pSDemag_Demag[idx]->transfer.transfer_in();
+						}
+
+						//do forward FFT
+						pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
+					}
+					else {
+
+						//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
+						pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->pMesh->M);
+					}
 				}
 			}
-		}
 
-		//Kernel multiplications for multiple inputs. Reverse loop ordering improves cache use at both ends.
-		for (int idx = pSDemag_Demag.size() - 1; idx >= 0; idx--) {
+			//Kernel multiplications for multiple inputs. Reverse loop ordering improves cache use at both ends.
+			for (int idx = pSDemag_Demag.size() - 1; idx >= 0; idx--) {
 
-			pSDemag_Demag[idx]->KernelMultiplication_MultipleInputs(FFT_Spaces_Input);
+				pSDemag_Demag[idx]->KernelMultiplication_MultipleInputs(FFT_Spaces_Input);
+			}
 		}
 
 		///////////////////////////////////////////////////////////////////////////////////////////////
 		/////////////////////////////////// NO SPEEDUP - MULTILAYERED /////////////////////////////////
 		///////////////////////////////////////////////////////////////////////////////////////////////
 
-		if (!pSMesh->GetEvaluationSpeedup() || (num_Hdemag_saved < pSMesh->GetEvaluationSpeedup() && !pSMesh->Check_Step_Update())) {
+		if (speedup_step == EVALSPEEDUPSTEP_COMPUTE) {
 
 			//don't use evaluation speedup, so no need to use Hdemag in SDemag_Demag modules (this won't have memory allocated anyway)
 
@@ -871,7 +906,10 @@ double SDemag::UpdateField(void)
 						else pSDemag_Demag[idx]->energy += (-MU0 / 2) * (pSDemag_Demag[idx]->InverseFFT(pSDemag_Demag[idx]->transfer, pSDemag_Demag[idx]->transfer, true) / pSDemag_Demag[idx]->non_empty_cells);
 
 						//transfer to Heff in each mesh
-						pSDemag_Demag[idx]->transfer.transfer_out_duplicated();
+						{
+							ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+							pSDemag_Demag[idx]->transfer.transfer_out_duplicated();
+						}
 					}
 					else {
 
@@ -907,7 +945,10 @@ double SDemag::UpdateField(void)
 						else pSDemag_Demag[idx]->energy += (-MU0 / 2) * (pSDemag_Demag[idx]->InverseFFT(pSDemag_Demag[idx]->transfer, pSDemag_Demag[idx]->transfer, true) / pSDemag_Demag[idx]->non_empty_cells);
 
 						//transfer to Heff in each mesh
-						pSDemag_Demag[idx]->transfer.transfer_out();
+						{
+							ProfileScope profile_transfer(PROFILE_MESHTRANSFER);
+							pSDemag_Demag[idx]->transfer.transfer_out();
+						}
 					}
 					else {
 						
@@ -935,786 +976,216 @@ double SDemag::UpdateField(void)
 		////////////////////////////////// EVAL SPEEDUP - MULTILAYERED ////////////////////////////////
 		///////////////////////////////////////////////////////////////////////////////////////////////
 
-		else {
-
-			//update if required by ODE solver or if we don't have enough previous evaluations saved to extrapolate
-			if (pSMesh->Check_Step_Update() || num_Hdemag_saved < pSMesh->GetEvaluationSpeedup()) {
+		else if (speedup_step == EVALSPEEDUPSTEP_COMPUTE_AND_SAVE) {
 
-				energy = 0;
+			energy = 0;
 
-				for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
+			for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
 
-					VEC<DBL3>* pHdemag;
+				//save field in slot set by evaluation speedup history (shared by all meshes)
+				VEC<DBL3>* pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag[evalspeedup.get_save_slot()];
 
-					if (num_Hdemag_saved < pSMesh->GetEvaluationSpeedup()) {
+				//Inverse FFT
 
-						//don't have enough evaluations, so save next one
-						switch (num_Hdemag_saved)
-						{
-						case 0:
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
-							if (idx_mesh == pSDemag_Demag.size() - 1) time_demag1 = pSMesh->Get_EvalStep_Time();
-							break;
-						case 1:
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag2;
-							if (idx_mesh == pSDemag_Demag.size() - 1) time_demag2 = pSMesh->Get_EvalStep_Time();
-							break;
-						case 2:
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag3;
-							if (idx_mesh == pSDemag_Demag.size() - 1) time_demag3 = pSMesh->Get_EvalStep_Time();
-							break;
-						case 3:
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag4;
-							if (idx_mesh == pSDemag_Demag.size() - 1) time_demag4 = pSMesh->Get_EvalStep_Time();
-							break;
-						case 4:
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag5;
-							if (idx_mesh == pSDemag_Demag.size() - 1) time_demag5 = pSMesh->Get_EvalStep_Time();
-							break;
-						case 5:
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag6;
-							if (idx_mesh == pSDemag_Demag.size() - 1) time_demag6 = pSMesh->Get_EvalStep_Time();
-							break;
-						}
+				///////////////////////////////////////////////////////////////////////////////////////////////
+				//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
+				///////////////////////////////////////////////////////////////////////////////////////////////
 
-						if (idx_mesh == pSDemag_Demag.size() - 1) num_Hdemag_saved++;
-					}
-					else {
+				if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-						//have enough evaluations saved, so just cycle between them now
-
-						//QUINTIC
-						if (pSMesh->GetEvaluationSpeedup() == 6) {
-
-							//1, 2, 3, 4, 5, 6 -> next is 1
-							if (time_demag6 > time_demag5 && time_demag5 > time_demag4 && time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag1 = pSMesh->Get_EvalStep_Time();
-							}
-							//2, 3, 4, 5, 6, 1 -> next is 2
-							else if (time_demag1 > time_demag2) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag2;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag2 = pSMesh->Get_EvalStep_Time();
-							}
-							//3, 4, 5, 6, 1, 2 -> next is 3
-							else if (time_demag2 > time_demag3) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag3;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag3 = pSMesh->Get_EvalStep_Time();
-							}
-							//4, 5, 6, 1, 2, 3 -> next is 4
-							else if (time_demag3 > time_demag4) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag4;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag4 = pSMesh->Get_EvalStep_Time();
-							}
-							//5, 6, 1, 2, 3, 4 -> next is 5
-							else if (time_demag4 > time_demag5) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag5;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag5 = pSMesh->Get_EvalStep_Time();
-							}
-							else {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag6;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag6 = pSMesh->Get_EvalStep_Time();
-							}
-						}
-						//QUARTIC
-						else if (pSMesh->GetEvaluationSpeedup() == 5) {
-
-							//1, 2, 3, 4, 5 -> next is 1
-							if (time_demag5 > time_demag4 && time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag1 = pSMesh->Get_EvalStep_Time();
-							}
-							//2, 3, 4, 5, 1 -> next is 2
-							else if (time_demag1 > time_demag2) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag2;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag2 = pSMesh->Get_EvalStep_Time();
-							}
-							//3, 4, 5, 1, 2 -> next is 3
-							else if (time_demag2 > time_demag3) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag3;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag3 = pSMesh->Get_EvalStep_Time();
-							}
-							//4, 5, 1, 2, 3 -> next is 4
-							else if (time_demag3 > time_demag4) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag4;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag4 = pSMesh->Get_EvalStep_Time();
-							}
-							else {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag5;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag5 = pSMesh->Get_EvalStep_Time();
-							}
-						}
-						//CUBIC
-						else if (pSMesh->GetEvaluationSpeedup() == 4) {
-
-							//1, 2, 3, 4 -> next is 1
-							if (time_demag4 > time_demag3 && time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag1 = pSMesh->Get_EvalStep_Time();
-							}
-							//2, 3, 4, 1 -> next is 2
-							else if (time_demag1 > time_demag2) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag2;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag2 = pSMesh->Get_EvalStep_Time();
-							}
-							//3, 4, 1, 2 -> next is 3
-							else if (time_demag2 > time_demag3) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag3;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag3 = pSMesh->Get_EvalStep_Time();
-							}
-							else {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag4;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag4 = pSMesh->Get_EvalStep_Time();
-							}
-						}
-						//QUADRATIC
-						else if (pSMesh->GetEvaluationSpeedup() == 3) {
-
-							//1, 2, 3 -> next is 1
-							if (time_demag3 > time_demag2 && time_demag2 > time_demag1) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag1 = pSMesh->Get_EvalStep_Time();
-							}
-							//2, 3, 1 -> next is 2
-							else if (time_demag3 > time_demag2 && time_demag1 > time_demag2) {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag2;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag2 = pSMesh->Get_EvalStep_Time();
-							}
-							//3, 1, 2 -> next is 3, leading to 1, 2, 3 again
-							else {
-
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag3;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag3 = pSMesh->Get_EvalStep_Time();
-							}
-						}
-						//LINEAR
-						else if (pSMesh->GetEvaluationSpeedup() == 2) {
+					if (pSDemag_Demag[idx_mesh]->do_transfer) {
 
-							//1, 2 -> next is 1
-							if (time_demag2 > time_demag1) {
+						//do inverse FFT and accumulate energy
+						if (pSDemag_Demag[idx_mesh]->transfer_Module_Heff.linear_size()) {
 
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag1 = pSMesh->Get_EvalStep_Time();
-							}
-							//2, 1 -> next is 2, leading to 1, 2 again
-							else {
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
+								pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true, &pSDemag_Demag[idx_mesh]->transfer_Module_Heff, &pSDemag_Demag[idx_mesh]->transfer_Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 
-								pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag2;
-								if (idx_mesh == pSDemag_Demag.size() - 1) time_demag2 = pSMesh->Get_EvalStep_Time();
-							}
+							pSDemag_Demag[idx_mesh]->transfer_Module_Heff.transfer_out();
+							pSDemag_Demag[idx_mesh]->transfer_Module_energy.transfer_out();
 						}
-						//STEP
 						else {
 
-							pHdemag = &pSDemag_Demag[idx_mesh]->Hdemag;
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 						}
-					}
 
-					//Inverse FFT
-
-					///////////////////////////////////////////////////////////////////////////////////////////////
-					//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-					///////////////////////////////////////////////////////////////////////////////////////////////
-
-					if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-						if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-							//do inverse FFT and accumulate energy
-							if (pSDemag_Demag[idx_mesh]->transfer_Module_Heff.linear_size()) {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
-									pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true, &pSDemag_Demag[idx_mesh]->transfer_Module_Heff, &pSDemag_Demag[idx_mesh]->transfer_Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-
-								pSDemag_Demag[idx_mesh]->transfer_Module_Heff.transfer_out();
-								pSDemag_Demag[idx_mesh]->transfer_Module_energy.transfer_out();
-							}
-							else {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-							}
-
-							//transfer to Heff in each mesh
-							pHdemag->transfer_out_duplicated();
-
-							//remove self demag contribution
-							#pragma omp parallel for
-							for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
+						//transfer to Heff in each mesh
+						pHdemag->transfer_out_duplicated();
 
-								//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-								(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-							}
-						}
-						else {
+						//remove self demag contribution
+						#pragma omp parallel for
+						for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
 
-							//do inverse FFT and accumulate energy
-							if (pSDemag_Demag[idx_mesh]->Module_Heff.linear_size()) {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT_AveragedInputs(
-									pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->M2,
-									*pHdemag, true, &pSDemag_Demag[idx_mesh]->Module_Heff, &pSDemag_Demag[idx_mesh]->Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-							}
-							else {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT_AveragedInputs(
-									pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->M2,
-									*pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-							}
-
-							//add contribution to Heff and Heff2 then remove self demag contribution
-							#pragma omp parallel for
-							for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-								pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += (*pHdemag)[idx];
-								pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += (*pHdemag)[idx];
-								//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-								(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
-							}
+							//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+							(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
 						}
 					}
-
-					///////////////////////////////////////////////////////////////////////////////////////////////
-					///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-					///////////////////////////////////////////////////////////////////////////////////////////////
-
 					else {
 
-						if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-							//do inverse FFT and accumulate energy
-							if (pSDemag_Demag[idx_mesh]->transfer_Module_Heff.linear_size()) {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
-									pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true, &pSDemag_Demag[idx_mesh]->transfer_Module_Heff, &pSDemag_Demag[idx_mesh]->transfer_Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-
-								pSDemag_Demag[idx_mesh]->transfer_Module_Heff.transfer_out();
-								pSDemag_Demag[idx_mesh]->transfer_Module_energy.transfer_out();
-							}
-							else {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-							}
-
-							//transfer to Heff in each mesh
-							pHdemag->transfer_out();
-
-							//remove self demag contribution
-							#pragma omp parallel for
-							for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
+						//do inverse FFT and accumulate energy
+						if (pSDemag_Demag[idx_mesh]->Module_Heff.linear_size()) {
 
-								//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-								(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-							}
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT_AveragedInputs(
+								pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->M2,
+								*pHdemag, true, &pSDemag_Demag[idx_mesh]->Module_Heff, &pSDemag_Demag[idx_mesh]->Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 						}
 						else {
 
-							//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
-
-							//do inverse FFT and accumulate energy
-							if (pSDemag_Demag[idx_mesh]->Module_Heff.linear_size()) {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
-									pSDemag_Demag[idx_mesh]->pMesh->M, *pHdemag, true, &pSDemag_Demag[idx_mesh]->Module_Heff, &pSDemag_Demag[idx_mesh]->Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-							}
-							else {
-
-								pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
-									pSDemag_Demag[idx_mesh]->pMesh->M, *pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
-							}
-
-							//add contribution to Heff then remove self demag contribution
-							#pragma omp parallel for
-							for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
-
-								pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += (*pHdemag)[idx];
-								//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
-								(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-							}
-						}
-					}
-
-					//build total energy
-					energy += pSDemag_Demag[idx_mesh]->energy * pSDemag_Demag[idx_mesh]->energy_density_weight;
-				}
-			}
-			else {
-
-				//not required to update, and we have enough previous evaluations: use previous Hdemag saves to extrapolate for current evaluation
-
-				double a1 = 1.0, a2 = 0.0, a3 = 0.0, a4 = 0.0, a5 = 0.0, a6 = 0.0;
-				double time = pSMesh->Get_EvalStep_Time();
-
-				//QUINTIC
-				if (pSMesh->GetEvaluationSpeedup() == 6) {
-
-					a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4) * (time_demag1 - time_demag5) * (time_demag1 - time_demag6));
-					a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4) * (time_demag2 - time_demag5) * (time_demag2 - time_demag6));
-					a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) * (time - time_demag5) * (time - time_demag6) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4) * (time_demag3 - time_demag5) * (time_demag3 - time_demag6));
-					a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag5) * (time - time_demag6) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3) * (time_demag4 - time_demag5) * (time_demag4 - time_demag6));
-					a5 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag6) / ((time_demag5 - time_demag1) * (time_demag5 - time_demag2) * (time_demag5 - time_demag3) * (time_demag5 - time_demag4) * (time_demag5 - time_demag6));
-					a6 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag6 - time_demag1) * (time_demag6 - time_demag2) * (time_demag6 - time_demag3) * (time_demag6 - time_demag4) * (time_demag6 - time_demag5));
-
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						//ANTIFERROMAGNETIC
-						if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 + pSDemag_Demag[idx_mesh]->Hdemag6[idx] * a6 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
-
-								//add contribution to Heff and Heff2
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 + pSDemag_Demag[idx_mesh]->Hdemag6[idx] * a6 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
-
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += Hdemag_value;
-									pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += Hdemag_value;
-								}
-							}
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT_AveragedInputs(
+								pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->M2,
+								*pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 						}
-						//FERROMAGNETIC
-						else {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 + pSDemag_Demag[idx_mesh]->Hdemag6[idx] * a6 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
 
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
+						//add contribution to Heff and Heff2 then remove self demag contribution
+						#pragma omp parallel for
+						for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
 
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
-
-								//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
-
-								//add contribution to Heff
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] +=
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 + pSDemag_Demag[idx_mesh]->Hdemag6[idx] * a6 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-								}
-							}
+							pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += (*pHdemag)[idx];
+							pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += (*pHdemag)[idx];
+							//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+							(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
 						}
 					}
 				}
-				//QUARTIC
-				else if (pSMesh->GetEvaluationSpeedup() == 5) {
-
-					a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4) * (time_demag1 - time_demag5));
-					a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) * (time - time_demag5) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4) * (time_demag2 - time_demag5));
-					a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) * (time - time_demag5) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4) * (time_demag3 - time_demag5));
-					a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag5) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3) * (time_demag4 - time_demag5));
-					a5 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) * (time - time_demag4) / ((time_demag5 - time_demag1) * (time_demag5 - time_demag2) * (time_demag5 - time_demag3) * (time_demag5 - time_demag4));
-
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						//ANTIFERROMAGNETIC
-						if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
+				///////////////////////////////////////////////////////////////////////////////////////////////
+				///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
+				///////////////////////////////////////////////////////////////////////////////////////////////
 
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
+				else {
 
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
+					if (pSDemag_Demag[idx_mesh]->do_transfer) {
 
-								//add contribution to Heff and Heff2
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+						//do inverse FFT and accumulate energy
+						if (pSDemag_Demag[idx_mesh]->transfer_Module_Heff.linear_size()) {
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
+								pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true, &pSDemag_Demag[idx_mesh]->transfer_Module_Heff, &pSDemag_Demag[idx_mesh]->transfer_Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += Hdemag_value;
-									pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += Hdemag_value;
-								}
-							}
+							pSDemag_Demag[idx_mesh]->transfer_Module_Heff.transfer_out();
+							pSDemag_Demag[idx_mesh]->transfer_Module_energy.transfer_out();
 						}
-						//FERROMAGNETIC
 						else {
 
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
-
-								//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
-
-								//add contribution to Heff
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] +=
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + pSDemag_Demag[idx_mesh]->Hdemag5[idx] * a5 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-								}
-							}
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, *pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 						}
-					}
-				}
-				//CUBIC
-				else if (pSMesh->GetEvaluationSpeedup() == 4) {
-
-					a1 = (time - time_demag2) * (time - time_demag3) * (time - time_demag4) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3) * (time_demag1 - time_demag4));
-					a2 = (time - time_demag1) * (time - time_demag3) * (time - time_demag4) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3) * (time_demag2 - time_demag4));
-					a3 = (time - time_demag1) * (time - time_demag2) * (time - time_demag4) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2) * (time_demag3 - time_demag4));
-					a4 = (time - time_demag1) * (time - time_demag2) * (time - time_demag3) / ((time_demag4 - time_demag1) * (time_demag4 - time_demag2) * (time_demag4 - time_demag3));
-
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						//ANTIFERROMAGNETIC
-						if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
-
-								//add contribution to Heff and Heff2
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 + 
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
-
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += Hdemag_value;
-									pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += Hdemag_value;
-								}
-							}
-						}
-						//FERROMAGNETIC
-						else {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
-
-								//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
+						//transfer to Heff in each mesh
+						pHdemag->transfer_out();
 
-								//add contribution to Heff
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+						//remove self demag contribution
+						#pragma omp parallel for
+						for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] +=
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 + pSDemag_Demag[idx_mesh]->Hdemag4[idx] * a4 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-								}
-							}
+							//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+							(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
 						}
 					}
-				}
-				//QUADRATIC
-				else if (pSMesh->GetEvaluationSpeedup() == 3) {
-
-					a1 = (time - time_demag2) * (time - time_demag3) / ((time_demag1 - time_demag2) * (time_demag1 - time_demag3));
-					a2 = (time - time_demag1) * (time - time_demag3) / ((time_demag2 - time_demag1) * (time_demag2 - time_demag3));
-					a3 = (time - time_demag1) * (time - time_demag2) / ((time_demag3 - time_demag1) * (time_demag3 - time_demag2));
-
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						//ANTIFERROMAGNETIC
-						if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
+					else {
 
-								//add contribution to Heff and Heff2
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+						//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
+						//do inverse FFT and accumulate energy
+						if (pSDemag_Demag[idx_mesh]->Module_Heff.linear_size()) {
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += Hdemag_value;
-									pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += Hdemag_value;
-								}
-							}
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
+								pSDemag_Demag[idx_mesh]->pMesh->M, *pHdemag, true, &pSDemag_Demag[idx_mesh]->Module_Heff, &pSDemag_Demag[idx_mesh]->Module_energy) / pSDemag_Demag[idx_mesh]->non_empty_cells);
 						}
-						//FERROMAGNETIC
 						else {
 
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
-
-								//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
+							pSDemag_Demag[idx_mesh]->energy += (-MU0 / 2) * (pSDemag_Demag[idx_mesh]->InverseFFT(
+								pSDemag_Demag[idx_mesh]->pMesh->M, *pHdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells);
+						}
 
-								//add contribution to Heff
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+						//add contribution to Heff then remove self demag contribution
+						#pragma omp parallel for
+						for (int idx = 0; idx < pHdemag->linear_size(); idx++) {
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] +=
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 + pSDemag_Demag[idx_mesh]->Hdemag3[idx] * a3 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-								}
-							}
+							pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += (*pHdemag)[idx];
+							//subtract self demag contribution: we'll add in again for the new magnetization, so it least the self demag is exact
+							(*pHdemag)[idx] -= (pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
 						}
 					}
 				}
-				//LINEAR
-				else if (pSMesh->GetEvaluationSpeedup() == 2) {
 
-					a1 = (time - time_demag2) / (time_demag1 - time_demag2);
-					a2 = (time - time_demag1) / (time_demag2 - time_demag1);
-
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						//ANTIFERROMAGNETIC
-						if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+				//build total energy
+				energy += pSDemag_Demag[idx_mesh]->energy * pSDemag_Demag[idx_mesh]->energy_density_weight;
+			}
 
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
+			//with error control check extrapolation residual over all meshes
+			for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
 
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+				evalspeedup.Accumulate_Residual(pSDemag_Demag[idx_mesh]->Hdemag);
+			}
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
+			evalspeedup.Save_Done();
+		}
 
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
+		else {
 
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
+			//not required to update, and we have enough previous evaluations: use previous Hdemag saves to extrapolate for current evaluation
+			//self demag contribution added in again for the current magnetization, so at least the self demag is exact
 
-								//add contribution to Heff and Heff2
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+			for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
+				SDemag_Demag& sdemag_demag = *pSDemag_Demag[idx_mesh];
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += Hdemag_value;
-									pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += Hdemag_value;
-								}
-							}
-						}
-						//FERROMAGNETIC
-						else {
+				//ANTIFERROMAGNETIC
+				if (sdemag_demag.pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
+					if (sdemag_demag.do_transfer) {
 
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+						//transfer from M to common meshing (not done above since no convolution)
+						sdemag_demag.transfer.transfer_in_averaged();
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
+						#pragma omp parallel for
+						for (int idx = 0; idx < sdemag_demag.transfer.linear_size(); idx++) {
 
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
+							sdemag_demag.transfer[idx] = evalspeedup.extrapolate(sdemag_demag.Hdemag, idx) + (sdemag_demag.selfDemagCoeff & sdemag_demag.transfer[idx]);
+						}
 
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
+						//transfer to Heff in each mesh
+						sdemag_demag.transfer.transfer_out_duplicated();
+					}
+					else {
 
-								//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
+						//add contribution to Heff and Heff2
+						#pragma omp parallel for
+						for (int idx = 0; idx < sdemag_demag.pMesh->n.dim(); idx++) {
 
-								//add contribution to Heff
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+							DBL3 Hdemag_value = evalspeedup.extrapolate(sdemag_demag.Hdemag, idx) + (sdemag_demag.selfDemagCoeff & (sdemag_demag.pMesh->M[idx] + sdemag_demag.pMesh->M2[idx]) / 2);
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] +=
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] * a1 + pSDemag_Demag[idx_mesh]->Hdemag2[idx] * a2 +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-								}
-							}
+							sdemag_demag.pMesh->Heff[idx] += Hdemag_value;
+							sdemag_demag.pMesh->Heff2[idx] += Hdemag_value;
 						}
 					}
 				}
-				//STEP
+				//FERROMAGNETIC
 				else {
 
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						//ANTIFERROMAGNETIC
-						if (pSDemag_Demag[idx_mesh]->pMeshBase->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+					if (sdemag_demag.do_transfer) {
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
+						//transfer from M to common meshing (not done above since no convolution)
+						sdemag_demag.transfer.transfer_in();
 
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
+						#pragma omp parallel for
+						for (int idx = 0; idx < sdemag_demag.transfer.linear_size(); idx++) {
 
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
-
-								//add contribution to Heff and Heff2
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
-
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & (pSDemag_Demag[idx_mesh]->pMesh->M[idx] + pSDemag_Demag[idx_mesh]->pMesh->M2[idx]) / 2);
-
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] += Hdemag_value;
-									pSDemag_Demag[idx_mesh]->pMesh->Heff2[idx] += Hdemag_value;
-								}
-							}
+							sdemag_demag.transfer[idx] = evalspeedup.extrapolate(sdemag_demag.Hdemag, idx) + (sdemag_demag.selfDemagCoeff & sdemag_demag.transfer[idx]);
 						}
-						//FERROMAGNETIC
-						else {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
 
-									DBL3 Hdemag_value =
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->transfer[idx]);
-
-									pSDemag_Demag[idx_mesh]->transfer[idx] = Hdemag_value;
-								}
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
+						//transfer to Heff in each mesh
+						sdemag_demag.transfer.transfer_out();
+					}
+					else {
 
-								//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
+						//transfer is forced for atomistic meshes, so if no transfer required, this must mean a micromagnetic mesh
 
-								//add contribution to Heff
-								#pragma omp parallel for
-								for (int idx = 0; idx < pSDemag_Demag[idx_mesh]->Hdemag.linear_size(); idx++) {
+						//add contribution to Heff
+						#pragma omp parallel for
+						for (int idx = 0; idx < sdemag_demag.pMesh->n.dim(); idx++) {
 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff[idx] +=
-										pSDemag_Demag[idx_mesh]->Hdemag[idx] +
-										(pSDemag_Demag[idx_mesh]->selfDemagCoeff & pSDemag_Demag[idx_mesh]->pMesh->M[idx]);
-								}
-							}
+							sdemag_demag.pMesh->Heff[idx] += evalspeedup.extrapolate(sdemag_demag.Hdemag, idx) + (sdemag_demag.selfDemagCoeff & sdemag_demag.pMesh->M[idx]);
 						}
 					}
 				}
@@ -10,6 +10,7 @@ class SuperMesh;
 #include "Convolution.h"
 #include "DemagKernel.h"
 #include "DemagKernelCollection.h"
+#include "EvalSpeedup.h"
 
 #include "SDemag_Demag.h"
 
@@ -95,10 +96,8 @@ private:
 
 	//Evaluation speedup mode data
 
-	//times at which evaluations were done, used for extrapolation
-	double time_demag1 = 0.0, time_demag2 = 0.0, time_demag3 = 0.0, time_demag4 = 0.0, time_demag5 = 0.0, time_demag6 = 0.0;
-
-	int num_Hdemag_saved = 0;
+	//history of saved fields for multi-layered convolution : saved fields held by each SDemag_Demag module (Hdemag)
+	EvalSpeedup evalspeedup;
 
 private:
 
@@ -86,53 +86,13 @@ BError SDemag_Demag::Initialize_Mesh_Transfer(void)
 			{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
 			MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
 
-		//the Hdemag.size() checks are needed : if initializing in CUDA mode, this routine will be called so transfer objecty can calculate the mesh transfer. we don't need Hdemag ... from SDemag_Demag module in CUDA mode (but we do need them from the SDemagCUDA_Demag).
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup()) {
+		//the Hdemag[slot].size() checks are needed : if initializing in CUDA mode, this routine will be called so transfer objecty can calculate the mesh transfer. we don't need Hdemag from SDemag_Demag module in CUDA mode (but we do need them from the SDemagCUDA_Demag).
+		for (int slot = 0; slot < Hdemag.size(); slot++) {
 
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 1 && Hdemag.size() == transfer.size()) {
+			if (Hdemag[slot].size() == transfer.size()) {
 
 				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag.Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
-					{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
-					MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 2 && Hdemag2.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag2.Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
-					{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
-					MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 3 && Hdemag3.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag3.Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
-					{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
-					MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 4 && Hdemag4.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag4.Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
-					{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
-					MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 5 && Hdemag5.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag5.Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
-					{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
-					MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 6 && Hdemag6.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag6.Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
+				if (!Hdemag[slot].Initialize_MeshTransfer_AveragedInputs_DuplicatedOutputs(
 					{ &pMesh->M }, { &pMesh->M2 }, { &pMesh->Heff }, { &pMesh->Heff2 },
 					MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
 			}
@@ -152,42 +112,12 @@ BError SDemag_Demag::Initialize_Mesh_Transfer(void)
 
 		if (!transfer.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
 
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup()) {
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 1 && Hdemag.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 2 && Hdemag2.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag2.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
+		for (int slot = 0; slot < Hdemag.size(); slot++) {
 
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 3 && Hdemag3.size() == transfer.size()) {
+			if (Hdemag[slot].size() == transfer.size()) {
 
 				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag3.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 4 && Hdemag4.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag4.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 5 && Hdemag5.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag5.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 6 && Hdemag6.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag6.Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
+				if (!Hdemag[slot].Initialize_MeshTransfer({ &pMesh->M }, { &pMesh->Heff }, MESHTRANSFERTYPE_WEIGHTED)) return error(BERROR_OUTOFMEMORY_CRIT);
 			}
 		}
 
@@ -204,42 +134,12 @@ BError SDemag_Demag::Initialize_Mesh_Transfer(void)
 
 		if (!transfer.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
 
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup()) {
+		for (int slot = 0; slot < Hdemag.size(); slot++) {
 
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 1 && Hdemag.size() == transfer.size()) {
+			if (Hdemag[slot].size() == transfer.size()) {
 
 				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 2 && Hdemag2.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag2.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 3 && Hdemag3.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag3.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 4 && Hdemag4.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag4.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 5 && Hdemag5.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag5.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
-			}
-
-			if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 6 && Hdemag6.size() == transfer.size()) {
-
-				//initialize mesh transfer for Hdemag as well if we are using evaluation speedup
-				if (!Hdemag6.Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
+				if (!Hdemag[slot].Initialize_MeshTransfer({ &paMesh->M1 }, { &paMesh->Heff1 }, MESHTRANSFERTYPE_WDENSITY, MUB)) return error(BERROR_OUTOFMEMORY_CRIT);
 			}
 		}
 
@@ -327,24 +227,8 @@ BError SDemag_Demag::Initialize(void)
 
 		selfDemagCoeff = DemagTFunc().SelfDemag_PBC(h_common, pSDemag->n_common, pSDemag->demag_pbc_images);
 
-		//make sure to allocate memory for Hdemag if we need it
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 1) Hdemag.resize(h_common, convolution_rect);
-		else Hdemag.clear();
-
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 2) Hdemag2.resize(h_common, convolution_rect);
-		else Hdemag2.clear();
-
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 3) Hdemag3.resize(h_common, convolution_rect);
-		else Hdemag3.clear();
-
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 4) Hdemag4.resize(h_common, convolution_rect);
-		else Hdemag4.clear();
-
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 5) Hdemag5.resize(h_common, convolution_rect);
-		else Hdemag5.clear();
-
-		if (pMeshBase->pSMesh->GetEvaluationSpeedup() >= 6) Hdemag6.resize(h_common, convolution_rect);
-		else Hdemag6.clear();
+		//make sure to allocate memory for Hdemag if we need it (number of saved fields set by the evaluation speedup history in SDemag)
+		if (!pSDemag->evalspeedup.Resize_Fields(Hdemag, h_common, convolution_rect)) return error(BERROR_OUTOFMEMORY_CRIT);
 
 		if (!pMeshBase->is_atomistic() && convolution_rect == meshRect && h_common == h) {
 
@@ -400,11 +284,6 @@ BError SDemag_Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	if (!initialized) {
 
 		Hdemag.clear();
-		Hdemag2.clear();
-		Hdemag3.clear();
-		Hdemag4.clear();
-		Hdemag5.clear();
-		Hdemag6.clear();
 	}
 
 	if (layer_number_2d >= 0) {
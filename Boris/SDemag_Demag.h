@@ -80,8 +80,8 @@ private:
 
 	//Evaluation speedup mode data
 
-	//vec for demagnetizing field polynomial extrapolation
-	VEC<DBL3> Hdemag, Hdemag2, Hdemag3, Hdemag4, Hdemag5, Hdemag6;
+	//saved demagnetizing fields for polynomial extrapolation, without self demag contribution (history in SDemag evalspeedup)
+	std::vector<VEC<DBL3>> Hdemag;
 
 	//-Nxx, -Nyy, -Nzz values at r = r0
 	DBL3 selfDemagCoeff = DBL3();
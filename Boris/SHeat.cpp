@@ -8,7 +8,7 @@
 
 SHeat::SHeat(SuperMesh *pSMesh_) :
 	Modules(),
-	ProgramStateNames(this, {VINFO(heat_dT), VINFO(globalTemp), VINFO(globalTemp_velocity), VINFO(globalTemp_shift_clip), VINFO(globalTemp_shift_debt), VINFO(globalTemp_last_time)}, {})
+	ProgramStateNames(this, {VINFO(heat_dT), VINFO(globalTemp), VINFO(globalTemp_velocity), VINFO(globalTemp_shift_clip), VINFO(globalTemp_shift_debt), VINFO(globalTemp_last_time), VINFO(heat_solver), VINFO(heat_errorMax), VINFO(heat_maxIterations)}, {})
 {
 	pSMesh = pSMesh_;
 
@@ -35,6 +35,9 @@ BError SHeat::Initialize(void)
 	//needed by global temperature shift algorithm
 	globalTemp_last_time = pSMesh->GetTime();
 
+	heat_time_debt = 0.0;
+	heat_iters_to_conv = 0;
+
 	//check meshes to set heat boundary flags (NF2_CMBND flags for Temp)
 
 	//clear everything then rebuild
@@ -183,6 +186,28 @@ double SHeat::UpdateField(void)
 		return 0.0;
 	}
 
+	//implicit solvers : heat_dT can be larger than the magnetic time step, so only advance once the accumulated magnetic time steps reach it
+	if (heat_solver != HEATSOLVER_FTCS) {
+
+		heat_time_debt += magnetic_dT;
+
+		if (heat_time_debt >= heat_dT * (1.0 - 1e-6)) {
+
+			//if heat_dT is smaller than the magnetic time step, cover it in equal steps not exceeding heat_dT
+			int sub_steps = maximum((int)ceil_epsilon(heat_time_debt / heat_dT), 1);
+
+			for (int step_idx = 0; step_idx < sub_steps; step_idx++) IterateHeatEquation_Implicit(heat_time_debt / sub_steps);
+
+			heat_time_debt = 0.0;
+
+			for (int idx = 0; idx < (int)pHeat.size(); idx++) pHeat[idx]->pMeshBase->Temperature_Changed();
+		}
+
+		magnetic_dT = pSMesh->GetTimeStep();
+
+		return 0.0;
+	}
+
 	double dT = heat_dT;
 
 	//number of sub_steps to cover magnetic_dT required when advancing in smaller heat_dT steps
@@ -211,6 +236,9 @@ double SHeat::UpdateField(void)
 		set_cmbnd_values();
 	}
 
+	//temperature changed in all meshes : parameter values cached with temperature dependence must be resolved again
+	for (int idx = 0; idx < (int)pHeat.size(); idx++) pHeat[idx]->pMeshBase->Temperature_Changed();
+
 	//3. update the magnetic dT that will be used next time around to increment the heat solver by
 	magnetic_dT = pSMesh->GetTimeStep();
 
@@ -218,6 +246,69 @@ double SHeat::UpdateField(void)
 	return 0.0;
 }
 
+//advance heat equation by dT using the set implicit solver (CN or BE)
+void SHeat::IterateHeatEquation_Implicit(double dT)
+{
+	double theta = (heat_solver == HEATSOLVER_CN ? 0.5 : 1.0);
+
+	//1. store explicit parts in each mesh
+	for (int idx = 0; idx < (int)pHeat.size(); idx++) pHeat[idx]->PrimeHeatEquation_Implicit(dT, theta);
+
+	//2. iterate all meshes together, setting CMBND values after each iteration, until converged
+	heat_iters_to_conv = 0;
+
+	double error = 0.0;
+
+	do {
+
+		double max_change = 0.0, max_value = 0.0;
+
+		for (int idx = 0; idx < (int)pHeat.size(); idx++) {
+
+			DBL2 change_value = pHeat[idx]->IterateHeatEquation_Implicit(dT, theta);
+
+			max_change = maximum(max_change, change_value.i);
+			max_value = maximum(max_value, change_value.j);
+		}
+
+		set_cmbnd_values();
+
+		//normalized maximum change
+		error = (max_value > 0.0 ? max_change / max_value : max_change);
+
+		heat_iters_to_conv++;
+
+	} while (error > heat_errorMax && heat_iters_to_conv < heat_maxIterations);
+}
+
+std::string SHeat::GetHeatSolverName(void)
+{
+	switch (heat_solver) {
+
+	case HEATSOLVER_CN:
+		return "cn";
+
+	case HEATSOLVER_BE:
+		return "be";
+
+	default:
+		return "ftcs";
+	}
+}
+
+//set heat solver method by name (ftcs, cn, be) : return false if not recognized
+bool SHeat::SetHeatSolver(std::string method_name)
+{
+	if (method_name == "ftcs") heat_solver = HEATSOLVER_FTCS;
+	else if (method_name == "cn") heat_solver = HEATSOLVER_CN;
+	else if (method_name == "be") heat_solver = HEATSOLVER_BE;
+	else return false;
+
+	heat_time_debt = 0.0;
+
+	return true;
+}
+
 //calculate and set values at composite media boundaries after all other cells have been computed and set
 void SHeat::set_cmbnd_values(void)
 {
@@ -2,6 +2,7 @@
 
 #include "BorisLib.h"
 #include "Modules.h"
+#include "Heat_Defs.h"
 
 class SuperMesh;
 class HeatBase;
@@ -14,7 +15,7 @@ class HeatBase;
 
 class SHeat :
 	public Modules,
-	public ProgramState<SHeat, std::tuple<double, VEC_VC<double>, DBL3, DBL3, DBL3, double>, std::tuple<>>
+	public ProgramState<SHeat, std::tuple<double, VEC_VC<double>, DBL3, DBL3, DBL3, double, int, double, int>, std::tuple<>>
 {
 
 #if COMPILECUDA == 1
@@ -61,8 +62,26 @@ private:
 	//Update magnetic_dT after each heat equation advance (in case an adaptive time-step method is used for the magnetic part).
 	double magnetic_dT;
 
+	//---------------------- Implicit solver
+
+	//heat equation solver method (HEATSOLVER_ enum) : FTCS is explicit and heat_dT cannot exceed the magnetic time step; CN and BE are implicit and heat_dT can be larger
+	int heat_solver = HEATSOLVER_FTCS;
+
+	//convergence settings for implicit solvers : iterate until normalized maximum temperature change is below heat_errorMax, or heat_maxIterations reached
+	double heat_errorMax = 1e-7;
+	int heat_maxIterations = 100;
+
+	//number of iterations taken in the last implicit time step
+	int heat_iters_to_conv = 0;
+
+	//for implicit solvers the heat equation is advanced only once accumulated magnetic time steps reach heat_dT
+	double heat_time_debt = 0.0;
+
 private:
 
+	//advance heat equation by dT using the set implicit solver (CN or BE)
+	void IterateHeatEquation_Implicit(double dT);
+
 	//calculate and set values at composite media boundaries after all other cells have been computed and set
 	void set_cmbnd_values(void);
 
@@ -92,10 +111,21 @@ public:
 
 	double get_heat_dT(void) { return heat_dT; }
 
+	int GetHeatSolver(void) { return heat_solver; }
+	std::string GetHeatSolverName(void);
+
+	double GetHeatSolverConvergenceError(void) { return heat_errorMax; }
+	int GetHeatSolverIterationsTimeout(void) { return heat_maxIterations; }
+	int GetHeatSolverIterations(void) { return heat_iters_to_conv; }
+
 	//-------------------Setters
 
 	void set_heat_dT(double dT) { heat_dT = dT; }
 
+	//set heat solver method by name (ftcs, cn, be) : return false if not recognized
+	bool SetHeatSolver(std::string method_name);
+	void SetHeatSolverConvergence(double errorMax, int maxIterations) { heat_errorMax = errorMax; heat_maxIterations = maxIterations; }
+
 	void set_globalTemp_velocity(DBL3 velocity, DBL3 clipping) { globalTemp_velocity = velocity; globalTemp_shift_clip = clipping; }
 	DBL3 get_globalTemp_velocity(void) { return globalTemp_velocity; }
 	DBL3 get_globalTemp_clipping(void) { return globalTemp_shift_clip; }
@@ -144,10 +174,20 @@ public:
 
 	double get_heat_dT(void) { return 0.0; }
 
+	int GetHeatSolver(void) { return 0; }
+	std::string GetHeatSolverName(void) { return ""; }
+
+	double GetHeatSolverConvergenceError(void) { return 0.0; }
+	int GetHeatSolverIterationsTimeout(void) { return 0; }
+	int GetHeatSolverIterations(void) { return 0; }
+
 	//-------------------Setters
 
 	void set_heat_dT(double dT) {}
 
+	bool SetHeatSolver(std::string method_name) { return true; }
+	void SetHeatSolverConvergence(double errorMax, int maxIterations) {}
+
 	void set_globalTemp_velocity(DBL3 velocity, DBL3 clipping) { }
 	DBL3 get_globalTemp_velocity(void) { return DBL3(); }
 	DBL3 get_globalTemp_clipping(void) { return DBL3(); }
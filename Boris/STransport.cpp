@@ -18,7 +18,7 @@ STransport::STransport(SuperMesh *pSMesh_) :
 	ProgramStateNames(this, 
 		{ VINFO(electrode_rects), VINFO(electrode_potentials), VINFO(ground_electrode_index), 
 		VINFO(potential), VINFO(current), VINFO(net_current), VINFO(resistance), VINFO(constant_current_source), VINFO(open_potential_resistance),
-		VINFO(errorMaxLaplace), VINFO(maxLaplaceIterations), VINFO(s_errorMax), VINFO(s_maxIterations), VINFO(SOR_damping),
+		VINFO(errorMaxLaplace), VINFO(maxLaplaceIterations), VINFO(s_errorMax), VINFO(s_maxIterations), VINFO(SOR_damping), VINFO(solver_method),
 		VINFO(V_equation), VINFO(I_equation) }, {})
 {
 	pSMesh = pSMesh_;
@@ -602,6 +602,29 @@ void STransport::SetSConvergenceError(double s_errorMax_, int s_maxIterations_)
 	recalculate_transport = true;
 }
 
+std::string STransport::GetSolverMethodName(void)
+{
+	switch (solver_method) {
+
+	case TSOLVERMETHOD_MGV: return "mgv";
+	case TSOLVERMETHOD_MGW: return "mgw";
+	default: return "sor";
+	}
+}
+
+//set Poisson solver method used for V from name : sor, mgv (multigrid V-cycle), mgw (multigrid W-cycle). Return false if name not recognized.
+bool STransport::SetSolverMethod(std::string method_name)
+{
+	if (method_name == "sor") solver_method = TSOLVERMETHOD_SOR;
+	else if (method_name == "mgv") solver_method = TSOLVERMETHOD_MGV;
+	else if (method_name == "mgw") solver_method = TSOLVERMETHOD_MGW;
+	else return false;
+
+	recalculate_transport = true;
+
+	return true;
+}
+
 //-------------------Electrodes methods
 
 void STransport::AddElectrode(double electrode_potential, Rect electrode_rect)
@@ -18,7 +18,7 @@ class STransport :
 	public ProgramState<STransport, 
 	std::tuple<vector_lut<Rect>, std::vector<double>, int, 
 	double, double, double, double, bool, double,
-	double, int, double, int, DBL2, 
+	double, int, double, int, DBL2, int,
 	TEquation<double>, TEquation<double>>, std::tuple<>>
 {
 
@@ -100,6 +100,12 @@ private:
 	//fixed SOR damping to use for V (first value) and S (second value) Poisson equations
 	DBL2 SOR_damping = DBL2(1.4, 0.5);
 
+	//Poisson solver method used for V (TSOLVERMETHOD_ enum) : SOR iterations, or multigrid cycles. The S equation is always solved using SOR.
+	int solver_method = TSOLVERMETHOD_SOR;
+
+	//wall time (ms) taken by the last V solve, to compare solver methods together with iters_to_conv
+	unsigned solve_time_ms = 0;
+
 	//after transport solver has relaxed below errorMaxLaplace, it only needs to be updated if relevant quantities change (e.g. potential, conductivity)
 	//When these changes occur this flag is set to true.
 	bool recalculate_transport = true;
@@ -121,7 +127,7 @@ private:
 
 	//-----Charge Transport only
 
-	//solve for V and Jc in all meshes using SOR
+	//solve for V and Jc in all meshes using SOR (or multigrid if set)
 	void solve_charge_transport_sor(void);
 
 	//calculate and set values at composite media boundaries for V (charge transport only) after all other cells have been computed and set
@@ -129,9 +135,12 @@ private:
 
 	//-----Spin and Charge Transport
 
-	//solve for V, Jc and S in all meshes using SOR for Poisson equation and FTCS for S equation
+	//solve for V, Jc and S in all meshes using SOR for Poisson equation and FTCS for S equation (multigrid for V if set)
 	void solve_spin_transport_sor(void);
 
+	//take a single iteration of the V solver in transport mesh with given index, using the set solver method : charge solver, or charge part of spin solver if spin_solver is true
+	DBL2 iterate_V_solver(int idx, bool spin_solver);
+
 	//calculate and set values at composite media boundaries for V (when using spin transport solver)
 	void set_cmbnd_spin_transport_V(void);
 
@@ -214,6 +223,13 @@ public:
 	//get fixed SOR damping values (for V and S solvers)
 	DBL2 GetSORDamping(void) { return SOR_damping; }
 
+	//get Poisson solver method used for V (TSOLVERMETHOD_ enum), and its name as used in the tsolvermethod command
+	int GetSolverMethod(void) { return solver_method; }
+	std::string GetSolverMethodName(void);
+
+	//wall time (ms) taken by the last V solve
+	int GetSolveTime(void) { return (int)solve_time_ms; }
+
 	bool IsOpenPotential(void) { return open_potential_resistance > 0.0; }
 
 	double GetOpenPotentialResistance(void) { return open_potential_resistance; }
@@ -237,6 +253,9 @@ public:
 	//set fixed SOR damping values (for V and S solvers)
 	void SetSORDamping(DBL2 _SOR_damping);
 
+	//set Poisson solver method used for V from name : sor, mgv (multigrid V-cycle), mgw (multigrid W-cycle). Return false if name not recognized.
+	bool SetSolverMethod(std::string method_name);
+
 	//set text equation from std::string
 	BError SetPotentialEquation(std::string equation_string, int step);
 	BError SetCurrentEquation(std::string equation_string, int step);
@@ -344,6 +363,11 @@ public:
 	//get fixed SOR damping values (for V and S solvers)
 	DBL2 GetSORDamping(void) { return DBL2(); }
 
+	int GetSolverMethod(void) { return 0; }
+	std::string GetSolverMethodName(void) { return ""; }
+
+	int GetSolveTime(void) { return 0; }
+
 	double GetOpenPotentialResistance(void) { return 0.0; }
 
 	//-------------------Setters
@@ -364,6 +388,8 @@ public:
 	//set fixed SOR damping values (for V and S solvers)
 	void SetSORDamping(DBL2 _SOR_damping) {}
 
+	bool SetSolverMethod(std::string method_name) { return true; }
+
 	//set text equation from std::string
 	BError SetPotentialEquation(std::string equation_string, int step) { return BError(); }
 	BError SetCurrentEquation(std::string equation_string, int step) { return BError(); }
@@ -11,6 +11,8 @@ void STransport::solve_charge_transport_sor(void)
 
 	iters_to_conv = 0;
 
+	unsigned start_time = GetSystemTickCount();
+
 	do {
 
 		//get max error : the max change in V from one iteration to the next
@@ -22,7 +24,7 @@ void STransport::solve_charge_transport_sor(void)
 
 			DBL2 error;
 
-			error = pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+			error = iterate_V_solver(idx, false);
 
 			if (error.first > max_error.first) max_error.first = error.first;
 			if (error.second > max_error.second) max_error.second = error.second;
@@ -38,6 +40,8 @@ void STransport::solve_charge_transport_sor(void)
 
 	} while (max_error.first > errorMaxLaplace && iters_to_conv < maxLaplaceIterations);
 
+	solve_time_ms = GetSystemTickCount() - start_time;
+
 	//continue next iteration if iterations timeout reached - with this timeout built in the program doesn't block if errorMaxLaplace cannot be reached. 
 	if (iters_to_conv == maxLaplaceIterations) recalculate_transport = true;
 	
@@ -59,6 +63,29 @@ void STransport::solve_charge_transport_sor(void)
 	energy = max_error.first;
 }
 
+//take a single iteration of the V solver in transport mesh with given index, using the set solver method : charge solver, or charge part of spin solver if spin_solver is true
+DBL2 STransport::iterate_V_solver(int idx, bool spin_solver)
+{
+	//the charge part of the spin solver is only used in meshes with spin solver enabled
+	spin_solver &= (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE);
+
+	switch (solver_method) {
+
+	case TSOLVERMETHOD_MGV:
+	case TSOLVERMETHOD_MGW:
+	{
+		int cycle_gamma = (solver_method == TSOLVERMETHOD_MGW ? 2 : 1);
+
+		if (spin_solver) return pTransport[idx]->IterateSpinSolver_Charge_MG(SOR_damping.i, cycle_gamma);
+		else return pTransport[idx]->IterateChargeSolver_MG(SOR_damping.i, cycle_gamma);
+	}
+
+	default:
+		if (spin_solver) return pTransport[idx]->IterateSpinSolver_Charge_SOR(SOR_damping.i);
+		else return pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+	}
+}
+
 //-------------------CMBND computation methods
 
 void STransport::set_cmbnd_charge_transport(void)
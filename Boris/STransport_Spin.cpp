@@ -21,6 +21,8 @@ void STransport::solve_spin_transport_sor(void)
 	
 	//1. Solve V everywhere for current S until convergence criteria hit
 
+	unsigned start_time = GetSystemTickCount();
+
 	do {
 
 		//get max error : the max change in V from one iteration to the next
@@ -31,8 +33,7 @@ void STransport::solve_spin_transport_sor(void)
 
 			DBL2 error;
 
-			if (pTransport[idx]->Get_STSolveType() != STSOLVE_NONE) error = pTransport[idx]->IterateSpinSolver_Charge_SOR(SOR_damping.i);
-			else error = pTransport[idx]->IterateChargeSolver_SOR(SOR_damping.i);
+			error = iterate_V_solver(idx, true);
 
 			if (error.first > max_error.first) max_error.first = error.first;
 			if (error.second > max_error.second) max_error.second = error.second;
@@ -48,6 +49,8 @@ void STransport::solve_spin_transport_sor(void)
 
 	} while (max_error.first > errorMaxLaplace && iters_to_conv < maxLaplaceIterations);
 
+	solve_time_ms = GetSystemTickCount() - start_time;
+
 	//2. update E in all meshes
 	for (int idx = 0; idx < (int)pTransport.size(); idx++) {
 
@@ -24,34 +24,39 @@ void Simulation::Simulate(void)
 
 		CheckSaveDataConditions();
 
-		if (simStages[stage_step.major].stage_type() == SS_MONTECARLO) {
+		//iteration timed by the profiler (saving data not included)
+		{
+			ProfileScope profile_iteration(PROFILE_ITERATION);
 
-			//Monte-Carlo stages are special - use Iterate_MonteCarlo to advance simulation instead
+			if (simStages[stage_step.major].stage_type() == SS_MONTECARLO) {
+
+				//Monte-Carlo stages are special - use Iterate_MonteCarlo to advance simulation instead
 #if COMPILECUDA == 1
-			if (cudaEnabled) {
+				if (cudaEnabled) {
 
-				SMesh.Iterate_MonteCarloCUDA(simStages[stage_step.major].get_value<double>(stage_step.minor));
-				if (SMesh.Get_MonteCarlo_ComputeFields()) SMesh.ComputeFieldsCUDA();
-			}
-			else {
+					SMesh.Iterate_MonteCarloCUDA(simStages[stage_step.major].get_value<double>(stage_step.minor));
+					if (SMesh.Get_MonteCarlo_ComputeFields()) SMesh.ComputeFieldsCUDA();
+				}
+				else {
 
+					SMesh.Iterate_MonteCarlo(simStages[stage_step.major].get_value<double>(stage_step.minor));
+					if (SMesh.Get_MonteCarlo_ComputeFields()) SMesh.ComputeFields();
+				}
+#else
 				SMesh.Iterate_MonteCarlo(simStages[stage_step.major].get_value<double>(stage_step.minor));
 				if (SMesh.Get_MonteCarlo_ComputeFields()) SMesh.ComputeFields();
-			}
-#else
-			SMesh.Iterate_MonteCarlo(simStages[stage_step.major].get_value<double>(stage_step.minor));
-			if (SMesh.Get_MonteCarlo_ComputeFields()) SMesh.ComputeFields();
 #endif
-		}
-		else {
+			}
+			else {
 
-			//advance time for this iteration
+				//advance time for this iteration
 #if COMPILECUDA == 1
-			if (cudaEnabled) SMesh.AdvanceTimeCUDA();
-			else SMesh.AdvanceTime();
+				if (cudaEnabled) SMesh.AdvanceTimeCUDA();
+				else SMesh.AdvanceTime();
 #else
-			SMesh.AdvanceTime();
+				SMesh.AdvanceTime();
 #endif
+			}
 		}
 
 		if (iterUpdate && SMesh.GetIteration() % iterUpdate == 0) UpdateScreen_Quick();
@@ -125,7 +130,7 @@ bool Simulation::PrepareRunSimulation(void)
 	bool initialization_error = false;
 
 	//reset buffers
-	savedata_diskbuffer_position = 0;
+	savedata_diskbuffer.clear();
 
 	if (is_thread_running(THREAD_LOOP)) {
 
@@ -198,7 +203,7 @@ void Simulation::StopSimulation(void)
 		single_stage_run = false;
 
 		//flush disk buffer
-		if (savedata_diskbuffer_position) SaveData_DiskBufferFlush(&savedata_diskbuffer, &savedata_diskbuffer_position);
+		savedata_diskbuffer.flush();
 
 		stop_thread(THREAD_LOOP);
 
@@ -55,6 +55,23 @@ void Simulation::Load_Startup_Flags(void)
 				if (bdin.getline(line, FILEROWCHARS)) OmpThreads = ToNum(std::string(line));
 				if (OmpThreads == 0 || OmpThreads > omp_get_num_procs()) OmpThreads = omp_get_num_procs();
 			}
+
+			//FFTW planner rigor
+			if (std::string(line) == "fftw_planner_rigor") {
+
+				if (bdin.getline(line, FILEROWCHARS)) FFTWPlanner::set_rigor(std::string(line));
+			}
+
+			//Demag kernel cache : maximum size (0 to disable) and directory
+			if (std::string(line) == "kernelcache_maxsize_MB") {
+
+				if (bdin.getline(line, FILEROWCHARS)) DemagKernelCache::maxsize_MB() = ToNum(std::string(line));
+			}
+
+			if (std::string(line) == "kernelcache_directory") {
+
+				if (bdin.getline(line, FILEROWCHARS) && std::string(line).length()) DemagKernelCache::directory() = std::string(line);
+			}
 		}
 
 		bdin.close();
@@ -98,6 +115,17 @@ void Simulation::Save_Startup_Flags(void)
 		if (OmpThreads == omp_get_num_procs()) bdout << 0 << std::endl;
 		else bdout << OmpThreads << std::endl;
 
+		//FFTW planner rigor
+		bdout << "fftw_planner_rigor" << std::endl;
+		bdout << FFTWPlanner::rigor_name(FFTWPlanner::rigor()) << std::endl;
+
+		//Demag kernel cache : maximum size (0 to disable) and directory
+		bdout << "kernelcache_maxsize_MB" << std::endl;
+		bdout << DemagKernelCache::maxsize_MB() << std::endl;
+
+		bdout << "kernelcache_directory" << std::endl;
+		bdout << DemagKernelCache::directory() << std::endl;
+
 		bdout.close();
 	}
 }
\ No newline at end of file
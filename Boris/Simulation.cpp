@@ -515,6 +515,12 @@ Simulation::Simulation(
 	commands[CMD_DELMODULE].limits = { { Any(), Any() }, { Any(), Any() } };
 	commands[CMD_DELMODULE].descr = "[tc0,0.5,0.5,1/tc]Delete module with given handle from named mesh (focused mesh if not specified).";
 
+	commands.insert(CMD_FUSEDFIELDS, CommandSpecifier(CMD_FUSEDFIELDS), "fusedfields");
+	commands[CMD_FUSEDFIELDS].usage = "[tc0,0.5,0,1/tc]USAGE : <b>fusedfields</b> <i>status</i>";
+	commands[CMD_FUSEDFIELDS].descr = "[tc0,0.5,0.5,1/tc]Set/unset fused evaluation of local field modules (exchange, DMI, uniaxial anisotropy) in ferromagnetic meshes : consecutive such modules are computed in a single sweep over the mesh instead of one sweep per module, with same effective field. CPU computations only.";
+	commands[CMD_FUSEDFIELDS].limits = { { int(0), int(1) } };
+	commands[CMD_FUSEDFIELDS].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status</i>";
+
 	commands.insert(CMD_MULTICONV, CommandSpecifier(CMD_MULTICONV), "multiconvolution");
 	commands[CMD_MULTICONV].usage = "[tc0,0.5,0,1/tc]USAGE : <b>multiconvolution</b> <i>status</i>";
 	commands[CMD_MULTICONV].descr = "[tc0,0.5,0.5,1/tc]Switch between multi-layered convolution (true) and supermesh convolution (false).";
@@ -544,6 +550,12 @@ Simulation::Simulation(
 	commands[CMD_GPUKERNELS].descr = "[tc0,0.5,0.5,1/tc]When in CUDA mode calculate demagnetization kernels initialization on the GPU (1) or on the CPU (0).";
 	commands[CMD_GPUKERNELS].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status</i>";
 
+	commands.insert(CMD_DEMAGSPREC, CommandSpecifier(CMD_DEMAGSPREC), "demagsprec");
+	commands[CMD_DEMAGSPREC].usage = "[tc0,0.5,0,1/tc]USAGE : <b>demagsprec</b> <i>status</i>";
+	commands[CMD_DEMAGSPREC].descr = "[tc0,0.5,0.5,1/tc]Set/unset mixed precision demagnetization and dipole-dipole convolution : ffts and kernel multiplication done in single precision, with input and output fields in double precision. Faster for large meshes, at the cost of single precision accuracy in the convolution output. CPU computations only, not used for multi-layered convolution.";
+	commands[CMD_DEMAGSPREC].limits = { { int(0), int(1) } };
+	commands[CMD_DEMAGSPREC].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status</i>";
+
 	commands.insert(CMD_ODE, CommandSpecifier(CMD_ODE), "ode");
 	commands[CMD_ODE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ode</b>";
 	commands[CMD_ODE].descr = "[tc0,0.5,0.5,1/tc]Show interactive list of available and currently set ODEs and evaluation methods.";
@@ -554,6 +566,12 @@ Simulation::Simulation(
 	commands[CMD_EVALSPEEDUP].descr = "[tc0,0.5,0.5,1/tc]Enable/disable evaluation speedup by extrapolating demag field at evaluation substeps from previous field updates. Status levels: 0 (no speedup), 1 (step), 2 (linear), 3 (quadratic), 4 (cubic), 5 (quartic), 6 (quintic). If enabling speedup strongly recommended to always use quadratic type.";
 	commands[CMD_EVALSPEEDUP].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>level</i>";
 
+	commands.insert(CMD_EVALSPEEDUPTOL, CommandSpecifier(CMD_EVALSPEEDUPTOL), "evalspeeduptol");
+	commands[CMD_EVALSPEEDUPTOL].usage = "[tc0,0.5,0,1/tc]USAGE : <b>evalspeeduptol</b> <i>tolerance</i>";
+	commands[CMD_EVALSPEEDUPTOL].limits = { { double(0.0), Any() } };
+	commands[CMD_EVALSPEEDUPTOL].descr = "[tc0,0.5,0.5,1/tc]Set relative tolerance for the extrapolation residual in evaluation speedup mode (0 to disable, default). When set, every time the demag field is computed it is also compared to the extrapolated value: whilst the residual is within tolerance step updates are skipped (extrapolating instead), and the number of extrapolation points giving the smallest residual is used (up to the set evaluation speedup level). CPU only.";
+	commands[CMD_EVALSPEEDUPTOL].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>tolerance</i>";
+
 	commands.insert(CMD_SETODE, CommandSpecifier(CMD_SETODE), "setode");
 	commands[CMD_SETODE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setode</b> <i>equation evaluation</i>";
 	commands[CMD_SETODE].descr = "[tc0,0.5,0.5,1/tc]Set differential equation to solve in both micromagnetic and atomistic meshes, and method used to solve it (same method is applied to micromagnetic and atomistic meshes).";
@@ -639,7 +657,7 @@ Simulation::Simulation(
 
 	commands.insert(CMD_SAVEDATAFILE, CommandSpecifier(CMD_SAVEDATAFILE), "savedatafile");
 	commands[CMD_SAVEDATAFILE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>savedatafile</b> <i>(directory/)filename</i>";
-	commands[CMD_SAVEDATAFILE].descr = "[tc0,0.5,0.5,1/tc]Change output data file (and working directory if specified).";
+	commands[CMD_SAVEDATAFILE].descr = "[tc0,0.5,0.5,1/tc]Change output data file (and working directory if specified). Data is saved as tab-separated text (.txt termination by default), or as binary columns with full precision if the file termination is .bdat.";
 	commands[CMD_SAVEDATAFILE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>filename</i>";
 
 	commands.insert(CMD_SAVECOMMENT, CommandSpecifier(CMD_SAVECOMMENT), "savecomment");
@@ -1008,6 +1026,11 @@ Simulation::Simulation(
 	commands[CMD_SSOLVERCONFIG].descr = "[tc0,0.5,0.5,1/tc]Set spin-transport solver convergence error and iterations for timeout (if given, else use default).";
 	commands[CMD_SSOLVERCONFIG].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>s_convergence_error s_iters_timeout</i>";
 	
+	commands.insert(CMD_TSOLVERMETHOD, CommandSpecifier(CMD_TSOLVERMETHOD), "tsolvermethod");
+	commands[CMD_TSOLVERMETHOD].usage = "[tc0,0.5,0,1/tc]USAGE : <b>tsolvermethod</b> <i>method</i>";
+	commands[CMD_TSOLVERMETHOD].descr = "[tc0,0.5,0.5,1/tc]Set Poisson solver method used for V (electrical potential) in the charge and spin-transport solvers: sor (default), mgv (geometric multigrid, V-cycles) or mgw (geometric multigrid, W-cycles). With multigrid each solver iteration is one cycle, so the convergence error and iterations timeout set with tsolverconfig apply to cycles. The S equation is always solved using SOR. CPU solver only. Without parameters show the method together with iterations to convergence and wall time (ms) for the last V solve.";
+	commands[CMD_TSOLVERMETHOD].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>method iters_to_conv solve_time_ms</i>";
+
 	commands.insert(CMD_SETSORDAMPING, CommandSpecifier(CMD_SETSORDAMPING), "setsordamping");
 	commands[CMD_SETSORDAMPING].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setsordamping</b> <i>damping_v damping_s</i>";
 	commands[CMD_SETSORDAMPING].limits = { { DBL2(MINSORDAMPING), DBL2(MAXSORDAMPING) } };
@@ -1061,6 +1084,12 @@ Simulation::Simulation(
 	commands[CMD_SETHEATDT].unit = "s";
 	commands[CMD_SETHEATDT].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value</i> - heat equation time step.";
 
+	commands.insert(CMD_HEATSOLVER, CommandSpecifier(CMD_HEATSOLVER), "heatsolver");
+	commands[CMD_HEATSOLVER].usage = "[tc0,0.5,0,1/tc]USAGE : <b>heatsolver</b> <i>method (convergence_error iters_timeout)</i>";
+	commands[CMD_HEATSOLVER].limits = { { Any(), Any() }, { double(0.0), Any() }, { int(1), Any() } };
+	commands[CMD_HEATSOLVER].descr = "[tc0,0.5,0.5,1/tc]Set heat equation solver method: ftcs (default, explicit - heat equation time step cannot exceed the magnetization equation time step), cn (Crank-Nicolson, implicit) or be (backward Euler, implicit). With implicit methods the heat equation time step set with setheatdt can be much larger than the magnetization equation time step: the heat equation is advanced once the magnetization equation has covered it. Each implicit time step is iterated until the normalized maximum temperature change is below <i>convergence_error</i> (default 1e-7), or <i>iters_timeout</i> iterations reached (default 100). CPU solver only. Without parameters show the method, convergence settings and iterations taken in the last implicit time step.";
+	commands[CMD_HEATSOLVER].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>method convergence_error iters_timeout iters_to_conv</i>";
+
 	commands.insert(CMD_AMBIENTTEMPERATURE, CommandSpecifier(CMD_AMBIENTTEMPERATURE), "ambient");
 	commands[CMD_AMBIENTTEMPERATURE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ambient</b> <i>(meshname) ambient_temperature</i>";
 	commands[CMD_AMBIENTTEMPERATURE].limits = { { Any(), Any() }, { double(0.0), double(MAX_TEMPERATURE) } };
@@ -1306,6 +1335,12 @@ Simulation::Simulation(
 	commands[CMD_BENCHTIME].descr = "[tc0,0.5,0.5,1/tc]Show the last simulation duration time in ms, between start and stop; used for performance becnhmarking.";
 	commands[CMD_BENCHTIME].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value</i>";
 
+	commands.insert(CMD_PROFILE, CommandSpecifier(CMD_PROFILE), "profile");
+	commands[CMD_PROFILE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>profile</b> <i>(status)</i>";
+	commands[CMD_PROFILE].limits = { { int(0), int(1) } };
+	commands[CMD_PROFILE].descr = "[tc0,0.5,0.5,1/tc]Enable (status 1, also resets timers) or disable (status 0) the simulation profiler, which accumulates wall time spent in simulation stages (iteration, module field updates, ODE evaluation, moving mesh, mesh transfers, saving data) and in each module type. Without parameters show the profiler report. For CUDA computations only the iteration time is meaningful. Times can also be saved using the prof_ output data.";
+	commands[CMD_PROFILE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>iteration, modules, ODE, transport, heat, mesh transfer, save data</i> - total times in seconds.";
+
 	commands.insert(CMD_MATERIALSDATABASE, CommandSpecifier(CMD_MATERIALSDATABASE), "materialsdatabase");
 	commands[CMD_MATERIALSDATABASE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>materialsdatabase</b> <i>(mdbname)</i>";
 	commands[CMD_MATERIALSDATABASE].descr = "[tc0,0.5,0.5,1/tc]Switch materials database in use. This setting is not saved by savesim, so using loadsim doesn't affect this setting; default mdb set on program start.";
@@ -1402,6 +1437,12 @@ Simulation::Simulation(
 	commands[CMD_SAVEOVF2].descr = "[tc0,0.5,0.5,1/tc]Save an OOMMF-style OVF 2.0 file containing data from the given mesh (focused mesh if not specified), depending on currently displayed quantites, or the named quantity if given (see output of display command for possible quantities). You can specify the data type as data_type = bin4 (single precision 4 bytes per float), data_type = bin8 (double precision 8 bytes per float), or data_type = text. By default bin8 is used.";
 	commands[CMD_SAVEOVF2].limits = { { Any(), Any() }, { Any(), Any() }, { Any(), Any() }, { Any(), Any() } };
 
+	commands.insert(CMD_OVF2ASYNC, CommandSpecifier(CMD_OVF2ASYNC), "ovf2async");
+	commands[CMD_OVF2ASYNC].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ovf2async</b> <i>status</i>";
+	commands[CMD_OVF2ASYNC].limits = { { int(0), int(1) } };
+	commands[CMD_OVF2ASYNC].descr = "[tc0,0.5,0.5,1/tc]Set asynchronous writing of OVF 2.0 files (status = 1, default), or disable it (status = 0). When enabled, commands saving OVF 2.0 files return as soon as the data has been copied out, and the file is written on a background thread. Files are written in the order saved, and loading an OVF 2.0 file waits for any pending write to it; if reading saved files from outside Boris during a simulation disable this.";
+	commands[CMD_OVF2ASYNC].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>status</i>";
+
 	commands.insert(CMD_LOADOVF2DISP, CommandSpecifier(CMD_LOADOVF2DISP), "loadovf2disp");
 	commands[CMD_LOADOVF2DISP].usage = "[tc0,0.5,0,1/tc]USAGE : <b>loadovf2disp</b> <i>(meshname) (directory/)filename</i>";
 	commands[CMD_LOADOVF2DISP].descr = "[tc0,0.5,0.5,1/tc]Load an OOMMF-style OVF 2.0 file containing mechanical displacement data, into the given mesh (which must be ferromagnetic and have the melastic module enabled; focused mesh if not specified), mapping the data to the current mesh dimensions. From the mechanical displacement the strain tensor is calculated.";
@@ -1454,6 +1495,17 @@ Simulation::Simulation(
 	commands[CMD_THREADS].limits = { { int(0), Any(omp_get_num_procs()) } };
 	commands[CMD_THREADS].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>num_threads</i>";
 
+	commands.insert(CMD_KERNELCACHE, CommandSpecifier(CMD_KERNELCACHE), "kernelcache");
+	commands[CMD_KERNELCACHE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>kernelcache</b> <i>maxsize_MB (directory)</i>";
+	commands[CMD_KERNELCACHE].descr = "[tc0,0.5,0.5,1/tc]Set maximum size in MB for the on-disk demag kernel cache (0 disables it), and optionally the cache directory. Kernels calculated for a given geometry are saved and re-loaded next time the same geometry is used; oldest kernels are removed when the maximum size is exceeded.";
+	commands[CMD_KERNELCACHE].limits = { { int(0), Any() }, { Any(), Any() } };
+	commands[CMD_KERNELCACHE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>maxsize_MB, directory</i>";
+
+	commands.insert(CMD_FFTWPLANNER, CommandSpecifier(CMD_FFTWPLANNER), "fftwplanner");
+	commands[CMD_FFTWPLANNER].usage = "[tc0,0.5,0,1/tc]USAGE : <b>fftwplanner</b> <i>rigor</i>";
+	commands[CMD_FFTWPLANNER].descr = "[tc0,0.5,0.5,1/tc]Set FFTW planner rigor used when making fft plans for convolution and kernel calculations: estimate, measure, patient (default) or exhaustive. Higher rigor can give faster ffts but planning takes longer; planning results are kept between program runs (FFTW wisdom) so are only computed once for each shape.";
+	commands[CMD_FFTWPLANNER].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>rigor</i>";
+
 	commands.insert(CMD_SERVERPORT, CommandSpecifier(CMD_SERVERPORT), "serverport");
 	commands[CMD_SERVERPORT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>serverport</b> <i>port</i>";
 	commands[CMD_SERVERPORT].descr = "[tc0,0.5,0.5,1/tc]Set script server port.";
@@ -1694,6 +1746,12 @@ Simulation::Simulation(
 	commands[CMD_DP_GET].limits = { { int(0), int(MAX_ARRAYS - 1) },{ int(0), Any() } };
 	commands[CMD_DP_GET].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>value</i>";
 
+	commands.insert(CMD_DP_GETARRAY, CommandSpecifier(CMD_DP_GETARRAY), "dp_getarray");
+	commands[CMD_DP_GETARRAY].usage = "[tc0,0.5,0,1/tc]USAGE : <b>dp_getarray</b> <i>dp_arr</i>";
+	commands[CMD_DP_GETARRAY].descr = "[tc0,0.5,0.5,1/tc]Return all values in dp_arr to a script client. Clients using the framed protocol (NetSocks.py) receive the values as a raw typed buffer, returned as a numpy array.";
+	commands[CMD_DP_GETARRAY].limits = { { int(0), int(MAX_ARRAYS - 1) } };
+	commands[CMD_DP_GETARRAY].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>values</i>";
+
 	commands.insert(CMD_DP_SET, CommandSpecifier(CMD_DP_SET), "dp_set");
 	commands[CMD_DP_SET].usage = "[tc0,0.5,0,1/tc]USAGE : <b>dp_set</b> <i>dp_arr index value</i>";
 	commands[CMD_DP_SET].descr = "[tc0,0.5,0.5,1/tc]Set value in dp_arr at given index - the index must be within the dp_arr size.";
@@ -1702,7 +1760,7 @@ Simulation::Simulation(
 	commands.insert(CMD_DP_LOAD, CommandSpecifier(CMD_DP_LOAD), "dp_load");
 	commands[CMD_DP_LOAD].usage = "[tc0,0.5,0,1/tc]USAGE : <b>dp_load</b> <i>(directory/)filename file_indexes... dp_indexes...</i>";
 	commands[CMD_DP_LOAD].limits = { { Any(), Any() },  { int(0), int(MAX_ARRAYS - 1) } };
-	commands[CMD_DP_LOAD].descr = "[tc0,0.5,0.5,1/tc]Load data columns from filename into dp arrays. file_indexes are the column indexes in filename (.txt termination by default), dp_indexes are used for the dp arrays; count from 0. If directory not specified, the default one is used.";
+	commands[CMD_DP_LOAD].descr = "[tc0,0.5,0.5,1/tc]Load data columns from filename into dp arrays. file_indexes are the column indexes in filename (.txt termination by default, also .bdat binary data files), dp_indexes are used for the dp arrays; count from 0. If directory not specified, the default one is used.";
 
 	commands.insert(CMD_DP_SAVE, CommandSpecifier(CMD_DP_SAVE), "dp_save");
 	commands[CMD_DP_SAVE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>dp_save</b> <i>(directory/)filename dp_indexes...</i>";
@@ -2120,6 +2178,14 @@ Simulation::Simulation(
 	dataDescriptor.push_back("ts_err", DatumSpecifier("Transport Solver Error : ", 1), DATA_TRANSPORT_CONVERROR);
 	dataDescriptor.push_back("TMR", DatumSpecifier("TMR : ", 1, "Ohm", false, false), DATA_TMR);
 	dataDescriptor.push_back("commbuf", DatumSpecifier("Command Buffer : ", 1), DATA_COMMBUFFER);
+	dataDescriptor.push_back("diskbuf", DatumSpecifier("Disk buffer stalls, time : ", 2), DATA_DISKBUFFER);
+	dataDescriptor.push_back("prof_iter", DatumSpecifier("Profiler iteration time : ", 1, "s"), DATA_PROFILE_ITERATION);
+	dataDescriptor.push_back("prof_modules", DatumSpecifier("Profiler modules time : ", 1, "s"), DATA_PROFILE_MODULES);
+	dataDescriptor.push_back("prof_ode", DatumSpecifier("Profiler ODE time : ", 1, "s"), DATA_PROFILE_ODE);
+	dataDescriptor.push_back("prof_transport", DatumSpecifier("Profiler transport time : ", 1, "s"), DATA_PROFILE_TRANSPORT);
+	dataDescriptor.push_back("prof_heat", DatumSpecifier("Profiler heat time : ", 1, "s"), DATA_PROFILE_HEAT);
+	dataDescriptor.push_back("prof_transfer", DatumSpecifier("Profiler mesh transfer time : ", 1, "s"), DATA_PROFILE_MESHTRANSFER);
+	dataDescriptor.push_back("prof_save", DatumSpecifier("Profiler save data time : ", 1, "s"), DATA_PROFILE_SAVEDATA);
 
 	//---------------------------------------------------------------- MESHES
 
@@ -2202,17 +2268,19 @@ Simulation::Simulation(
 	odeEvalHandles.push_back("RKF56", EVAL_RKF56);
 	odeEvalHandles.push_back("RKCK45", EVAL_RKCK45);
 	odeEvalHandles.push_back("RKDP54", EVAL_RKDP54);
+	odeEvalHandles.push_back("LSRK45", EVAL_LSRK45);
 	odeEvalHandles.push_back("SDesc", EVAL_SD);
+	odeEvalHandles.push_back("LBFGS", EVAL_LBFGS);
 
 	//Allowed evaluation methods for given ODE
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLG);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_SD), ODE_LLGSTATIC);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_SD), ODE_LLGSTATICSA);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLGSTT);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLB);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLBSTT);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLGSA);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54), ODE_LLBSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45), ODE_LLG);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45, EVAL_SD, EVAL_LBFGS), ODE_LLGSTATIC);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45, EVAL_SD, EVAL_LBFGS), ODE_LLGSTATICSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45), ODE_LLGSTT);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45), ODE_LLB);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45), ODE_LLBSTT);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45), ODE_LLGSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF45, EVAL_RKF56, EVAL_RKCK45, EVAL_RKDP54, EVAL_LSRK45), ODE_LLBSA);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4), ODE_SLLG);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4), ODE_SLLGSTT);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4), ODE_SLLB);
@@ -2319,10 +2387,16 @@ Simulation::Simulation(
 	errorlog_fileName = GetUserDocumentsPath() + boris_data_directory + "errorlog.txt";
 	//set startup options file with path
 	startup_options_file = GetUserDocumentsPath() + boris_data_directory + "startup.txt";
+	//default demag kernel cache directory (cache disabled by default, but startup options can change this)
+	DemagKernelCache::directory() = GetUserDocumentsPath() + boris_data_directory + "KernelCache/";
 
 	//Load options for startup first
 	Load_Startup_Flags();
 
+	//FFTW wisdom from previous runs, so fft plans for already seen shapes are not re-computed
+	fftw_wisdom_file = GetUserDocumentsPath() + boris_data_directory + "fftw_wisdom.txt";
+	FFTWPlanner::ImportWisdom(fftw_wisdom_file);
+
 	//---------------------------------------------------------------- SERVER START
 
 	server_port = server_port_;
@@ -2357,9 +2431,8 @@ Simulation::Simulation(
 	//Update display - do not animate starting view
 	UpdateScreen_AutoSet_Sudden();
 
-	//make sure the disk buffer has the correct size
-	if (savedata_diskbuffer.size() != savedata_diskbuffer_size) savedata_diskbuffer.resize(savedata_diskbuffer_size);
-	savedata_diskbuffer_position = 0;
+	//disk buffer rows are written on the disk buffer writer thread
+	savedata_diskbuffer.set_writer([&](std::vector<std::string>& rows) { int rows_count = rows.size(); SaveData_DiskBufferFlush(&rows, &rows_count); });
 
 	//---------------------------------------------------------------- EMBEDDED PYTHON SCRIPT
 
@@ -2403,5 +2476,11 @@ Simulation::~Simulation()
 
 	Stop_All_Threads();
 
+	//finish writing any data handed over to the disk buffer writer thread while Simulation is still intact
+	savedata_diskbuffer.stop_writer();
+
+	//keep FFTW wisdom accumulated during this run for next time
+	FFTWPlanner::ExportWisdom(fftw_wisdom_file);
+
 	BD.DisplayConsoleMessage("All threads stopped. Clean-up...");
 }
@@ -56,6 +56,9 @@
 #include "SimSchedule.h"
 #include "DataProcessing.h"
 #include "MaterialsDataBase.h"
+#include "DemagKernelCache.h"
+#include "FFTWPlanner.h"
+#include "Profiler.h"
 
 #include "Mesh.h"
 #include "Atom_Mesh.h"
@@ -162,6 +165,9 @@ private:
 	//save/load startup flags in this file (e.g. log_errors, start_check_updates, start_scriptserver)
 	std::string startup_options_file;
 
+	//FFTW wisdom imported from this file on startup, and exported to it on exit
+	std::string fftw_wisdom_file;
+
 	//value set by version update checker :
 	//-1: attempting to connect
 	//0: connection failure
@@ -283,9 +289,8 @@ private:
 
 	//output buffered data saving to disk
 	int savedata_diskbuffer_size = DISKBUFFERLINES;
-	//savedata_diskbuffer_position maximum value is savedata_diskbuffer_size, and indicates the next position to write data to buffer; when maximum reached then flush buffer
-	int savedata_diskbuffer_position = 0;
-	std::vector<std::string> savedata_diskbuffer;
+	//rows are added by SaveData; when savedata_diskbuffer_size rows are accumulated they are written to disk on a separate thread, so the simulation only waits for disk access if the previous rows are still being written
+	DoubleBufferWriter<std::string> savedata_diskbuffer;
 
 	//data to display in data box
 	vector_lut<DatumConfig> dataBoxList;
@@ -739,6 +744,10 @@ private:
 	
 	void Print_DisplayRenderSettings(void);
 
+	//---------------------------------------------------- PROFILER
+
+	void Print_Profile(void);
+
 	//---------------------------------------------------- MAKE INTERACTIVE OBJECT : Auxiliary method
 
 	//Generate a formatted std::string depending on the interactive object identifier
@@ -790,6 +799,10 @@ private:
 	//this is GetDataValue but with std::string conversion
 	std::string GetDataValueString(DatumConfig dConfig, bool ignore_unit = false);
 
+	//values of saveDataList entries (as GetDataValue) for entries which can be computed using fused reductions (CPU only) : one sweep per VEC for all such entries.
+	//Entries not computed are left as null.
+	std::vector<Any> GetSaveDataValues_Fused(void);
+
 	//make a new entry in saveDataList
 	void NewSaveDataEntry(DATA_ dataId, std::string meshName = "", Rect dataRect = Rect());
 	void EditSaveDataEntry(int index, DATA_ dataId, std::string meshName = "", Rect dataRect = Rect());
@@ -807,6 +820,14 @@ private:
 	void SaveData(void);
 	//This method does the actual writing to disk : can be launched asynchronously from SaveData method
 	void SaveData_DiskBufferFlush(std::vector<std::string>* pdiskbuffer, int* diskbuffer_position);
+	//as above for binary data files (BINARYDATAFILE_TERMINATION) : called from SaveData_DiskBufferFlush
+	void SaveData_DiskBufferFlush_Binary(std::vector<std::string>* pdiskbuffer, int* diskbuffer_position);
+
+	//date and mesh settings written at the start of data files
+	std::string GetSaveDataFileInfo(void);
+
+	//label for saveDataList entry as used in data file headers
+	std::string GetSaveDataLabel(int idx, bool with_unit = true);
 
 #if GRAPHICS == 1
 
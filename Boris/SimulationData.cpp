@@ -579,6 +579,56 @@ Any Simulation::GetDataValue(DatumConfig dConfig)
 		return Any(command_buffer.size());
 	}
 	break;
+
+	case DATA_DISKBUFFER:
+	{
+		//number of times the simulation had to wait for disk writes to finish (disk buffer filled up before the previous one was written), and total time spent waiting (s)
+		return Any(DBL2(savedata_diskbuffer.get_stalls(), savedata_diskbuffer.get_stall_time()));
+	}
+	break;
+
+	case DATA_PROFILE_ITERATION:
+	{
+		//profiler times (s) accumulated since the profiler was enabled
+		return Any(profiler.get_stage_time(PROFILE_ITERATION));
+	}
+	break;
+
+	case DATA_PROFILE_MODULES:
+	{
+		return Any(profiler.get_stage_time(PROFILE_MODULES));
+	}
+	break;
+
+	case DATA_PROFILE_ODE:
+	{
+		return Any(profiler.get_stage_time(PROFILE_ODE));
+	}
+	break;
+
+	case DATA_PROFILE_TRANSPORT:
+	{
+		return Any(profiler.get_modules_time({ MOD_TRANSPORT, MOD_TMR, MODS_STRANSPORT }));
+	}
+	break;
+
+	case DATA_PROFILE_HEAT:
+	{
+		return Any(profiler.get_modules_time({ MOD_HEAT, MODS_SHEAT }));
+	}
+	break;
+
+	case DATA_PROFILE_MESHTRANSFER:
+	{
+		return Any(profiler.get_stage_time(PROFILE_MESHTRANSFER));
+	}
+	break;
+
+	case DATA_PROFILE_SAVEDATA:
+	{
+		return Any(profiler.get_stage_time(PROFILE_SAVEDATA));
+	}
+	break;
 	}
 
 	return Any(0);
@@ -592,6 +642,107 @@ std::string Simulation::GetDataValueString(DatumConfig dConfig, bool ignore_unit
 	return GetDataValue(dConfig).convert_to_string(unit);
 }
 
+std::vector<Any> Simulation::GetSaveDataValues_Fused(void)
+{
+	std::vector<Any> values(saveDataList.size());
+
+	//with CUDA enabled reductions are done on the GPU for each entry
+	if (cudaEnabled) return values;
+
+	//reduction plans for each VEC used by saveDataList entries
+	std::map<const VEC_VC<DBL3>*, VEC_VC_MultiReduction<DBL3>> plans_DBL3;
+	std::map<const VEC_VC<double>*, VEC_VC_MultiReduction<double>> plans_double;
+
+	//for each saveDataList entry : VEC and entry index in its plan (nullptr if not fused)
+	std::vector<std::pair<const VEC_VC<DBL3>*, int>> entries_DBL3(saveDataList.size(), std::pair<const VEC_VC<DBL3>*, int>(nullptr, 0));
+	std::vector<std::pair<const VEC_VC<double>*, int>> entries_double(saveDataList.size(), std::pair<const VEC_VC<double>*, int>(nullptr, 0));
+
+	//empty VECs are left to GetDataValue, which returns the appropriate default values
+	auto add_DBL3 = [&](int idx, const VEC_VC<DBL3>& vec, MULTIREDUCTION_ type) -> void {
+
+		if (!vec.linear_size()) return;
+
+		VEC_VC_MultiReduction<DBL3>& plan = plans_DBL3[&vec];
+		entries_DBL3[idx] = std::pair<const VEC_VC<DBL3>*, int>(&vec, (type == MULTIREDUCTION_AVERAGE ? plan.add_average(saveDataList[idx].rectangle) : plan.add_minmax(type, saveDataList[idx].rectangle)));
+	};
+
+	auto add_double = [&](int idx, const VEC_VC<double>& vec) -> void {
+
+		if (!vec.linear_size()) return;
+
+		entries_double[idx] = std::pair<const VEC_VC<double>*, int>(&vec, plans_double[&vec].add_average(saveDataList[idx].rectangle));
+	};
+
+	//1. compile plans : only quantities held in VECs of (micromagnetic) meshes, same as the corresponding GetDataValue entries
+	for (int idx = 0; idx < saveDataList.size(); idx++) {
+
+		DatumConfig& dConfig = saveDataList[idx];
+
+		if (!SMesh.contains(dConfig.meshName) || SMesh[dConfig.meshName]->is_atomistic()) continue;
+
+		Mesh* pMesh = dynamic_cast<Mesh*>(SMesh[dConfig.meshName]);
+
+		switch (dConfig.datumId) {
+
+		case DATA_AVM: add_DBL3(idx, pMesh->M, MULTIREDUCTION_AVERAGE); break;
+		case DATA_AVM2: add_DBL3(idx, pMesh->M2, MULTIREDUCTION_AVERAGE); break;
+		case DATA_M_MINMAX: add_DBL3(idx, pMesh->M, MULTIREDUCTION_MINMAX); break;
+		case DATA_MX_MINMAX: add_DBL3(idx, pMesh->M, MULTIREDUCTION_MINMAX_X); break;
+		case DATA_MY_MINMAX: add_DBL3(idx, pMesh->M, MULTIREDUCTION_MINMAX_Y); break;
+		case DATA_MZ_MINMAX: add_DBL3(idx, pMesh->M, MULTIREDUCTION_MINMAX_Z); break;
+		case DATA_S: add_DBL3(idx, pMesh->S, MULTIREDUCTION_AVERAGE); break;
+		case DATA_AVU: add_DBL3(idx, pMesh->u_disp, MULTIREDUCTION_AVERAGE); break;
+		case DATA_AVSTRAINDIAG: add_DBL3(idx, pMesh->strain_diag, MULTIREDUCTION_AVERAGE); break;
+		case DATA_AVSTRAINODIAG: add_DBL3(idx, pMesh->strain_odiag, MULTIREDUCTION_AVERAGE); break;
+		case DATA_V: add_double(idx, pMesh->V); break;
+		case DATA_ELC: add_double(idx, pMesh->elC); break;
+		case DATA_TEMP: add_double(idx, pMesh->Temp); break;
+		case DATA_TEMP_L: add_double(idx, pMesh->Temp_l); break;
+		default: break;
+		}
+	}
+
+	//2. one sweep for each VEC : if a reduction cannot be done (out of memory) its entries are left to GetDataValue
+	for (auto plan = plans_DBL3.begin(); plan != plans_DBL3.end(); plan++) {
+
+		if (!plan->second.reduce(*plan->first)) for (int idx = 0; idx < saveDataList.size(); idx++) if (entries_DBL3[idx].first == plan->first) entries_DBL3[idx].first = nullptr;
+	}
+
+	for (auto plan = plans_double.begin(); plan != plans_double.end(); plan++) {
+
+		if (!plan->second.reduce(*plan->first)) for (int idx = 0; idx < saveDataList.size(); idx++) if (entries_double[idx].first == plan->first) entries_double[idx].first = nullptr;
+	}
+
+	//3. values, same types as returned by GetDataValue
+	for (int idx = 0; idx < saveDataList.size(); idx++) {
+
+		if (entries_DBL3[idx].first) {
+
+			VEC_VC_MultiReduction<DBL3>& plan = plans_DBL3[entries_DBL3[idx].first];
+
+			switch (saveDataList[idx].datumId) {
+
+			case DATA_M_MINMAX:
+			case DATA_MX_MINMAX:
+			case DATA_MY_MINMAX:
+			case DATA_MZ_MINMAX:
+				values[idx] = Any(plan.minmax(entries_DBL3[idx].second));
+				break;
+
+			default:
+				values[idx] = Any(plan.average(entries_DBL3[idx].second));
+				break;
+			}
+		}
+		else if (entries_double[idx].first) {
+
+			values[idx] = Any(plans_double[entries_double[idx].first].average(entries_double[idx].second));
+		}
+	}
+
+	return values;
+}
+
 void Simulation::NewSaveDataEntry(DATA_ dataId, std::string meshName, Rect dataRect) 
 {
 	//if not meshless, make sure meshName is valid
@@ -656,30 +807,49 @@ void Simulation::DeleteSaveDataEntries(std::string meshName)
 
 void Simulation::SaveData(void)
 {
+	ProfileScope profile_savedata(PROFILE_SAVEDATA);
+
 	last_time_save = SMesh.GetStageTime();
 
-	//First build text to write to data file as a single row
+	//First build text to write to data file as a single row (raw values for binary data files)
 	std::string row_text;
 
-	//save actual values as configured in saveDataList
-	for (int idx = 0; idx < saveDataList.size(); idx++) {
+	//values which can be obtained from fused reductions (single sweep per VEC), null for other entries
+	std::vector<Any> fused_values = GetSaveDataValues_Fused();
+
+	if (GetFileTermination(savedataFile) == BINARYDATAFILE_TERMINATION) {
 
-		std::string value_string = GetDataValueString(saveDataList[idx], true);
-		replaceall(value_string, ", ", "\t");
+		//binary data file : row is stored as raw values, components for each entry as given in dataDescriptor (missing components are zero)
+		std::vector<double> row_values;
 
-		row_text += value_string;
-		if (idx != saveDataList.size() - 1) row_text += "\t";
+		for (int idx = 0; idx < saveDataList.size(); idx++) {
+
+			int start = row_values.size();
+
+			if (fused_values[idx].IsNull()) GetDataValue(saveDataList[idx]).convert_to_doubles(row_values);
+			else fused_values[idx].convert_to_doubles(row_values);
+
+			row_values.resize(start + dataDescriptor(saveDataList[idx].datumId).components, 0.0);
+		}
+
+		row_text.assign(reinterpret_cast<const char*>(row_values.data()), row_values.size() * sizeof(double));
 	}
+	else {
+
+		//save actual values as configured in saveDataList
+		for (int idx = 0; idx < saveDataList.size(); idx++) {
 
-	while (is_thread_running(THREAD_DISKACCESS)) {}
-	//at this point diskacess thread is guaranteed to not be accessing the diskbuffer - more efficient this way than using a mutex
-	if (savedata_diskbuffer_position < savedata_diskbuffer_size) savedata_diskbuffer[savedata_diskbuffer_position++] = row_text;
-	if (savedata_diskbuffer_position == savedata_diskbuffer_size) {
+			std::string value_string = (fused_values[idx].IsNull() ? GetDataValueString(saveDataList[idx], true) : fused_values[idx].convert_to_string());
+			replaceall(value_string, ", ", "\t");
 
-		//flush regular buffer asynchronously
-		while (single_call_launch<std::vector<std::string>*, int*>(&Simulation::SaveData_DiskBufferFlush, &savedata_diskbuffer, &savedata_diskbuffer_position, THREAD_DISKACCESS) != THREAD_DISKACCESS);
+			row_text += value_string;
+			if (idx != saveDataList.size() - 1) row_text += "\t";
+		}
 	}
 
+	//when full the buffer is written to disk asynchronously
+	savedata_diskbuffer.push(row_text, savedata_diskbuffer_size);
+
 	//Image saving:
 	if (saveImageFlag) {
 
@@ -702,79 +872,156 @@ void Simulation::SaveData_DiskBufferFlush(std::vector<std::string>* pdiskbuffer,
 		//we need a file name to save to
 		if (savedataFile.size()) {
 
-			std::ofstream bdout;
-
-			//append to file or make a new one ?
-			if (appendToDataFile) bdout.open((directory + savedataFile).c_str(), std::ios::out | std::ios::app);
+			if (GetFileTermination(savedataFile) == BINARYDATAFILE_TERMINATION) SaveData_DiskBufferFlush_Binary(pdiskbuffer, pdiskbuffer_position);
 			else {
 
-				//Create new file
-				bdout.open((directory + savedataFile).c_str(), std::ios::out);
-				appendToDataFile = true;
-
-				//Append header
-				time_t rawtime;
-				time(&rawtime);
-				bdout << std::string(ctime(&rawtime)) << std::endl;
+				std::ofstream bdout;
 
-				//List meshes
-				for (int idx = 0; idx < SMesh.size(); idx++) {
+				//append to file or make a new one ?
+				if (appendToDataFile) bdout.open((directory + savedataFile).c_str(), std::ios::out | std::ios::app);
+				else {
 
-					bdout << "<" + SMesh.key_from_meshIdx(idx) + "> : ";
-					bdout << "Rectangle : " << ToString(SMesh[idx]->GetMeshRect(), "m") << ". ";
-					bdout << "Cells : " << ToString(SMesh[idx]->GetMeshSize()) << ". ";
-					bdout << "Cellsize : " << ToString(SMesh[idx]->GetMeshCellsize(), "m");
-					bdout << std::endl;
-				}
+					//Create new file
+					bdout.open((directory + savedataFile).c_str(), std::ios::out);
+					appendToDataFile = true;
 
-				//Supermesh settings
-				bdout << "<" + SMesh.superMeshHandle + "> : ";
-				bdout << "Rectangle : " << ToString(SMesh.GetFMSMeshRect(), "m") << ". ";
-				bdout << "Cells : " << ToString(SMesh.GetFMSMeshsize()) << ". ";
-				bdout << "Cellsize : " << ToString(SMesh.GetFMSMeshCellsize(), "m");
-				bdout << std::endl;
+					//Append header
+					bdout << GetSaveDataFileInfo();
 
-				//List saved data labels and units
-				bdout << "\nSaved data (dataname (unit) <meshname> (cells_rectangle)) : \n\n";
+					//List saved data labels and units
+					bdout << "\nSaved data (dataname (unit) <meshname> (cells_rectangle)) : \n\n";
 
-				for (int idx = 0; idx < saveDataList.size(); idx++) {
+					for (int idx = 0; idx < saveDataList.size(); idx++) {
 
-					//data name
-					bdout << dataDescriptor.get_key_from_ID(saveDataList[idx].datumId);
+						bdout << GetSaveDataLabel(idx);
 
-					//unit?
-					if (dataDescriptor(saveDataList[idx].datumId).unit.length())
-						bdout << " (" << dataDescriptor(saveDataList[idx].datumId).unit << ")";
+						for (int tabs = 0; tabs < dataDescriptor(saveDataList[idx].datumId).components; tabs++)
+							bdout << '\t';
+					}
 
-					//mesh?
-					if (!dataDescriptor(saveDataList[idx].datumId).meshless)
-						bdout << " <" << saveDataList[idx].meshName << ">";
+					bdout << std::endl << std::endl;
+				}
 
-					//box?
-					if (!dataDescriptor(saveDataList[idx].datumId).boxless)
-						bdout << " (" << ToString(saveDataList[idx].rectangle, "m") << ")";
+				//write buffer entries
+				for (int idx = 0; idx < *pdiskbuffer_position; idx++) {
 
-					for (int tabs = 0; tabs < dataDescriptor(saveDataList[idx].datumId).components; tabs++)
-						bdout << '\t';
+					bdout << (*pdiskbuffer)[idx] << std::endl;
 				}
 
-				bdout << std::endl << std::endl;
+				bdout.close();
 			}
 
-			//write buffer entries
-			for (int idx = 0; idx < *pdiskbuffer_position; idx++) {
+			//buffer flushed now
+			*pdiskbuffer_position = 0;
+		}
+	}
+
+	diskMutex.unlock();
+}
+
+//binary data file version of SaveData_DiskBufferFlush : buffer entries are rows of raw values, written as chunks of rows with the same number of columns
+void Simulation::SaveData_DiskBufferFlush_Binary(std::vector<std::string>* pdiskbuffer, int* pdiskbuffer_position)
+{
+	std::ofstream bdout;
+
+	//append to file or make a new one ?
+	if (appendToDataFile) bdout.open((directory + savedataFile).c_str(), std::ios::out | std::ios::app | std::ios::binary);
+	else {
+
+		//Create new file
+		bdout.open((directory + savedataFile).c_str(), std::ios::out | std::ios::binary);
+		appendToDataFile = true;
+
+		//header : same information as for text files, with a label and unit for each column
+		std::vector<std::string> labels, units;
 
-				bdout << (*pdiskbuffer)[idx] << std::endl;
+		for (int idx = 0; idx < saveDataList.size(); idx++) {
+
+			int components = dataDescriptor(saveDataList[idx].datumId).components;
+
+			for (int component = 0; component < components; component++) {
+
+				labels.push_back(GetSaveDataLabel(idx, false) + (components > 1 ? " " + ToString(component) : ""));
+				units.push_back(dataDescriptor(saveDataList[idx].datumId).unit);
 			}
+		}
 
-			//buffer flushed now
-			*pdiskbuffer_position = 0;
+		WriteBinaryDataFileHeader(bdout, GetSaveDataFileInfo(), labels, units);
+	}
+
+	std::vector<double> chunk_values;
 
-			bdout.close();
+	int idx = 0;
+	while (idx < *pdiskbuffer_position) {
+
+		//consecutive rows with the same size form a chunk
+		size_t row_size = (*pdiskbuffer)[idx].size();
+		int columns = row_size / sizeof(double);
+		int rows = 0;
+
+		chunk_values.clear();
+
+		for (; idx < *pdiskbuffer_position && (*pdiskbuffer)[idx].size() == row_size; idx++, rows++) {
+
+			size_t start = chunk_values.size();
+			chunk_values.resize(start + columns);
+			if (columns) memcpy(&chunk_values[start], (*pdiskbuffer)[idx].data(), columns * sizeof(double));
 		}
+
+		WriteBinaryDataFileChunk(bdout, chunk_values.data(), rows, columns);
 	}
 
-	diskMutex.unlock();
+	bdout.close();
+}
+
+//date and mesh settings written at the start of data files
+std::string Simulation::GetSaveDataFileInfo(void)
+{
+	std::stringstream ss;
+
+	time_t rawtime;
+	time(&rawtime);
+	ss << std::string(ctime(&rawtime)) << std::endl;
+
+	//List meshes
+	for (int idx = 0; idx < SMesh.size(); idx++) {
+
+		ss << "<" + SMesh.key_from_meshIdx(idx) + "> : ";
+		ss << "Rectangle : " << ToString(SMesh[idx]->GetMeshRect(), "m") << ". ";
+		ss << "Cells : " << ToString(SMesh[idx]->GetMeshSize()) << ". ";
+		ss << "Cellsize : " << ToString(SMesh[idx]->GetMeshCellsize(), "m");
+		ss << std::endl;
+	}
+
+	//Supermesh settings
+	ss << "<" + SMesh.superMeshHandle + "> : ";
+	ss << "Rectangle : " << ToString(SMesh.GetFMSMeshRect(), "m") << ". ";
+	ss << "Cells : " << ToString(SMesh.GetFMSMeshsize()) << ". ";
+	ss << "Cellsize : " << ToString(SMesh.GetFMSMeshCellsize(), "m");
+	ss << std::endl;
+
+	return ss.str();
+}
+
+//label for saveDataList entry as used in data file headers : dataname (unit) <meshname> (cells_rectangle). Unit not included if with_unit false.
+std::string Simulation::GetSaveDataLabel(int idx, bool with_unit)
+{
+	//data name
+	std::string label = dataDescriptor.get_key_from_ID(saveDataList[idx].datumId);
+
+	//unit?
+	if (with_unit && dataDescriptor(saveDataList[idx].datumId).unit.length())
+		label += " (" + dataDescriptor(saveDataList[idx].datumId).unit + ")";
+
+	//mesh?
+	if (!dataDescriptor(saveDataList[idx].datumId).meshless)
+		label += " <" + saveDataList[idx].meshName + ">";
+
+	//box?
+	if (!dataDescriptor(saveDataList[idx].datumId).boxless)
+		label += " (" + ToString(saveDataList[idx].rectangle, "m") + ")";
+
+	return label;
 }
 
 //file name can have data specifiers, e.g. %iter% means '%iter%' should be replaced by the actual value of the iter data field, etc.
@@ -12,7 +12,7 @@ SuperMesh::SuperMesh(void) :
 			VINFO(pSMod),
 			VINFO(activeMeshName), VINFO(superMeshHandle),
 			VINFO(scale_rects), VINFO(coupled_dipoles), VINFO(dwpos_component),
-			VINFO(kernel_initialize_on_gpu),
+			VINFO(kernel_initialize_on_gpu), VINFO(fused_local_fields), VINFO(demag_single_precision),
 			VINFO(computefields_if_MC), VINFO(cone_angle_minmax)
 		}, 
 		{
@@ -43,7 +43,7 @@ class SuperMesh :
 	vector_lut<Modules*>, 
 	std::string, std::string, 
 	bool, bool, int,
-	bool,
+	bool, bool, bool,
 	bool, DBL2>,
 	std::tuple<
 	//Micromagnetic Meshes
@@ -188,6 +188,12 @@ private:
 	//in CUDA mode initialize kernels on GPU. Can be set to false to initialize on CPU (slightly more accurate, but not enough to make this the default option)
 	bool kernel_initialize_on_gpu = true;
 
+	//evaluate consecutive local field modules (exchange, DMI, uniaxial anisotropy) in ferromagnetic meshes in a single sweep over the mesh, rather than one sweep per module (CPU only)
+	bool fused_local_fields = false;
+
+	//use mixed precision convolution (single precision ffts and kernels) for demag and dipole-dipole in single meshes and supermesh demag (CPU only, not for multilayered convolution)
+	bool demag_single_precision = false;
+
 	//-----Mesh data settings
 
 	//select which component to use when fitting to obtain domain wall width and position for dwpos_x, dwpos_y, dwpos_z parameters
@@ -353,6 +359,10 @@ public:
 	//check evaluation speedup settings in ode solver
 	int GetEvaluationSpeedup(void);
 
+	//set extrapolation residual tolerance for evaluation speedup in ode solver (0 to disable error control)
+	void SetEvaluationSpeedupTolerance(double tolerance);
+	double GetEvaluationSpeedupTolerance(void);
+
 	//is the current time step fully finished? - most evaluation schemes need multiple sub-steps
 	bool CurrentTimeStepSolved(void);
 
@@ -712,6 +722,10 @@ public:
 
 	bool Get_Kernel_Initialize_on_GPU(void) { return kernel_initialize_on_gpu; }
 
+	bool Get_Fused_Local_Fields(void) { return fused_local_fields; }
+
+	bool Get_Demag_Single_Precision(void) { return demag_single_precision; }
+
 	int Get_DWPos_Component(void) { return dwpos_component; }
 
 	//get total volume energy density
@@ -757,6 +771,10 @@ public:
 
 	BError Set_Kernel_Initialize_on_GPU(bool status) { kernel_initialize_on_gpu = status; return UpdateConfiguration(UPDATECONFIG_DEMAG_CONVCHANGE); }
 
+	void Set_Fused_Local_Fields(bool status) { fused_local_fields = status; }
+
+	BError Set_Demag_Single_Precision(bool status) { demag_single_precision = status; return UpdateConfiguration(UPDATECONFIG_DEMAG_CONVCHANGE); }
+
 	void Set_DWPos_Component(int component) { dwpos_component = component; }
 
 	//----------------------------------- DISPLAY-ASSOCIATED GET/SET METHODS : SuperMeshDisplay.cpp
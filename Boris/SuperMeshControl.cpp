@@ -208,6 +208,13 @@ BError SuperMesh::SwitchCUDAState(bool cudaState, std::vector<int> devices)
 		//Monte-Carlo serial mode not possible with cuda on
 		Set_MonteCarlo_Serial(false, superMeshHandle);
 
+		//low-storage and L-BFGS evaluation methods not available with cuda on : revert to default evaluation method
+		ODE_ setODE;
+		EVAL_ evalMethod;
+		QueryODE(setODE, evalMethod);
+		if (evalMethod == EVAL_LSRK45) SetODEEval(EVAL_RKF45);
+		else if (evalMethod == EVAL_LBFGS) SetODEEval(EVAL_SD);
+
 		error = update_configuration(true, error);
 
 		if (!error) cudaEnabled = true;
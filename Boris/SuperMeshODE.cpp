@@ -26,6 +26,9 @@ BError SuperMesh::SetODE(ODE_ setOde, EVAL_ evalMethod)
 
 	if (setOde <= ODE_ERROR || evalMethod <= EVAL_ERROR) return error(BERROR_INCORRECTNAME);
 
+	//the low-storage and L-BFGS evaluation methods are only available with cuda off
+	if (cudaEnabled && (evalMethod == EVAL_LSRK45 || evalMethod == EVAL_LBFGS)) return error(BERROR_INCORRECTCONFIG);
+
 	//Changing ODE with cuda switched on is problematic. Easiest just switch cuda off, then after switch it back on.
 	bool switch_cuda_back_on = false;
 	if (cudaEnabled) {
@@ -55,6 +58,9 @@ BError SuperMesh::SetAtomisticODE(ODE_ setOde, EVAL_ evalMethod)
 
 	if (setOde <= ODE_ERROR || evalMethod <= EVAL_ERROR) return error(BERROR_INCORRECTNAME);
 
+	//the low-storage and L-BFGS evaluation methods are only available with cuda off
+	if (cudaEnabled && (evalMethod == EVAL_LSRK45 || evalMethod == EVAL_LBFGS)) return error(BERROR_INCORRECTCONFIG);
+
 	//Changing ODE with cuda switched on is problematic. Easiest just switch cuda off, then after switch it back on.
 	bool switch_cuda_back_on = false;
 	if (cudaEnabled) {
@@ -79,6 +85,9 @@ BError SuperMesh::SetODEEval(EVAL_ evalMethod)
 
 	if (evalMethod <= EVAL_ERROR) return error(BERROR_INCORRECTNAME);
 
+	//the low-storage and L-BFGS evaluation methods are only available with cuda off
+	if (cudaEnabled && (evalMethod == EVAL_LSRK45 || evalMethod == EVAL_LBFGS)) return error(BERROR_INCORRECTCONFIG);
+
 	//Changing ODE evaluation method with cuda switched on is problematic. Easiest just switch cuda off, then after switch it back on.
 	bool switch_cuda_back_on = false;
 	if (cudaEnabled) {
@@ -163,6 +172,20 @@ int SuperMesh::GetEvaluationSpeedup(void)
 	return odeSolver.GetEvaluationSpeedup();
 }
 
+//set extrapolation residual tolerance for evaluation speedup in ode solver (0 to disable error control)
+void SuperMesh::SetEvaluationSpeedupTolerance(double tolerance)
+{
+	odeSolver.SetEvaluationSpeedupTolerance(tolerance);
+
+	//saved fields need reallocating
+	UpdateConfiguration(UPDATECONFIG_DEMAG_CONVCHANGE);
+}
+
+double SuperMesh::GetEvaluationSpeedupTolerance(void)
+{
+	return odeSolver.GetEvaluationSpeedupTolerance();
+}
+
 //is the current time step fully finished? - most evaluation schemes need multiple sub-steps
 bool SuperMesh::CurrentTimeStepSolved(void)
 {
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "SuperMesh.h"
+#include "Profiler.h"
 
 //--------------------------------------------------------- SIMULATION CONTROL
 
@@ -90,7 +91,10 @@ void SuperMesh::AdvanceTime(void)
 	//In the future this will be changed to allow better performance, as it's possible in a multiscale simulation some micromagnetics meshes can be evaluated with a larger time-step compared to atomistic ones.
 
 	//moving mesh algorithm, if enabled
-	odeSolver.MovingMeshAlgorithm(this);
+	{
+		ProfileScope profile_movingmesh(PROFILE_MOVINGMESH);
+		odeSolver.MovingMeshAlgorithm(this);
+	}
 
 	do {
 
@@ -102,21 +106,30 @@ void SuperMesh::AdvanceTime(void)
 
 		total_energy_density = 0.0;
 
-		//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
-		for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+		{
+			ProfileScope profile_modules(PROFILE_MODULES);
 
-			total_energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
-		}
+			//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
+			for (int idx = 0; idx < (int)pMesh.size(); idx++) {
 
-		//update effective field for super-mesh modules
-		for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+				total_energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
+			}
+
+			//update effective field for super-mesh modules
+			for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+				ProfileScope profile_module((MOD_)pSMod.get_ID_from_index(idx));
 
-			//super-mesh modules contribute with equal weights as sum total of individual mesh energy densities -> i.e. we don't need to apply a weight here
-			total_energy_density += pSMod[idx]->UpdateField();
+				//super-mesh modules contribute with equal weights as sum total of individual mesh energy densities -> i.e. we don't need to apply a weight here
+				total_energy_density += pSMod[idx]->UpdateField();
+			}
 		}
 
 		//iterate ODE evaluation method - ODE solvers are called separately in the magnetic meshes. This is why the same evaluation method must be used in all the magnetic meshes, with the same time step.
-		odeSolver.Iterate();
+		{
+			ProfileScope profile_ode(PROFILE_ODE);
+			odeSolver.Iterate();
+		}
 
 	} while (!odeSolver.TimeStepSolved());
 }
@@ -163,6 +176,8 @@ void SuperMesh::ComputeFields(void)
 
 	total_energy_density = 0.0;
 
+	ProfileScope profile_modules(PROFILE_MODULES);
+
 	//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
 	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
 
@@ -172,6 +187,8 @@ void SuperMesh::ComputeFields(void)
 	//update effective field for super-mesh modules
 	for (int idx = 0; idx < (int)pSMod.size(); idx++) {
 
+		ProfileScope profile_module((MOD_)pSMod.get_ID_from_index(idx));
+
 		total_energy_density += pSMod[idx]->UpdateField();
 	}
 }
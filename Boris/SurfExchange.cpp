@@ -153,6 +153,10 @@ BError SurfExchange::Initialize(void)
 		}
 	}
 	
+	//precompute coupling topology for top and bottom surface cells
+	Build_Coupling(true);
+	Build_Coupling(false);
+
 	//Make sure display data has memory allocated (or freed) as required
 	error = Update_Module_Display_VECs(
 		pMesh->h, pMesh->meshRect, 
@@ -200,262 +204,241 @@ BError SurfExchange::MakeCUDAModule(void)
 	return error;
 }
 
-double SurfExchange::UpdateField(void)
+//build coupling_Top and acells_Top (top = true), or coupling_Bot and acells_Bot, from the identified coupled meshes
+void SurfExchange::Build_Coupling(bool top)
 {
-	double energy = 0;
+	std::vector<Mesh*>& pMesh_C = (top ? pMesh_Top : pMesh_Bot);
+	std::vector<Atom_Mesh*>& paMesh_C = (top ? paMesh_Top : paMesh_Bot);
 
-	SZ3 n = pMesh->n;
+	std::vector<SurfCoupling>& coupling = (top ? coupling_Top : coupling_Bot);
+	std::vector<int>& acells = (top ? acells_Top : acells_Bot);
+	std::vector<int>& coupling_idx = (top ? coupling_Top_idx : coupling_Bot_idx);
 
-	//zero module display VECs if needed, since contributions must be added into them to account for possiblility of 2 contributions (top and bottom)
-	ZeroModuleVECs();
+	coupling.clear();
+	acells.clear();
+	coupling_idx.clear();
 
-	if (pMesh_Top.size() || paMesh_Top.size()) {
+	if (!pMesh_C.size() && !paMesh_C.size()) return;
 
-		//surface exchange coupling at the top
-		#pragma omp parallel for reduction(+:energy)
-		for (int j = 0; j < n.y; j++) {
-			for (int i = 0; i < n.x; i++) {
+	SZ3 n = pMesh->n;
 
-				int cell_idx = i + j * n.x + (n.z - 1) * n.x*n.y;
+	coupling_idx.assign(n.x * n.y, -1);
 
-				//empty cell here ... next
-				if (pMesh->M.is_empty(cell_idx)) continue;
+	for (int j = 0; j < n.y; j++) {
+		for (int i = 0; i < n.x; i++) {
 
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(cell_idx, pMesh->Ms, Ms);
+			int cell_idx = i + j * n.x + (top ? (n.z - 1) * n.x*n.y : 0);
 
-				//effective field and energy for this cell
-				DBL3 Hsurfexch = DBL3();
-				double cell_energy = 0.0;
-				bool cell_coupled = false;
+			//empty cell here ... next
+			if (pMesh->M.is_empty(cell_idx)) continue;
 
-				//check all meshes for coupling
-				//1 : coupling into this micromagnetic mesh from other micromagnetic meshes (FM or AFM)
-				for (int mesh_idx = 0; mesh_idx < (int)pMesh_Top.size(); mesh_idx++) {
-					
-					if (!check_cell_coupling(pMesh->M, pMesh_Top[mesh_idx]->M,
-						(i + 0.5) * pMesh->h.x, (j + 0.5) * pMesh->h.y, pMesh_Top[mesh_idx]->h.z / 2)) continue;
+			SurfCoupling cell_coupling;
+			cell_coupling.cell_idx = cell_idx;
+			cell_coupling.mesh_idx = -1;
+			cell_coupling.ccell_idx = -1;
+			cell_coupling.acells_start = 0;
+			cell_coupling.acells_end = 0;
 
-					DBL3 cell_rel_pos = DBL3(
-						(i + 0.5) * pMesh->h.x + pMesh->M.rect.s.x - pMesh_Top[mesh_idx]->M.rect.s.x, 
-						(j + 0.5) * pMesh->h.y + pMesh->M.rect.s.y - pMesh_Top[mesh_idx]->M.rect.s.y, 
-						pMesh_Top[mesh_idx]->h.z / 2);
+			//check all meshes for coupling
+			//1 : coupling into this micromagnetic mesh from other micromagnetic meshes (FM or AFM)
+			for (int mesh_idx = 0; mesh_idx < (int)pMesh_C.size(); mesh_idx++) {
 
-					if (pMesh_Top[mesh_idx]->GetMeshType() == MESH_FERROMAGNETIC) {
+				//z coordinate in coupled mesh : first cell for top mesh, last cell for bottom mesh
+				double zrel_c = (top ? pMesh_C[mesh_idx]->h.z / 2 : pMesh_C[mesh_idx]->meshRect.height() - pMesh_C[mesh_idx]->h.z / 2);
 
-						//Surface exchange field from a ferromagnetic mesh (RKKY)
+				if (!check_cell_coupling(pMesh->M, pMesh_C[mesh_idx]->M, (i + 0.5) * pMesh->h.x, (j + 0.5) * pMesh->h.y, zrel_c)) continue;
 
-						//Top mesh sets J1 and J2 values
-						double J1 = pMesh_Top[mesh_idx]->J1;
-						double J2 = pMesh_Top[mesh_idx]->J2;
-						pMesh_Top[mesh_idx]->update_parameters_atposition(cell_rel_pos, pMesh_Top[mesh_idx]->J1, J1, pMesh_Top[mesh_idx]->J2, J2);
+				DBL3 cell_rel_pos = DBL3(
+					(i + 0.5) * pMesh->h.x + pMesh->M.rect.s.x - pMesh_C[mesh_idx]->M.rect.s.x,
+					(j + 0.5) * pMesh->h.y + pMesh->M.rect.s.y - pMesh_C[mesh_idx]->M.rect.s.y,
+					zrel_c);
 
-						//get magnetization value in top mesh cell to couple with
-						DBL3 m_j = normalize(pMesh_Top[mesh_idx]->M[cell_rel_pos]);
-						DBL3 m_i = normalize(pMesh->M[cell_idx]);
+				VEC_VC<DBL3>& Mc = pMesh_C[mesh_idx]->M;
 
-						double dot_prod = m_i * m_j;
+				cell_coupling.mesh_idx = mesh_idx;
+				cell_coupling.cell_rel_pos = cell_rel_pos;
+				//same cell as read with Mc[cell_rel_pos]
+				cell_coupling.ccell_idx = int(cell_rel_pos.x / Mc.h.x) + int(cell_rel_pos.y / Mc.h.y) * Mc.n.x + int(cell_rel_pos.z / Mc.h.z) * Mc.n.x * Mc.n.y;
 
-						//total surface exchange field in coupling cells, including bilinear and biquadratic terms
-						Hsurfexch = (m_j / (MU0 * Ms * pMesh->h.z)) * (J1 + 2 * J2 * dot_prod);
-						cell_energy = (-1 * J1 - 2 * J2 * dot_prod) * dot_prod / pMesh->h.z;
-					}
-					else if (pMesh_Top[mesh_idx]->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+				//for each cell, either it's not coupled to any other mesh cell, or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
+				break;
+			}
 
-						//Surface exchange field from an antiferromagnetic mesh (exchange bias)
+			//2 : coupling into this micromagnetic mesh from atomistic meshes
+			//as for the micromagnetic meshes a cell is only coupled to one atomistic mesh, which is taken to be the first one
+			if (cell_coupling.ccell_idx < 0 && paMesh_C.size()) {
 
-						//Top mesh sets J1 and J2 values
-						double J1 = pMesh_Top[mesh_idx]->J1;
-						double J2 = pMesh_Top[mesh_idx]->J2;
-						pMesh_Top[mesh_idx]->update_parameters_atposition(cell_rel_pos, pMesh_Top[mesh_idx]->J1, J1, pMesh_Top[mesh_idx]->J2, J2);
+				VEC_VC<DBL3>& M1 = paMesh_C[0]->M1;
 
-						//get magnetization values in top mesh cell to couple with
-						DBL3 m_j1 = normalize(pMesh_Top[mesh_idx]->M[cell_rel_pos]);
-						DBL3 m_j2 = normalize(pMesh_Top[mesh_idx]->M2[cell_rel_pos]);
-						DBL3 m_i = normalize(pMesh->M[cell_idx]);
+				//coupling rectangle in atomistic mesh in absolute coordinates : atomistic mesh first cells layer at the top, last cells layer at the bottom
+				Rect rect_c = (top ?
+					Rect(
+						DBL3(i * pMesh->h.x, j * pMesh->h.y, pMesh->M.rect.e.z),
+						DBL3((i + 1) * pMesh->h.x, (j + 1) * pMesh->h.y, M1.h.z + pMesh->M.rect.e.z)) :
+					Rect(
+						DBL3(i * pMesh->h.x, j * pMesh->h.y, M1.rect.e.z - M1.h.z),
+						DBL3((i + 1) * pMesh->h.x, (j + 1) * pMesh->h.y, M1.rect.e.z)));
+				rect_c += DBL3(pMesh->M.rect.s.x, pMesh->M.rect.s.y, 0.0);
 
-						//total surface exchange field in coupling cells, including contributions from both sub-lattices
-						Hsurfexch = (m_j1 / (MU0 * Ms * pMesh->h.z)) * J1;
-						Hsurfexch += (m_j2 / (MU0 * Ms * pMesh->h.z)) * J2;
-						cell_energy = (-J1 * (m_i * m_j1) - J2 * (m_i * m_j2)) / pMesh->h.z;
-					}
+				//cells box in atomistic mesh
+				Box abox = M1.box_from_rect_min(rect_c);
 
-					//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-					cell_coupled = true;
-					break;
-				}
+				cell_coupling.mesh_idx = 0;
+				cell_coupling.acells_start = acells.size();
 
-				if (!cell_coupled) {
+				for (int ai = abox.s.i; ai < abox.e.i; ai++) {
+					for (int aj = abox.s.j; aj < abox.e.j; aj++) {
 
-					//2 : coupling into this micromagnetic mesh from atomistic meshes
-					for (int mesh_idx = 0; mesh_idx < (int)paMesh_Top.size(); mesh_idx++) {
+						int acell_idx = ai + aj * M1.n.x + (top ? 0 : (M1.n.z - 1) * M1.n.x * M1.n.y);
 
-						VEC_VC<DBL3>& M1 = paMesh_Top[mesh_idx]->M1;
+						if (!M1.is_empty(acell_idx)) acells.push_back(acell_idx);
+					}
+				}
 
-						//coupling rectangle in atomistic mesh in absolute coordinates
-						Rect rect_c = Rect(
-							DBL3(i * pMesh->h.x, j * pMesh->h.y, pMesh->M.rect.e.z),
-							DBL3((i + 1) * pMesh->h.x, (j + 1) * pMesh->h.y, M1.h.z + pMesh->M.rect.e.z));
-						rect_c += DBL3(pMesh->M.rect.s.x, pMesh->M.rect.s.y, 0.0);
+				cell_coupling.acells_end = acells.size();
 
-						//cells box in atomistic mesh
-						Box acells = M1.box_from_rect_min(rect_c);
+				//no atomistic moments at the interface : not coupled
+				if (cell_coupling.acells_end == cell_coupling.acells_start) cell_coupling.mesh_idx = -1;
+			}
 
-						//find total "directed energy" contribution from atomistic mesh : i.e. sum all mj * Js contributions from atomistic moments in the coupling area at the interface
-						DBL3 total_directed_coupling_energy = DBL3();
-						for (int ai = acells.s.i; ai < acells.e.i; ai++) {
-							for (int aj = acells.s.j; aj < acells.e.j; aj++) {
+			if (cell_coupling.mesh_idx >= 0) {
 
-								int acell_idx = ai + aj * M1.n.x;
+				coupling_idx[i + j * n.x] = coupling.size();
+				coupling.push_back(cell_coupling);
+			}
+		}
+	}
+}
 
-								if (M1.is_empty(acell_idx)) continue;
+//surface exchange field and energy density for a coupled surface cell, with magnetization M_i in this cell (Ms, and for bottom surface also J1, J2 in this mesh, already resolved at this cell)
+void SurfExchange::Get_Coupling_Field(const SurfCoupling& coupling, bool top, DBL3 M_i, double Ms, double J1, double J2, DBL3& Hsurfexch, double& cell_energy)
+{
+	Hsurfexch = DBL3();
+	cell_energy = 0.0;
 
-								//Js value from atomistic mesh
-								double Js = paMesh_Top[mesh_idx]->Js;
-								double mu_s = paMesh_Top[mesh_idx]->mu_s;
-								paMesh_Top[mesh_idx]->update_parameters_mcoarse(acell_idx, paMesh_Top[mesh_idx]->Js, Js, paMesh_Top[mesh_idx]->mu_s, mu_s);
+	if (coupling.ccell_idx >= 0) {
 
-								total_directed_coupling_energy += M1[acell_idx] * Js / mu_s;
-							}
-						}
+		//1 : coupling into this micromagnetic mesh from other micromagnetic meshes (FM or AFM)
+		Mesh* pMesh_C = (top ? pMesh_Top[coupling.mesh_idx] : pMesh_Bot[coupling.mesh_idx]);
 
-						//now obtain coupling field from atomistic mesh at micromagnetic cell
-						Hsurfexch = (total_directed_coupling_energy / (pMesh->h.x * pMesh->h.y)) / (MU0 * Ms * pMesh->h.z);
-						cell_energy = -MU0 * pMesh->M[cell_idx] * Hsurfexch;
+		if (pMesh_C->GetMeshType() != MESH_FERROMAGNETIC && pMesh_C->GetMeshType() != MESH_ANTIFERROMAGNETIC) return;
 
-						//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-						break;
-					}
-				}
-				
-				pMesh->Heff[cell_idx] += Hsurfexch;
-				energy += cell_energy;
+		//Top mesh sets J1 and J2 values
+		if (top) {
 
-				if (Module_Heff.linear_size()) Module_Heff[cell_idx] += Hsurfexch;
-				if (Module_energy.linear_size()) Module_energy[cell_idx] += cell_energy;
-			}
+			J1 = pMesh_C->J1;
+			J2 = pMesh_C->J2;
+			pMesh_C->update_parameters_atposition(coupling.cell_rel_pos, pMesh_C->J1, J1, pMesh_C->J2, J2);
 		}
-	}
 
-	if (pMesh_Bot.size() || paMesh_Bot.size()) {
+		DBL3 m_i = normalize(M_i);
 
-		//surface exchange coupling at the bottom
-		#pragma omp parallel for reduction(+:energy)
-		for (int j = 0; j < n.y; j++) {
-			for (int i = 0; i < n.x; i++) {
+		if (pMesh_C->GetMeshType() == MESH_FERROMAGNETIC) {
 
-				int cell_idx = i + j * n.x;
+			//Surface exchange field from a ferromagnetic mesh (RKKY)
 
-				//empty cell here ... next
-				if (pMesh->M.is_empty(cell_idx)) continue;
+			//get magnetization value in coupled mesh cell
+			DBL3 m_j = normalize(pMesh_C->M[coupling.ccell_idx]);
 
-				double Ms = pMesh->Ms;
-				double J1 = pMesh->J1;
-				double J2 = pMesh->J2;
-				pMesh->update_parameters_mcoarse(cell_idx, pMesh->Ms, Ms, pMesh->J1, J1, pMesh->J2, J2);
+			double dot_prod = m_i * m_j;
 
-				//effective field and energy for this cell
-				DBL3 Hsurfexch = DBL3();
-				double cell_energy = 0.0;
-				bool cell_coupled = false;
-
-				//check all meshes for coupling
-				//1 : coupling into this micromagnetic mesh from other micromagnetic meshes (FM or AFM)
-				for (int mesh_idx = 0; mesh_idx < (int)pMesh_Bot.size(); mesh_idx++) {
+			//total surface exchange field in coupling cells, including bilinear and biquadratic terms
+			Hsurfexch = (m_j / (MU0 * Ms * pMesh->h.z)) * (J1 + 2 * J2 * dot_prod);
+			cell_energy = (-1 * J1 - 2 * J2 * dot_prod) * dot_prod / pMesh->h.z;
+		}
+		else {
 
-					if (!check_cell_coupling(pMesh->M, pMesh_Bot[mesh_idx]->M,
-						(i + 0.5) * pMesh->h.x, (j + 0.5) * pMesh->h.y, pMesh_Bot[mesh_idx]->meshRect.height() - pMesh_Bot[mesh_idx]->h.z / 2)) continue;
+			//Surface exchange field from an antiferromagnetic mesh (exchange bias)
 
-					DBL3 cell_rel_pos = DBL3(
-						(i + 0.5) * pMesh->h.x + pMesh->M.rect.s.x - pMesh_Bot[mesh_idx]->M.rect.s.x, 
-						(j + 0.5) * pMesh->h.y + pMesh->M.rect.s.y - pMesh_Bot[mesh_idx]->M.rect.s.y, 
-						pMesh_Bot[mesh_idx]->meshRect.height() - pMesh_Bot[mesh_idx]->h.z / 2);
+			//get magnetization values in coupled mesh cell
+			DBL3 m_j1 = normalize(pMesh_C->M[coupling.ccell_idx]);
+			DBL3 m_j2 = normalize(pMesh_C->M2[coupling.ccell_idx]);
 
-					if (pMesh_Bot[mesh_idx]->GetMeshType() == MESH_FERROMAGNETIC) {
+			//total surface exchange field in coupling cells, including contributions from both sub-lattices
+			Hsurfexch = (m_j1 / (MU0 * Ms * pMesh->h.z)) * J1;
+			Hsurfexch += (m_j2 / (MU0 * Ms * pMesh->h.z)) * J2;
+			cell_energy = (-J1 * (m_i * m_j1) - J2 * (m_i * m_j2)) / pMesh->h.z;
+		}
+	}
+	else {
 
-						//Surface exchange field from a ferromagnetic mesh (RKKY)
+		//2 : coupling into this micromagnetic mesh from atomistic meshes
+		//NOTE : at atomistic/micromagnetic coupling, it's the atomistic mesh which sets coupling constant, not the top mesh
+		Atom_Mesh* paMesh_C = (top ? paMesh_Top[coupling.mesh_idx] : paMesh_Bot[coupling.mesh_idx]);
+		std::vector<int>& acells = (top ? acells_Top : acells_Bot);
 
-						//get magnetization value in top mesh cell to couple with
-						DBL3 m_j = normalize(pMesh_Bot[mesh_idx]->M[cell_rel_pos]);
-						DBL3 m_i = normalize(pMesh->M[cell_idx]);
+		VEC_VC<DBL3>& M1 = paMesh_C->M1;
 
-						double dot_prod = m_i * m_j;
+		//find total "directed energy" contribution from atomistic mesh : i.e. sum all mj * Js contributions from atomistic moments in the coupling area at the interface
+		DBL3 total_directed_coupling_energy = DBL3();
+		for (int aidx = coupling.acells_start; aidx < coupling.acells_end; aidx++) {
 
-						//total surface exchange field in coupling cells, including bilinear and biquadratic terms
-						Hsurfexch = (m_j / (MU0 * Ms * pMesh->h.z)) * (J1 + 2 * J2 * dot_prod);
-						cell_energy = (-1 * J1 - 2 * J2 * dot_prod) * dot_prod / pMesh->h.z;
-					}
-					else if (pMesh_Bot[mesh_idx]->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+			int acell_idx = acells[aidx];
 
-						//Surface exchange field from an antiferromagnetic mesh (exchange bias)
+			//Js value from atomistic mesh
+			double Js = paMesh_C->Js;
+			double mu_s = paMesh_C->mu_s;
+			paMesh_C->update_parameters_mcoarse(acell_idx, paMesh_C->Js, Js, paMesh_C->mu_s, mu_s);
 
-						//get magnetization value in top mesh cell to couple with
-						DBL3 m_j1 = normalize(pMesh_Bot[mesh_idx]->M[cell_rel_pos]);
-						DBL3 m_j2 = normalize(pMesh_Bot[mesh_idx]->M2[cell_rel_pos]);
-						DBL3 m_i = normalize(pMesh->M[cell_idx]);
+			total_directed_coupling_energy += M1[acell_idx] * Js / mu_s;
+		}
 
-						//total surface exchange field in coupling cells, including contributions from both sub-lattices
-						Hsurfexch = (m_j1 / (MU0 * Ms * pMesh->h.z)) * J1;
-						Hsurfexch += (m_j2 / (MU0 * Ms * pMesh->h.z)) * J2;
-						cell_energy = (-J1 * (m_i * m_j1) - J2 * (m_i * m_j2)) / pMesh->h.z;
-					}
+		//now obtain coupling field from atomistic mesh at micromagnetic cell
+		Hsurfexch = (total_directed_coupling_energy / (pMesh->h.x * pMesh->h.y)) / (MU0 * Ms * pMesh->h.z);
+		cell_energy = -MU0 * M_i * Hsurfexch;
+	}
+}
 
-					//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-					cell_coupled = true;
-					break;
-				}
-				
-				if (!cell_coupled) {
+double SurfExchange::UpdateField(void)
+{
+	double energy = 0;
 
-					//2 : coupling into this micromagnetic mesh from atomistic meshes
-					for (int mesh_idx = 0; mesh_idx < (int)paMesh_Bot.size(); mesh_idx++) {
+	//zero module display VECs if needed, since contributions must be added into them to account for possiblility of 2 contributions (top and bottom)
+	ZeroModuleVECs();
 
-						VEC_VC<DBL3>& M1 = paMesh_Bot[mesh_idx]->M1;
+	//surface exchange coupling at the top
+	#pragma omp parallel for reduction(+:energy)
+	for (int cidx = 0; cidx < (int)coupling_Top.size(); cidx++) {
 
-						//coupling rectangle in atomistic mesh in absolute coordinates
-						Rect rect_c = Rect(
-							DBL3(i * pMesh->h.x, j * pMesh->h.y, M1.rect.e.z - M1.h.z),
-							DBL3((i + 1) * pMesh->h.x, (j + 1) * pMesh->h.y, M1.rect.e.z));
-						rect_c += DBL3(pMesh->M.rect.s.x, pMesh->M.rect.s.y, 0.0);
+		int cell_idx = coupling_Top[cidx].cell_idx;
 
-						//cells box in atomistic mesh
-						Box acells = M1.box_from_rect_min(rect_c);
+		double Ms = pMesh->Ms;
+		pMesh->update_parameters_mcoarse(cell_idx, pMesh->Ms, Ms);
 
-						//find total "directed energy" contribution from atomistic mesh : i.e. sum all mj * Js contributions from atomistic moments in the coupling area at the interface
-						//NOTE : at atomistic/micromagnetic coupling, it's the atomistic mesh which sets coupling constant, not the top mesh
-						DBL3 total_directed_coupling_energy = DBL3();
-						for (int ai = acells.s.i; ai < acells.e.i; ai++) {
-							for (int aj = acells.s.j; aj < acells.e.j; aj++) {
+		//effective field and energy for this cell
+		DBL3 Hsurfexch;
+		double cell_energy;
+		Get_Coupling_Field(coupling_Top[cidx], true, pMesh->M[cell_idx], Ms, 0.0, 0.0, Hsurfexch, cell_energy);
 
-								int acell_idx = ai + aj * M1.n.x + (M1.n.z - 1) * M1.n.x * M1.n.y;
+		pMesh->Heff[cell_idx] += Hsurfexch;
+		energy += cell_energy;
 
-								if (M1.is_empty(acell_idx)) continue;
+		if (Module_Heff.linear_size()) Module_Heff[cell_idx] += Hsurfexch;
+		if (Module_energy.linear_size()) Module_energy[cell_idx] += cell_energy;
+	}
 
-								//Js value from atomistic mesh
-								double Js = paMesh_Bot[mesh_idx]->Js;
-								double mu_s = paMesh_Bot[mesh_idx]->mu_s;
-								paMesh_Bot[mesh_idx]->update_parameters_mcoarse(acell_idx, paMesh_Bot[mesh_idx]->Js, Js, paMesh_Bot[mesh_idx]->mu_s, mu_s);
+	//surface exchange coupling at the bottom
+	#pragma omp parallel for reduction(+:energy)
+	for (int cidx = 0; cidx < (int)coupling_Bot.size(); cidx++) {
 
-								total_directed_coupling_energy += M1[acell_idx] * Js / mu_s;
-							}
-						}
+		int cell_idx = coupling_Bot[cidx].cell_idx;
 
-						//now obtain coupling field from atomistic mesh at micromagnetic cell
-						Hsurfexch = (total_directed_coupling_energy / (pMesh->h.x * pMesh->h.y)) / (MU0 * Ms * pMesh->h.z);
-						cell_energy = -MU0 * pMesh->M[cell_idx] * Hsurfexch;
+		//this mesh sets J1 and J2 values at the bottom
+		double Ms = pMesh->Ms;
+		double J1 = pMesh->J1;
+		double J2 = pMesh->J2;
+		pMesh->update_parameters_mcoarse(cell_idx, pMesh->Ms, Ms, pMesh->J1, J1, pMesh->J2, J2);
 
-						//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-						break;
-					}
-				}
+		//effective field and energy for this cell
+		DBL3 Hsurfexch;
+		double cell_energy;
+		Get_Coupling_Field(coupling_Bot[cidx], false, pMesh->M[cell_idx], Ms, J1, J2, Hsurfexch, cell_energy);
 
-				pMesh->Heff[cell_idx] += Hsurfexch;
-				energy += cell_energy;
+		pMesh->Heff[cell_idx] += Hsurfexch;
+		energy += cell_energy;
 
-				if (Module_Heff.linear_size()) Module_Heff[cell_idx] += Hsurfexch;
-				if (Module_energy.linear_size()) Module_energy[cell_idx] += cell_energy;
-			}
-		}
+		if (Module_Heff.linear_size()) Module_Heff[cell_idx] += Hsurfexch;
+		if (Module_energy.linear_size()) Module_energy[cell_idx] += cell_energy;
 	}
 	
 	energy /= pMesh->M.get_nonempty_cells();
@@ -472,247 +455,46 @@ double SurfExchange::Get_EnergyChange(int spin_index, DBL3 Mnew)
 
 	SZ3 n = pMesh->n;
 
-	//if spin is on top surface then look at paMesh_Top
-	if (spin_index / (n.x * n.y) == n.z - 1 && (pMesh_Top.size() || paMesh_Top.size())) {
+	//index of surface cell (top or bottom)
+	int surf_idx = spin_index % (n.x * n.y);
 
-		if (!pMesh->M.is_empty(spin_index)) {
-
-			int i = spin_index % n.x;
-			int j = (spin_index / n.x) % n.y;
-
-			double Ms = pMesh->Ms;
-			pMesh->update_parameters_mcoarse(spin_index, pMesh->Ms, Ms);
-
-			bool cell_coupled = false;
-
-			//check all meshes for coupling
-			for (int mesh_idx = 0; mesh_idx < (int)pMesh_Top.size(); mesh_idx++) {
-
-				if (!check_cell_coupling(pMesh->M, pMesh_Top[mesh_idx]->M,
-					(i + 0.5) * pMesh->h.x, (j + 0.5) * pMesh->h.y, pMesh_Top[mesh_idx]->h.z / 2)) continue;
-
-				DBL3 cell_rel_pos = DBL3(
-					(i + 0.5) * pMesh->h.x + pMesh->M.rect.s.x - pMesh_Top[mesh_idx]->M.rect.s.x,
-					(j + 0.5) * pMesh->h.y + pMesh->M.rect.s.y - pMesh_Top[mesh_idx]->M.rect.s.y,
-					pMesh_Top[mesh_idx]->h.z / 2);
-
-				if (pMesh_Top[mesh_idx]->GetMeshType() == MESH_FERROMAGNETIC) {
-
-					//Surface exchange field from a ferromagnetic mesh (RKKY)
-
-					//Top mesh sets J1 and J2 values
-					double J1 = pMesh_Top[mesh_idx]->J1;
-					double J2 = pMesh_Top[mesh_idx]->J2;
-					pMesh_Top[mesh_idx]->update_parameters_atposition(cell_rel_pos, pMesh_Top[mesh_idx]->J1, J1, pMesh_Top[mesh_idx]->J2, J2);
-
-					//get magnetization value in top mesh cell to couple with
-					DBL3 m_j = normalize(pMesh_Top[mesh_idx]->M[cell_rel_pos]);
-					DBL3 m_i = normalize(pMesh->M[spin_index]);
-					
-					double dot_prod = m_i * m_j;
-					energy_old = (-1 * J1 - 2 * J2 * dot_prod) * dot_prod / pMesh->h.z;
-
-					if (Mnew != DBL3()) {
-
-						DBL3 mnew_i = normalize(Mnew);
-						double dot_prod_new = mnew_i * m_j;
-						energy_new = (-1 * J1 - 2 * J2 * dot_prod_new) * dot_prod_new / pMesh->h.z;
-					}
-				}
-				else if (pMesh_Top[mesh_idx]->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+	//if spin is on top surface then look at coupling at the top
+	if (spin_index / (n.x * n.y) == n.z - 1 && coupling_Top_idx.size() && coupling_Top_idx[surf_idx] >= 0) {
 
-					//Surface exchange field from an antiferromagnetic mesh (exchange bias)
+		double Ms = pMesh->Ms;
+		pMesh->update_parameters_mcoarse(spin_index, pMesh->Ms, Ms);
 
-					//Top mesh sets J1 and J2 values
-					double J1 = pMesh_Top[mesh_idx]->J1;
-					double J2 = pMesh_Top[mesh_idx]->J2;
-					pMesh_Top[mesh_idx]->update_parameters_atposition(cell_rel_pos, pMesh_Top[mesh_idx]->J1, J1, pMesh_Top[mesh_idx]->J2, J2);
+		DBL3 Hsurfexch;
+		double cell_energy;
 
-					//get magnetization values in top mesh cell to couple with
-					DBL3 m_j1 = normalize(pMesh_Top[mesh_idx]->M[cell_rel_pos]);
-					DBL3 m_j2 = normalize(pMesh_Top[mesh_idx]->M2[cell_rel_pos]);
-					DBL3 m_i = normalize(pMesh->M[spin_index]);
+		Get_Coupling_Field(coupling_Top[coupling_Top_idx[surf_idx]], true, pMesh->M[spin_index], Ms, 0.0, 0.0, Hsurfexch, cell_energy);
+		energy_old += cell_energy;
 
-					energy_old = (-J1 * (m_i * m_j1) - J2 * (m_i * m_j2)) / pMesh->h.z;
+		if (Mnew != DBL3()) {
 
-					if (Mnew != DBL3()) {
-
-						DBL3 mnew_i = normalize(Mnew);
-						energy_new = (-J1 * (mnew_i * m_j1) - J2 * (mnew_i * m_j2)) / pMesh->h.z;
-					}
-				}
-
-				//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-				cell_coupled = true;
-				break;
-			}
-
-			if (!cell_coupled) {
-
-				//2 : coupling into this micromagnetic mesh from atomistic meshes
-				for (int mesh_idx = 0; mesh_idx < (int)paMesh_Top.size(); mesh_idx++) {
-
-					VEC_VC<DBL3>& M1 = paMesh_Top[mesh_idx]->M1;
-
-					//coupling rectangle in atomistic mesh in absolute coordinates
-					Rect rect_c = Rect(
-						DBL3(i * pMesh->h.x, j * pMesh->h.y, pMesh->M.rect.e.z),
-						DBL3((i + 1) * pMesh->h.x, (j + 1) * pMesh->h.y, M1.h.z + pMesh->M.rect.e.z));
-					rect_c += DBL3(pMesh->M.rect.s.x, pMesh->M.rect.s.y, 0.0);
-
-					//cells box in atomistic mesh
-					Box acells = M1.box_from_rect_min(rect_c);
-
-					//find total "directed energy" contribution from atomistic mesh : i.e. sum all mj * Js contributions from atomistic moments in the coupling area at the interface
-					DBL3 total_directed_coupling_energy = DBL3();
-					for (int ai = acells.s.i; ai < acells.e.i; ai++) {
-						for (int aj = acells.s.j; aj < acells.e.j; aj++) {
-
-							int acell_idx = ai + aj * M1.n.x;
-
-							if (M1.is_empty(acell_idx)) continue;
-
-							//Js value from atomistic mesh
-							double Js = paMesh_Top[mesh_idx]->Js;
-							double mu_s = paMesh_Top[mesh_idx]->mu_s;
-							paMesh_Top[mesh_idx]->update_parameters_mcoarse(acell_idx, paMesh_Top[mesh_idx]->Js, Js, paMesh_Top[mesh_idx]->mu_s, mu_s);
-
-							total_directed_coupling_energy += M1[acell_idx] * Js / mu_s;
-						}
-					}
-
-					//now obtain coupling field from atomistic mesh at micromagnetic cell
-					DBL3 Hsurfexch = (total_directed_coupling_energy / (pMesh->h.x * pMesh->h.y)) / (MU0 * Ms * pMesh->h.z);
-					energy_old = -MU0 * pMesh->M[spin_index] * Hsurfexch;
-					
-					if (Mnew != DBL3()) {
-
-						energy_new = -MU0 * Mnew * Hsurfexch;
-					}
-
-					//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-					break;
-				}
-			}
+			Get_Coupling_Field(coupling_Top[coupling_Top_idx[surf_idx]], true, Mnew, Ms, 0.0, 0.0, Hsurfexch, cell_energy);
+			energy_new += cell_energy;
 		}
 	}
 
-	if (spin_index / (n.x * n.y) == 0 && (pMesh_Bot.size() || paMesh_Bot.size())) {
-
-		//surface exchange coupling at the bottom
+	//if spin is on bottom surface then look at coupling at the bottom
+	if (spin_index / (n.x * n.y) == 0 && coupling_Bot_idx.size() && coupling_Bot_idx[surf_idx] >= 0) {
 
-		if (!pMesh->M.is_empty(spin_index)) {
-
-			int i = spin_index % n.x;
-			int j = (spin_index / n.x) % n.y;
-
-			double Ms = pMesh->Ms;
-			double J1 = pMesh->J1;
-			double J2 = pMesh->J2;
-			pMesh->update_parameters_mcoarse(spin_index, pMesh->Ms, Ms, pMesh->J1, J1, pMesh->J2, J2);
-
-			bool cell_coupled = false;
-
-			//check all meshes for coupling
-			for (int mesh_idx = 0; mesh_idx < (int)pMesh_Bot.size(); mesh_idx++) {
-
-				if (!check_cell_coupling(pMesh->M, pMesh_Bot[mesh_idx]->M,
-					(i + 0.5) * pMesh->h.x, (j + 0.5) * pMesh->h.y, pMesh_Bot[mesh_idx]->meshRect.height() - pMesh_Bot[mesh_idx]->h.z / 2)) continue;
-
-				DBL3 cell_rel_pos = DBL3(
-					(i + 0.5) * pMesh->h.x + pMesh->M.rect.s.x - pMesh_Bot[mesh_idx]->M.rect.s.x,
-					(j + 0.5) * pMesh->h.y + pMesh->M.rect.s.y - pMesh_Bot[mesh_idx]->M.rect.s.y,
-					pMesh_Bot[mesh_idx]->meshRect.height() - pMesh_Bot[mesh_idx]->h.z / 2);
+		double Ms = pMesh->Ms;
+		double J1 = pMesh->J1;
+		double J2 = pMesh->J2;
+		pMesh->update_parameters_mcoarse(spin_index, pMesh->Ms, Ms, pMesh->J1, J1, pMesh->J2, J2);
 
-				if (pMesh_Bot[mesh_idx]->GetMeshType() == MESH_FERROMAGNETIC) {
+		DBL3 Hsurfexch;
+		double cell_energy;
 
-					//Surface exchange field from a ferromagnetic mesh (RKKY)
+		Get_Coupling_Field(coupling_Bot[coupling_Bot_idx[surf_idx]], false, pMesh->M[spin_index], Ms, J1, J2, Hsurfexch, cell_energy);
+		energy_old += cell_energy;
 
-					//get magnetization value in top mesh cell to couple with
-					DBL3 m_j = normalize(pMesh_Bot[mesh_idx]->M[cell_rel_pos]);
-					DBL3 m_i = normalize(pMesh->M[spin_index]);
-					DBL3 mnew_i = normalize(Mnew);
+		if (Mnew != DBL3()) {
 
-					double dot_prod = m_i * m_j;
-					energy_old += (-1 * J1 - 2 * J2 * dot_prod) * dot_prod / pMesh->h.z;
-
-					if (Mnew != DBL3()) {
-
-						double dot_prod_new = mnew_i * m_j;
-						energy_new += (-1 * J1 - 2 * J2 * dot_prod_new) * dot_prod_new / pMesh->h.z;
-					}
-				}
-				else if (pMesh_Bot[mesh_idx]->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					//Surface exchange field from an antiferromagnetic mesh (exchange bias)
-
-					//get magnetization value in top mesh cell to couple with
-					DBL3 m_j1 = normalize(pMesh_Bot[mesh_idx]->M[cell_rel_pos]);
-					DBL3 m_j2 = normalize(pMesh_Bot[mesh_idx]->M2[cell_rel_pos]);
-					DBL3 m_i = normalize(pMesh->M[spin_index]);
-
-					energy_old += (-J1 * (m_i * m_j1) - J2 * (m_i * m_j2)) / pMesh->h.z;
-
-					if (Mnew != DBL3()) {
-
-						DBL3 mnew_i = normalize(Mnew);
-						energy_new += (-J1 * (mnew_i * m_j1) - J2 * (mnew_i * m_j2)) / pMesh->h.z;
-					}
-				}
-
-				//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-				cell_coupled = true;
-				break;
-			}
-
-			if (!cell_coupled) {
-
-				//2 : coupling into this micromagnetic mesh from atomistic meshes
-				for (int mesh_idx = 0; mesh_idx < (int)paMesh_Bot.size(); mesh_idx++) {
-
-					VEC_VC<DBL3>& M1 = paMesh_Bot[mesh_idx]->M1;
-
-					//coupling rectangle in atomistic mesh in absolute coordinates
-					Rect rect_c = Rect(
-						DBL3(i * pMesh->h.x, j * pMesh->h.y, M1.rect.e.z - M1.h.z),
-						DBL3((i + 1) * pMesh->h.x, (j + 1) * pMesh->h.y, M1.rect.e.z));
-					rect_c += DBL3(pMesh->M.rect.s.x, pMesh->M.rect.s.y, 0.0);
-
-					//cells box in atomistic mesh
-					Box acells = M1.box_from_rect_min(rect_c);
-
-					//find total "directed energy" contribution from atomistic mesh : i.e. sum all mj * Js contributions from atomistic moments in the coupling area at the interface
-					//NOTE : at atomistic/micromagnetic coupling, it's the atomistic mesh which sets coupling constant, not the top mesh
-					DBL3 total_directed_coupling_energy = DBL3();
-					for (int ai = acells.s.i; ai < acells.e.i; ai++) {
-						for (int aj = acells.s.j; aj < acells.e.j; aj++) {
-
-							int acell_idx = ai + aj * M1.n.x + (M1.n.z - 1) * M1.n.x * M1.n.y;
-
-							if (M1.is_empty(acell_idx)) continue;
-
-							//Js value from atomistic mesh
-							double Js = paMesh_Bot[mesh_idx]->Js;
-							double mu_s = paMesh_Bot[mesh_idx]->mu_s;
-							paMesh_Bot[mesh_idx]->update_parameters_mcoarse(acell_idx, paMesh_Bot[mesh_idx]->Js, Js, paMesh_Bot[mesh_idx]->mu_s, mu_s);
-
-							total_directed_coupling_energy += M1[acell_idx] * Js / mu_s;
-						}
-					}
-
-					//now obtain coupling field from atomistic mesh at micromagnetic cell
-					DBL3 Hsurfexch = (total_directed_coupling_energy / (pMesh->h.x * pMesh->h.y)) / (MU0 * Ms * pMesh->h.z);
-					energy_old += -MU0 * pMesh->M[spin_index] * Hsurfexch;
-					
-					if (Mnew != DBL3()) {
-
-						energy_new += -MU0 * Mnew * Hsurfexch;
-					}
-
-					//for each cell, either it's not coupled to any other mesh cell (so we never get here), or else it's coupled to exactly one cell on this surface (thus can stop looping over meshes now)
-					break;
-				}
-			}
+			Get_Coupling_Field(coupling_Bot[coupling_Bot_idx[surf_idx]], false, Mnew, Ms, J1, J2, Hsurfexch, cell_energy);
+			energy_new += cell_energy;
 		}
 	}
 
@@ -34,8 +34,42 @@ private:
 	//atomic meshes in surface exchange coupling with the mesh holding this module, top and bottom
 	std::vector<Atom_Mesh*> paMesh_Bot, paMesh_Top;
 
+	//coupling of a surface cell in this mesh (top or bottom) with a cell in a micromagnetic mesh, or with interface cells in an atomistic mesh
+	struct SurfCoupling {
+
+		//surface cell index in this mesh
+		int cell_idx;
+
+		//coupled mesh index : in pMesh_Top / pMesh_Bot if ccell_idx >= 0, else in paMesh_Top / paMesh_Bot
+		int mesh_idx;
+
+		//coupled cell index in micromagnetic mesh, -1 for atomistic mesh
+		int ccell_idx;
+
+		//relative position in coupled micromagnetic mesh, used to get coupling constants there
+		DBL3 cell_rel_pos;
+
+		//atomistic mesh : non-empty interface cells are acells_Top / acells_Bot entries from acells_start up to acells_end (exclusive)
+		int acells_start, acells_end;
+	};
+
+	//coupling topology for all coupled surface cells, built in Initialize, so at run-time only the coupled values need to be read
+	std::vector<SurfCoupling> coupling_Top, coupling_Bot;
+
+	//interface cells in atomistic meshes, referenced by coupling_Top / coupling_Bot
+	std::vector<int> acells_Top, acells_Bot;
+
+	//for each surface cell (i + j * n.x) the index in coupling_Top / coupling_Bot, -1 if not coupled (used for Monte Carlo energy changes)
+	std::vector<int> coupling_Top_idx, coupling_Bot_idx;
+
 private:
 
+	//build coupling_Top and acells_Top (top = true), or coupling_Bot and acells_Bot, from the identified coupled meshes
+	void Build_Coupling(bool top);
+
+	//surface exchange field and energy density for a coupled surface cell, with magnetization M_i in this cell (Ms, and for bottom surface also J1, J2 in this mesh, already resolved at this cell)
+	void Get_Coupling_Field(const SurfCoupling& coupling, bool top, DBL3 M_i, double Ms, double J1, double J2, DBL3& Hsurfexch, double& cell_energy);
+
 	//Mh is for "here", and Mc is what we're trying to couple to. xrel_h and yrel_h are relative to here, and zrel_c relative to coupling mesh
 	bool check_cell_coupling(VEC_VC<DBL3>& Mh, VEC_VC<DBL3>& Mc, double xrel_h, double yrel_h, double zrel_c)
 	{
@@ -14,7 +14,7 @@
 
 DBL2 TMR::IterateChargeSolver_SOR(double damping)
 {
-	return pMesh->V.IteratePoisson_SOR<TMR>(&TMR::Evaluate_ChargeSolver_delsqV_RHS, *this, damping);
+	return pMesh->V.IteratePoisson_SOR_Func([this](int idx) { return TMR::Evaluate_ChargeSolver_delsqV_RHS(idx); }, damping);
 }
 
 double TMR::Evaluate_ChargeSolver_delsqV_RHS(int idx) const
@@ -17,7 +17,7 @@
 
 DBL2 TMR::IterateSpinSolver_Charge_SOR(double damping)
 {
-	return pMesh->V.IteratePoisson_SOR<TMR>(&TMR::Evaluate_SpinSolver_delsqV_RHS, *this, damping);
+	return pMesh->V.IteratePoisson_SOR_Func([this](int idx) { return TMR::Evaluate_SpinSolver_delsqV_RHS(idx); }, damping);
 }
 
 //before iterating the spin solver (charge part) we need to prime it : pre-compute values which do not change as the spin solver relaxes. Not needed for TMR.
@@ -37,7 +37,7 @@ double TMR::Evaluate_SpinSolver_delsqV_RHS(int idx) const
 //solve for spin accumulation using Poisson equation for delsq_S, solved using SOR algorithm
 DBL2 TMR::IterateSpinSolver_Spin_SOR(double damping)
 {
-	return pMesh->S.IteratePoisson_SOR<TMR>(&TMR::Evaluate_SpinSolver_delsqS_RHS, *this, damping);
+	return pMesh->S.IteratePoisson_SOR_Func([this](int idx) { return TMR::Evaluate_SpinSolver_delsqS_RHS(idx); }, damping);
 }
 
 //before iterating the spin solver (spin part) we need to prime it : pre-compute values which do not change as the spin solver relaxes. Not needed for TMR.
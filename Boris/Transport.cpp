@@ -10,7 +10,8 @@
 Transport::Transport(Mesh *pMesh_) :
 	Modules(),
 	TransportBase(pMesh_),
-	ProgramStateNames(this, { VINFO(TAMR_conductivity_equation) }, {})
+	ProgramStateNames(this, { VINFO(TAMR_conductivity_equation) }, {}),
+	V_mgsolve(&pMesh_->V)
 {
 	pMesh = pMesh_;
 
@@ -37,6 +37,9 @@ private:
 	//pointer to mesh object holding this effective field module
 	Mesh* pMesh;
 
+	//multigrid solver for V (used instead of SOR iterations if set in STransport)
+	MGSolve<double> V_mgsolve;
+
 private:
 
 	//-------------------Calculation Methods
@@ -50,6 +53,9 @@ private:
 	//Return un-normalized error (maximum change in quantity from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
 	DBL2 IterateChargeSolver_SOR(double damping);
 
+	//as above but take a single multigrid cycle (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2)
+	DBL2 IterateChargeSolver_MG(double damping, int cycle_gamma);
+
 	//call-back method for Poisson equation to evaluate RHS
 	double Evaluate_ChargeSolver_delsqV_RHS(int idx) const;
 
@@ -65,6 +71,9 @@ private:
 	//Return un-normalized error (maximum change in quantity from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
 	DBL2 IterateSpinSolver_Charge_SOR(double damping);
 
+	//as above but take a single multigrid cycle (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2)
+	DBL2 IterateSpinSolver_Charge_MG(double damping, int cycle_gamma);
+
 	//call-back method for Poisson equation to evaluate RHS
 	double Evaluate_SpinSolver_delsqV_RHS(int idx) const;
 
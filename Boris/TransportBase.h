@@ -89,6 +89,9 @@ protected:
 	//Return un-normalized error (maximum change in quantity from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
 	virtual DBL2 IterateChargeSolver_SOR(double damping) = 0;
 
+	//as above but take a single multigrid cycle (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2) instead of a SOR iteration. If not available in this mesh type then take a SOR iteration instead.
+	virtual DBL2 IterateChargeSolver_MG(double damping, int cycle_gamma) { return IterateChargeSolver_SOR(damping); }
+
 	//call-back method for Poisson equation to evaluate RHS
 	virtual double Evaluate_ChargeSolver_delsqV_RHS(int idx) const = 0;
 
@@ -101,6 +104,9 @@ protected:
 	//Return un-normalized error (maximum change in quantity from one iteration to the next) - first - and maximum value  -second - divide them to obtain normalized error
 	virtual DBL2 IterateSpinSolver_Charge_SOR(double damping) = 0;
 
+	//as above but take a single multigrid cycle (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2) instead of a SOR iteration. If not available in this mesh type then take a SOR iteration instead.
+	virtual DBL2 IterateSpinSolver_Charge_MG(double damping, int cycle_gamma) { return IterateSpinSolver_Charge_SOR(damping); }
+
 	//call-back method for Poisson equation to evaluate RHS
 	virtual double Evaluate_SpinSolver_delsqV_RHS(int idx) const = 0;
 
@@ -17,12 +17,27 @@ DBL2 Transport::IterateChargeSolver_SOR(double damping)
 	if (!is_thermoelectric_mesh) {
 
 		//no thermoelectric effect
-		return pMesh->V.IteratePoisson_SOR<Transport>(&Transport::Evaluate_ChargeSolver_delsqV_RHS, *this, damping);
+		return pMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Transport::Evaluate_ChargeSolver_delsqV_RHS(idx); }, damping);
 	}
 	else {
 
 		//include thermoelectric effect
-		return pMesh->V.IteratePoisson_SOR<Transport>(&Transport::Evaluate_ChargeSolver_delsqV_Thermoelectric_RHS, &Transport::NHNeumann_Vdiff_Thermoelectric, *this, damping);
+		return pMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Transport::Evaluate_ChargeSolver_delsqV_Thermoelectric_RHS(idx); }, [this](int idx) { return Transport::NHNeumann_Vdiff_Thermoelectric(idx); }, damping);
+	}
+}
+
+//as above but take a single multigrid cycle (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2)
+DBL2 Transport::IterateChargeSolver_MG(double damping, int cycle_gamma)
+{
+	if (!is_thermoelectric_mesh) {
+
+		//no thermoelectric effect
+		return V_mgsolve.Iterate<Transport>(&Transport::Evaluate_ChargeSolver_delsqV_RHS, *this, cycle_gamma);
+	}
+	else {
+
+		//include thermoelectric effect
+		return V_mgsolve.Iterate<Transport>(&Transport::Evaluate_ChargeSolver_delsqV_Thermoelectric_RHS, &Transport::NHNeumann_Vdiff_Thermoelectric, *this, cycle_gamma);
 	}
 }
 
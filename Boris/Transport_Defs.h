@@ -35,4 +35,21 @@ enum TMR_ {
 
 	//number of options in this enum
 	TMR_NUMOPTIONS
-};
\ No newline at end of file
+};
+//Poisson equation solver method used for V (charge solver, and charge part of spin solver) :
+
+//0. red-black SOR, one iteration per outer solver iteration
+
+//1. geometric multigrid, one V-cycle per outer solver iteration
+
+//2. geometric multigrid, one W-cycle per outer solver iteration
+
+enum TSOLVERMETHOD_ {
+
+	TSOLVERMETHOD_SOR = 0,
+	TSOLVERMETHOD_MGV = 1,
+	TSOLVERMETHOD_MGW = 2,
+
+	//number of options in this enum
+	TSOLVERMETHOD_NUMOPTIONS
+};
@@ -20,12 +20,27 @@ DBL2 Transport::IterateSpinSolver_Charge_SOR(double damping)
 	if (IsZ((double)pMesh->iSHA) || stsolve == STSOLVE_FERROMAGNETIC || stsolve == STSOLVE_NONE) {
 
 		//no iSHE contribution. Note, iSHE is not included in magnetic meshes.
-		return pMesh->V.IteratePoisson_SOR<Transport>(&Transport::Evaluate_SpinSolver_delsqV_RHS, *this, damping);
+		return pMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Transport::Evaluate_SpinSolver_delsqV_RHS(idx); }, damping);
 	}
 	else {
 
 		//iSHE enabled, must use non-homogeneous Neumann boundary condition for grad V -> Note homogeneous Neumann boundary conditions apply when calculating S differentials here (due to Jc.n = 0 at boundaries)
-		return pMesh->V.IteratePoisson_SOR<Transport>(&Transport::Evaluate_SpinSolver_delsqV_RHS, &Transport::NHNeumann_Vdiff, *this, damping);
+		return pMesh->V.IteratePoisson_SOR_Func([this](int idx) { return Transport::Evaluate_SpinSolver_delsqV_RHS(idx); }, [this](int idx) { return Transport::NHNeumann_Vdiff(idx); }, damping);
+	}
+}
+
+//as above but take a single multigrid cycle (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2)
+DBL2 Transport::IterateSpinSolver_Charge_MG(double damping, int cycle_gamma)
+{
+	if (IsZ((double)pMesh->iSHA) || stsolve == STSOLVE_FERROMAGNETIC || stsolve == STSOLVE_NONE) {
+
+		//no iSHE contribution. Note, iSHE is not included in magnetic meshes.
+		return V_mgsolve.Iterate<Transport>(&Transport::Evaluate_SpinSolver_delsqV_RHS, *this, cycle_gamma);
+	}
+	else {
+
+		//iSHE enabled, must use non-homogeneous Neumann boundary condition for grad V
+		return V_mgsolve.Iterate<Transport>(&Transport::Evaluate_SpinSolver_delsqV_RHS, &Transport::NHNeumann_Vdiff, *this, cycle_gamma);
 	}
 }
 
@@ -175,12 +190,12 @@ DBL2 Transport::IterateSpinSolver_Spin_SOR(double damping)
 	if (IsZ((double)pMesh->SHA) || stsolve == STSOLVE_FERROMAGNETIC) {
 
 		//no SHE contribution. Note, SHE is not included in magnetic meshes.
-		return pMesh->S.IteratePoisson_SOR<Transport>(&Transport::Evaluate_SpinSolver_delsqS_RHS, *this, damping);
+		return pMesh->S.IteratePoisson_SOR_Func([this](int idx) { return Transport::Evaluate_SpinSolver_delsqS_RHS(idx); }, damping);
 	}
 	else {
 
 		//SHE enabled, must use non-homogeneous Neumann boundary condition for grad S
-		return pMesh->S.IteratePoisson_SOR<Transport>(&Transport::Evaluate_SpinSolver_delsqS_RHS, &Transport::NHNeumann_Sdiff, *this, damping);
+		return pMesh->S.IteratePoisson_SOR_Func([this](int idx) { return Transport::Evaluate_SpinSolver_delsqS_RHS(idx); }, [this](int idx) { return Transport::NHNeumann_Sdiff(idx); }, damping);
 	}
 }
 
@@ -269,34 +269,45 @@ double Zeeman::UpdateField(void)
 
 		double time = pSMesh->GetStageTime();
 
+		//relative x positions are the same for all rows along x, so the equation is evaluated for a whole row in one call
+		std::vector<double> x_row(pMesh->n.x);
+		for (int i = 0; i < pMesh->n.x; i++) x_row[i] = (i + 0.5) * pMesh->h.x;
+
 		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-#pragma omp parallel for reduction(+:energy)
-			for (int j = 0; j < pMesh->n.y; j++) {
-				for (int k = 0; k < pMesh->n.z; k++) {
-					for (int i = 0; i < pMesh->n.x; i++) {
+#pragma omp parallel reduction(+:energy)
+			{
+				std::vector<DBL3> H_row(pMesh->n.x);
+
+#pragma omp for
+				for (int j = 0; j < pMesh->n.y; j++) {
+					for (int k = 0; k < pMesh->n.z; k++) {
+
+						H_equation.evaluate_vector_many(pMesh->n.x, x_row.data(), (j + 0.5) * pMesh->h.y, (k + 0.5) * pMesh->h.z, time, H_row.data());
+
+						for (int i = 0; i < pMesh->n.x; i++) {
 
-						int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+							int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
 
-						//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
-						double cHA = pMesh->cHA;
-						pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
+							//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
+							double cHA = pMesh->cHA;
+							pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
 
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h;
-						DBL3 H = H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, time);
+							DBL3 H = H_row[i];
 
-						DBL3 Hext = cHA * H;
-						if (globalField.linear_size()) Hext += globalField[idx];
+							DBL3 Hext = cHA * H;
+							if (globalField.linear_size()) Hext += globalField[idx];
 
-						pMesh->Heff[idx] = Hext;
-						pMesh->Heff2[idx] = Hext;
+							pMesh->Heff[idx] = Hext;
+							pMesh->Heff2[idx] = Hext;
 
-						energy += (pMesh->M[idx] + pMesh->M2[idx]) * Hext / 2;
+							energy += (pMesh->M[idx] + pMesh->M2[idx]) * Hext / 2;
 
-						if (Module_Heff.linear_size()) Module_Heff[idx] = Hext;
-						if (Module_Heff2.linear_size()) Module_Heff2[idx] = Hext;
-						if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * Hext;
-						if (Module_energy2.linear_size()) Module_energy2[idx] = -MU0 * pMesh->M2[idx] * Hext;
+							if (Module_Heff.linear_size()) Module_Heff[idx] = Hext;
+							if (Module_Heff2.linear_size()) Module_Heff2[idx] = Hext;
+							if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * Hext;
+							if (Module_energy2.linear_size()) Module_energy2[idx] = -MU0 * pMesh->M2[idx] * Hext;
+						}
 					}
 				}
 			}
@@ -304,29 +315,36 @@ double Zeeman::UpdateField(void)
 
 		else {
 
-#pragma omp parallel for reduction(+:energy)
-			for (int j = 0; j < pMesh->n.y; j++) {
-				for (int k = 0; k < pMesh->n.z; k++) {
-					for (int i = 0; i < pMesh->n.x; i++) {
+#pragma omp parallel reduction(+:energy)
+			{
+				std::vector<DBL3> H_row(pMesh->n.x);
+
+#pragma omp for
+				for (int j = 0; j < pMesh->n.y; j++) {
+					for (int k = 0; k < pMesh->n.z; k++) {
+
+						H_equation.evaluate_vector_many(pMesh->n.x, x_row.data(), (j + 0.5) * pMesh->h.y, (k + 0.5) * pMesh->h.z, time, H_row.data());
+
+						for (int i = 0; i < pMesh->n.x; i++) {
 
-						int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
+							int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
 
-						//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
-						double cHA = pMesh->cHA;
-						pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
+							//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
+							double cHA = pMesh->cHA;
+							pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
 
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h;
-						DBL3 H = H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, time);
+							DBL3 H = H_row[i];
 
-						DBL3 Hext = cHA * H;
-						if (globalField.linear_size()) Hext += globalField[idx];
+							DBL3 Hext = cHA * H;
+							if (globalField.linear_size()) Hext += globalField[idx];
 
-						pMesh->Heff[idx] = Hext;
+							pMesh->Heff[idx] = Hext;
 
-						energy += pMesh->M[idx] * Hext;
+							energy += pMesh->M[idx] * Hext;
 
-						if (Module_Heff.linear_size()) Module_Heff[idx] = Hext;
-						if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * Hext;
+							if (Module_Heff.linear_size()) Module_Heff[idx] = Hext;
+							if (Module_energy.linear_size()) Module_energy[idx] = -MU0 * pMesh->M[idx] * Hext;
+						}
 					}
 				}
 			}
@@ -22,6 +22,9 @@ private:
 	//pointer to mesh object holding this effective field module
 	Mesh * pMesh;
 
+	//FM mesh : add field contribution at non-empty cell idx to Heff, returning the energy density term to be summed (before final scaling)
+	double UpdateField_FM_Cell(int idx);
+
 public:
 
 	iDMExchange(Mesh *pMesh_);
@@ -44,6 +47,13 @@ public:
 
 	double UpdateField(void);
 
+	//-------------------Fused local field evaluation (see Modules)
+
+	bool FusedField_Available(void);
+	void FusedField_Prepare(void);
+	double FusedField_Cell(int idx);
+	double FusedField_Finish(double energy);
+
 	//-------------------Energy methods
 
 	//FM Mesh
@@ -9,6 +9,7 @@
 #include "Funcs_Files_Windows.h"
 #include "Funcs_Files_Linux.h"
 #include "Funcs_Files.h"
+#include "Funcs_Files_Binary.h"
 #include "Funcs_Aux_base.h"
 #include "Funcs_Aux_Windows.h"
 #include "Funcs_Aux_Linux.h"
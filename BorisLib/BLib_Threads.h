@@ -3,6 +3,7 @@
 //Include Threaded function calls
 
 #include "Threads.h"
+#include "Threads_DoubleBuffer.h"
 
 //CIRCULAR INCLUSION CHECK : PASSED 
 
@@ -16,6 +16,7 @@
 #include "VEC_VC_extract.h"
 #include "VEC_VC_avg.h"
 #include "VEC_VC_nprops.h"
+#include "VEC_VC_MultiReduction.h"
 #include "VEC_VC_Grad.h"
 #include "VEC_VC_Div.h"
 #include "VEC_VC_Curl.h"
@@ -24,6 +25,7 @@
 #include "VEC_VC_ngbrsum.h"
 #include "VEC_VC_Solve.h"
 #include "VEC_VC_CGSolve.h"
+#include "VEC_VC_MGSolve.h"
 
 //CIRCULAR INCLUSION CHECK : PASSED 
 
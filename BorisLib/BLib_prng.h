@@ -19,10 +19,21 @@ class BorisRand {
 
 private:
 
-	std::vector<unsigned> prn;
+	//per-thread generator state, padded to a cache line so threads don't share lines (false sharing)
+	struct alignas(64) ThreadState {
+
+		unsigned prn = 0;
+
+		//count number of random numbers generated between calls to check_periodicity : if this divides the LCG period it could be problematic so need to adjust
+		unsigned period = 0;
+
+		//second value generated by the Box-Muller transform, returned on the next rand_gauss call
+		double z1 = 0.0;
+		bool z1_available = false;
+	};
+
+	std::vector<ThreadState> state;
 
-	//count number of random numbers generated between calls to check_periodicity : if this divides the LCG period it could be problematic so need to adjust
-	std::vector<unsigned> period;
 	//set to true on first call to check_periodicity
 	bool calculate_period = false;
 
@@ -31,14 +42,12 @@ public:
 	BorisRand(unsigned seed, bool multithreaded_ = true)
 	{
 		int OmpThreads = omp_get_num_procs();
-		prn.resize(OmpThreads);
-		period.resize(OmpThreads);
+		state.resize(OmpThreads);
 
 		//seed all threads
 		for (int idx = 0; idx < OmpThreads; idx++) {
 
-			prn[idx] = seed * (idx + 1);
-			period[idx] = 0;
+			state[idx].prn = seed * (idx + 1);
 		}
 	}
 
@@ -46,55 +55,50 @@ public:
 	{
 		calculate_period = true;
 
-		for (int idx = 0; idx < period.size(); idx++) {
+		for (int idx = 0; idx < state.size(); idx++) {
 
 			//if the generation period at this point matches the LCG period then notch generation by 1 point, i.e. increase period by 1.
-			if (period[idx] && (unsigned)4294967295 % period[idx] == period[idx] - 1) {
+			if (state[idx].period && (unsigned)4294967295 % state[idx].period == state[idx].period - 1) {
 
-				prn[idx] = ((unsigned)1664525 * prn[idx] + (unsigned)1013904223);
+				state[idx].prn = ((unsigned)1664525 * state[idx].prn + (unsigned)1013904223);
 
 				//reset period : set to 1 since a point has already been generated
-				period[idx] = 1;
+				state[idx].period = 1;
 			}
-			else period[idx] = 0;
+			else state[idx].period = 0;
 		}
 	}
 
 	//unsigned integer value out : 0 to 2^32 - 1
 	unsigned randi(void)
 	{
-		int tn = omp_get_thread_num();
+		ThreadState& ts = state[omp_get_thread_num()];
 
 		//LCG equation used to generate next number in sequence : the modulo operation is free since unsigned is 32 bits wide
-		prn[tn] = ((unsigned)1664525 * prn[tn] + (unsigned)1013904223);
+		ts.prn = ((unsigned)1664525 * ts.prn + (unsigned)1013904223);
 
 		//count number of points generated on this thread since last call to check_periodicity
-		if (calculate_period) period[tn]++;
+		if (calculate_period) ts.period++;
 
-		return prn[tn];
+		return ts.prn;
 	}
 
 	//floating point value out in interval [0, 1]
 	double rand(void)
 	{
-		int tn = omp_get_thread_num();
-
-		prn[tn] = ((unsigned)1664525 * prn[tn] + (unsigned)1013904223);
-
-		//count number of points generated on this thread since last call to check_periodicity
-		if (calculate_period) period[tn]++;
-
-		return (double)prn[tn] / (unsigned)4294967295;
+		return (double)randi() / (unsigned)4294967295;
 	}
 
 	//Box-Muller transform to generate Gaussian distribution from uniform distribution
 	double rand_gauss(double mean, double std)
 	{
-		thread_local double z1;
-		thread_local bool generate;
-		generate = !generate;
+		ThreadState& ts = state[omp_get_thread_num()];
+
+		if (ts.z1_available) {
 
-		if (!generate) return z1 * std + mean;
+			ts.z1_available = false;
+			return ts.z1 * std + mean;
+		}
 
 		double u1, u2;
 		do {
@@ -104,8 +108,129 @@ public:
 
 		double z0;
 		z0 = sqrt(-2.0 * log(u1)) * cos(TWO_PI * u2);
-		z1 = sqrt(-2.0 * log(u1)) * sin(TWO_PI * u2);
+		ts.z1 = sqrt(-2.0 * log(u1)) * sin(TWO_PI * u2);
+		ts.z1_available = true;
 
 		return z0 * std + mean;
 	}
 };
+
+//Counter-based pseudo-random number generator (Philox4x32-10 : J. K. Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011)).
+//There is no generator state : a block of 4 random numbers is a function of a 64-bit key (seed and stream identifier) and a 128-bit counter only.
+//Use it with counter = (index, step), where index is e.g. a cell index and step is incremented every time new numbers are needed for all cells;
+//the random numbers obtained for a given cell then don't depend on the number of threads or the order in which cells are processed, so runs with a fixed seed are reproducible on any machine.
+
+class BorisCBRand {
+
+private:
+
+	unsigned key[2];
+
+public:
+
+	//single Philox4x32-10 evaluation : ctr is replaced by 4 random unsigned values
+	static void philox4x32(unsigned ctr[4], const unsigned key_[2])
+	{
+		unsigned k0 = key_[0], k1 = key_[1];
+
+		for (int round = 0; round < 10; round++) {
+
+			unsigned long long prod0 = (unsigned long long)0xD2511F53 * ctr[0];
+			unsigned long long prod1 = (unsigned long long)0xCD9E8D57 * ctr[2];
+
+			unsigned c0 = (unsigned)(prod1 >> 32) ^ ctr[1] ^ k0;
+			unsigned c2 = (unsigned)(prod0 >> 32) ^ ctr[3] ^ k1;
+
+			ctr[0] = c0;
+			ctr[1] = (unsigned)prod1;
+			ctr[2] = c2;
+			ctr[3] = (unsigned)prod0;
+
+			k0 += 0x9E3779B9;
+			k1 += 0xBB67AE85;
+		}
+	}
+
+	//random numbers for given index and step : draw as many as needed, in order (stream of blocks of 4 with increasing block counter)
+	class Stream {
+
+	private:
+
+		unsigned key[2];
+
+		//counter : index, block number, step (low and high words)
+		unsigned ctr[4];
+
+		unsigned block[4];
+		int block_pos = 4;
+
+		//radius and angle of the last Box-Muller transform : second value only computed if requested on the next rand_gauss call
+		double bm_r = 0.0, bm_angle = 0.0;
+		bool z1_available = false;
+
+	public:
+
+		Stream(const unsigned key_[2], unsigned index, unsigned long long step, unsigned substream)
+		{
+			key[0] = key_[0]; key[1] = key_[1];
+			ctr[0] = index; ctr[1] = substream << 16; ctr[2] = (unsigned)step; ctr[3] = (unsigned)(step >> 32);
+		}
+
+		//unsigned integer value out : 0 to 2^32 - 1
+		unsigned randi(void)
+		{
+			if (block_pos == 4) {
+
+				for (int i = 0; i < 4; i++) block[i] = ctr[i];
+				philox4x32(block, key);
+				ctr[1]++;
+				block_pos = 0;
+			}
+
+			return block[block_pos++];
+		}
+
+		//floating point value out in interval [0, 1]
+		double rand(void) { return (double)randi() / (unsigned)4294967295; }
+
+		//Box-Muller transform to generate Gaussian distribution from uniform distribution
+		double rand_gauss(double mean, double std)
+		{
+			if (z1_available) {
+
+				z1_available = false;
+				return bm_r * sin(bm_angle) * std + mean;
+			}
+
+			//u1 in (0, 1], so no rejection needed for the logarithm
+			double u1 = ((double)randi() + 1.0) / 4294967296.0;
+			double u2 = (double)randi() / 4294967296.0;
+
+			bm_r = sqrt(-2.0 * log(u1));
+			bm_angle = TWO_PI * u2;
+			z1_available = true;
+
+			return bm_r * cos(bm_angle) * std + mean;
+		}
+
+		//3 Gaussian values returned as a 3-component type (e.g. DBL3) : use this rather than rand_gauss calls in an argument list, whose evaluation order is unspecified
+		template <typename VType>
+		VType rand_gauss3(double mean, double std)
+		{
+			double x = rand_gauss(mean, std);
+			double y = rand_gauss(mean, std);
+			double z = rand_gauss(mean, std);
+
+			return VType(x, y, z);
+		}
+	};
+
+	//stream_id distinguishes generators which share the same seed (e.g. different meshes)
+	BorisCBRand(unsigned seed = 0, unsigned stream_id = 0) { set_seed(seed, stream_id); }
+
+	void set_seed(unsigned seed, unsigned stream_id = 0) { key[0] = seed; key[1] = stream_id; }
+
+	//get stream of random numbers for given index (e.g. cell index) and step
+	//substream can be used to obtain independent streams for the same index and step (each allows up to 2^16 blocks of 4 numbers)
+	Stream stream(unsigned index, unsigned long long step, unsigned substream = 0) const { return Stream(key, index, step, substream); }
+};
@@ -0,0 +1,169 @@
+//Functions for working with binary columnar data files
+
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+//Binary data file format, used for saved simulation data as an alternative to tab-separated text (selected by the file termination).
+//Values are stored as 8 byte floating point numbers with full precision, and files can be appended to by adding more chunks.
+//All values are little endian.
+//
+//Header:
+//BINARYDATAFILE_MAGIC (8 bytes), uint32 version
+//uint32 length, info text (free text, e.g. date and mesh settings)
+//uint32 number of columns, then for each column : uint32 length, label, uint32 length, unit
+//
+//Chunks, any number following the header:
+//BINARYDATAFILE_CHUNK (4 bytes), uint32 rows, uint32 columns, uint32 codec, uint64 payload size in bytes, payload
+//With BINARYDATAFILE_CODEC_RAW the payload is rows * columns values, stored row by row. Chunks with other codecs are skipped by readers which do not support them.
+
+#define BINARYDATAFILE_TERMINATION	".bdat"
+
+#define BINARYDATAFILE_MAGIC		"BORISDAT"
+#define BINARYDATAFILE_VERSION		1
+
+#define BINARYDATAFILE_CHUNK		"CHNK"
+#define BINARYDATAFILE_CODEC_RAW	0
+
+///////////////////////////////////////////////////////////////////////////////
+// AUXILIARY
+
+inline void BinaryDataFile_Write(std::ofstream& bdout, uint32_t value) { bdout.write(reinterpret_cast<const char*>(&value), sizeof(uint32_t)); }
+inline void BinaryDataFile_Write(std::ofstream& bdout, uint64_t value) { bdout.write(reinterpret_cast<const char*>(&value), sizeof(uint64_t)); }
+inline void BinaryDataFile_Write(std::ofstream& bdout, const std::string& text) { BinaryDataFile_Write(bdout, (uint32_t)text.length()); bdout.write(text.data(), text.length()); }
+
+inline bool BinaryDataFile_Read(std::ifstream& bdin, uint32_t& value) { return (bool)bdin.read(reinterpret_cast<char*>(&value), sizeof(uint32_t)); }
+inline bool BinaryDataFile_Read(std::ifstream& bdin, uint64_t& value) { return (bool)bdin.read(reinterpret_cast<char*>(&value), sizeof(uint64_t)); }
+
+inline bool BinaryDataFile_Read(std::ifstream& bdin, std::string& text)
+{
+	uint32_t length;
+	if (!BinaryDataFile_Read(bdin, length)) return false;
+
+	text.resize(length);
+	return (!length || (bool)bdin.read(&text[0], length));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// WRITING
+
+//write header to a new binary data file : info text, then label and unit for each column
+inline bool WriteBinaryDataFileHeader(std::ofstream& bdout, const std::string& info, const std::vector<std::string>& labels, const std::vector<std::string>& units)
+{
+	bdout.write(BINARYDATAFILE_MAGIC, 8);
+	BinaryDataFile_Write(bdout, (uint32_t)BINARYDATAFILE_VERSION);
+
+	BinaryDataFile_Write(bdout, info);
+
+	BinaryDataFile_Write(bdout, (uint32_t)labels.size());
+	for (int idx = 0; idx < labels.size(); idx++) {
+
+		BinaryDataFile_Write(bdout, labels[idx]);
+		BinaryDataFile_Write(bdout, (idx < units.size() ? units[idx] : std::string()));
+	}
+
+	return (bool)bdout;
+}
+
+//write a chunk of rows, each with given number of columns, from values stored row by row
+inline bool WriteBinaryDataFileChunk(std::ofstream& bdout, const double* pvalues, int rows, int columns)
+{
+	uint64_t payload_size = (uint64_t)rows * columns * sizeof(double);
+
+	bdout.write(BINARYDATAFILE_CHUNK, 4);
+	BinaryDataFile_Write(bdout, (uint32_t)rows);
+	BinaryDataFile_Write(bdout, (uint32_t)columns);
+	BinaryDataFile_Write(bdout, (uint32_t)BINARYDATAFILE_CODEC_RAW);
+	BinaryDataFile_Write(bdout, payload_size);
+
+	bdout.write(reinterpret_cast<const char*>(pvalues), payload_size);
+
+	return (bool)bdout;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// READING
+
+//check if given file is a binary data file (from its contents, not termination)
+inline bool IsBinaryDataFile(const std::string& filename)
+{
+	std::ifstream bdin(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!bdin.is_open()) return false;
+
+	char magic[8];
+	if (!bdin.read(magic, 8)) return false;
+
+	return std::string(magic, 8) == BINARYDATAFILE_MAGIC;
+}
+
+//read header of binary data file, leaving bdin at the first chunk : return false if not a binary data file
+inline bool ReadBinaryDataFileHeader(std::ifstream& bdin, std::string& info, std::vector<std::string>& labels, std::vector<std::string>& units)
+{
+	char magic[8];
+	if (!bdin.read(magic, 8) || std::string(magic, 8) != BINARYDATAFILE_MAGIC) return false;
+
+	uint32_t version, columns;
+	if (!BinaryDataFile_Read(bdin, version) || version > BINARYDATAFILE_VERSION) return false;
+
+	if (!BinaryDataFile_Read(bdin, info)) return false;
+	if (!BinaryDataFile_Read(bdin, columns)) return false;
+
+	labels.resize(columns);
+	units.resize(columns);
+
+	for (int idx = 0; idx < columns; idx++) {
+
+		if (!BinaryDataFile_Read(bdin, labels[idx]) || !BinaryDataFile_Read(bdin, units[idx])) return false;
+	}
+
+	return true;
+}
+
+//From given binary data file read specified data columns only and load them in data_cols. Return maximum number of rows read.
+//As for ReadDataColumns, rows which don't have a requested column (e.g. appended after the saved data configuration changed) don't contribute to it.
+inline int ReadBinaryDataColumns(const std::string& filename, std::vector<std::vector<double>>& data_cols, const std::vector<int>& cols)
+{
+	data_cols.resize(0);
+	data_cols.resize(cols.size());
+
+	std::ifstream bdin(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!bdin.is_open()) return 0;
+
+	std::string info;
+	std::vector<std::string> labels, units;
+	if (!ReadBinaryDataFileHeader(bdin, info, labels, units)) return 0;
+
+	std::vector<double> values;
+
+	while (true) {
+
+		char marker[4];
+		uint32_t rows, columns, codec;
+		uint64_t payload_size;
+
+		if (!bdin.read(marker, 4) || std::string(marker, 4) != BINARYDATAFILE_CHUNK) break;
+		if (!BinaryDataFile_Read(bdin, rows) || !BinaryDataFile_Read(bdin, columns) || !BinaryDataFile_Read(bdin, codec) || !BinaryDataFile_Read(bdin, payload_size)) break;
+
+		if (codec != BINARYDATAFILE_CODEC_RAW || payload_size != (uint64_t)rows * columns * sizeof(double)) {
+
+			bdin.seekg(payload_size, std::ios::cur);
+			continue;
+		}
+
+		values.resize((size_t)rows * columns);
+		//incomplete chunk (e.g. file still being written) : stop here
+		if (payload_size && !bdin.read(reinterpret_cast<char*>(values.data()), payload_size)) break;
+
+		for (int idx = 0; idx < (int)cols.size(); idx++) {
+
+			if (cols[idx] < 0 || cols[idx] >= columns) continue;
+
+			for (int row = 0; row < rows; row++) data_cols[idx].push_back(values[(size_t)row * columns + cols[idx]]);
+		}
+	}
+
+	return (cols.size() ? (int)data_cols[0].size() : 0);
+}
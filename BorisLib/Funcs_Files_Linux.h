@@ -8,6 +8,9 @@
 #include <pwd.h>
 //#include <filesystem>
 #include <limits.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
 #include <X11/Xlib.h>
 #include "Funcs_Files.h"
 
@@ -36,13 +39,45 @@ inline std::string GetExeDirectory(void)
 }
 
 //return all files sharing the given base (in specified directory) and termination. Return them ordered (including full path) by creation time
+//(on Linux creation time is not generally available so last modification time is used instead)
 inline std::vector<std::string> GetFilesInDirectory(std::string directory, std::string baseFileName, std::string termination)
 {
-	std::vector<std::string> fileNames;
-	std::vector<double> creationTimes;
+	std::vector<std::pair<std::string, double>> fileNames_creationTimes;
 
-	//TO DO
+	DIR* pDir = opendir(directory.c_str());
+	if (!pDir) return {};
+
+	struct dirent* pEntry;
+	while ((pEntry = readdir(pDir)) != nullptr) {
+
+		std::string fileName = std::string(pEntry->d_name);
+
+		//only get file names, not directories
+		struct stat file_stat;
+		if (stat((directory + fileName).c_str(), &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) continue;
+
+		//if filename including termination is too short then skip it
+		if (fileName.length() < termination.length() || fileName.length() < baseFileName.length()) continue;
+
+		//if basefile name is specified then it must match that of the file (the beggining of the file name)
+		if (baseFileName.length() && fileName.substr(0, baseFileName.length()).compare(baseFileName) != 0) continue;
 
+		//if termination is specified then it must match that of the file (the ending of the file name)
+		if (termination.length() && fileName.substr(fileName.length() - termination.length()).compare(termination) != 0) continue;
+
+		fileNames_creationTimes.push_back({ directory + fileName, (double)file_stat.st_mtim.tv_sec + (double)file_stat.st_mtim.tv_nsec * 1e-9 });
+	}
+
+	closedir(pDir);
+
+	auto compare = [&](const std::pair<std::string, double>& first, const std::pair<std::string, double>& second) -> bool { return first.second < second.second; };
+
+	//sort by creation time order
+	std::sort(fileNames_creationTimes.begin(), fileNames_creationTimes.end(), compare);
+
+	//extract and return fileNames only
+	std::vector<std::string> fileNames(fileNames_creationTimes.size());
+	std::transform(fileNames_creationTimes.begin(), fileNames_creationTimes.end(), fileNames.begin(), [](auto const& pair) { return pair.first; });
 	return fileNames;
 }
 
@@ -82,11 +117,14 @@ inline std::string GetUserDocumentsPath(void)
 
 inline bool MakeDirectory(std::string directory)
 {
-	//available in C++17
-	//std::filesystem::create_directories(directory);
+	//create all directories along the path in turn (equivalent of std::filesystem::create_directories)
+	for (size_t pos = directory.find('/', 1); pos != std::string::npos; pos = directory.find('/', pos + 1)) {
+
+		mkdir(directory.substr(0, pos).c_str(), 0755);
+	}
 
-	//TO DO: check if directory already exists and return true; for all other errors return false
-	return true;
+	if (mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST) return true;
+	else return false;
 }
 
 //This function has been adapted from : https://stackoverflow.com/questions/27378318/c-get-std::string-from-clipboard-on-linux
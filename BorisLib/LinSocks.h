@@ -5,23 +5,31 @@
 
 #include <string.h>
 #include <vector>
+#include <map>
 #include <thread>
 #include <chrono>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <netinet/tcp.h>
+
+#include "NetSocks_Protocol.h"
 
 #define DEFAULT_BUFLEN 1048576
 #define DEFAULT_PORT "1542"
 
-//Used for non-blocking calls to recv : after each call sleep this number of ms to avoid hogging too much CPU time 
-//Calling recv too often will put a slight load on one of the CPU cores which can affect parallelized computations
+//The server waits for network events (new connections, incoming data) with epoll, so messages are picked up as soon as they arrive.
+//Listen returns to the caller if nothing happens within the wait time below, so the calling thread can be stopped.
 
-//receive commands from client sleep
+//maximum time to wait for network events (ms)
 #define RECVSLEEPMS		5
 //error - make listen socket sleep
 #define SERRSLEEPMS		500
 //accept new client sleep
 #define ACPTSLEEPMS		200
+//maximum number of events handled per wait
+#define MAXEVENTS		16
 
 //see https://www.bogotobogo.com/cplusplus/sockets_server_client.php
 
@@ -36,8 +44,16 @@ class NetSocks {
 private:
 
 	int ListenSocket;
+
+	//epoll instance watching the listen socket and all client sockets
+	int EpollSocket;
+
+	//client which sent the last message : replies go to this client
     int ClientSocket;
 
+	//all connected clients, each with its own receive state. Clients using the framed protocol keep their connection open and can pipeline messages.
+	std::map<int, NetSocksConnection> clients;
+
 	//receive buffer and length
     char *recvbuf;
     int recvbuflen;
@@ -49,6 +65,10 @@ private:
 	//commands processed by Simulation may return parameters. These are placed in this std::vector to be sent to Client in NetSocks thread
 	std::vector<std::string> dataParams;
 
+	//alternatively commands can return a large array of values : these are sent as a typed buffer to framed clients (and as text to legacy clients)
+	std::vector<double> dataBuffer;
+	int dataBuffer_components = 0;
+
 	//the last received message
 	std::string last_message;
 
@@ -63,6 +83,23 @@ private:
 	//Make non-blocking listen socket on DEFAULT_PORT to accept incoming connections - done in the constructor
 	void MakeListenSocket(void);
 
+	//close all sockets (clients, listen socket, epoll)
+	void CloseSockets(void);
+
+	//accept all pending connections on the listen socket
+	void AcceptClients(void);
+
+	//read all available data from given client into its receive state : return false if connection was closed
+	bool ReceiveFromClient(int socket);
+
+	void CloseClient(int socket);
+
+	//get the next complete message from any client, setting it as the client to reply to
+	bool NextMessage(std::string& message);
+
+	//send all of message to client (socket is non-blocking so wait if the send buffer fills up)
+	bool SendAll(int socket, const std::string& message);
+
 public:
 
 	NetSocks(std::string port = DEFAULT_PORT, int recvsleepms = RECVSLEEPMS, int buffer_size = DEFAULT_BUFLEN);
@@ -77,11 +114,14 @@ public:
 	//Non-blocking call to Listen for incoming messages - return message when received
 	std::string Listen(void);
 
-	//set data to be sent to client - not intended to send massive amounts of data, e.g. shouldn't use it to send the entire mesh data
+	//set data to be sent to client
 	//SetSendData just loads values in dataParams std::vector whilst the SendDataParams actually sends data
 	void SetSendData(const std::vector<std::string>& newdataParams);
 	void SetSendData(std::vector<std::string>&& newdataParams);
 
+	//set a large array of values to be sent to client (components is the number of components per element, e.g. 3 for vector quantities)
+	void SetSendData_Buffer(const std::vector<double>& newdataBuffer, int components = 1);
+
 	//send prepared data to client
 	void SendDataParams(void);
 
@@ -111,38 +151,38 @@ inline NetSocks::NetSocks(std::string port, int recvsleepms, int buffer_size)
 
 inline NetSocks::~NetSocks() 
 {
-	if (clientConnected) {
-
-		// shutdown the connection since we're done
-		shutdown(ClientSocket, SHUT_RDWR);
-		close(ClientSocket);
-	}
-
-	if (listenSocketActive) {
-
-		close(ListenSocket);
-	}
+	CloseSockets();
 	
-	delete recvbuf;
+	delete[] recvbuf;
 }
 
 inline void NetSocks::Change_Port(std::string port)
 {
 	server_port = port;
 
-	if (clientConnected) {
+	CloseSockets();
+
+	MakeListenSocket();
+}
+
+inline void NetSocks::CloseSockets(void)
+{
+	for (auto& client : clients) {
 
 		// shutdown the connection since we're done
-		shutdown(ClientSocket, SHUT_RDWR);
-		close(ClientSocket);
+		shutdown(client.first, SHUT_RDWR);
+		close(client.first);
 	}
 
+	clients.clear();
+	clientConnected = false;
+
 	if (listenSocketActive) {
 
 		close(ListenSocket);
+		close(EpollSocket);
+		listenSocketActive = false;
 	}
-
-	MakeListenSocket();
 }
 
 inline void NetSocks::MakeListenSocket(void) 
@@ -151,6 +191,7 @@ inline void NetSocks::MakeListenSocket(void)
 	listenSocketActive = false;
 
 	ListenSocket = -1;
+	EpollSocket = -1;
 	ClientSocket = -1;
 
 	int portno = atoi(server_port.c_str());
@@ -187,118 +228,217 @@ inline void NetSocks::MakeListenSocket(void)
 	//Set ListenSocket as non-blocking 
 	fcntl(ListenSocket, F_SETFL, O_NONBLOCK);
 
-	listenSocketActive = true;
-}
+	//all sockets are watched with epoll
+	EpollSocket = epoll_create1(0);
+	if (EpollSocket < 0) {
 
-inline std::string NetSocks::Listen(void) 
-{	
-	if (!listenSocketActive) { 
-		
-		std::this_thread::sleep_for(std::chrono::milliseconds(SERRSLEEPMS)); 
-		MakeListenSocket(); 
-		return ""; 
+		//error
+		close(ListenSocket);
+		return;
 	}
 
-	if (!clientConnected) {
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = ListenSocket;
+	epoll_ctl(EpollSocket, EPOLL_CTL_ADD, ListenSocket, &event);
+
+	listenSocketActive = true;
+}
+
+inline void NetSocks::AcceptClients(void)
+{
+	while (true) {
 
 		struct sockaddr_in cli_addr;
 
 		// The accept() call actually accepts an incoming connection
-     	socklen_t clilen = sizeof(cli_addr);
+		socklen_t clilen = sizeof(cli_addr);
+
+		int socket = accept(ListenSocket, (struct sockaddr *) &cli_addr, &clilen);
+		if (socket < 0) break;
 
-     	ClientSocket = accept(ListenSocket, (struct sockaddr *) &cli_addr, &clilen);
+		//Set client socket as non-blocking
+		fcntl(socket, F_SETFL, O_NONBLOCK);
+
+		//replies are small and latency matters more than throughput
+		int option = 1;
+		setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &option, sizeof(option));
+
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.fd = socket;
+		epoll_ctl(EpollSocket, EPOLL_CTL_ADD, socket, &event);
+
+		clients[socket] = NetSocksConnection();
+	}
+}
+
+inline bool NetSocks::ReceiveFromClient(int socket)
+{
+	while (true) {
 
-		if (ClientSocket < 0) {
-			 
-			std::this_thread::sleep_for(std::chrono::milliseconds(ACPTSLEEPMS));
-			return "";
+		int iResult = read(socket, recvbuf, recvbuflen);
+
+		//Client connection was closed
+		if (iResult == 0) return false;
+
+		if (iResult < 0) {
+
+			//EWOULDBLOCK is issued for non-blocking sockets when all data has been read, but respond to all other errors
+			return (errno == EWOULDBLOCK || errno == EAGAIN);
 		}
-		else {
 
-			//Set ClientSocket as non-blocking
-			fcntl(ClientSocket, F_SETFL, O_NONBLOCK);
+		clients[socket].recv_data.append(recvbuf, iResult);
+	}
+}
+
+inline void NetSocks::CloseClient(int socket)
+{
+	epoll_ctl(EpollSocket, EPOLL_CTL_DEL, socket, nullptr);
+
+	// Shutdown our socket
+	shutdown(socket, SHUT_RDWR);
+	close(socket);
+
+	clients.erase(socket);
+
+	if (socket == ClientSocket) clientConnected = false;
+}
+
+inline bool NetSocks::NextMessage(std::string& message)
+{
+	for (auto& client : clients) {
+
+		if (client.second.next_message(message)) {
 
-			//mark new client connection established
+			ClientSocket = client.first;
 			clientConnected = true;
+			return true;
 		}
 	}
 
-	//client is connected : listen for message
-	int iResult = read(ClientSocket, recvbuf, recvbuflen);
-	
-	if (iResult == 0) {
-			
-		//Client connection was closed
-		close(ClientSocket);
-		clientConnected = false;
-		return "";
+	return false;
+}
+
+inline std::string NetSocks::Listen(void) 
+{	
+	if (!listenSocketActive) { 
+		
+		std::this_thread::sleep_for(std::chrono::milliseconds(SERRSLEEPMS)); 
+		MakeListenSocket(); 
+		return ""; 
 	}
 
-	//EWOULDBLOCK is issued for non-blocking sockets so ignore it, but respond to all other errors
-	if (errno && errno != EWOULDBLOCK) {
+	//messages already received (pipelined by a client) are handled first, otherwise wait for network events
+	if (!NextMessage(last_message)) {
 
-		//error
-		// Shutdown our socket
-		shutdown(ClientSocket, SHUT_RDWR);
-		close(ClientSocket);
-		clientConnected = false;
-		return "";
-	}
+		struct epoll_event events[MAXEVENTS];
 
-	//all good, return the received message
-	if (iResult > 0) {
+		int num_events = epoll_wait(EpollSocket, events, MAXEVENTS, server_recvsleepms);
 
-		//received message, return it to be processed after password check
-		last_message = std::string(recvbuf).substr(0, iResult);
+		for (int idx = 0; idx < num_events; idx++) {
 
-		if (last_message.length() > password.length()) {
+			int socket = events[idx].data.fd;
 
-			if (last_message.substr(0, password.length()) == password) return last_message.substr(password.length());
+			if (socket == ListenSocket) AcceptClients();
+			else if (!ReceiveFromClient(socket)) {
+
+				//connection closed or error : any complete messages already received are dropped as there's nobody to reply to
+				CloseClient(socket);
+			}
 		}
 
-		//failed password check
-		return "";
+		if (!NextMessage(last_message)) return "";
 	}
 
-	//sleep before calling the non-blocking recv function (client socket is not blocking)
-	std::this_thread::sleep_for(std::chrono::milliseconds(RECVSLEEPMS));
+	//received message, return it to be processed after password check
+	if (last_message.length() > password.length()) {
 
+		if (last_message.substr(0, password.length()) == password) return last_message.substr(password.length());
+	}
+
+	//failed password check
 	return "";
 }
 
 inline void NetSocks::SetSendData(const std::vector<std::string>& newdataParams) 
 {
 	dataParams = newdataParams;
+	dataBuffer.clear();
+	dataBuffer_components = 0;
 }
 
 inline void NetSocks::SetSendData(std::vector<std::string>&& newdataParams) 
 {
 	dataParams = move(newdataParams);
+	dataBuffer.clear();
+	dataBuffer_components = 0;
+}
+
+inline void NetSocks::SetSendData_Buffer(const std::vector<double>& newdataBuffer, int components)
+{
+	dataParams.clear();
+	dataBuffer = newdataBuffer;
+	dataBuffer_components = components;
+}
+
+inline bool NetSocks::SendAll(int socket, const std::string& message)
+{
+	size_t sent = 0;
+
+	while (sent < message.length()) {
+
+		int iSendResult = send(socket, message.c_str() + sent, message.length() - sent, MSG_NOSIGNAL);
+
+		if (iSendResult < 0) {
+
+			if (errno != EWOULDBLOCK && errno != EAGAIN) return false;
+
+			//send buffer full : wait until it can accept more data
+			struct pollfd pfd = { socket, POLLOUT, 0 };
+			if (poll(&pfd, 1, ACPTSLEEPMS) < 0) return false;
+		}
+		else sent += iSendResult;
+	}
+
+	return true;
 }
 
 inline void NetSocks::SendDataParams(void) 
 {
 	if (clientConnected) {
 
-		//form message std::string : tab value tab value tab value etc. If no values then just a tab
-		std::string message = GetDataParams_String();
+		auto client = clients.find(ClientSocket);
+
+		std::string message;
+
+		//framed clients get a frame, with typed buffers sent as raw values. Legacy clients get the text message : tab value tab value tab value etc. If no values then just a tab
+		if (client != clients.end() && client->second.framed == 1) {
+
+			if (dataBuffer_components && dataParams.empty()) message = NetSocks_MakeFrame(NetSocks_MakeBufferPayload(dataBuffer, dataBuffer_components));
+			else message = NetSocks_MakeFrame(GetDataParams_String());
+		}
+		else message = GetDataParams_String();
 
 		//message client
-		int iSendResult = send(ClientSocket, message.c_str(), (int)message.length(), 0);
-		if (iSendResult < 0) {
+		if (!SendAll(ClientSocket, message)) {
 			
 			//error
-			return;
+			CloseClient(ClientSocket);
 		}
 	}
 
-	//done so reset std::vector to zero size
+	//done so reset to zero size
 	dataParams.resize(0);
+	dataBuffer.clear();
+	dataBuffer_components = 0;
 }
 
 //get prepare data as a string (this is the string which SendDataParams will send)
 inline std::string NetSocks::GetDataParams_String(void)
 {
+	if (dataBuffer_components && dataParams.empty()) return NetSocks_MakeBufferText(dataBuffer);
+
 	//form message std::string : tab value tab value tab value etc. If no values then just a tab
 	std::stringstream ss;
 
@@ -319,7 +459,7 @@ inline void NetSocks::SignalClientError(std::string message)
 	dataParams.push_back(message);
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+//Framed scripting protocol used by the NetSocks server (WinSocks.h / LinSocks.h) and the Python client (NetSocks.py).
+//
+//Legacy clients open a connection per command and send the bare message (password followed by the command, which starts with '*' or '>'); the reply is the bare tab-separated text.
+//Framed clients keep the connection open and may send several frames back-to-back (pipelining) : replies are returned in the same order.
+//
+//Client frame : NETSOCKS_FRAME_MARKER, uint32 payload length (little endian), payload (password followed by the command, as for legacy messages).
+//Server frame : NETSOCKS_FRAME_MARKER, uint32 payload length (little endian), payload, where payload is either :
+//	1) text : tab-separated values, always starting with a tab (same as legacy replies)
+//	2) typed buffer : NETSOCKS_BUFFER_MARKER, type character ('d' : 8 byte floating point), uint32 number of components per element, raw little-endian values
+//
+//The first byte received on a connection decides if it's a framed or a legacy client (the frame marker cannot start a password or command).
+
+#define NETSOCKS_FRAME_MARKER	'\x01'
+#define NETSOCKS_BUFFER_MARKER	'\x02'
+
+//marker byte followed by uint32 length
+#define NETSOCKS_FRAME_HEADER	5
+
+//state kept for each connected client
+struct NetSocksConnection {
+
+	//received bytes not yet returned as messages
+	std::string recv_data;
+
+	//-1 : not yet known, 0 : legacy client, 1 : framed client
+	int framed = -1;
+
+	//extract the next complete message from recv_data : return false if none available yet
+	bool next_message(std::string& message)
+	{
+		if (!recv_data.length()) return false;
+
+		if (framed < 0) framed = (recv_data[0] == NETSOCKS_FRAME_MARKER);
+
+		if (!framed) {
+
+			//legacy client : everything received is the message
+			message = recv_data;
+			recv_data.clear();
+			return true;
+		}
+
+		if (recv_data.length() < NETSOCKS_FRAME_HEADER) return false;
+
+		size_t length = 0;
+		for (int byte = 0; byte < 4; byte++) length |= (size_t)(unsigned char)recv_data[1 + byte] << (8 * byte);
+
+		if (recv_data.length() < NETSOCKS_FRAME_HEADER + length) return false;
+
+		message = recv_data.substr(NETSOCKS_FRAME_HEADER, length);
+		recv_data.erase(0, NETSOCKS_FRAME_HEADER + length);
+
+		return true;
+	}
+};
+
+//make a frame from given payload
+inline std::string NetSocks_MakeFrame(const std::string& payload)
+{
+	std::string frame(NETSOCKS_FRAME_HEADER, NETSOCKS_FRAME_MARKER);
+
+	size_t length = payload.length();
+	for (int byte = 0; byte < 4; byte++) frame[1 + byte] = (char)((length >> (8 * byte)) & 0xFF);
+
+	return frame + payload;
+}
+
+//make a typed buffer payload from values (components is the number of components per element, e.g. 3 for a vector quantity)
+inline std::string NetSocks_MakeBufferPayload(const std::vector<double>& values, int components)
+{
+	std::string payload(6, NETSOCKS_BUFFER_MARKER);
+	payload[1] = 'd';
+	for (int byte = 0; byte < 4; byte++) payload[2 + byte] = (char)((components >> (8 * byte)) & 0xFF);
+
+	//all supported platforms are little endian, so raw values can be copied in one go
+	payload.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+
+	return payload;
+}
+
+//text form of a typed buffer, as used for legacy clients and the embedded Python module : tab value tab value etc.
+inline std::string NetSocks_MakeBufferText(const std::vector<double>& values)
+{
+	std::stringstream ss;
+	ss.precision(17);
+
+	if (!values.size()) ss << "\t";
+	for (int idx = 0; idx < values.size(); idx++) ss << "\t" << values[idx];
+
+	return ss.str();
+}
@@ -1070,4 +1070,25 @@ public:
 	{
 		return eq_component_3.evaluate(bvars...);
 	}
+
+	/////////////////////////////////////////////////////////
+	//
+	// BATCH EVALUATION
+
+	//Evaluate equation for num points in one call, much faster than calling evaluate for each point. 
+	//Each user variable is given either as an array of num values, or as a single value used for all points, e.g. evaluate_many(n, x_values, y, z, t, out) with x_values an array.
+
+	//evaluate scalar equation, setting num values in pout
+	void evaluate_many(int num, EqComp::BVarBatch_t<BVarType>... bvars, double* pout) const
+	{
+		eq_component_1.evaluate_many(num, bvars..., pout, 1);
+	}
+
+	//evaluate vector equation, setting num values in pout
+	void evaluate_vector_many(int num, EqComp::BVarBatch_t<BVarType>... bvars, DBL3* pout) const
+	{
+		eq_component_1.evaluate_many(num, bvars..., &pout[0].x, 3);
+		eq_component_2.evaluate_many(num, bvars..., &pout[0].y, 3);
+		eq_component_3.evaluate_many(num, bvars..., &pout[0].z, 3);
+	}
 };
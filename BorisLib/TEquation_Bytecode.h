@@ -0,0 +1,483 @@
+#pragma once
+
+#include "TEquation_FSPEC.h"
+
+#include "Funcs_Math.h"
+#include "Obj_Math_Special.h"
+
+#include <vector>
+#include <memory>
+
+namespace EqComp {
+
+	//values of a user variable for batch evaluation : either an array with one value per point, or a single value used for all points
+	struct BVarBatch {
+
+		const double* pvalues = nullptr;
+		double value = 0.0;
+
+		BVarBatch(const double* pvalues_) :
+			pvalues(pvalues_)
+		{}
+
+		BVarBatch(double value_) :
+			value(value_)
+		{}
+
+		double get(int idx) const { return (pvalues ? pvalues[idx] : value); }
+	};
+
+	//used to expand a BVarType parameter pack into BVarBatch parameters
+	template <typename BVar>
+	using BVarBatch_t = BVarBatch;
+
+	//Equation component compiled from its logical representation (FSPEC branches) into a flat list of instructions working on registers, one register per branch.
+	//Instructions are in branch order, so operands of binary operators are always ready when needed; unary functions act in-place on the register of their branch.
+	//Sub-expressions which don't depend on user variables are folded into constants when compiling.
+	//Each instruction computes exactly what the corresponding Function object computes, so results are the same as for the Function objects tree.
+	class Bytecode {
+
+	public:
+
+		//maximum number of registers for scalar evaluation (registers kept on the stack) : larger equations should be evaluated with the Function objects
+		static const int max_scalar_registers = 32;
+
+		//number of points evaluated together in batch evaluation : each instruction is applied to all points in a batch before moving to the next one
+		static const int batch_size = 64;
+
+	private:
+
+		struct Instruction {
+
+			FUNC_ type = FUNC_CONST;
+
+			//destination and source registers (sources only used by binary operators, unary functions work in-place on dst)
+			int dst = 0, src1 = 0, src2 = 0;
+
+			//user variable index for FUNC_BVAR
+			int varlevel = 0;
+
+			double param = 1.0;
+			double base_or_exponent = 0.0;
+		};
+
+		std::vector<Instruction> code;
+
+		int num_registers = 0;
+		int result_register = 0;
+
+		bool compiled = false;
+
+		//the whole equation folded to a constant
+		bool is_constant = false;
+		double constant_value = 0.0;
+
+		//special functions, indexed by special_index
+		std::shared_ptr<Funcs_Special> pSpecial[8];
+
+	private:
+
+		static bool is_binary(FUNC_ type) { return (type >= FUNC_POW && type <= FUNC_ADD_PMUL); }
+
+		//index in pSpecial for special functions, -1 if not a special function
+		static int special_index(FUNC_ type)
+		{
+			switch (type) {
+
+			case FUNC_CURIEWEISS: case FUNC_CURIEWEISS_PMUL: return 0;
+			case FUNC_CURIEWEISS1: case FUNC_CURIEWEISS1_PMUL: return 1;
+			case FUNC_CURIEWEISS2: case FUNC_CURIEWEISS2_PMUL: return 2;
+			case FUNC_LONGRELSUS: case FUNC_LONGRELSUS_PMUL: return 3;
+			case FUNC_LONGRELSUS1: case FUNC_LONGRELSUS1_PMUL: return 4;
+			case FUNC_LONGRELSUS2: case FUNC_LONGRELSUS2_PMUL: return 5;
+			case FUNC_ALPHA1: case FUNC_ALPHA1_PMUL: return 6;
+			case FUNC_ALPHA2: case FUNC_ALPHA2_PMUL: return 7;
+			default: return -1;
+			}
+		}
+
+		//binary operators, as in Function
+		static double binary(const Instruction& ins, double a, double b)
+		{
+			switch (ins.type) {
+
+			case FUNC_ADD: return a + b;
+			case FUNC_ADD_PMUL: return ins.param * (a + b);
+			case FUNC_SUB: return a - b;
+			case FUNC_SUB_PMUL: return ins.param * (a - b);
+			case FUNC_MUL: return a * b;
+			case FUNC_MUL_PMUL: return ins.param * a * b;
+			case FUNC_DIV: return a / b;
+			case FUNC_DIV_PMUL: return ins.param * (a / b);
+			case FUNC_POW: return pow(a, b);
+			case FUNC_POW_PMUL: return ins.param * pow(a, b);
+			default: return 0.0;
+			}
+		}
+
+		//unary and special functions, as in Function
+		double unary(const Instruction& ins, double arg) const
+		{
+			switch (ins.type) {
+
+			case FUNC_SIN: return sin(arg);
+			case FUNC_SIN_PMUL: return ins.param * sin(arg);
+			case FUNC_SINC: return (arg ? sin(arg) / arg : 1.0);
+			case FUNC_SINC_PMUL: return (arg ? ins.param * sin(arg) / arg : ins.param);
+			case FUNC_COS: return cos(arg);
+			case FUNC_COS_PMUL: return ins.param * cos(arg);
+			case FUNC_TAN: return tan(arg);
+			case FUNC_TAN_PMUL: return ins.param * tan(arg);
+			case FUNC_SINH: return sinh(arg);
+			case FUNC_SINH_PMUL: return ins.param * sinh(arg);
+			case FUNC_COSH: return cosh(arg);
+			case FUNC_COSH_PMUL: return ins.param * cosh(arg);
+			case FUNC_TANH: return tanh(arg);
+			case FUNC_TANH_PMUL: return ins.param * tanh(arg);
+			case FUNC_SQRT: return sqrt(arg);
+			case FUNC_SQRT_PMUL: return ins.param * sqrt(arg);
+			case FUNC_EXP: return exp(arg);
+			case FUNC_EXP_PMUL: return ins.param * exp(arg);
+			case FUNC_ASIN: return asin(arg);
+			case FUNC_ASIN_PMUL: return ins.param * asin(arg);
+			case FUNC_ACOS: return acos(arg);
+			case FUNC_ACOS_PMUL: return ins.param * acos(arg);
+			case FUNC_ATAN: return atan(arg);
+			case FUNC_ATAN_PMUL: return ins.param * atan(arg);
+			case FUNC_ASINH: return asinh(arg);
+			case FUNC_ASINH_PMUL: return ins.param * asinh(arg);
+			case FUNC_ACOSH: return acosh(arg);
+			case FUNC_ACOSH_PMUL: return ins.param * acosh(arg);
+			case FUNC_ATANH: return atanh(arg);
+			case FUNC_ATANH_PMUL: return ins.param * atanh(arg);
+			case FUNC_LN: return log(arg);
+			case FUNC_LN_PMUL: return ins.param * log(arg);
+			case FUNC_LOG: return log10(arg);
+			case FUNC_LOG_PMUL: return ins.param * log10(arg);
+			case FUNC_ABS: return fabs(arg);
+			case FUNC_ABS_PMUL: return ins.param * fabs(arg);
+			case FUNC_SGN: return get_sign(arg);
+			case FUNC_SGN_PMUL: return ins.param * get_sign(arg);
+			case FUNC_CEIL: return ceil(arg);
+			case FUNC_CEIL_PMUL: return ins.param * ceil(arg);
+			case FUNC_FLOOR: return floor(arg);
+			case FUNC_FLOOR_PMUL: return ins.param * floor(arg);
+			case FUNC_ROUND: return round(arg);
+			case FUNC_ROUND_PMUL: return ins.param * round(arg);
+			case FUNC_STEP: return (arg < 0 ? 0.0 : 1.0);
+			case FUNC_STEP_PMUL: return (arg < 0 ? 0.0 : ins.param);
+
+			case FUNC_SWAV:
+			case FUNC_SWAV_PMUL:
+				return ins.param * (-2 * (((int)floor(fabs(arg) / PI) + (get_sign(arg) < 0)) % 2) + 1);
+
+			case FUNC_TWAV:
+				if ((int)floor(fabs(arg) / PI) % 2) return (2 * fmod(fabs(arg), PI) / PI - 1);
+				else return (1 - 2 * fmod(fabs(arg), PI) / PI);
+
+			case FUNC_TWAV_PMUL:
+				if ((int)floor(fabs(arg) / PI) % 2) return ins.param * (2 * fmod(fabs(arg), PI) / PI - 1);
+				else return ins.param * (1 - 2 * fmod(fabs(arg), PI) / PI);
+
+			case FUNC_POWER_EXPCONST: return pow(arg, ins.base_or_exponent);
+			case FUNC_POWER_EXPCONST_PMUL: return ins.param * pow(arg, ins.base_or_exponent);
+			case FUNC_POWER_BASECONST: return pow(ins.base_or_exponent, arg);
+			case FUNC_POWER_BASECONST_PMUL: return ins.param * pow(ins.base_or_exponent, arg);
+
+			//special functions : value if not set is 1 for Curie-Weiss and damping scaling, 0 for susceptibilities
+			case FUNC_CURIEWEISS: case FUNC_CURIEWEISS1: case FUNC_CURIEWEISS2: case FUNC_ALPHA1: case FUNC_ALPHA2:
+				return (pSpecial[special_index(ins.type)] ? pSpecial[special_index(ins.type)]->evaluate(arg) : 1.0);
+
+			case FUNC_CURIEWEISS_PMUL: case FUNC_CURIEWEISS1_PMUL: case FUNC_CURIEWEISS2_PMUL: case FUNC_ALPHA1_PMUL: case FUNC_ALPHA2_PMUL:
+				return (pSpecial[special_index(ins.type)] ? ins.param * pSpecial[special_index(ins.type)]->evaluate(arg) : 1.0);
+
+			case FUNC_LONGRELSUS: case FUNC_LONGRELSUS1: case FUNC_LONGRELSUS2:
+				return (pSpecial[special_index(ins.type)] ? pSpecial[special_index(ins.type)]->evaluate(arg) : 0.0);
+
+			case FUNC_LONGRELSUS_PMUL: case FUNC_LONGRELSUS1_PMUL: case FUNC_LONGRELSUS2_PMUL:
+				return (pSpecial[special_index(ins.type)] ? ins.param * pSpecial[special_index(ins.type)]->evaluate(arg) : 0.0);
+
+			default: return 0.0;
+			}
+		}
+
+	public:
+
+		Bytecode(void) {}
+
+		//-------------------------------------------- COMPILE
+
+		void clear(void)
+		{
+			code.clear();
+			num_registers = 0;
+			result_register = 0;
+			compiled = false;
+			is_constant = false;
+			constant_value = 0.0;
+
+			for (int idx = 0; idx < 8; idx++) pSpecial[idx] = nullptr;
+		}
+
+		//compile from logical representation, as used to make the Function objects (see Equation_Component::make). Return false if not possible, in which case the Function objects must be used.
+		bool compile(const std::vector<std::vector<FSPEC>>& eq_fspec)
+		{
+			clear();
+
+			if (!eq_fspec.size()) return false;
+
+			num_registers = eq_fspec.size();
+			result_register = num_registers - 1;
+
+			//registers holding constants not yet loaded with an instruction (folded)
+			std::vector<bool> reg_const(num_registers, false);
+			std::vector<double> reg_value(num_registers, 0.0);
+			std::vector<bool> reg_loaded(num_registers, false);
+
+			//constant register used as operand by an instruction : must be loaded first
+			auto load_constant = [&](int reg) {
+
+				if (reg_const[reg] && !reg_loaded[reg]) {
+
+					Instruction ins;
+					ins.type = FUNC_CONST;
+					ins.dst = reg;
+					ins.param = reg_value[reg];
+					code.push_back(ins);
+
+					reg_loaded[reg] = true;
+				}
+			};
+
+			for (int idx = 0; idx < eq_fspec.size(); idx++) {
+
+				if (!eq_fspec[idx].size()) return false;
+
+				const FSPEC& fspec = eq_fspec[idx][0];
+
+				Instruction ins;
+				ins.type = fspec.type;
+				ins.dst = idx;
+				ins.varlevel = fspec.varlevel;
+				ins.param = fspec.param;
+				ins.base_or_exponent = fspec.base_or_exponent;
+
+				//1. start of branch : binary operator combining previous branches, or basis function
+				if (fspec.is_binary_operator()) {
+
+					if (fspec.bin_idx1 >= idx || fspec.bin_idx2 >= idx || fspec.bin_idx1 < 0 || fspec.bin_idx2 < 0) return false;
+
+					ins.src1 = fspec.bin_idx1;
+					ins.src2 = fspec.bin_idx2;
+
+					if (reg_const[ins.src1] && reg_const[ins.src2]) {
+
+						reg_const[idx] = true;
+						reg_value[idx] = binary(ins, reg_value[ins.src1], reg_value[ins.src2]);
+					}
+					else {
+
+						load_constant(ins.src1);
+						load_constant(ins.src2);
+						code.push_back(ins);
+					}
+				}
+				else if (fspec.type == FUNC_CONST) {
+
+					reg_const[idx] = true;
+					reg_value[idx] = fspec.param;
+				}
+				else if (fspec.type == FUNC_BVAR || fspec.type == FUNC_BVAR_PMUL) {
+
+					code.push_back(ins);
+				}
+				//branches must start with a basis function or binary operator
+				else return false;
+
+				//2. unary functions applied in turn to the branch
+				for (int idx_tree = 1; idx_tree < eq_fspec[idx].size(); idx_tree++) {
+
+					const FSPEC& fspec_unary = eq_fspec[idx][idx_tree];
+
+					if (!fspec_unary.is_unary_function()) return false;
+
+					Instruction ins_unary;
+					ins_unary.type = fspec_unary.type;
+					ins_unary.dst = idx;
+					ins_unary.param = fspec_unary.param;
+					ins_unary.base_or_exponent = fspec_unary.base_or_exponent;
+
+					//special functions are not folded since they can be set after compiling
+					if (reg_const[idx] && special_index(ins_unary.type) < 0) {
+
+						reg_value[idx] = unary(ins_unary, reg_value[idx]);
+					}
+					else {
+
+						load_constant(idx);
+						reg_const[idx] = false;
+						code.push_back(ins_unary);
+					}
+				}
+			}
+
+			if (reg_const[result_register]) {
+
+				is_constant = true;
+				constant_value = reg_value[result_register];
+			}
+
+			compiled = true;
+
+			return true;
+		}
+
+		void Set_SpecialFunction(FUNC_ type, std::shared_ptr<Funcs_Special> pSpecialFunc)
+		{
+			int sidx = special_index(type);
+			if (sidx >= 0) pSpecial[sidx] = pSpecialFunc;
+		}
+
+		//-------------------------------------------- INFO
+
+		bool is_compiled(void) const { return compiled; }
+
+		//can be evaluated for single points with evaluate
+		bool scalar_available(void) const { return compiled && num_registers <= max_scalar_registers; }
+
+		//-------------------------------------------- EVALUATE
+
+		//evaluate for a single point, with values of user variables in pvars (num_vars of them; variables with higher indexes evaluate to zero). Must have scalar_available().
+		double evaluate(const double* pvars, int num_vars) const
+		{
+			if (is_constant) return constant_value;
+
+			double reg[max_scalar_registers];
+
+			for (int idx = 0; idx < code.size(); idx++) {
+
+				const Instruction& ins = code[idx];
+
+				switch (ins.type) {
+
+				case FUNC_BVAR:
+					reg[ins.dst] = (ins.varlevel < num_vars ? pvars[ins.varlevel] : 0.0);
+					break;
+
+				case FUNC_BVAR_PMUL:
+					reg[ins.dst] = (ins.varlevel < num_vars ? ins.param * pvars[ins.varlevel] : 0.0);
+					break;
+
+				case FUNC_CONST:
+					reg[ins.dst] = ins.param;
+					break;
+
+				default:
+					if (is_binary(ins.type)) reg[ins.dst] = binary(ins, reg[ins.src1], reg[ins.src2]);
+					else reg[ins.dst] = unary(ins, reg[ins.dst]);
+					break;
+				}
+			}
+
+			return reg[result_register];
+		}
+
+		//evaluate for num points, with values of user variables in pvars (num_vars of them; variables with higher indexes evaluate to zero).
+		//Results written to pout[idx * out_stride] for point idx. Must have is_compiled().
+		//Points are done in batches, applying each instruction to all points in a batch : arithmetic instructions are simple loops over contiguous arrays which the compiler can vectorize.
+		void evaluate_many(int num, const BVarBatch* pvars, int num_vars, double* pout, int out_stride) const
+		{
+			if (is_constant) {
+
+				for (int idx = 0; idx < num; idx++) pout[idx * out_stride] = constant_value;
+				return;
+			}
+
+			std::vector<double> registers(num_registers * batch_size);
+
+			for (int start = 0; start < num; start += batch_size) {
+
+				int batch = (num - start < batch_size ? num - start : batch_size);
+
+				for (int cidx = 0; cidx < code.size(); cidx++) {
+
+					const Instruction& ins = code[cidx];
+
+					double* pdst = &registers[ins.dst * batch_size];
+					const double* psrc1 = &registers[ins.src1 * batch_size];
+					const double* psrc2 = &registers[ins.src2 * batch_size];
+
+					switch (ins.type) {
+
+					case FUNC_BVAR:
+					case FUNC_BVAR_PMUL:
+					{
+						double param = (ins.type == FUNC_BVAR_PMUL ? ins.param : 1.0);
+
+						if (ins.varlevel >= num_vars) for (int idx = 0; idx < batch; idx++) pdst[idx] = 0.0;
+						else if (pvars[ins.varlevel].pvalues) {
+
+							const double* pvalues = pvars[ins.varlevel].pvalues + start;
+							for (int idx = 0; idx < batch; idx++) pdst[idx] = param * pvalues[idx];
+						}
+						else {
+
+							double value = param * pvars[ins.varlevel].value;
+							for (int idx = 0; idx < batch; idx++) pdst[idx] = value;
+						}
+					}
+					break;
+
+					case FUNC_CONST:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = ins.param;
+						break;
+
+					case FUNC_ADD:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = psrc1[idx] + psrc2[idx];
+						break;
+
+					case FUNC_ADD_PMUL:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = ins.param * (psrc1[idx] + psrc2[idx]);
+						break;
+
+					case FUNC_SUB:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = psrc1[idx] - psrc2[idx];
+						break;
+
+					case FUNC_SUB_PMUL:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = ins.param * (psrc1[idx] - psrc2[idx]);
+						break;
+
+					case FUNC_MUL:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = psrc1[idx] * psrc2[idx];
+						break;
+
+					case FUNC_MUL_PMUL:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = ins.param * psrc1[idx] * psrc2[idx];
+						break;
+
+					case FUNC_DIV:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = psrc1[idx] / psrc2[idx];
+						break;
+
+					case FUNC_DIV_PMUL:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = ins.param * (psrc1[idx] / psrc2[idx]);
+						break;
+
+					case FUNC_POW:
+					case FUNC_POW_PMUL:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = binary(ins, psrc1[idx], psrc2[idx]);
+						break;
+
+					default:
+						for (int idx = 0; idx < batch; idx++) pdst[idx] = unary(ins, pdst[idx]);
+						break;
+					}
+				}
+
+				const double* presult = &registers[result_register * batch_size];
+				for (int idx = 0; idx < batch; idx++) pout[(start + idx) * out_stride] = presult[idx];
+			}
+		}
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TEquation_Function.h"
+#include "TEquation_Bytecode.h"
 #include "Funcs_Strings.h"
 
 template <typename ... BVarType>
@@ -15,6 +16,9 @@ private:
 	//the equation component with Function objects ready for run-time evaluation
 	std::vector< std::vector<EqComp::Function<BVarType...>*> > Funcs;
 
+	//the equation component compiled for run-time evaluation without the Function objects (used instead of them when available)
+	EqComp::Bytecode bytecode;
+
 	//text specifiers for user-defined function variables
 	std::vector<double>& varvec;
 
@@ -237,6 +241,8 @@ public:
 
 		Funcs.clear();
 		eq_fspec.clear();
+
+		bytecode.clear();
 	}
 
 	/////////////////////////////////////////////////////////
@@ -297,6 +303,9 @@ public:
 			}
 		}
 
+		//compile from the same logical representation : if not possible the Function objects are used
+		bytecode.compile(eq_fspec);
+
 		return true;
 	}
 
@@ -325,6 +334,8 @@ public:
 				Funcs[idx][idx_tree]->Set_SpecialFunction(type, pSpecialFunc);
 			}
 		}
+
+		bytecode.Set_SpecialFunction(type, pSpecialFunc);
 	}
 
 	/////////////////////////////////////////////////////////
@@ -334,7 +345,46 @@ public:
 	//evaluate scalar equation
 	double evaluate(BVarType... bvars) const
 	{
-		if (Funcs.size()) return Funcs.back().back()->evaluate(bvars...);
-		else return 0.0;
+		if (!Funcs.size()) return 0.0;
+
+		if (bytecode.scalar_available()) {
+
+			//no variables in variadic list, so use varvec instead
+			if (sizeof...(BVarType) == 0) return bytecode.evaluate(varvec.data(), varvec.size());
+
+			const double vars[] = { (double)bvars..., 0.0 };
+			return bytecode.evaluate(vars, sizeof...(BVarType));
+		}
+		else return Funcs.back().back()->evaluate(bvars...);
+	}
+
+	//evaluate scalar equation for num points, each user variable given as an array of num values or as a single value for all points.
+	//Result for point idx written to pout[idx * out_stride].
+	void evaluate_many(int num, EqComp::BVarBatch_t<BVarType>... bvars, double* pout, int out_stride) const
+	{
+		if (!Funcs.size()) {
+
+			for (int idx = 0; idx < num; idx++) pout[idx * out_stride] = 0.0;
+			return;
+		}
+
+		if (bytecode.is_compiled()) {
+
+			//no variables in variadic list, so use varvec instead
+			if (sizeof...(BVarType) == 0) {
+
+				std::vector<EqComp::BVarBatch> vars(varvec.begin(), varvec.end());
+				bytecode.evaluate_many(num, vars.data(), vars.size(), pout, out_stride);
+			}
+			else {
+
+				const EqComp::BVarBatch vars[] = { bvars..., EqComp::BVarBatch(0.0) };
+				bytecode.evaluate_many(num, vars, sizeof...(BVarType), pout, out_stride);
+			}
+		}
+		else {
+
+			for (int idx = 0; idx < num; idx++) pout[idx * out_stride] = Funcs.back().back()->evaluate(bvars.get(idx)...);
+		}
 	}
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+
+//Double-buffered output between a producer thread (e.g. the simulation thread) and a persistent writer thread doing the slow output (e.g. disk writes).
+//
+//The producer appends rows to the front buffer without locking. When the front buffer reaches the given capacity it is swapped with the back buffer, which the writer thread then writes out.
+//The producer only waits if the writer thread is still busy with the previous back buffer when the front buffer fills up again (back-pressure) : number of such stalls and total time spent waiting are recorded.
+//
+//Usage:
+//
+//DoubleBufferWriter<std::string> buffer;
+//buffer.set_writer([&](std::vector<std::string>& rows) { ... write rows ... });
+//buffer.push(row, capacity);	//producer thread only
+//buffer.flush();				//write out everything pushed so far and wait for it to complete
+
+template <typename RowType>
+class DoubleBufferWriter {
+
+private:
+
+	//rows being added by the producer (only accessed by the producer thread)
+	std::vector<RowType> front;
+
+	//rows handed over to the writer thread (only accessed by the writer thread while back_pending is set)
+	std::vector<RowType> back;
+
+	//the writer : called on the writer thread with rows to write. Rows are cleared afterwards.
+	std::function<void(std::vector<RowType>&)> write_rows;
+
+	std::thread writer_thread;
+
+	std::mutex writer_mutex;
+	std::condition_variable writer_cv;
+
+	//back buffer handed over and not yet written (protected by writer_mutex)
+	bool back_pending = false;
+
+	//writer thread asked to finish (protected by writer_mutex)
+	bool writer_stop = false;
+
+	//back-pressure statistics : number of times the producer had to wait for the writer, and total time spent waiting (s)
+	int stalls = 0;
+	double stall_time = 0.0;
+
+private:
+
+	void writer_loop(void)
+	{
+		std::unique_lock<std::mutex> lock(writer_mutex);
+
+		while (true) {
+
+			writer_cv.wait(lock, [&] { return back_pending || writer_stop; });
+
+			if (back_pending) {
+
+				//write without holding the lock, so the producer is free to keep adding rows to the front buffer
+				lock.unlock();
+				if (write_rows) write_rows(back);
+				back.clear();
+				lock.lock();
+
+				back_pending = false;
+				writer_cv.notify_all();
+			}
+			else return;
+		}
+	}
+
+	//wait for the writer to finish the back buffer : lock must be held. Return time spent waiting (s).
+	double wait_writer(std::unique_lock<std::mutex>& lock)
+	{
+		if (!back_pending) return 0.0;
+
+		auto start = std::chrono::steady_clock::now();
+		writer_cv.wait(lock, [&] { return !back_pending; });
+
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//hand over front buffer to the writer thread, waiting for it first if busy
+	void hand_over(bool count_stall)
+	{
+		std::unique_lock<std::mutex> lock(writer_mutex);
+
+		if (back_pending) {
+
+			double wait_time = wait_writer(lock);
+
+			if (count_stall) {
+
+				stalls++;
+				stall_time += wait_time;
+			}
+		}
+
+		front.swap(back);
+		back_pending = true;
+
+		//writer thread started on first use
+		if (!writer_thread.joinable()) {
+
+			writer_stop = false;
+			writer_thread = std::thread(&DoubleBufferWriter<RowType>::writer_loop, this);
+		}
+
+		writer_cv.notify_all();
+	}
+
+public:
+
+	DoubleBufferWriter(void) {}
+
+	~DoubleBufferWriter() { stop_writer(); }
+
+	//--------------------------------------------
+
+	void set_writer(std::function<void(std::vector<RowType>&)> write_rows_) { write_rows = write_rows_; }
+
+	//finish writing any handed over rows and stop the writer thread (restarted on next hand over). Rows not yet handed over are kept.
+	void stop_writer(void)
+	{
+		{
+			std::unique_lock<std::mutex> lock(writer_mutex);
+			writer_stop = true;
+			writer_cv.notify_all();
+		}
+
+		if (writer_thread.joinable()) writer_thread.join();
+	}
+
+	//--------------------------------------------
+
+	//add row to front buffer (producer thread only) : when capacity is reached rows are handed over to the writer thread
+	void push(const RowType& row, int capacity)
+	{
+		front.push_back(row);
+
+		if (front.size() >= capacity) hand_over(true);
+	}
+
+	//write out all rows pushed so far and wait for them to be written (producer thread only)
+	void flush(void)
+	{
+		if (front.size()) hand_over(false);
+
+		std::unique_lock<std::mutex> lock(writer_mutex);
+		wait_writer(lock);
+	}
+
+	//discard rows not yet handed over, after waiting for any handed over rows to be written (producer thread only)
+	void clear(void)
+	{
+		{
+			std::unique_lock<std::mutex> lock(writer_mutex);
+			wait_writer(lock);
+		}
+
+		front.clear();
+	}
+
+	//--------------------------------------------
+
+	//number of rows not yet handed over
+	int size(void) const { return front.size(); }
+
+	//back-pressure statistics
+	int get_stalls(void) const { return stalls; }
+	double get_stall_time(void) const { return stall_time; }
+	void reset_stalls(void) { stalls = 0; stall_time = 0.0; }
+};
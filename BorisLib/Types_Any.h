@@ -26,6 +26,9 @@
 //
 // f.convert_to_string("m");	//similar to << std::stringstream operator for conversion, but allows use of units. Will output 8.1987km as a std::string.
 //
+// std::vector<double> values;
+// f.convert_to_doubles(values);	//appends the numerical components of the stored value (here 8198.7) without conversion to text.
+//
 // Any g;
 // g.convert_string_set_type("8000", btypeinfo<double>().name());	//stores 8000 as a double - use this when type of Any has not been set yet, or to overwrite set type.
 // g.clear();			//clear stored type and value
@@ -96,6 +99,14 @@ struct ConvertToString_Params {
 	ConvertToString_Params(std::string unit_) { unit = unit_; }
 };
 
+//TODOUBLES
+struct ConvertToDoubles_Params {
+
+	std::vector<double>* pvalues;
+
+	ConvertToDoubles_Params(std::vector<double>* pvalues_) { pvalues = pvalues_; }
+};
+
 //CONVERTTYPE
 struct ConvertType_Params {
 
@@ -106,6 +117,23 @@ struct DeleteType_Params {
 
 };
 
+//------------------------------- Numerical components of stored values, used for TODOUBLES : non-numerical types have no components
+
+template <typename Type, std::enable_if_t<std::is_arithmetic<Type>::value>* = nullptr>
+void Any_AppendDoubles(std::vector<double>& values, const Type& value) { values.push_back((double)value); }
+
+template <typename Type, std::enable_if_t<!std::is_arithmetic<Type>::value>* = nullptr>
+void Any_AppendDoubles(std::vector<double>& values, const Type& value) {}
+
+template <typename VType>
+void Any_AppendDoubles(std::vector<double>& values, const VAL2<VType>& value) { values.push_back((double)value.x); values.push_back((double)value.y); }
+
+template <typename VType>
+void Any_AppendDoubles(std::vector<double>& values, const VAL3<VType>& value) { values.push_back((double)value.x); values.push_back((double)value.y); values.push_back((double)value.z); }
+
+template <typename VType>
+void Any_AppendDoubles(std::vector<double>& values, const VAL4<VType>& value) { values.push_back((double)value.x); values.push_back((double)value.y); values.push_back((double)value.z); values.push_back((double)value.t); }
+
 class Any {
 
 private:
@@ -209,6 +237,12 @@ private:
 		return ToString(*reinterpret_cast<Type*>(pValue), param.unit);
 	}
 
+	//TODOUBLES
+	template <typename RType, typename Type> RType RunThisMethod(ConvertToDoubles_Params param)
+	{
+		Any_AppendDoubles(*param.pvalues, *reinterpret_cast<Type*>(pValue));
+	}
+
 	//CONVERTTYPE
 	template <typename RType, typename Type> RType Convert_Type_to_RType(std::true_type)
 	{
@@ -520,6 +554,12 @@ public:
 		else return "";
 	}
 
+	//append numerical components of stored value to values (e.g. 3 values for a DBL3), without conversion to text. Non-numerical types append nothing.
+	void convert_to_doubles(std::vector<double>& values)
+	{
+		if (pValue) MatchType_CallFunc<void, ConvertToDoubles_Params>(ConvertToDoubles_Params(&values));
+	}
+
 	//this allows conversion to std::string using << via a std::stringstream (and also needed by ToString method). 
 	//Reason for using const_cast:
 	//const Any& rhs is required (ToString receives a const Type& rhs). convert_to_string() cannot be made const since it calls MatchType_CallFunc which cannot be made const (it must change values when handling other type of calls)
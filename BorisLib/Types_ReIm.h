@@ -103,6 +103,9 @@ struct __ReIm {
 //this is the most common type to use : double precision.
 typedef __ReIm<double> ReIm;
 
+//single precision, used for mixed precision convolution
+typedef __ReIm<float> ReImF;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////// __ReIm3
 //
 //
@@ -207,4 +210,7 @@ struct __ReIm3 {
 };
 
 //this is the most common type to use : double precision.
-typedef __ReIm3<double> ReIm3;
\ No newline at end of file
+typedef __ReIm3<double> ReIm3;
+
+//single precision, used for mixed precision convolution
+typedef __ReIm3<float> ReIm3F;
\ No newline at end of file
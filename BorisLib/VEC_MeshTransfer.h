@@ -171,19 +171,27 @@ private:
 	//secondary input specifically specified as a double
 	std::vector<VEC<double>*> mesh_in2_double;
 
-	//input mesh list of contributing cells and weights - transfer_in_info has size pVEC->linear_size()
-	//for each super-mesh cell, we have a list of contributing cells from the in meshes together with pre-calculated weights - InMeshCellsWeights
-	std::vector< InMeshCellsWeights > transfer_in_info;
+	//Transfer info is stored in compressed row (CSR) layout, so run-time transfers stream through a few contiguous arrays rather than one small allocation per cell.
+	//The InMeshCellsWeights and SuperMeshCellsWeights lists are only used while building, one cell at a time.
 
-	//transfer_out_info has size mesh_out.size() : number of output meshes; for each transfer_out_info entry, we have a vector the size of that out mesh.
-	//For each out mesh cell we have a list of contributing super-mesh cells with pre-calculated weights - SuperMeshCellsWeights
-	std::vector< std::vector< SuperMeshCellsWeights > > transfer_out_info;
+	//input mesh contributing cells and weights : contributions to super-mesh cell idx are entries from in_offsets[idx] up to in_offsets[idx + 1] (exclusive)
+	//in_offsets has size pVEC->linear_size() + 1; in_cells holds (mesh index, cell index) for each entry, in_weights the pre-calculated weight
+	std::vector<size_t> in_offsets;
+	std::vector<INT2> in_cells;
+	std::vector<double> in_weights;
 
-	//total number of transfers from input meshes (i.e. in the flattened transfer info)
-	size_t transfer_in_info_size = 0;
+	//if every super-mesh cell has exactly one contribution, from the cell with the same index in a single input mesh (i.e. the input mesh grid coincides with the super-mesh grid), this is that input mesh index, else -1
+	//in this case the transfer in is done as a direct cellwise copy (scaled by in_weights) without index indirection
+	int in_identity_mesh = -1;
 
-	//total number of transfers to output meshes (i.e. in the flattened transfer info)
-	size_t transfer_out_info_size = 0;
+	//output mesh contributing super-mesh cells and weights, with rows for all cells of all output meshes concatenated : out mesh cell idx in mesh meshIdx has row out_rows_start[meshIdx] + idx
+	//contributions to a row are entries from out_offsets[row] up to out_offsets[row + 1] (exclusive), with out_cells the super-mesh cell index, out_weights the pre-calculated weight
+	std::vector<size_t> out_rows_start, out_offsets;
+	std::vector<int> out_cells;
+	std::vector<double> out_weights;
+
+	//for each output mesh : true if each of its cells has exactly one contribution, from the super-mesh cell with the same index (direct cellwise copy)
+	std::vector<bool> out_identity;
 
 private:
 	
@@ -200,6 +208,11 @@ private:
 
 	double build_supermeshcells_weights(SuperMeshCellsWeights &cellsWeights, Rect rect_mc);
 
+	//start building input transfer info (CSR layout) for all super-mesh cells, then append contributions for each super-mesh cell in order, then finish. Return false if not enough memory.
+	bool begin_transfer_in(void);
+	bool append_transfer_in(InMeshCellsWeights &cellsWeights);
+	void finish_transfer_in(void);
+
 	//before calling the helpers below you must make sure mesh_in, mesh_in2, mesh_out, mesh_out2 are set correctly as required
 
 	//MESHTRANSFERTYPE_WEIGHTED
@@ -287,12 +300,13 @@ public:
 	
 	//----------------------------------- INFO
 
-	size_t size_transfer_in(void) { return transfer_in_info_size; }
-	size_t size_transfer_out(void) { return transfer_out_info_size; }
+	//total number of transfers from input meshes, and to output meshes (i.e. in the flattened transfer info)
+	size_t size_transfer_in(void) { return in_cells.size(); }
+	size_t size_transfer_out(void) { return out_cells.size(); }
 
 	//----------------------------------- FLATTENED TRANSFER INFO
 
-	//from transfer_in_info and transfer_out_info build flatted transfer_info and pass it on (note vector perfect forwarding makes this ok - build the vector inside this function and return it, the caller can then use it)
+	//from the input and output transfer info build flatted transfer_info and pass it on (note vector perfect forwarding makes this ok - build the vector inside this function and return it, the caller can then use it)
 	std::vector<std::pair<INT3, double>> get_flattened_transfer_in_info(void);
 	std::vector<std::pair<INT3, double>> get_flattened_transfer_out_info(void);
 
@@ -435,6 +449,69 @@ double Transfer<VType>::build_supermeshcells_weights(SuperMeshCellsWeights &cell
 	return d_recip_total;
 }
 
+//start building input transfer info (CSR layout) for all super-mesh cells
+template <typename VType>
+bool Transfer<VType>::begin_transfer_in(void)
+{
+	in_cells.clear();
+	in_cells.shrink_to_fit();
+	in_weights.clear();
+	in_weights.shrink_to_fit();
+
+	in_identity_mesh = -1;
+
+	//offsets for each super-mesh cell, plus end offset
+	if (!mreserve_vector(in_offsets, pVEC->linear_size() + 1)) return false;
+	in_offsets.clear();
+	in_offsets.push_back(0);
+
+	return true;
+}
+
+//append contributions for next super-mesh cell
+template <typename VType>
+bool Transfer<VType>::append_transfer_in(InMeshCellsWeights &cellsWeights)
+{
+	try {
+
+		for (int cidx = 0; cidx < cellsWeights.size(); cidx++) {
+
+			in_cells.push_back(cellsWeights[cidx].first);
+			in_weights.push_back(cellsWeights[cidx].second);
+		}
+
+		in_offsets.push_back(in_cells.size());
+	}
+	catch (...) {
+
+		return false;
+	}
+
+	return true;
+}
+
+//finished building input transfer info : release unused capacity and check if the transfer is a direct cellwise copy from a single input mesh
+template <typename VType>
+void Transfer<VType>::finish_transfer_in(void)
+{
+	in_cells.shrink_to_fit();
+	in_weights.shrink_to_fit();
+
+	in_identity_mesh = -1;
+
+	if (!pVEC->linear_size() || in_cells.size() != pVEC->linear_size()) return;
+
+	int mesh_idx = in_cells[0].i;
+	if (mesh_in[mesh_idx]->linear_size() != pVEC->linear_size()) return;
+
+	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
+
+		if (in_offsets[idx] != (size_t)idx || in_cells[idx] != INT2(mesh_idx, idx)) return;
+	}
+
+	in_identity_mesh = mesh_idx;
+}
+
 //----------------------------------- RUN-TIME TRANSFER METHODS
 
 //SINGLE INPUT
@@ -443,34 +520,57 @@ double Transfer<VType>::build_supermeshcells_weights(SuperMeshCellsWeights &cell
 template <typename VType>
 void Transfer<VType>::transfer_from_external_meshes(bool clear)
 {
+	VType* sm_data = pVEC->data();
+	const double* weights = in_weights.data();
+
+	//input mesh grid coincides with super-mesh grid : direct cellwise copy
+	if (in_identity_mesh >= 0) {
+
+		VType* in_data = mesh_in[in_identity_mesh]->data();
+
+		if (clear) {
+
+#pragma omp parallel for
+			for (int idx = 0; idx < pVEC->linear_size(); idx++) sm_data[idx] = in_data[idx] * weights[idx];
+		}
+		else {
+
+#pragma omp parallel for
+			for (int idx = 0; idx < pVEC->linear_size(); idx++) sm_data[idx] += in_data[idx] * weights[idx];
+		}
+
+		return;
+	}
+
+	//data for input meshes
+	std::vector<VType*> in_data(mesh_in.size());
+	for (int mesh_idx = 0; mesh_idx < mesh_in.size(); mesh_idx++) in_data[mesh_idx] = mesh_in[mesh_idx]->data();
+
+	const size_t* offsets = in_offsets.data();
+	const INT2* cells = in_cells.data();
+
 	//go through all super-mesh cells
 #pragma omp parallel for
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
 
-		if (transfer_in_info[idx].size()) {
+		size_t start = offsets[idx], end = offsets[idx + 1];
 
-			//first contribution to cell idx : set or add depending on clear flag
-			INT2 full_index = transfer_in_info[idx][0].first;
-			double weight = transfer_in_info[idx][0].second;
+		if (end > start) {
 
-			//obtain weighted value from external mesh
-			VType total_weighted_value = (*mesh_in[full_index.i])[full_index.j] * weight;
+			//first contribution to cell idx : set or add depending on clear flag
+			VType total_weighted_value = in_data[cells[start].i][cells[start].j] * weights[start];
 
 			//go through all other contributions to cell idx
-			for (int cidx = 1; cidx < transfer_in_info[idx].size(); cidx++) {
-
-				INT2 full_index = transfer_in_info[idx][cidx].first;
-				double weight = transfer_in_info[idx][cidx].second;
+			for (size_t cidx = start + 1; cidx < end; cidx++) {
 
-				//obtain weighted value from external mesh
-				total_weighted_value += (*mesh_in[full_index.i])[full_index.j] * weight;
+				total_weighted_value += in_data[cells[cidx].i][cells[cidx].j] * weights[cidx];
 			}
 
 			//stored contribution in supermesh
-			if (clear) (*pVEC)[idx] = total_weighted_value;
-			else (*pVEC)[idx] += total_weighted_value;
+			if (clear) sm_data[idx] = total_weighted_value;
+			else sm_data[idx] += total_weighted_value;
 		}
-		else if (clear) (*pVEC)[idx] = VType();
+		else if (clear) sm_data[idx] = VType();
 	}
 }
 
@@ -479,46 +579,68 @@ void Transfer<VType>::transfer_from_external_meshes(bool clear)
 template <typename VType>
 void Transfer<VType>::transfer_from_external_meshes_averaged(bool clear)
 {
+	VType* sm_data = pVEC->data();
+	const double* weights = in_weights.data();
+
+	//data for input meshes; secondary input is nullptr if empty (use simple input)
+	std::vector<VType*> in_data(mesh_in.size()), in2_data(mesh_in.size());
+	for (int mesh_idx = 0; mesh_idx < mesh_in.size(); mesh_idx++) {
+
+		in_data[mesh_idx] = mesh_in[mesh_idx]->data();
+		in2_data[mesh_idx] = (mesh_in2[mesh_idx]->linear_size() ? mesh_in2[mesh_idx]->data() : nullptr);
+	}
+
+	//input mesh grid coincides with super-mesh grid : direct cellwise copy, averaged if possible
+	if (in_identity_mesh >= 0) {
+
+		VType* in1 = in_data[in_identity_mesh];
+		VType* in2 = in2_data[in_identity_mesh];
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC->linear_size(); idx++) {
+
+			VType weighted_value = (in2 ? (in1[idx] + in2[idx]) * weights[idx] / 2 : in1[idx] * weights[idx]);
+
+			if (clear) sm_data[idx] = weighted_value;
+			else sm_data[idx] += weighted_value;
+		}
+
+		return;
+	}
+
+	const size_t* offsets = in_offsets.data();
+	const INT2* cells = in_cells.data();
+
 	//go through all super-mesh cells
 #pragma omp parallel for
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
 
-		if (transfer_in_info[idx].size()) {
+		size_t start = offsets[idx], end = offsets[idx + 1];
 
-			//first contribution to cell idx : set or add depending on clear flag
-			INT2 full_index = transfer_in_info[idx][0].first;
-			double weight = transfer_in_info[idx][0].second;
+		if (end > start) {
 
-			//obtain weighted value from external mesh
-			VType total_weighted_value = VType();
-			
+			//first contribution to cell idx : set or add depending on clear flag
 			//average input if possible else simple input
-			if (mesh_in2[full_index.i]->linear_size()) {
+			INT2 full_index = cells[start];
 
-				total_weighted_value = ((*mesh_in[full_index.i])[full_index.j] + (*mesh_in2[full_index.i])[full_index.j]) * weight / 2;
-			}
-			else total_weighted_value = (*mesh_in[full_index.i])[full_index.j] * weight;
+			VType total_weighted_value = (in2_data[full_index.i] ?
+				(in_data[full_index.i][full_index.j] + in2_data[full_index.i][full_index.j]) * weights[start] / 2 :
+				in_data[full_index.i][full_index.j] * weights[start]);
 
 			//go through all other contributions to cell idx
-			for (int cidx = 1; cidx < transfer_in_info[idx].size(); cidx++) {
-
-				INT2 full_index = transfer_in_info[idx][cidx].first;
-				double weight = transfer_in_info[idx][cidx].second;
+			for (size_t cidx = start + 1; cidx < end; cidx++) {
 
-				//obtain weighted value from external mesh
-				//average input if possible else simple input
-				if (mesh_in2[full_index.i]->linear_size()) {
+				INT2 full_index = cells[cidx];
 
-					total_weighted_value += ((*mesh_in[full_index.i])[full_index.j] + (*mesh_in2[full_index.i])[full_index.j]) * weight / 2;
-				}
-				else total_weighted_value += (*mesh_in[full_index.i])[full_index.j] * weight;
+				if (in2_data[full_index.i]) total_weighted_value += (in_data[full_index.i][full_index.j] + in2_data[full_index.i][full_index.j]) * weights[cidx] / 2;
+				else total_weighted_value += in_data[full_index.i][full_index.j] * weights[cidx];
 			}
 
 			//stored contribution in supermesh
-			if (clear) (*pVEC)[idx] = total_weighted_value;
-			else (*pVEC)[idx] += total_weighted_value;
+			if (clear) sm_data[idx] = total_weighted_value;
+			else sm_data[idx] += total_weighted_value;
 		}
-		else if (clear) (*pVEC)[idx] = VType();
+		else if (clear) sm_data[idx] = VType();
 	}
 }
 
@@ -527,46 +649,69 @@ void Transfer<VType>::transfer_from_external_meshes_averaged(bool clear)
 template <typename VType>
 void Transfer<VType>::transfer_from_external_meshes_multiplied(bool clear)
 {
+	VType* sm_data = pVEC->data();
+	const double* weights = in_weights.data();
+
+	//data for input meshes; secondary input is nullptr if empty (use simple input)
+	std::vector<VType*> in_data(mesh_in.size());
+	std::vector<double*> in2_data(mesh_in.size());
+	for (int mesh_idx = 0; mesh_idx < mesh_in.size(); mesh_idx++) {
+
+		in_data[mesh_idx] = mesh_in[mesh_idx]->data();
+		in2_data[mesh_idx] = (mesh_in2_double[mesh_idx]->linear_size() ? mesh_in2_double[mesh_idx]->data() : nullptr);
+	}
+
+	//input mesh grid coincides with super-mesh grid : direct cellwise copy, multiplied if possible
+	if (in_identity_mesh >= 0) {
+
+		VType* in1 = in_data[in_identity_mesh];
+		double* in2 = in2_data[in_identity_mesh];
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pVEC->linear_size(); idx++) {
+
+			VType weighted_value = (in2 ? (in1[idx] * in2[idx]) * weights[idx] : in1[idx] * weights[idx]);
+
+			if (clear) sm_data[idx] = weighted_value;
+			else sm_data[idx] += weighted_value;
+		}
+
+		return;
+	}
+
+	const size_t* offsets = in_offsets.data();
+	const INT2* cells = in_cells.data();
+
 	//go through all super-mesh cells
 #pragma omp parallel for
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
 
-		if (transfer_in_info[idx].size()) {
+		size_t start = offsets[idx], end = offsets[idx + 1];
 
-			//first contribution to cell idx : set or add depending on clear flag
-			INT2 full_index = transfer_in_info[idx][0].first;
-			double weight = transfer_in_info[idx][0].second;
-
-			//obtain weighted value from external mesh
-			VType total_weighted_value = VType();
+		if (end > start) {
 
+			//first contribution to cell idx : set or add depending on clear flag
 			//multiply inputs if possible else simple input
-			if (mesh_in2_double[full_index.i]->linear_size()) {
+			INT2 full_index = cells[start];
 
-				total_weighted_value = ((*mesh_in[full_index.i])[full_index.j] * (*mesh_in2_double[full_index.i])[full_index.j]) * weight;
-			}
-			else total_weighted_value = (*mesh_in[full_index.i])[full_index.j] * weight;
+			VType total_weighted_value = (in2_data[full_index.i] ?
+				(in_data[full_index.i][full_index.j] * in2_data[full_index.i][full_index.j]) * weights[start] :
+				in_data[full_index.i][full_index.j] * weights[start]);
 
 			//go through all other contributions to cell idx
-			for (int cidx = 1; cidx < transfer_in_info[idx].size(); cidx++) {
-
-				INT2 full_index = transfer_in_info[idx][cidx].first;
-				double weight = transfer_in_info[idx][cidx].second;
+			for (size_t cidx = start + 1; cidx < end; cidx++) {
 
-				//obtain weighted value from external mesh
-				//multiply inputs if possible else simple input
-				if (mesh_in2_double[full_index.i]->linear_size()) {
+				INT2 full_index = cells[cidx];
 
-					total_weighted_value += ((*mesh_in[full_index.i])[full_index.j] * (*mesh_in2_double[full_index.i])[full_index.j]) * weight;
-				}
-				else total_weighted_value += (*mesh_in[full_index.i])[full_index.j] * weight;
+				if (in2_data[full_index.i]) total_weighted_value += (in_data[full_index.i][full_index.j] * in2_data[full_index.i][full_index.j]) * weights[cidx];
+				else total_weighted_value += in_data[full_index.i][full_index.j] * weights[cidx];
 			}
 
 			//stored contribution in supermesh
-			if (clear) (*pVEC)[idx] = total_weighted_value;
-			else (*pVEC)[idx] += total_weighted_value;
+			if (clear) sm_data[idx] = total_weighted_value;
+			else sm_data[idx] += total_weighted_value;
 		}
-		else if (clear) (*pVEC)[idx] = VType();
+		else if (clear) sm_data[idx] = VType();
 	}
 }
 
@@ -575,37 +720,60 @@ void Transfer<VType>::transfer_from_external_meshes_multiplied(bool clear)
 //transfer values to the external meshes (mesh_out) from the supermesh
 template <typename VType>
 void Transfer<VType>::transfer_to_external_meshes(bool clear)
-{	
+{
+	VType* sm_data = pVEC->data();
+
 	//go through all out meshes
 	for (int meshIdx = 0; meshIdx < mesh_out.size(); meshIdx++) {
 
-		//for each out mesh go through all its cells to build mesh_entry
+		VType* out_data = mesh_out[meshIdx]->data();
+
+		//rows for this out mesh
+		const size_t* offsets = out_offsets.data() + out_rows_start[meshIdx];
+
+		//out mesh grid coincides with super-mesh grid : direct cellwise copy
+		if (out_identity[meshIdx]) {
+
+			const double* weights = out_weights.data() + offsets[0];
+
+			if (clear) {
+
 #pragma omp parallel for
-		for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
+				for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) out_data[idx] = sm_data[idx] * weights[idx];
+			}
+			else {
 
-			if (transfer_out_info[meshIdx][idx].size()) {
+#pragma omp parallel for
+				for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) out_data[idx] += sm_data[idx] * weights[idx];
+			}
 
-				//first contribution to cell idx : set or add depending on clear flag
-				int index = transfer_out_info[meshIdx][idx][0].first;
-				double weight = transfer_out_info[meshIdx][idx][0].second;
+			continue;
+		}
 
-				VType total_weighted_value = VType();
+		const int* cells = out_cells.data();
+		const double* weights = out_weights.data();
 
-				total_weighted_value = (*pVEC)[index] * weight;
+		//for each out mesh go through all its cells
+#pragma omp parallel for
+		for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
 
-				//go through all other contributions to cell idx
-				for (int cidx = 1; cidx < transfer_out_info[meshIdx][idx].size(); cidx++) {
+			size_t start = offsets[idx], end = offsets[idx + 1];
 
-					int index = transfer_out_info[meshIdx][idx][cidx].first;
-					double weight = transfer_out_info[meshIdx][idx][cidx].second;
+			if (end > start) {
 
-					total_weighted_value += (*pVEC)[index] * weight;
+				//first contribution to cell idx : set or add depending on clear flag
+				VType total_weighted_value = sm_data[cells[start]] * weights[start];
+
+				//go through all other contributions to cell idx
+				for (size_t cidx = start + 1; cidx < end; cidx++) {
+
+					total_weighted_value += sm_data[cells[cidx]] * weights[cidx];
 				}
 
-				if (clear) (*mesh_out[meshIdx])[idx] = total_weighted_value;
-				else (*mesh_out[meshIdx])[idx] += total_weighted_value;
+				if (clear) out_data[idx] = total_weighted_value;
+				else out_data[idx] += total_weighted_value;
 			}
-			else if (clear) (*mesh_out[meshIdx])[idx] = VType();
+			else if (clear) out_data[idx] = VType();
 		}
 	}
 }
@@ -615,53 +783,79 @@ void Transfer<VType>::transfer_to_external_meshes(bool clear)
 template <typename VType>
 void Transfer<VType>::transfer_to_external_meshes_duplicated(bool clear)
 {
+	VType* sm_data = pVEC->data();
+
 	//go through all out meshes
 	for (int meshIdx = 0; meshIdx < mesh_out.size(); meshIdx++) {
 
-		//for each out mesh go through all its cells to build mesh_entry
+		VType* out_data = mesh_out[meshIdx]->data();
+
+		//duplicate output if possible, else nullptr
+		VType* out2_data = (mesh_out2[meshIdx]->linear_size() ? mesh_out2[meshIdx]->data() : nullptr);
+
+		//rows for this out mesh
+		const size_t* offsets = out_offsets.data() + out_rows_start[meshIdx];
+
+		//out mesh grid coincides with super-mesh grid : direct cellwise copy
+		if (out_identity[meshIdx]) {
+
+			const double* weights = out_weights.data() + offsets[0];
+
 #pragma omp parallel for
-		for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
+			for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
 
-			if (transfer_out_info[meshIdx][idx].size()) {
+				VType weighted_value = sm_data[idx] * weights[idx];
 
-				//first contribution to cell idx : set or add depending on clear flag
-				int index = transfer_out_info[meshIdx][idx][0].first;
-				double weight = transfer_out_info[meshIdx][idx][0].second;
+				if (clear) {
 
-				VType total_weighted_value = VType();
+					out_data[idx] = weighted_value;
+					if (out2_data) out2_data[idx] = weighted_value;
+				}
+				else {
 
-				total_weighted_value = (*pVEC)[index] * weight;
+					out_data[idx] += weighted_value;
+					if (out2_data) out2_data[idx] += weighted_value;
+				}
+			}
 
-				//go through all other contributions to cell idx
-				for (int cidx = 1; cidx < transfer_out_info[meshIdx][idx].size(); cidx++) {
+			continue;
+		}
+
+		const int* cells = out_cells.data();
+		const double* weights = out_weights.data();
+
+		//for each out mesh go through all its cells
+#pragma omp parallel for
+		for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
 
-					int index = transfer_out_info[meshIdx][idx][cidx].first;
-					double weight = transfer_out_info[meshIdx][idx][cidx].second;
+			size_t start = offsets[idx], end = offsets[idx + 1];
+
+			if (end > start) {
+
+				//first contribution to cell idx : set or add depending on clear flag
+				VType total_weighted_value = sm_data[cells[start]] * weights[start];
+
+				//go through all other contributions to cell idx
+				for (size_t cidx = start + 1; cidx < end; cidx++) {
 
-					total_weighted_value += (*pVEC)[index] * weight;
+					total_weighted_value += sm_data[cells[cidx]] * weights[cidx];
 				}
 
 				if (clear) {
 
-					(*mesh_out[meshIdx])[idx] = total_weighted_value;
-					
-					//duplicate output if possible
-					if (mesh_out2[meshIdx]->linear_size()) (*mesh_out2[meshIdx])[idx] = total_weighted_value;
+					out_data[idx] = total_weighted_value;
+					if (out2_data) out2_data[idx] = total_weighted_value;
 				}
 				else {
 
-					(*mesh_out[meshIdx])[idx] += total_weighted_value;
-
-					//duplicate output if possible
-					if (mesh_out2[meshIdx]->linear_size()) (*mesh_out2[meshIdx])[idx] += total_weighted_value;
+					out_data[idx] += total_weighted_value;
+					if (out2_data) out2_data[idx] += total_weighted_value;
 				}
 			}
 			else if (clear) {
 
-				(*mesh_out[meshIdx])[idx] = VType();
-
-				//duplicate output if possible
-				if (mesh_out2[meshIdx]->linear_size()) (*mesh_out2[meshIdx])[idx] = VType();
+				out_data[idx] = VType();
+				if (out2_data) out2_data[idx] = VType();
 			}
 		}
 	}
@@ -680,13 +874,24 @@ void Transfer<VType>::clear(void)
 
 	mesh_in2_double.clear();
 
-	transfer_in_info.clear();
-	transfer_in_info.shrink_to_fit();
-	transfer_out_info.clear();
-	transfer_out_info.shrink_to_fit();
+	in_offsets.clear();
+	in_offsets.shrink_to_fit();
+	in_cells.clear();
+	in_cells.shrink_to_fit();
+	in_weights.clear();
+	in_weights.shrink_to_fit();
+
+	in_identity_mesh = -1;
 
-	transfer_in_info_size = 0;
-	transfer_out_info_size = 0;
+	out_rows_start.clear();
+	out_offsets.clear();
+	out_offsets.shrink_to_fit();
+	out_cells.clear();
+	out_cells.shrink_to_fit();
+	out_weights.clear();
+	out_weights.shrink_to_fit();
+
+	out_identity.clear();
 }
 
 //----------------------------------- INITIALIZE TRANSFER
@@ -903,10 +1108,8 @@ bool Transfer<VType>::initialize_transfer_in_weighted(double multiplier)
 
 	//-------------------------------------------------------------- Build transfer_in_info
 
-	//set size for transfer_in_info : number of cells in the super-mesh
-	if (!malloc_vector(transfer_in_info, pVEC->linear_size())) return false;
-
-	transfer_in_info_size = 0;
+	//contributions for each super-mesh cell are appended in order
+	if (!begin_transfer_in()) return false;
 
 	//go through all super-mesh cells
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
@@ -945,12 +1148,11 @@ bool Transfer<VType>::initialize_transfer_in_weighted(double multiplier)
 		if (d_recip_total > 0) mesh_cellsWeights.multiply_weights(covered_volume_ratio * multiplier / d_recip_total);
 
 		//store calculated contributions for this super-mesh cell.
-		transfer_in_info[idx] = mesh_cellsWeights;
-
-		//calculate the total number of contributing cell transfers : sum of all in meshes transfers to each super-mesh cell. This is the flattened total number of transfers.
-		transfer_in_info_size += transfer_in_info[idx].size();
+		if (!append_transfer_in(mesh_cellsWeights)) return false;
 	}
 
+	finish_transfer_in();
+
 	return true;
 }
 
@@ -961,10 +1163,8 @@ bool Transfer<VType>::initialize_transfer_in_clipped(double multiplier)
 
 	//-------------------------------------------------------------- Build transfer_in_info
 
-	//set size for transfer_in_info : number of cells in the super-mesh
-	if (!malloc_vector(transfer_in_info, pVEC->linear_size())) return false;
-
-	transfer_in_info_size = 0;
+	//contributions for each super-mesh cell are appended in order
+	if (!begin_transfer_in()) return false;
 
 	//go through all super-mesh cells
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
@@ -1002,12 +1202,11 @@ bool Transfer<VType>::initialize_transfer_in_clipped(double multiplier)
 		if (d_recip_total > 0) mesh_cellsWeights.multiply_weights(multiplier / d_recip_total);
 
 		//store calculated contributions for this super-mesh cell.
-		transfer_in_info[idx] = mesh_cellsWeights;
-
-		//calculate the total number of contributing cell transfers : sum of all in meshes transfers to each super-mesh cell. This is the flattened total number of transfers.
-		transfer_in_info_size += transfer_in_info[idx].size();
+		if (!append_transfer_in(mesh_cellsWeights)) return false;
 	}
 
+	finish_transfer_in();
+
 	return true;
 }
 
@@ -1018,10 +1217,8 @@ bool Transfer<VType>::initialize_transfer_in_enlarged(double multiplier)
 
 	//-------------------------------------------------------------- Build transfer_in_info
 
-	//set size for transfer_in_info : number of cells in the super-mesh
-	if (!malloc_vector(transfer_in_info, pVEC->linear_size())) return false;
-
-	transfer_in_info_size = 0;
+	//contributions for each super-mesh cell are appended in order
+	if (!begin_transfer_in()) return false;
 
 	//go through all super-mesh cells
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
@@ -1055,12 +1252,11 @@ bool Transfer<VType>::initialize_transfer_in_enlarged(double multiplier)
 		if (d_recip_total > 0) mesh_cellsWeights.multiply_weights(multiplier / d_recip_total);
 
 		//store calculated contributions for this super-mesh cell.
-		transfer_in_info[idx] = mesh_cellsWeights;
-
-		//calculate the total number of contributing cell transfers : sum of all in meshes transfers to each super-mesh cell. This is the flattened total number of transfers.
-		transfer_in_info_size += transfer_in_info[idx].size();
+		if (!append_transfer_in(mesh_cellsWeights)) return false;
 	}
 
+	finish_transfer_in();
+
 	return true;
 }
 
@@ -1070,10 +1266,8 @@ bool Transfer<VType>::initialize_transfer_in_sum(double multiplier)
 {
 	//-------------------------------------------------------------- Build transfer_in_info
 
-	//set size for transfer_in_info : number of cells in the super-mesh
-	if (!malloc_vector(transfer_in_info, pVEC->linear_size())) return false;
-
-	transfer_in_info_size = 0;
+	//contributions for each super-mesh cell are appended in order
+	if (!begin_transfer_in()) return false;
 
 	//go through all super-mesh cells
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
@@ -1103,12 +1297,11 @@ bool Transfer<VType>::initialize_transfer_in_sum(double multiplier)
 		mesh_cellsWeights.multiply_weights(multiplier);
 
 		//store calculated contributions for this super-mesh cell.
-		transfer_in_info[idx] = mesh_cellsWeights;
-
-		//calculate the total number of contributing cell transfers : sum of all in meshes transfers to each super-mesh cell. This is the flattened total number of transfers.
-		transfer_in_info_size += transfer_in_info[idx].size();
+		if (!append_transfer_in(mesh_cellsWeights)) return false;
 	}
 
+	finish_transfer_in();
+
 	return true;
 }
 
@@ -1118,10 +1311,8 @@ bool Transfer<VType>::initialize_transfer_in_density(double multiplier)
 {
 	//-------------------------------------------------------------- Build transfer_in_info
 
-	//set size for transfer_in_info : number of cells in the super-mesh
-	if (!malloc_vector(transfer_in_info, pVEC->linear_size())) return false;
-
-	transfer_in_info_size = 0;
+	//contributions for each super-mesh cell are appended in order
+	if (!begin_transfer_in()) return false;
 
 	//go through all super-mesh cells
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
@@ -1153,12 +1344,11 @@ bool Transfer<VType>::initialize_transfer_in_density(double multiplier)
 		if (volume > 0) mesh_cellsWeights.multiply_weights(multiplier / volume);
 
 		//store calculated contributions for this super-mesh cell.
-		transfer_in_info[idx] = mesh_cellsWeights;
-
-		//calculate the total number of contributing cell transfers : sum of all in meshes transfers to each super-mesh cell. This is the flattened total number of transfers.
-		transfer_in_info_size += transfer_in_info[idx].size();
+		if (!append_transfer_in(mesh_cellsWeights)) return false;
 	}
 
+	finish_transfer_in();
+
 	return true;
 }
 
@@ -1168,10 +1358,8 @@ bool Transfer<VType>::initialize_transfer_in_weighted_density(double multiplier)
 {
 	//-------------------------------------------------------------- Build transfer_in_info
 
-	//set size for transfer_in_info : number of cells in the super-mesh
-	if (!malloc_vector(transfer_in_info, pVEC->linear_size())) return false;
-
-	transfer_in_info_size = 0;
+	//contributions for each super-mesh cell are appended in order
+	if (!begin_transfer_in()) return false;
 
 	//go through all super-mesh cells
 	for (int idx = 0; idx < pVEC->linear_size(); idx++) {
@@ -1208,12 +1396,11 @@ bool Transfer<VType>::initialize_transfer_in_weighted_density(double multiplier)
 		if (volume > 0) mesh_cellsWeights.multiply_weights(multiplier * covered_volume_ratio / volume);
 
 		//store calculated contributions for this super-mesh cell.
-		transfer_in_info[idx] = mesh_cellsWeights;
-
-		//calculate the total number of contributing cell transfers : sum of all in meshes transfers to each super-mesh cell. This is the flattened total number of transfers.
-		transfer_in_info_size += transfer_in_info[idx].size();
+		if (!append_transfer_in(mesh_cellsWeights)) return false;
 	}
 
+	finish_transfer_in();
+
 	return true;
 }
 
@@ -1223,48 +1410,72 @@ bool Transfer<VType>::initialize_transfer_out(void)
 
 	//-------------------------------------------------------------- Build transfer_out_info
 
-	transfer_out_info.clear();
-	transfer_out_info.shrink_to_fit();
+	out_cells.clear();
+	out_cells.shrink_to_fit();
+	out_weights.clear();
+	out_weights.shrink_to_fit();
 
-	transfer_out_info_size = 0;
+	out_identity.assign(mesh_out.size(), false);
 
-	//go through all out meshes
-	for (int meshIdx = 0; meshIdx < mesh_out.size(); meshIdx++) {
+	//rows for all out mesh cells, plus end offset
+	size_t num_rows = 0;
+	for (int meshIdx = 0; meshIdx < mesh_out.size(); meshIdx++) num_rows += mesh_out[meshIdx]->linear_size();
 
-		//build the entry for out mesh with meshIdx
-		std::vector< SuperMeshCellsWeights > mesh_entry;
+	if (!mreserve_vector(out_offsets, num_rows + 1)) return false;
+	out_offsets.clear();
+	out_offsets.push_back(0);
 
-		//for each out mesh go through all its cells to build mesh_entry
-		for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
+	out_rows_start.clear();
 
-			//mesh cell rectangle (absolute)
-			Rect rect_mc = mesh_out[meshIdx]->get_cellrect(idx);
+	try {
 
-			//list of all supermesh cells intersecting with this mesh cell
-			SuperMeshCellsWeights supermesh_cellsWeights;
+		//go through all out meshes
+		for (int meshIdx = 0; meshIdx < mesh_out.size(); meshIdx++) {
 
-			//total reciprocal distance
-			double d_recip_total = build_supermeshcells_weights(supermesh_cellsWeights, rect_mc);
+			out_rows_start.push_back(out_offsets.size() - 1);
 
-			if (d_recip_total > 0) supermesh_cellsWeights.multiply_weights(1.0 / d_recip_total);
+			//out mesh grid coincides with super-mesh grid if each of its cells receives only the super-mesh cell with the same index
+			bool identity = (mesh_out[meshIdx]->linear_size() && mesh_out[meshIdx]->linear_size() == pVEC->linear_size());
 
-			//store in mesh_entry : new entry for cell idx
-			mesh_entry.push_back(supermesh_cellsWeights);
+			//for each out mesh go through all its cells
+			for (int idx = 0; idx < mesh_out[meshIdx]->linear_size(); idx++) {
 
-			//for this mesh and mesh cell supermesh_cellsWeights.size() has the number of contributing super-mesh cells transfers : add them to flattened total number of transfers
-			transfer_out_info_size += supermesh_cellsWeights.size();
-		}
+				//mesh cell rectangle (absolute)
+				Rect rect_mc = mesh_out[meshIdx]->get_cellrect(idx);
 
-		try {
+				//list of all supermesh cells intersecting with this mesh cell
+				SuperMeshCellsWeights supermesh_cellsWeights;
 
-			transfer_out_info.push_back(mesh_entry);
-		}
-		catch (...) {
+				//total reciprocal distance
+				double d_recip_total = build_supermeshcells_weights(supermesh_cellsWeights, rect_mc);
+
+				if (d_recip_total > 0) supermesh_cellsWeights.multiply_weights(1.0 / d_recip_total);
+
+				//store as new row for cell idx
+				for (int cidx = 0; cidx < supermesh_cellsWeights.size(); cidx++) {
+
+					out_cells.push_back(supermesh_cellsWeights[cidx].first);
+					out_weights.push_back(supermesh_cellsWeights[cidx].second);
+				}
+
+				out_offsets.push_back(out_cells.size());
+
+				if (supermesh_cellsWeights.size() != 1 || supermesh_cellsWeights[0].first != idx) identity = false;
+			}
 
-			return false;
+			out_identity[meshIdx] = identity;
 		}
+
+		out_rows_start.push_back(out_offsets.size() - 1);
+	}
+	catch (...) {
+
+		return false;
 	}
 
+	out_cells.shrink_to_fit();
+	out_weights.shrink_to_fit();
+
 	return true;
 }
 
@@ -1277,24 +1488,19 @@ std::vector<std::pair<INT3, double>> Transfer<VType>::get_flattened_transfer_in_
 {
 	std::vector<std::pair<INT3, double>> flattened_transfer_info;
 
-	if (!malloc_vector(flattened_transfer_info, transfer_in_info_size)) return flattened_transfer_info;
-
-	//go through all super-mesh cells (from transfer_in_info)
-	int store_index = 0;
+	if (!malloc_vector(flattened_transfer_info, in_cells.size())) return flattened_transfer_info;
 
-	for (int smcIdx = 0; smcIdx < transfer_in_info.size(); smcIdx++) {
+	//go through all super-mesh cells
+	for (int smcIdx = 0; smcIdx < (int)in_offsets.size() - 1; smcIdx++) {
 
 		//go through all contributions to this cell
-		for (int cidx = 0; cidx < transfer_in_info[smcIdx].size(); cidx++) {
+		for (size_t cidx = in_offsets[smcIdx]; cidx < in_offsets[smcIdx + 1]; cidx++) {
 
 			//in mesh and contributing cell index
-			INT2 full_index = transfer_in_info[smcIdx][cidx].first;
+			INT2 full_index = in_cells[cidx];
 
-			//weight for in transfer for this super-mesh cell and in mesh cell
-			double in_weight = transfer_in_info[smcIdx][cidx].second;
-
-			//store flattened info
-			flattened_transfer_info[store_index++] = std::pair<INT3, double>(INT3(full_index.i, full_index.j, smcIdx), in_weight);
+			//store flattened info, with weight for in transfer for this super-mesh cell and in mesh cell
+			flattened_transfer_info[cidx] = std::pair<INT3, double>(INT3(full_index.i, full_index.j, smcIdx), in_weights[cidx]);
 		}
 	}
 
@@ -1308,28 +1514,24 @@ std::vector<std::pair<INT3, double>> Transfer<VType>::get_flattened_transfer_out
 {
 	std::vector<std::pair<INT3, double>> flattened_transfer_info;
 
-	if (!malloc_vector(flattened_transfer_info, transfer_out_info_size)) return flattened_transfer_info;
-
-	//go through all output meshes cells (from transfer_out_info)
-	int store_index = 0;
+	if (!malloc_vector(flattened_transfer_info, out_cells.size())) return flattened_transfer_info;
 
 	//parse output meshes
-	for (int meshIdx = 0; meshIdx < transfer_out_info.size(); meshIdx++) {
+	for (int meshIdx = 0; meshIdx < (int)out_rows_start.size() - 1; meshIdx++) {
 
 		//parse all cells in each output mesh
-		for (int cellIdx = 0; cellIdx < transfer_out_info[meshIdx].size(); cellIdx++) {
+		for (int cellIdx = 0; cellIdx < (int)(out_rows_start[meshIdx + 1] - out_rows_start[meshIdx]); cellIdx++) {
 
-			//go through all super-mesh cells contributions to this mesh cell
-			for (int idx = 0; idx < transfer_out_info[meshIdx][cellIdx].size(); idx++) {
+			size_t row = out_rows_start[meshIdx] + cellIdx;
 
-				INT3 full_index = INT3(meshIdx, cellIdx, transfer_out_info[meshIdx][cellIdx][idx].first);
-				double out_weight = transfer_out_info[meshIdx][cellIdx][idx].second;
+			//go through all super-mesh cells contributions to this mesh cell
+			for (size_t cidx = out_offsets[row]; cidx < out_offsets[row + 1]; cidx++) {
 
 				//store flattened info
-				flattened_transfer_info[store_index++] = std::pair<INT3, double>(full_index, out_weight);
+				flattened_transfer_info[cidx] = std::pair<INT3, double>(INT3(meshIdx, cellIdx, out_cells[cidx]), out_weights[cidx]);
 			}
 		}
 	}
 
 	return flattened_transfer_info;
-}
\ No newline at end of file
+}
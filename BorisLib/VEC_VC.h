@@ -10,6 +10,7 @@
 /////////////////////////////////////////////////////////////////////
 
 template <typename VType> class CGSolve;
+template <typename VType> class MGSolve;
 
 struct CMBNDInfo;
 
@@ -24,6 +25,7 @@ class VEC_VC :
 {
 
 	friend CGSolve<VType>;
+	friend MGSolve<VType>;
 
 //the following are used as masks for ngbrFlags. 32 bits in total (4 bytes for an int)
 
@@ -287,6 +289,12 @@ private:
 	//get average value from composite shape
 	VType shape_valuegetter(std::vector<std::function<bool(DBL3, DBL3)>> shape_methods, std::vector<MeshShape> shapes);
 
+	//---------------------------------------------LAPLACE / POISSON EQUATION : VEC_VC_solve.h
+
+	//SOR iteration for Poisson equation with RHS (and boundary differential if nhneumann) given as callables taking the cell index : used by all IteratePoisson_SOR methods without Tensor_RHS
+	template <bool nhneumann, typename RHSFunction, typename BDiffFunction>
+	DBL2 IteratePoisson_SOR_Kernel(RHSFunction& Poisson_RHS, BDiffFunction& bdiff, double relaxation_param);
+
 public:
 
 	//--------------------------------------------CONSTRUCTORS : VEC_VC_mng.h
@@ -757,6 +765,9 @@ public:
 	//The K constant is used in Robin boundary condition calculations, where -K*diff_norm(T) = alpha*(Tboundary - Tambient) is the flux normal to the boundary - K is the thermal conductivity in the heat equation
 	VType delsq_robin(int idx, double K) const;
 
+	//coefficient of the value at cell idx in delsq_robin(idx, K) : used by implicit solvers
+	double delsq_robin_diag(int idx, double K) const;
+
 	//----GRADIENT OPERATOR : VEC_VC_grad.h
 
 	//gradient operator. Use Neumann boundary conditions (homogeneous).
@@ -944,6 +955,10 @@ public:
 	template <typename Owner>
 	DBL2 IteratePoisson_SOR(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, double relaxation_param = 1.9);
 
+	//As above, but Poisson_RHS is any callable taking the cell index and returning VType, e.g. a lambda calling a const method of the owner : it is inlined in the SOR loop so prefer this to the std::function version.
+	template <typename RHSFunction>
+	DBL2 IteratePoisson_SOR_Func(RHSFunction Poisson_RHS, double relaxation_param = 1.9);
+
 	//This solves delsq V = F + M * V : For M use Tensor_RHS (For VType double M returns type double, For VType DBL3 M returns DBL33)
 	//For Poisson equation we need a function to specify the RHS of the equation delsq V = F : use Poisson_RHS
 	//F must be a member const method of Owner taking an index value (the index ranges over this VEC) and returning a double value : F(index) evaluated at the index-th cell.
@@ -958,6 +973,10 @@ public:
 	template <typename Owner>
 	DBL2 IteratePoisson_SOR(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, double relaxation_param = 1.9);
 
+	//As above with callables taking the cell index : Poisson_RHS returns VType, bdiff returns VAL3<VType>, and bdiff is evaluated at most once per cell.
+	template <typename RHSFunction, typename BDiffFunction>
+	DBL2 IteratePoisson_SOR_Func(RHSFunction Poisson_RHS, BDiffFunction bdiff, double relaxation_param);
+
 	//This solves delsq V = F + M * V : For M use Tensor_RHS (For VType double M returns type double, For VType DBL3 M returns DBL33)
 	//Poisson equation solved using SOR, but using non-homogeneous Neumann boundary condition - this is evaluated using the bdiff call-back method.
 	//NOTE : the boundary differential is specified with 3 components, one for each of +x, +y, +z surface normal directions
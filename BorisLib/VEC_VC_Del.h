@@ -781,4 +781,54 @@ VType VEC_VC<VType>::delsq_robin(int idx, double K) const
 	diff_z /= (VEC<VType>::h.z*VEC<VType>::h.z);
 
 	return (diff_x + diff_y + diff_z);
-}
\ No newline at end of file
+}
+//coefficient of the value at cell idx in delsq_robin(idx, K), i.e. delsq_robin(idx, K) = diagonal * quantity[idx] + (terms not depending on quantity[idx]).
+//Used by implicit solvers which need to separate the diagonal part of the operator.
+template <typename VType>
+double VEC_VC<VType>::delsq_robin_diag(int idx, double K) const
+{
+	double diag_x = 0.0, diag_y = 0.0, diag_z = 0.0;
+
+	if (!(ngbrFlags[idx] & NF_NOTEMPTY)) return 0.0;
+
+	//x axis
+	if ((ngbrFlags[idx] & NF_BOTHX) == NF_BOTHX) diag_x = -2.0;
+	else if (ngbrFlags2.size() && (ngbrFlags2[idx] & NF2_CMBNDX)) diag_x = 0.0;
+	else if (ngbrFlags[idx] & NF_NGBRX) {
+
+		if (ngbrFlags2.size() && (ngbrFlags2[idx] & NF2_ROBINX)) {
+
+			double alpha = (ngbrFlags2[idx] & NF2_ROBINV ? robin_v.i : (ngbrFlags2[idx] & NF2_ROBINPX ? robin_nx.i : robin_px.i));
+			diag_x = -(1 + 3 * alpha * VEC<VType>::h.x / (2 * K));
+		}
+		else diag_x = (ngbrFlags[idx] & NF_PBCX ? -2.0 : -1.0);
+	}
+
+	//y axis
+	if ((ngbrFlags[idx] & NF_BOTHY) == NF_BOTHY) diag_y = -2.0;
+	else if (ngbrFlags2.size() && (ngbrFlags2[idx] & NF2_CMBNDY)) diag_y = 0.0;
+	else if (ngbrFlags[idx] & NF_NGBRY) {
+
+		if (ngbrFlags2.size() && (ngbrFlags2[idx] & NF2_ROBINY)) {
+
+			double alpha = (ngbrFlags2[idx] & NF2_ROBINV ? robin_v.i : (ngbrFlags2[idx] & NF2_ROBINPY ? robin_ny.i : robin_py.i));
+			diag_y = -(1 + 3 * alpha * VEC<VType>::h.y / (2 * K));
+		}
+		else diag_y = (ngbrFlags[idx] & NF_PBCY ? -2.0 : -1.0);
+	}
+
+	//z axis
+	if ((ngbrFlags[idx] & NF_BOTHZ) == NF_BOTHZ) diag_z = -2.0;
+	else if (ngbrFlags2.size() && (ngbrFlags2[idx] & NF2_CMBNDZ)) diag_z = 0.0;
+	else if (ngbrFlags[idx] & NF_NGBRZ) {
+
+		if (ngbrFlags2.size() && (ngbrFlags2[idx] & NF2_ROBINZ)) {
+
+			double alpha = (ngbrFlags2[idx] & NF2_ROBINV ? robin_v.i : (ngbrFlags2[idx] & NF2_ROBINPZ ? robin_nz.i : robin_pz.i));
+			diag_z = -(1 + 3 * alpha * VEC<VType>::h.z / (2 * K));
+		}
+		else diag_z = (ngbrFlags[idx] & NF_PBCZ ? -2.0 : -1.0);
+	}
+
+	return diag_x / (VEC<VType>::h.x*VEC<VType>::h.x) + diag_y / (VEC<VType>::h.y*VEC<VType>::h.y) + diag_z / (VEC<VType>::h.z*VEC<VType>::h.z);
+}
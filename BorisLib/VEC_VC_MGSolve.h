@@ -0,0 +1,635 @@
+#pragma once
+
+#include "VEC_VC.h"
+#include "VEC_VC_Solve.h"
+
+//-------------------------------- Geometric Multigrid Solver
+
+//Multigrid solver for the Poisson equation delsq V = F on a VEC_VC, used as an alternative to repeated IteratePoisson_SOR calls.
+//Each call to Iterate takes one multigrid cycle, and replaces one SOR iteration in the outer solver loop (which also sets CMBND cells between meshes after each iteration).
+
+//MG Solver flow:
+
+//1. Pre-smooth on the fine level using the red-black IteratePoisson_SOR method (Gauss-Seidel, i.e. relaxation 1) : this includes all boundary conditions and the RHS.
+//2. Calculate the fine level residual r = F - L V, where L is the same discretisation relaxed by IteratePoisson_SOR (Dirichlet, homogeneous or non-homogeneous Neumann).
+//   The RHS F is evaluated with the current V (lagged, as in SOR), and the residual is zero on composite media boundary cells as these are fixed here.
+//3. Restrict the residual to the next coarse level and solve L e = r there for the correction e, recursively (V-cycle for cycle_gamma = 1, W-cycle for cycle_gamma = 2) :
+//   On coarse levels red-black Gauss-Seidel smoothing is used with homogeneous boundary conditions : Dirichlet faces have zero correction, coarse cells containing composite media boundary cells are fixed at zero correction.
+//4. Prolongate the correction (piecewise constant) and add it to V in non-empty, non-fixed cells.
+//5. Post-smooth on the fine level.
+
+//Coarse levels are obtained by halving each dimension with more than one cell; a coarse cell is non-empty if any of its children are non-empty.
+//Coarse level flags are recalculated on each cycle, so changes in mesh shape or electrodes are picked up without any extra calls.
+
+template <typename VType>
+class MGSolve {
+
+	friend VEC_VC<VType>;
+
+private:
+
+	//flags used for coarse level cells
+	enum { MGF_NOTEMPTY = 1, MGF_FIXED = 2, MGF_DIRICHLETPX = 4, MGF_DIRICHLETNX = 8, MGF_DIRICHLETPY = 16, MGF_DIRICHLETNY = 32, MGF_DIRICHLETPZ = 64, MGF_DIRICHLETNZ = 128 };
+
+	//coarse level data
+	struct MGLevel {
+
+		//dimensions and cellsize
+		SZ3 n;
+		DBL3 h;
+
+		//coarsening factor (1 or 2) along each axis, relative to the previous (finer) level
+		INT3 c;
+
+		//coarse level flags (MGF_ values)
+		std::vector<int> flags;
+
+		//correction (solution on this level), right-hand side (restricted residual from finer level), and residual on this level
+		std::vector<VType> e, r, res;
+	};
+
+private:
+
+	//The VEC_VC holding the quantity to solve for
+	VEC_VC<VType>* pV;
+
+	//coarse levels : levels[0] is obtained from the fine level in *pV
+	std::vector<MGLevel> levels;
+
+	//fine level residual
+	std::vector<VType> res;
+
+	//fine level values at start of cycle, used to calculate the maximum change
+	std::vector<VType> V_start;
+
+	//number of pre- and post-smoothing sweeps on each level, and number of sweeps on the coarsest level
+	int pre_sweeps = 2, post_sweeps = 2, coarsest_sweeps = 50;
+
+	//stop coarsening when a level has at most this number of cells
+	int min_coarse_cells = 64;
+
+	OmpReduction<double> reduction_change, reduction_value;
+
+private:
+
+	//make coarse levels with flags from the fine level flags in *pV. Memory is only re-allocated if dimensions changed.
+	void build_levels(void);
+
+	//get weighted neighbor sum and total weight for a coarse level cell (same form as IteratePoisson_SOR, but with homogeneous boundary conditions), so L e = (weighted_sum - total_weight * e) / h_max_sq.
+	void coarse_stencil(const MGLevel& level, int i, int j, int k, double h_max_sq, VType& weighted_sum, double& total_weight);
+
+	//fine level residual F - L V at non-empty, non-CMBND cell idx, with the same discretisation as IteratePoisson_SOR. Use bdiff if set (non-homogeneous Neumann boundary conditions).
+	VType fine_residual(int idx, std::function<VType(int)>& F, std::function<VAL3<VType>(int)>& bdiff, double h_max_sq, DBL3 w);
+
+	//red-black Gauss-Seidel sweeps on given coarse level
+	void smooth_level(MGLevel& level, int sweeps);
+
+	//restrict residual on given coarse level (res) to next coarse level (r), and zero the next level correction
+	void restrict_level(int level_idx);
+
+	//recursive multigrid cycle on given coarse level
+	void cycle_level(int level_idx, int cycle_gamma);
+
+	//one full cycle starting from the fine level : smooth_fine takes one fine level SOR iteration
+	DBL2 cycle(std::function<VType(int)> F, std::function<VAL3<VType>(int)> bdiff, std::function<void(void)> smooth_fine, int cycle_gamma);
+
+public:
+
+	MGSolve(VEC_VC<VType>* pV_) :
+		pV(pV_)
+	{}
+
+	//number of coarse levels used in the last cycle
+	int GetNumLevels(void) { return (int)levels.size(); }
+
+	//----POISSON EQUATION delsq V = F with Dirichlet boundary conditions where set, and homogeneous Neumann boundary conditions. Composite media boundary cells are not changed.
+
+	//Take one multigrid cycle (V-cycle if cycle_gamma = 1, W-cycle if cycle_gamma = 2). Poisson_RHS as for IteratePoisson_SOR.
+	//Return un-normalized error (maximum change in quantity over the cycle) - first - and maximum value  -second - divide them to obtain normalized error
+	template <typename Owner>
+	DBL2 Iterate(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, int cycle_gamma = 1);
+
+	//As above but using non-homogeneous Neumann boundary conditions, evaluated using the bdiff call-back method, as for IteratePoisson_SOR.
+	template <typename Owner>
+	DBL2 Iterate(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, int cycle_gamma = 1);
+};
+
+//-------------------------------------------------------------------------------------------------
+
+//make coarse levels with flags from the fine level flags in *pV. Memory is only re-allocated if dimensions changed.
+template <typename VType>
+void MGSolve<VType>::build_levels(void)
+{
+	//first work out number of levels and their dimensions
+	SZ3 n = pV->n;
+	DBL3 h = pV->h;
+
+	int num_levels = 0;
+
+	while ((int)n.dim() > min_coarse_cells && (n.x > 1 || n.y > 1 || n.z > 1)) {
+
+		INT3 c = INT3(n.x > 1 ? 2 : 1, n.y > 1 ? 2 : 1, n.z > 1 ? 2 : 1);
+
+		n = SZ3((n.x + c.x - 1) / c.x, (n.y + c.y - 1) / c.y, (n.z + c.z - 1) / c.z);
+		h = DBL3(h.x * c.x, h.y * c.y, h.z * c.z);
+
+		if (num_levels >= (int)levels.size()) levels.push_back(MGLevel());
+
+		MGLevel& level = levels[num_levels];
+
+		level.c = c;
+		level.h = h;
+
+		if (level.n != n) {
+
+			level.n = n;
+			level.flags.assign(n.dim(), 0);
+			level.e.assign(n.dim(), VType());
+			level.r.assign(n.dim(), VType());
+			level.res.assign(n.dim(), VType());
+		}
+
+		num_levels++;
+	}
+
+	levels.resize(num_levels);
+
+	if (res.size() != pV->n.dim()) res.assign(pV->n.dim(), VType());
+	if (V_start.size() != pV->n.dim()) V_start.assign(pV->n.dim(), VType());
+
+	bool using_extended_flags = pV->ngbrFlags2.size();
+
+	//now set flags on each level from the finer level
+	for (int level_idx = 0; level_idx < (int)levels.size(); level_idx++) {
+
+		MGLevel& level = levels[level_idx];
+
+		SZ3 n_fine = (level_idx ? levels[level_idx - 1].n : pV->n);
+
+		#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < level.n.y * level.n.z; idx_jk++) {
+
+			int j = idx_jk % level.n.y;
+			int k = idx_jk / level.n.y;
+
+			for (int i = 0; i < level.n.x; i++) {
+
+				int flags = 0;
+
+				for (int kf = k * level.c.z; kf < (k + 1) * level.c.z && kf < n_fine.z; kf++) {
+					for (int jf = j * level.c.y; jf < (j + 1) * level.c.y && jf < n_fine.y; jf++) {
+						for (int i_f = i * level.c.x; i_f < (i + 1) * level.c.x && i_f < n_fine.x; i_f++) {
+
+							int idx_f = i_f + jf * n_fine.x + kf * n_fine.x * n_fine.y;
+
+							if (level_idx) {
+
+								//from coarse level flags : all flags carry over
+								flags |= levels[level_idx - 1].flags[idx_f];
+							}
+							else {
+
+								//from fine level flags
+								if (!(pV->ngbrFlags[idx_f] & NF_NOTEMPTY)) continue;
+
+								flags |= MGF_NOTEMPTY;
+
+								if (!using_extended_flags) continue;
+
+								int ngbrFlags2 = pV->ngbrFlags2[idx_f];
+
+								if (ngbrFlags2 & NF2_CMBND) flags |= MGF_FIXED;
+
+								if (ngbrFlags2 & NF2_DIRICHLETPX) flags |= MGF_DIRICHLETPX;
+								if (ngbrFlags2 & NF2_DIRICHLETNX) flags |= MGF_DIRICHLETNX;
+								if (ngbrFlags2 & NF2_DIRICHLETPY) flags |= MGF_DIRICHLETPY;
+								if (ngbrFlags2 & NF2_DIRICHLETNY) flags |= MGF_DIRICHLETNY;
+								if (ngbrFlags2 & NF2_DIRICHLETPZ) flags |= MGF_DIRICHLETPZ;
+								if (ngbrFlags2 & NF2_DIRICHLETNZ) flags |= MGF_DIRICHLETNZ;
+							}
+						}
+					}
+				}
+
+				level.flags[i + j * level.n.x + k * level.n.x * level.n.y] = flags;
+			}
+		}
+	}
+
+	//drop coarse levels which have no free cells left (e.g. small meshes entirely covered by composite media boundary cells after coarsening)
+	for (int level_idx = 0; level_idx < (int)levels.size(); level_idx++) {
+
+		bool free_cells = false;
+
+		for (int idx = 0; idx < (int)levels[level_idx].flags.size(); idx++) {
+
+			if ((levels[level_idx].flags[idx] & (MGF_NOTEMPTY + MGF_FIXED)) == MGF_NOTEMPTY) {
+
+				free_cells = true;
+				break;
+			}
+		}
+
+		if (!free_cells) {
+
+			levels.resize(level_idx);
+			break;
+		}
+	}
+}
+
+//get weighted neighbor sum and total weight for a coarse level cell (same form as IteratePoisson_SOR, but with homogeneous boundary conditions), so L e = (weighted_sum - total_weight * e) / h_max_sq.
+template <typename VType>
+void MGSolve<VType>::coarse_stencil(const MGLevel& level, int i, int j, int k, double h_max_sq, VType& weighted_sum, double& total_weight)
+{
+	const SZ3& n = level.n;
+	int idx = i + j * n.x + k * n.x * n.y;
+	int flags = level.flags[idx];
+
+	weighted_sum = VType();
+	total_weight = 0.0;
+
+	auto add_axis = [&](bool ngbr_p, bool ngbr_n, int stride, double w, int dirichlet_flags) {
+
+		if (ngbr_p && ngbr_n) {
+
+			total_weight += 2 * w;
+			weighted_sum += w * (level.e[idx - stride] + level.e[idx + stride]);
+		}
+		else if (flags & dirichlet_flags) {
+
+			//zero correction on Dirichlet face
+			if (ngbr_p)			{ total_weight += 6 * w; weighted_sum += 2 * w * level.e[idx + stride]; }
+			else if (ngbr_n)	{ total_weight += 6 * w; weighted_sum += 2 * w * level.e[idx - stride]; }
+			else				  total_weight += 4 * w;
+		}
+		else if (ngbr_p) {
+
+			total_weight += w;
+			weighted_sum += w * level.e[idx + stride];
+		}
+		else if (ngbr_n) {
+
+			total_weight += w;
+			weighted_sum += w * level.e[idx - stride];
+		}
+	};
+
+	add_axis(i < n.x - 1 && (level.flags[idx + 1] & MGF_NOTEMPTY), i > 0 && (level.flags[idx - 1] & MGF_NOTEMPTY), 1, h_max_sq / (level.h.x * level.h.x), MGF_DIRICHLETPX + MGF_DIRICHLETNX);
+	add_axis(j < n.y - 1 && (level.flags[idx + n.x] & MGF_NOTEMPTY), j > 0 && (level.flags[idx - n.x] & MGF_NOTEMPTY), n.x, h_max_sq / (level.h.y * level.h.y), MGF_DIRICHLETPY + MGF_DIRICHLETNY);
+	add_axis(k < n.z - 1 && (level.flags[idx + n.x * n.y] & MGF_NOTEMPTY), k > 0 && (level.flags[idx - n.x * n.y] & MGF_NOTEMPTY), n.x * n.y, h_max_sq / (level.h.z * level.h.z), MGF_DIRICHLETPZ + MGF_DIRICHLETNZ);
+}
+
+//fine level residual F - L V at non-empty, non-CMBND cell idx, with the same discretisation as IteratePoisson_SOR. Use bdiff if set (non-homogeneous Neumann boundary conditions).
+template <typename VType>
+VType MGSolve<VType>::fine_residual(int idx, std::function<VType(int)>& F, std::function<VAL3<VType>(int)>& bdiff, double h_max_sq, DBL3 w)
+{
+	VEC_VC<VType>& V = *pV;
+
+	int ngbrFlags = V.ngbrFlags[idx];
+	int ngbrFlags2 = (V.ngbrFlags2.size() ? V.ngbrFlags2[idx] : 0);
+
+	VType weighted_sum = VType(0);
+	double total_weight = 0;
+
+	VAL3<VType> boundary_diff = (bdiff && (ngbrFlags & (NF_BOTHX + NF_BOTHY + NF_BOTHZ)) != (NF_BOTHX + NF_BOTHY + NF_BOTHZ) ? bdiff(idx) : VAL3<VType>());
+
+	//x direction
+	if ((ngbrFlags & NF_BOTHX) == NF_BOTHX) {
+
+		total_weight += 2 * w.x;
+		weighted_sum += w.x * (V[idx - 1] + V[idx + 1]);
+	}
+	else if (ngbrFlags2 & NF2_DIRICHLETX) {
+
+		total_weight += 6 * w.x;
+
+		if (ngbrFlags2 & NF2_DIRICHLETPX) weighted_sum += w.x * (4 * V.get_dirichlet_value(NF2_DIRICHLETPX, idx) + 2 * V[idx + 1]);
+		else							  weighted_sum += w.x * (4 * V.get_dirichlet_value(NF2_DIRICHLETNX, idx) + 2 * V[idx - 1]);
+	}
+	else if (ngbrFlags & NF_NGBRX) {
+
+		total_weight += w.x;
+
+		if (ngbrFlags & NF_NPX) weighted_sum += w.x * (V[idx + 1] - boundary_diff.x * V.h.x);
+		else					weighted_sum += w.x * (V[idx - 1] + boundary_diff.x * V.h.x);
+	}
+
+	//y direction
+	if ((ngbrFlags & NF_BOTHY) == NF_BOTHY) {
+
+		total_weight += 2 * w.y;
+		weighted_sum += w.y * (V[idx - V.n.x] + V[idx + V.n.x]);
+	}
+	else if (ngbrFlags2 & NF2_DIRICHLETY) {
+
+		total_weight += 6 * w.y;
+
+		if (ngbrFlags2 & NF2_DIRICHLETPY) weighted_sum += w.y * (4 * V.get_dirichlet_value(NF2_DIRICHLETPY, idx) + 2 * V[idx + V.n.x]);
+		else							  weighted_sum += w.y * (4 * V.get_dirichlet_value(NF2_DIRICHLETNY, idx) + 2 * V[idx - V.n.x]);
+	}
+	else if (ngbrFlags & NF_NGBRY) {
+
+		total_weight += w.y;
+
+		if (ngbrFlags & NF_NPY) weighted_sum += w.y * (V[idx + V.n.x] - boundary_diff.y * V.h.y);
+		else					weighted_sum += w.y * (V[idx - V.n.x] + boundary_diff.y * V.h.y);
+	}
+
+	//z direction
+	if ((ngbrFlags & NF_BOTHZ) == NF_BOTHZ) {
+
+		total_weight += 2 * w.z;
+		weighted_sum += w.z * (V[idx - V.n.x * V.n.y] + V[idx + V.n.x * V.n.y]);
+	}
+	else if (ngbrFlags2 & NF2_DIRICHLETZ) {
+
+		total_weight += 6 * w.z;
+
+		if (ngbrFlags2 & NF2_DIRICHLETPZ) weighted_sum += w.z * (4 * V.get_dirichlet_value(NF2_DIRICHLETPZ, idx) + 2 * V[idx + V.n.x * V.n.y]);
+		else							  weighted_sum += w.z * (4 * V.get_dirichlet_value(NF2_DIRICHLETNZ, idx) + 2 * V[idx - V.n.x * V.n.y]);
+	}
+	else if (ngbrFlags & NF_NGBRZ) {
+
+		total_weight += w.z;
+
+		if (ngbrFlags & NF_NPZ) weighted_sum += w.z * (V[idx + V.n.x * V.n.y] - boundary_diff.z * V.h.z);
+		else					weighted_sum += w.z * (V[idx - V.n.x * V.n.y] + boundary_diff.z * V.h.z);
+	}
+
+	return F(idx) - (weighted_sum - total_weight * V[idx]) / h_max_sq;
+}
+
+//red-black Gauss-Seidel sweeps on given coarse level
+template <typename VType>
+void MGSolve<VType>::smooth_level(MGLevel& level, int sweeps)
+{
+	double h_max_sq = maximum(level.h.x, level.h.y, level.h.z);
+	h_max_sq *= h_max_sq;
+
+	for (int sweep = 0; sweep < sweeps; sweep++) {
+
+		//red-black : two passes will be taken
+		for (int rb = 0; rb < 2; rb++) {
+
+			#pragma omp parallel for
+			for (int idx_jk = 0; idx_jk < level.n.y * level.n.z; idx_jk++) {
+
+				int j = idx_jk % level.n.y;
+				int k = idx_jk / level.n.y;
+
+				//red_nudge = true for odd rows and even planes or for even rows and odd planes - have to keep index on the checkerboard pattern
+				bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
+
+				for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < level.n.x; i += 2) {
+
+					int idx = i + j * level.n.x + k * level.n.x * level.n.y;
+
+					if ((level.flags[idx] & (MGF_NOTEMPTY + MGF_FIXED)) != MGF_NOTEMPTY) continue;
+
+					VType weighted_sum;
+					double total_weight;
+					coarse_stencil(level, i, j, k, h_max_sq, weighted_sum, total_weight);
+
+					if (total_weight > 0.0) level.e[idx] = (weighted_sum - h_max_sq * level.r[idx]) / total_weight;
+				}
+			}
+		}
+	}
+}
+
+//restrict residual on given coarse level (res) to next coarse level (r), and zero the next level correction
+template <typename VType>
+void MGSolve<VType>::restrict_level(int level_idx)
+{
+	MGLevel& level = levels[level_idx];
+	MGLevel& coarse = levels[level_idx + 1];
+
+	double h_max_sq = maximum(level.h.x, level.h.y, level.h.z);
+	h_max_sq *= h_max_sq;
+
+	//residual on this level
+	#pragma omp parallel for
+	for (int idx_jk = 0; idx_jk < level.n.y * level.n.z; idx_jk++) {
+
+		int j = idx_jk % level.n.y;
+		int k = idx_jk / level.n.y;
+
+		for (int i = 0; i < level.n.x; i++) {
+
+			int idx = i + j * level.n.x + k * level.n.x * level.n.y;
+
+			if ((level.flags[idx] & (MGF_NOTEMPTY + MGF_FIXED)) != MGF_NOTEMPTY) { level.res[idx] = VType(); continue; }
+
+			VType weighted_sum;
+			double total_weight;
+			coarse_stencil(level, i, j, k, h_max_sq, weighted_sum, total_weight);
+
+			level.res[idx] = level.r[idx] - (weighted_sum - total_weight * level.e[idx]) / h_max_sq;
+		}
+	}
+
+	//average over non-empty children
+	#pragma omp parallel for
+	for (int idx_jk = 0; idx_jk < coarse.n.y * coarse.n.z; idx_jk++) {
+
+		int j = idx_jk % coarse.n.y;
+		int k = idx_jk / coarse.n.y;
+
+		for (int i = 0; i < coarse.n.x; i++) {
+
+			int idx = i + j * coarse.n.x + k * coarse.n.x * coarse.n.y;
+
+			VType sum = VType();
+			int count = 0;
+
+			for (int kf = k * coarse.c.z; kf < (k + 1) * coarse.c.z && kf < level.n.z; kf++) {
+				for (int jf = j * coarse.c.y; jf < (j + 1) * coarse.c.y && jf < level.n.y; jf++) {
+					for (int i_f = i * coarse.c.x; i_f < (i + 1) * coarse.c.x && i_f < level.n.x; i_f++) {
+
+						int idx_f = i_f + jf * level.n.x + kf * level.n.x * level.n.y;
+
+						if (level.flags[idx_f] & MGF_NOTEMPTY) {
+
+							sum += level.res[idx_f];
+							count++;
+						}
+					}
+				}
+			}
+
+			coarse.r[idx] = (count ? sum / count : VType());
+			coarse.e[idx] = VType();
+		}
+	}
+}
+
+//recursive multigrid cycle on given coarse level
+template <typename VType>
+void MGSolve<VType>::cycle_level(int level_idx, int cycle_gamma)
+{
+	MGLevel& level = levels[level_idx];
+
+	//coarsest level : just smooth
+	if (level_idx == (int)levels.size() - 1) {
+
+		smooth_level(level, coarsest_sweeps);
+		return;
+	}
+
+	smooth_level(level, pre_sweeps);
+
+	restrict_level(level_idx);
+
+	for (int gamma = 0; gamma < cycle_gamma; gamma++) cycle_level(level_idx + 1, cycle_gamma);
+
+	//prolongate correction (piecewise constant) and add it
+	MGLevel& coarse = levels[level_idx + 1];
+
+	#pragma omp parallel for
+	for (int idx_jk = 0; idx_jk < level.n.y * level.n.z; idx_jk++) {
+
+		int j = idx_jk % level.n.y;
+		int k = idx_jk / level.n.y;
+
+		for (int i = 0; i < level.n.x; i++) {
+
+			int idx = i + j * level.n.x + k * level.n.x * level.n.y;
+
+			if ((level.flags[idx] & (MGF_NOTEMPTY + MGF_FIXED)) != MGF_NOTEMPTY) continue;
+
+			level.e[idx] += coarse.e[i / coarse.c.x + (j / coarse.c.y) * coarse.n.x + (k / coarse.c.z) * coarse.n.x * coarse.n.y];
+		}
+	}
+
+	smooth_level(level, post_sweeps);
+}
+
+//one full cycle starting from the fine level : smooth_fine takes one fine level SOR iteration
+template <typename VType>
+DBL2 MGSolve<VType>::cycle(std::function<VType(int)> F, std::function<VAL3<VType>(int)> bdiff, std::function<void(void)> smooth_fine, int cycle_gamma)
+{
+	VEC_VC<VType>& V = *pV;
+
+	build_levels();
+
+	bool using_extended_flags = V.ngbrFlags2.size();
+
+	std::copy(V.quantity.begin(), V.quantity.end(), V_start.begin());
+
+	//1. pre-smooth
+	for (int sweep = 0; sweep < pre_sweeps; sweep++) smooth_fine();
+
+	if (levels.size()) {
+
+		//2. fine level residual
+		double h_max_sq = maximum(V.h.x, V.h.y, V.h.z);
+		h_max_sq *= h_max_sq;
+
+		DBL3 w = DBL3(h_max_sq / (V.h.x * V.h.x), h_max_sq / (V.h.y * V.h.y), h_max_sq / (V.h.z * V.h.z));
+
+		#pragma omp parallel for
+		for (int idx = 0; idx < (int)V.n.dim(); idx++) {
+
+			if ((using_extended_flags && (V.ngbrFlags2[idx] & NF2_CMBND)) || !(V.ngbrFlags[idx] & NF_NOTEMPTY)) res[idx] = VType();
+			else res[idx] = fine_residual(idx, F, bdiff, h_max_sq, w);
+		}
+
+		//3. restrict to first coarse level (average over non-empty children) then solve for correction
+		MGLevel& coarse = levels[0];
+
+		#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < coarse.n.y * coarse.n.z; idx_jk++) {
+
+			int j = idx_jk % coarse.n.y;
+			int k = idx_jk / coarse.n.y;
+
+			for (int i = 0; i < coarse.n.x; i++) {
+
+				int idx = i + j * coarse.n.x + k * coarse.n.x * coarse.n.y;
+
+				VType sum = VType();
+				int count = 0;
+
+				for (int kf = k * coarse.c.z; kf < (k + 1) * coarse.c.z && kf < V.n.z; kf++) {
+					for (int jf = j * coarse.c.y; jf < (j + 1) * coarse.c.y && jf < V.n.y; jf++) {
+						for (int i_f = i * coarse.c.x; i_f < (i + 1) * coarse.c.x && i_f < V.n.x; i_f++) {
+
+							int idx_f = i_f + jf * V.n.x + kf * V.n.x * V.n.y;
+
+							if (V.ngbrFlags[idx_f] & NF_NOTEMPTY) {
+
+								sum += res[idx_f];
+								count++;
+							}
+						}
+					}
+				}
+
+				coarse.r[idx] = (count ? sum / count : VType());
+				coarse.e[idx] = VType();
+			}
+		}
+
+		for (int gamma = 0; gamma < cycle_gamma; gamma++) cycle_level(0, cycle_gamma);
+
+		//4. prolongate correction (piecewise constant) and add it
+		#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < V.n.y * V.n.z; idx_jk++) {
+
+			int j = idx_jk % V.n.y;
+			int k = idx_jk / V.n.y;
+
+			for (int i = 0; i < V.n.x; i++) {
+
+				int idx = i + j * V.n.x + k * V.n.x * V.n.y;
+
+				if ((using_extended_flags && (V.ngbrFlags2[idx] & NF2_CMBND)) || !(V.ngbrFlags[idx] & NF_NOTEMPTY)) continue;
+
+				V[idx] += coarse.e[i / coarse.c.x + (j / coarse.c.y) * coarse.n.x + (k / coarse.c.z) * coarse.n.x * coarse.n.y];
+			}
+		}
+	}
+
+	//5. post-smooth
+	for (int sweep = 0; sweep < post_sweeps; sweep++) smooth_fine();
+
+	//maximum change over the cycle, and maximum value
+	reduction_change.new_minmax_reduction();
+	reduction_value.new_minmax_reduction();
+
+	#pragma omp parallel for
+	for (int idx = 0; idx < (int)V.n.dim(); idx++) {
+
+		if ((using_extended_flags && (V.ngbrFlags2[idx] & NF2_CMBND)) || !(V.ngbrFlags[idx] & NF_NOTEMPTY)) continue;
+
+		reduction_change.reduce_max(GetMagnitude(V[idx] - V_start[idx]));
+		reduction_value.reduce_max(GetMagnitude(V[idx]));
+	}
+
+	return DBL2(reduction_change.maximum(), reduction_value.maximum());
+}
+
+//Take one multigrid cycle (V-cycle if cycle_gamma = 1, W-cycle if cycle_gamma = 2). Poisson_RHS as for IteratePoisson_SOR.
+template <typename VType>
+template <typename Owner>
+DBL2 MGSolve<VType>::Iterate(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, int cycle_gamma)
+{
+	return cycle(
+		[&](int idx) -> VType { return Poisson_RHS(instance, idx); },
+		std::function<VAL3<VType>(int)>(),
+		[&](void) { pV->template IteratePoisson_SOR<Owner>(Poisson_RHS, instance, 1.0); },
+		cycle_gamma);
+}
+
+//As above but using non-homogeneous Neumann boundary conditions, evaluated using the bdiff call-back method, as for IteratePoisson_SOR.
+template <typename VType>
+template <typename Owner>
+DBL2 MGSolve<VType>::Iterate(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, int cycle_gamma)
+{
+	return cycle(
+		[&](int idx) -> VType { return Poisson_RHS(instance, idx); },
+		[&](int idx) -> VAL3<VType> { return bdiff(instance, idx); },
+		[&](void) { pV->template IteratePoisson_SOR<Owner>(Poisson_RHS, bdiff, instance, 1.0); },
+		cycle_gamma);
+}
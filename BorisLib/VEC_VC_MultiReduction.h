@@ -0,0 +1,249 @@
+#pragma once
+
+#include <omp.h>
+#include <vector>
+
+#include "VEC_VC.h"
+
+//Several reductions (averages and min-max values, each in its own rectangle) on a VEC_VC computed in a single parallel sweep over the mesh.
+//Results are the same as for the individual average_nonempty_omp, get_minmax and get_minmax_component_x/y/z methods with the same rectangles,
+//but the VEC is only read once for all of them. Used when saving data, where many output columns are computed from the same VEC.
+//
+//Each object has its own per-thread accumulators, so unlike the VEC reduction methods different objects can be used concurrently.
+//
+//Usage:
+//
+//VEC_VC_MultiReduction<DBL3> plan;
+//int av_entry = plan.add_average(rect1);
+//int mm_entry = plan.add_minmax(MULTIREDUCTION_MINMAX, rect2);
+//plan.reduce(M);
+//DBL3 av = plan.average(av_entry);
+//DBL2 mm = plan.minmax(mm_entry);
+
+//types of reductions which can be added to a plan
+enum MULTIREDUCTION_ {
+
+	//average over non-empty cells
+	MULTIREDUCTION_AVERAGE,
+
+	//min-max of magnitude over non-empty cells
+	MULTIREDUCTION_MINMAX,
+
+	//min-max of x, y or z component over non-empty cells
+	MULTIREDUCTION_MINMAX_X, MULTIREDUCTION_MINMAX_Y, MULTIREDUCTION_MINMAX_Z
+};
+
+template <typename VType>
+class VEC_VC_MultiReduction {
+
+private:
+
+	struct Entry {
+
+		MULTIREDUCTION_ type;
+
+		//rectangle relative to the VEC rect, null for the entire VEC
+		Rect rectangle;
+
+		//box of cells for the rectangle, set in reduce. Null if the rectangle doesn't intersect the VEC.
+		Box box;
+	};
+
+	//per-thread accumulator for one entry, padded to a cache line so threads don't share lines (false sharing)
+	struct alignas(64) Accumulator {
+
+		VType sum = VType();
+		int count = 0;
+
+		double min = 0.0, max = 0.0;
+	};
+
+	std::vector<Entry> entries;
+
+	//accumulators for thread tn and entry e are at index tn * entries.size() + e
+	std::vector<Accumulator> accumulators;
+
+	//final results for each entry
+	std::vector<VType> averages;
+	std::vector<DBL2> minmaxes;
+
+private:
+
+	//component and magnitude values used for min-max reductions
+	static double component(const DBL3& value, int component_idx) { return (component_idx == 0 ? value.x : (component_idx == 1 ? value.y : value.z)); }
+	static double component(const DBL2& value, int component_idx) { return (component_idx == 0 ? value.x : value.y); }
+	static double component(double value, int component_idx) { return value; }
+
+	static double magnitude(const DBL3& value) { return value.norm(); }
+	static double magnitude(const DBL2& value) { return value.norm(); }
+	static double magnitude(double value) { return fabs(value); }
+
+	void reduce_minmax(Accumulator& acc, double value)
+	{
+		if (!acc.count) acc.min = acc.max = value;
+		else {
+
+			if (value < acc.min) acc.min = value;
+			if (value > acc.max) acc.max = value;
+		}
+
+		acc.count++;
+	}
+
+public:
+
+	//-------------------------------------------- PLAN
+
+	void clear(void) { entries.clear(); }
+
+	int size(void) const { return entries.size(); }
+
+	//add an average reduction in given rectangle (relative, null rectangle for entire VEC) : return entry index
+	int add_average(const Rect& rectangle = Rect())
+	{
+		entries.push_back({ MULTIREDUCTION_AVERAGE, rectangle, Box() });
+		return entries.size() - 1;
+	}
+
+	//add a min-max reduction (MULTIREDUCTION_MINMAX or MULTIREDUCTION_MINMAX_X/Y/Z) in given rectangle : return entry index
+	int add_minmax(MULTIREDUCTION_ type, const Rect& rectangle = Rect())
+	{
+		entries.push_back({ type, rectangle, Box() });
+		return entries.size() - 1;
+	}
+
+	//-------------------------------------------- REDUCTION
+
+	//compute all entries in a single sweep over vec : return false if out of memory
+	bool reduce(const VEC_VC<VType>& vec)
+	{
+		int num_entries = entries.size();
+		int OmpThreads = omp_get_num_procs();
+
+		if (!malloc_vector(averages, num_entries, VType())) return false;
+		if (!malloc_vector(minmaxes, num_entries, DBL2())) return false;
+		if (!num_entries || !vec.linear_size()) return true;
+
+		//boxes for all entries, with same conventions as average_nonempty_omp : null rectangle is the entire VEC, else cells intersecting the rectangle
+		//the sweep is done over the smallest box containing them all
+		Box sweep_box;
+		bool sweep_box_set = false;
+
+		for (int e = 0; e < num_entries; e++) {
+
+			if (entries[e].rectangle.IsNull()) entries[e].box = Box(vec.n);
+			else if (vec.rect.intersects(entries[e].rectangle + vec.rect.s)) entries[e].box = vec.box_from_rect_max(entries[e].rectangle + vec.rect.s);
+			else {
+
+				entries[e].box = Box();
+				continue;
+			}
+
+			if (!sweep_box_set) sweep_box = entries[e].box;
+			else sweep_box = Box(
+				INT3(std::min(sweep_box.s.i, entries[e].box.s.i), std::min(sweep_box.s.j, entries[e].box.s.j), std::min(sweep_box.s.k, entries[e].box.s.k)),
+				INT3(std::max(sweep_box.e.i, entries[e].box.e.i), std::max(sweep_box.e.j, entries[e].box.e.j), std::max(sweep_box.e.k, entries[e].box.e.k)));
+
+			sweep_box_set = true;
+		}
+
+		if (!sweep_box_set) return true;
+
+		if (!malloc_vector(accumulators, OmpThreads * num_entries, Accumulator())) return false;
+
+		//magnitude only needs computing once per cell if any magnitude min-max entries
+		bool need_magnitude = false;
+		for (int e = 0; e < num_entries; e++) if (entries[e].type == MULTIREDUCTION_MINMAX) need_magnitude = true;
+
+		INT3 n = vec.n;
+		INT3 box_size = sweep_box.size();
+
+#pragma omp parallel for
+		for (int idx_box = 0; idx_box < box_size.dim(); idx_box++) {
+
+			//i, j, k values inside the mesh from the box cell index
+			int i = (idx_box % box_size.x) + sweep_box.s.i;
+			int j = ((idx_box / box_size.x) % box_size.y) + sweep_box.s.j;
+			int k = (idx_box / (box_size.x * box_size.y)) + sweep_box.s.k;
+
+			int idx = i + j * n.x + k * n.x * n.y;
+
+			if (idx < 0 || idx >= n.dim() || !vec.is_not_empty(idx)) continue;
+
+			const VType& value = vec[idx];
+			double value_magnitude = (need_magnitude ? magnitude(value) : 0.0);
+
+			Accumulator* pacc = &accumulators[omp_get_thread_num() * num_entries];
+
+			for (int e = 0; e < num_entries; e++) {
+
+				const Box& box = entries[e].box;
+				if (i < box.s.i || i >= box.e.i || j < box.s.j || j >= box.e.j || k < box.s.k || k >= box.e.k) continue;
+
+				switch (entries[e].type) {
+
+				case MULTIREDUCTION_AVERAGE:
+					pacc[e].sum += value;
+					pacc[e].count++;
+					break;
+
+				case MULTIREDUCTION_MINMAX:
+					reduce_minmax(pacc[e], value_magnitude);
+					break;
+
+				case MULTIREDUCTION_MINMAX_X:
+					reduce_minmax(pacc[e], component(value, 0));
+					break;
+
+				case MULTIREDUCTION_MINMAX_Y:
+					reduce_minmax(pacc[e], component(value, 1));
+					break;
+
+				case MULTIREDUCTION_MINMAX_Z:
+					reduce_minmax(pacc[e], component(value, 2));
+					break;
+				}
+			}
+		}
+
+		//combine thread results
+		for (int e = 0; e < num_entries; e++) {
+
+			VType sum = VType();
+			int count = 0;
+			bool minmax_set = false;
+
+			for (int tn = 0; tn < OmpThreads; tn++) {
+
+				Accumulator& acc = accumulators[tn * num_entries + e];
+				if (!acc.count) continue;
+
+				if (entries[e].type == MULTIREDUCTION_AVERAGE) {
+
+					sum += acc.sum;
+					count += acc.count;
+				}
+				else if (!minmax_set) {
+
+					minmaxes[e] = DBL2(acc.min, acc.max);
+					minmax_set = true;
+				}
+				else {
+
+					if (acc.min < minmaxes[e].i) minmaxes[e].i = acc.min;
+					if (acc.max > minmaxes[e].j) minmaxes[e].j = acc.max;
+				}
+			}
+
+			if (count) averages[e] = sum / count;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------- RESULTS
+
+	//results available after reduce
+	VType average(int entry) const { return averages[entry]; }
+	DBL2 minmax(int entry) const { return minmaxes[entry]; }
+};
@@ -143,9 +143,11 @@ DBL2 VEC_VC<VType>::IterateLaplace_SOR(double relaxation_param)
 
 //-------------------------------- POISSON EQUATION
 
+//SOR iteration kernel for Poisson equation, with RHS and (if nhneumann) boundary differential given as callables taking the cell index, so they can be inlined in the loop.
+//bdiff is evaluated at most once per cell, and only in cells which need it.
 template <typename VType>
-template <typename Owner>
-DBL2 VEC_VC<VType>::IteratePoisson_SOR(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, double relaxation_param)
+template <bool nhneumann, typename RHSFunction, typename BDiffFunction>
+DBL2 VEC_VC<VType>::IteratePoisson_SOR_Kernel(RHSFunction& Poisson_RHS, BDiffFunction& bdiff, double relaxation_param)
 {
 	//get maximum cell side
 	double h_max_sq = maximum(VEC<VType>::h.x, VEC<VType>::h.y, VEC<VType>::h.z);
@@ -162,12 +164,18 @@ DBL2 VEC_VC<VType>::IteratePoisson_SOR(std::function<VType(const Owner&, int)> P
 	//need to check for DIRICHLET flags which are held in the extended ngbrFlags (may be empty if not set)
 	bool using_extended_flags = ngbrFlags2.size();
 
+	int nx = VEC<VType>::n.x;
+	int nxy = VEC<VType>::n.x * VEC<VType>::n.y;
+
+	VType* V = VEC<VType>::quantity.data();
+	const int* flags = ngbrFlags.data();
+	const int* flags2 = (using_extended_flags ? ngbrFlags2.data() : nullptr);
+
 	//red-black : two passes will be taken
-	int rb = 0;
-	while (rb < 2) {
+	for (int rb = 0; rb < 2; rb++) {
 
-		#pragma omp parallel for
-		for(int idx_jk = 0; idx_jk < VEC<VType>::n.y * VEC<VType>::n.z; idx_jk++) {
+#pragma omp parallel for
+		for (int idx_jk = 0; idx_jk < VEC<VType>::n.y * VEC<VType>::n.z; idx_jk++) {
 
 			int j = idx_jk % VEC<VType>::n.y;
 			int k = (idx_jk / VEC<VType>::n.y) % VEC<VType>::n.z;
@@ -175,113 +183,156 @@ DBL2 VEC_VC<VType>::IteratePoisson_SOR(std::function<VType(const Owner&, int)> P
 			//red_nudge = true for odd rows and even planes or for even rows and odd planes - have to keep index on the checkerboard pattern
 			bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
 
+			int row_start = j * nx + k * nxy;
+
 			//For red pass (first) i starts from red_nudge. For black pass (second) i starts from !red_nudge.
-			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < VEC<VType>::n.x; i += 2) {
+			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < nx; i += 2) {
 
-				int idx = i + j * VEC<VType>::n.x + k * VEC<VType>::n.x*VEC<VType>::n.y;
+				int idx = row_start + i;
+
+				int flag = flags[idx];
+				int flag2 = (using_extended_flags ? flags2[idx] : 0);
 
 				//calculate new value only in non-empty cells with non-fixed values; also skip if indicated as a composite media boundary condition cell
-				if ((using_extended_flags && (ngbrFlags2[idx] & NF2_CMBND)) || !(ngbrFlags[idx] & NF_NOTEMPTY)) continue;
+				if ((flag2 & NF2_CMBND) || !(flag & NF_NOTEMPTY)) continue;
 
 				VType weighted_sum = VType(0);
 				double total_weight = 0;
 
+				//boundary differential for this cell, only evaluated if needed
+				VAL3<VType> bdiff_value;
+				bool bdiff_evaluated = false;
+
 				//x direction
-				if ((ngbrFlags[idx] & NF_BOTHX) == NF_BOTHX) {
+				if ((flag & NF_BOTHX) == NF_BOTHX) {
 
 					total_weight += 2 * w_x;
-					weighted_sum += w_x * (VEC<VType>::quantity[idx - 1] + VEC<VType>::quantity[idx + 1]);
+					weighted_sum += w_x * (V[idx - 1] + V[idx + 1]);
 				}
-				else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETX)) {
+				else if (flag2 & NF2_DIRICHLETX) {
 
 					total_weight += 6 * w_x;
 
-					if (ngbrFlags2[idx] & NF2_DIRICHLETPX) {
+					if (flag2 & NF2_DIRICHLETPX) weighted_sum += w_x * (4 * get_dirichlet_value(NF2_DIRICHLETPX, idx) + 2 * V[idx + 1]);
+					else						 weighted_sum += w_x * (4 * get_dirichlet_value(NF2_DIRICHLETNX, idx) + 2 * V[idx - 1]);
+				}
+				else if (flag & NF_NGBRX) {
 
-						weighted_sum += w_x * (4 * get_dirichlet_value(NF2_DIRICHLETPX, idx) + 2 * VEC<VType>::quantity[idx + 1]);
+					total_weight += w_x;
+
+					if (nhneumann) {
+
+						bdiff_value = bdiff(idx);
+						bdiff_evaluated = true;
+
+						if (flag & NF_NPX) weighted_sum += w_x * (V[idx + 1] - bdiff_value.x * VEC<VType>::h.x);
+						else			   weighted_sum += w_x * (V[idx - 1] + bdiff_value.x * VEC<VType>::h.x);
 					}
 					else {
 
-						weighted_sum += w_x * (4 * get_dirichlet_value(NF2_DIRICHLETNX, idx) + 2 * VEC<VType>::quantity[idx - 1]);
+						if (flag & NF_NPX) weighted_sum += w_x * V[idx + 1];
+						else			   weighted_sum += w_x * V[idx - 1];
 					}
 				}
-				else if (ngbrFlags[idx] & NF_NGBRX) {
-
-					total_weight += w_x;
-
-					if (ngbrFlags[idx] & NF_NPX) weighted_sum += w_x * VEC<VType>::quantity[idx + 1];
-					else						 weighted_sum += w_x * VEC<VType>::quantity[idx - 1];
-				}
 
 				//y direction
-				if ((ngbrFlags[idx] & NF_BOTHY) == NF_BOTHY) {
+				if ((flag & NF_BOTHY) == NF_BOTHY) {
 
 					total_weight += 2 * w_y;
-					weighted_sum += w_y * (VEC<VType>::quantity[idx - VEC<VType>::n.x] + VEC<VType>::quantity[idx + VEC<VType>::n.x]);
+					weighted_sum += w_y * (V[idx - nx] + V[idx + nx]);
 				}
-				else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETY)) {
+				else if (flag2 & NF2_DIRICHLETY) {
 
 					total_weight += 6 * w_y;
 
-					if (ngbrFlags2[idx] & NF2_DIRICHLETPY) {
+					if (flag2 & NF2_DIRICHLETPY) weighted_sum += w_y * (4 * get_dirichlet_value(NF2_DIRICHLETPY, idx) + 2 * V[idx + nx]);
+					else						 weighted_sum += w_y * (4 * get_dirichlet_value(NF2_DIRICHLETNY, idx) + 2 * V[idx - nx]);
+				}
+				else if (flag & NF_NGBRY) {
 
-						weighted_sum += w_y * (4 * get_dirichlet_value(NF2_DIRICHLETPY, idx) + 2 * VEC<VType>::quantity[idx + VEC<VType>::n.x]);
+					total_weight += w_y;
+
+					if (nhneumann) {
+
+						if (!bdiff_evaluated) { bdiff_value = bdiff(idx); bdiff_evaluated = true; }
+
+						if (flag & NF_NPY) weighted_sum += w_y * (V[idx + nx] - bdiff_value.y * VEC<VType>::h.y);
+						else			   weighted_sum += w_y * (V[idx - nx] + bdiff_value.y * VEC<VType>::h.y);
 					}
 					else {
 
-						weighted_sum += w_y * (4 * get_dirichlet_value(NF2_DIRICHLETNY, idx) + 2 * VEC<VType>::quantity[idx - VEC<VType>::n.x]);
+						if (flag & NF_NPY) weighted_sum += w_y * V[idx + nx];
+						else			   weighted_sum += w_y * V[idx - nx];
 					}
 				}
-				else if (ngbrFlags[idx] & NF_NGBRY) {
-
-					total_weight += w_y;
-
-					if (ngbrFlags[idx] & NF_NPY) weighted_sum += w_y * VEC<VType>::quantity[idx + VEC<VType>::n.x];
-					else						 weighted_sum += w_y * VEC<VType>::quantity[idx - VEC<VType>::n.x];
-				}
 
 				//z direction
-				if ((ngbrFlags[idx] & NF_BOTHZ) == NF_BOTHZ) {
+				if ((flag & NF_BOTHZ) == NF_BOTHZ) {
 
 					total_weight += 2 * w_z;
-					weighted_sum += w_z * (VEC<VType>::quantity[idx - VEC<VType>::n.x*VEC<VType>::n.y] + VEC<VType>::quantity[idx + VEC<VType>::n.x*VEC<VType>::n.y]);
+					weighted_sum += w_z * (V[idx - nxy] + V[idx + nxy]);
 				}
-				else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETZ)) {
+				else if (flag2 & NF2_DIRICHLETZ) {
 
 					total_weight += 6 * w_z;
 
-					if (ngbrFlags2[idx] & NF2_DIRICHLETPZ) {
+					if (flag2 & NF2_DIRICHLETPZ) weighted_sum += w_z * (4 * get_dirichlet_value(NF2_DIRICHLETPZ, idx) + 2 * V[idx + nxy]);
+					else						 weighted_sum += w_z * (4 * get_dirichlet_value(NF2_DIRICHLETNZ, idx) + 2 * V[idx - nxy]);
+				}
+				else if (flag & NF_NGBRZ) {
 
-						weighted_sum += w_z * (4 * get_dirichlet_value(NF2_DIRICHLETPZ, idx) + 2 * VEC<VType>::quantity[idx + VEC<VType>::n.x*VEC<VType>::n.y]);
+					total_weight += w_z;
+
+					if (nhneumann) {
+
+						if (!bdiff_evaluated) bdiff_value = bdiff(idx);
+
+						if (flag & NF_NPZ) weighted_sum += w_z * (V[idx + nxy] - bdiff_value.z * VEC<VType>::h.z);
+						else			   weighted_sum += w_z * (V[idx - nxy] + bdiff_value.z * VEC<VType>::h.z);
 					}
 					else {
 
-						weighted_sum += w_z * (4 * get_dirichlet_value(NF2_DIRICHLETNZ, idx) + 2 * VEC<VType>::quantity[idx - VEC<VType>::n.x*VEC<VType>::n.y]);
+						if (flag & NF_NPZ) weighted_sum += w_z * V[idx + nxy];
+						else			   weighted_sum += w_z * V[idx - nxy];
 					}
 				}
-				else if (ngbrFlags[idx] & NF_NGBRZ) {
-
-					total_weight += w_z;
-
-					if (ngbrFlags[idx] & NF_NPZ) weighted_sum += w_z * VEC<VType>::quantity[idx + VEC<VType>::n.x*VEC<VType>::n.y];
-					else						 weighted_sum += w_z * VEC<VType>::quantity[idx - VEC<VType>::n.x*VEC<VType>::n.y];
-				}
 
 				//advance using SOR equation
-				VType old_value = VEC<VType>::quantity[idx];
-				VEC<VType>::quantity[idx] = VEC<VType>::quantity[idx] * (1 - relaxation_param) + relaxation_param * ((weighted_sum - h_max_sq*Poisson_RHS(instance, idx)) / total_weight);
+				VType old_value = V[idx];
+				V[idx] = V[idx] * (1 - relaxation_param) + relaxation_param * ((weighted_sum - h_max_sq * Poisson_RHS(idx)) / total_weight);
 
-				VEC<VType>::magnitude_reduction.reduce_max(GetMagnitude(old_value - VEC<VType>::quantity[idx]));
-				VEC<VType>::magnitude_reduction2.reduce_max(GetMagnitude(VEC<VType>::quantity[idx]));
+				VEC<VType>::magnitude_reduction.reduce_max(GetMagnitude(old_value - V[idx]));
+				VEC<VType>::magnitude_reduction2.reduce_max(GetMagnitude(V[idx]));
 			}
 		}
-
-		rb++;
 	}
 
 	return DBL2(VEC<VType>::magnitude_reduction.maximum(), VEC<VType>::magnitude_reduction2.maximum());
 }
 
+template <typename VType>
+template <typename RHSFunction>
+DBL2 VEC_VC<VType>::IteratePoisson_SOR_Func(RHSFunction Poisson_RHS, double relaxation_param)
+{
+	auto no_bdiff = [](int idx) { return VAL3<VType>(); };
+
+	return IteratePoisson_SOR_Kernel<false>(Poisson_RHS, no_bdiff, relaxation_param);
+}
+
+template <typename VType>
+template <typename RHSFunction, typename BDiffFunction>
+DBL2 VEC_VC<VType>::IteratePoisson_SOR_Func(RHSFunction Poisson_RHS, BDiffFunction bdiff, double relaxation_param)
+{
+	return IteratePoisson_SOR_Kernel<true>(Poisson_RHS, bdiff, relaxation_param);
+}
+
+template <typename VType>
+template <typename Owner>
+DBL2 VEC_VC<VType>::IteratePoisson_SOR(std::function<VType(const Owner&, int)> Poisson_RHS, Owner& instance, double relaxation_param)
+{
+	return IteratePoisson_SOR_Func([&](int idx) { return Poisson_RHS(instance, idx); }, relaxation_param);
+}
+
 //This solves delsq V = F + M * V : For M use Tensor_RHS (For VType double M returns type double, For VType DBL3 M returns DBL33)
 //For Poisson equation we need a function to specify the RHS of the equation delsq V = F : use Poisson_RHS
 //F must be a member const method of Owner taking an index value (the index ranges over this VEC) and returning a double value : F(index) evaluated at the index-th cell.
@@ -434,139 +485,7 @@ template <typename VType>
 template <typename Owner>
 DBL2 VEC_VC<VType>::IteratePoisson_SOR(std::function<VType(const Owner&, int)> Poisson_RHS, std::function<VAL3<VType>(const Owner&, int)> bdiff, Owner& instance, double relaxation_param)
 {
-	//get maximum cell side
-	double h_max_sq = maximum(VEC<VType>::h.x, VEC<VType>::h.y, VEC<VType>::h.z);
-	h_max_sq *= h_max_sq;
-
-	//get weights
-	double w_x = h_max_sq / (VEC<VType>::h.x*VEC<VType>::h.x);
-	double w_y = h_max_sq / (VEC<VType>::h.y*VEC<VType>::h.y);
-	double w_z = h_max_sq / (VEC<VType>::h.z*VEC<VType>::h.z);
-
-	VEC<VType>::magnitude_reduction.new_minmax_reduction();
-	VEC<VType>::magnitude_reduction2.new_minmax_reduction();
-
-	//need to check for DIRICHLET flags which are held in the extended ngbrFlags (may be empty if not set)
-	bool using_extended_flags = ngbrFlags2.size();
-
-	//red-black : two passes will be taken
-	int rb = 0;
-	while (rb < 2) {
-
-#pragma omp parallel for
-		for (int idx_jk = 0; idx_jk < VEC<VType>::n.y * VEC<VType>::n.z; idx_jk++) {
-
-			int j = idx_jk % VEC<VType>::n.y;
-			int k = (idx_jk / VEC<VType>::n.y) % VEC<VType>::n.z;
-
-			//red_nudge = true for odd rows and even planes or for even rows and odd planes - have to keep index on the checkerboard pattern
-			bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
-
-			//For red pass (first) i starts from red_nudge. For black pass (second) i starts from !red_nudge.
-			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < VEC<VType>::n.x; i += 2) {
-
-				int idx = i + j * VEC<VType>::n.x + k * VEC<VType>::n.x*VEC<VType>::n.y;
-
-				//calculate new value only in non-empty cells with non-fixed values; also skip if indicated as a composite media boundary condition cell
-				if ((using_extended_flags && (ngbrFlags2[idx] & NF2_CMBND)) || !(ngbrFlags[idx] & NF_NOTEMPTY)) continue;
-
-				VType weighted_sum = VType(0);
-				double total_weight = 0;
-
-				//x direction
-				if ((ngbrFlags[idx] & NF_BOTHX) == NF_BOTHX) {
-
-					total_weight += 2 * w_x;
-					weighted_sum += w_x * (VEC<VType>::quantity[idx - 1] + VEC<VType>::quantity[idx + 1]);
-				}
-				else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETX)) {
-
-					total_weight += 6 * w_x;
-
-					if (ngbrFlags2[idx] & NF2_DIRICHLETPX) {
-
-						weighted_sum += w_x * (4 * get_dirichlet_value(NF2_DIRICHLETPX, idx) + 2 * VEC<VType>::quantity[idx + 1]);
-					}
-					else {
-
-						weighted_sum += w_x * (4 * get_dirichlet_value(NF2_DIRICHLETNX, idx) + 2 * VEC<VType>::quantity[idx - 1]);
-					}
-				}
-				else if (ngbrFlags[idx] & NF_NGBRX) {
-
-					total_weight += w_x;
-
-					if (ngbrFlags[idx] & NF_NPX) weighted_sum += w_x * (VEC<VType>::quantity[idx + 1] - bdiff(instance, idx).x * VEC<VType>::h.x);
-					else						 weighted_sum += w_x * (VEC<VType>::quantity[idx - 1] + bdiff(instance, idx).x * VEC<VType>::h.x);
-				}
-
-				//y direction
-				if ((ngbrFlags[idx] & NF_BOTHY) == NF_BOTHY) {
-
-					total_weight += 2 * w_y;
-					weighted_sum += w_y * (VEC<VType>::quantity[idx - VEC<VType>::n.x] + VEC<VType>::quantity[idx + VEC<VType>::n.x]);
-				}
-				else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETY)) {
-
-					total_weight += 6 * w_y;
-
-					if (ngbrFlags2[idx] & NF2_DIRICHLETPY) {
-
-						weighted_sum += w_y * (4 * get_dirichlet_value(NF2_DIRICHLETPY, idx) + 2 * VEC<VType>::quantity[idx + VEC<VType>::n.x]);
-					}
-					else {
-
-						weighted_sum += w_y * (4 * get_dirichlet_value(NF2_DIRICHLETNY, idx) + 2 * VEC<VType>::quantity[idx - VEC<VType>::n.x]);
-					}
-				}
-				else if (ngbrFlags[idx] & NF_NGBRY) {
-
-					total_weight += w_y;
-
-					if (ngbrFlags[idx] & NF_NPY) weighted_sum += w_y * (VEC<VType>::quantity[idx + VEC<VType>::n.x] - bdiff(instance, idx).y * VEC<VType>::h.y);
-					else						 weighted_sum += w_y * (VEC<VType>::quantity[idx - VEC<VType>::n.x] + bdiff(instance, idx).y * VEC<VType>::h.y);
-				}
-				
-				//z direction
-				if ((ngbrFlags[idx] & NF_BOTHZ) == NF_BOTHZ) {
-
-					total_weight += 2 * w_z;
-					weighted_sum += w_z * (VEC<VType>::quantity[idx - VEC<VType>::n.x*VEC<VType>::n.y] + VEC<VType>::quantity[idx + VEC<VType>::n.x*VEC<VType>::n.y]);
-				}
-				else if (using_extended_flags && (ngbrFlags2[idx] & NF2_DIRICHLETZ)) {
-
-					total_weight += 6 * w_z;
-
-					if (ngbrFlags2[idx] & NF2_DIRICHLETPZ) {
-
-						weighted_sum += w_z * (4 * get_dirichlet_value(NF2_DIRICHLETPZ, idx) + 2 * VEC<VType>::quantity[idx + VEC<VType>::n.x*VEC<VType>::n.y]);
-					}
-					else {
-
-						weighted_sum += w_z * (4 * get_dirichlet_value(NF2_DIRICHLETNZ, idx) + 2 * VEC<VType>::quantity[idx - VEC<VType>::n.x*VEC<VType>::n.y]);
-					}
-				}
-				else if (ngbrFlags[idx] & NF_NGBRZ) {
-
-					total_weight += w_z;
-
-					if (ngbrFlags[idx] & NF_NPZ) weighted_sum += w_z * (VEC<VType>::quantity[idx + VEC<VType>::n.x*VEC<VType>::n.y] - bdiff(instance, idx).z * VEC<VType>::h.z);
-					else						 weighted_sum += w_z * (VEC<VType>::quantity[idx - VEC<VType>::n.x*VEC<VType>::n.y] + bdiff(instance, idx).z * VEC<VType>::h.z);
-				}
-
-				//advance using SOR equation
-				VType old_value = VEC<VType>::quantity[idx];
-				VEC<VType>::quantity[idx] = VEC<VType>::quantity[idx] * (1 - relaxation_param) + relaxation_param * ((weighted_sum - h_max_sq * Poisson_RHS(instance, idx)) / total_weight);
-
-				VEC<VType>::magnitude_reduction.reduce_max(GetMagnitude(old_value - VEC<VType>::quantity[idx]));
-				VEC<VType>::magnitude_reduction2.reduce_max(GetMagnitude(VEC<VType>::quantity[idx]));
-			}
-		}
-
-		rb++;
-	}
-
-	return DBL2(VEC<VType>::magnitude_reduction.maximum(), VEC<VType>::magnitude_reduction2.maximum());
+	return IteratePoisson_SOR_Func([&](int idx) { return Poisson_RHS(instance, idx); }, [&](int idx) { return bdiff(instance, idx); }, relaxation_param);
 }
 
 //This solves delsq V = F + M * V : For M use Tensor_RHS (For VType double M returns type double, For VType DBL3 M returns DBL33)
@@ -2,14 +2,11 @@
 
 #include "VEC_VC.h"
 #include "BLib_prng.h"
+#include "VoronoiSiteIndex.h"
 
 //--------------------------------------------MULTIPLE ENTRIES SETTERS - SHAPE GENERATORS : VEC_VC_genshape.h, VEC_VC_Voronoi.h
 
-//simple brute-force Voronoi diagram generation.
-//when you have time use a propoer algorithm:
-//1. Steven Fortune's algorithm
-//2. Bowyer-Watson algorithm for Delauney triangulation, then obtain Voronoi diagram for it
-//Need to  look into a better algorithm for 3D also
+//Voronoi diagram generation : each mesh cell is assigned to the nearest site, found using a bucket grid index of the sites (VoronoiSiteIndex.h)
 
 //Generate 2D Voronoi cells with boundaries between cells set to empty
 template <typename VType>
@@ -37,37 +34,22 @@ bool VEC_VC<VType>::generate_Voronoi2D_Grains(double spacing, unsigned seed)
 		sites[idx] = DBL2(x_pos, y_pos);
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL2 meshcell_pos) -> int {
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return false;
 
-		double distance = GetMagnitude(VEC<VType>::rect.size().x, VEC<VType>::rect.size().y);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < VEC<VType>::n.x; i++) {
-		for (int j = 0; j < VEC<VType>::n.y; j++) {
+	for (int idx = 0; idx < VEC<VType>::n.x * VEC<VType>::n.y; idx++) {
 
-			DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(VEC<VType>::h.x, VEC<VType>::h.y);
+		int i = idx % VEC<VType>::n.x;
+		int j = idx / VEC<VType>::n.x;
 
-			int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(VEC<VType>::h.x, VEC<VType>::h.y);
 
-			markers[i + j * VEC<VType>::n.x] = cellidx;
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	//now pass over cells in mesh and detect Voronoi cell boundaries - mark them empty
@@ -128,39 +110,23 @@ bool VEC_VC<VType>::generate_Voronoi3D_Grains(double spacing, unsigned seed)
 		sites[idx] = DBL3(x_pos, y_pos, z_pos);
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL3 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(VEC<VType>::rect.size().x, VEC<VType>::rect.size().y);
-		int cellidx = 0;
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return false;
 
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < VEC<VType>::n.x; i++) {
-		for (int j = 0; j < VEC<VType>::n.y; j++) {
-			for (int k = 0; k < VEC<VType>::n.z; k++) {
+	for (int idx = 0; idx < VEC<VType>::n.dim(); idx++) {
 
-				DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & VEC<VType>::h;
+		int i = idx % VEC<VType>::n.x;
+		int j = (idx / VEC<VType>::n.x) % VEC<VType>::n.y;
+		int k = idx / (VEC<VType>::n.x * VEC<VType>::n.y);
 
-				int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & VEC<VType>::h;
 
-				markers[i + j * VEC<VType>::n.x + k * VEC<VType>::n.x * VEC<VType>::n.y] = cellidx;
-			}
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	//now pass over cells in mesh and detect Voronoi cell boundaries - mark them empty
@@ -257,37 +223,22 @@ bool VEC_VC<VType>::generate_uVoronoi2D_Grains(double spacing, double variation,
 		}
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL2 meshcell_pos) -> int {
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return false;
 
-		double distance = GetMagnitude(VEC<VType>::rect.size().x, VEC<VType>::rect.size().y);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < VEC<VType>::n.x; i++) {
-		for (int j = 0; j < VEC<VType>::n.y; j++) {
+	for (int idx = 0; idx < VEC<VType>::n.x * VEC<VType>::n.y; idx++) {
 
-			DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(VEC<VType>::h.x, VEC<VType>::h.y);
+		int i = idx % VEC<VType>::n.x;
+		int j = idx / VEC<VType>::n.x;
 
-			int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(VEC<VType>::h.x, VEC<VType>::h.y);
 
-			markers[i + j * VEC<VType>::n.x] = cellidx;
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	//now pass over cells in mesh and detect Voronoi cell boundaries - mark them empty
@@ -365,39 +316,23 @@ bool VEC_VC<VType>::generate_uVoronoi3D_Grains(double spacing, double variation,
 		}
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL3 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(VEC<VType>::rect.size().x, VEC<VType>::rect.size().y);
-		int cellidx = 0;
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return false;
 
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < VEC<VType>::n.x; i++) {
-		for (int j = 0; j < VEC<VType>::n.y; j++) {
-			for (int k = 0; k < VEC<VType>::n.z; k++) {
+	for (int idx = 0; idx < VEC<VType>::n.dim(); idx++) {
 
-				DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & VEC<VType>::h;
+		int i = idx % VEC<VType>::n.x;
+		int j = (idx / VEC<VType>::n.x) % VEC<VType>::n.y;
+		int k = idx / (VEC<VType>::n.x * VEC<VType>::n.y);
 
-				int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & VEC<VType>::h;
 
-				markers[i + j * VEC<VType>::n.x + k * VEC<VType>::n.x * VEC<VType>::n.y] = cellidx;
-			}
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	//now pass over cells in mesh and detect Voronoi cell boundaries - mark them empty
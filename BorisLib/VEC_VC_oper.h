@@ -328,39 +328,51 @@ void VEC_VC<VType>::shift_x(double delta, const Rect& shift_rect)
 
 	Box shift_box = VEC<VType>::box_from_rect_min(shift_rect);
 
-	if (cells_shift < 0) {
+	//range of destination cells along x : shifting values towards lower i for cells_shift < 0 (source is to the right), else towards higher i
+	int i_start = (cells_shift < 0 ? shift_box.s.x : shift_box.s.x + cells_shift);
+	int i_end = (cells_shift < 0 ? shift_box.e.x + cells_shift : shift_box.e.x);
+	if (i_end <= i_start) return;
+
+	//rows along x are independent, so parallelize over rows (j, k) and shift each row in turn
+	int rows_y = shift_box.e.y - shift_box.s.y;
+	int num_rows = rows_y * (shift_box.e.z - shift_box.s.z);
 
-		for (int i = shift_box.s.x; i < shift_box.e.x + cells_shift; i++) {
 #pragma omp parallel for
-			for (int j = shift_box.s.y; j < shift_box.e.y; j++) {
-				for (int k = shift_box.s.z; k < shift_box.e.z; k++) {
+	for (int row = 0; row < num_rows; row++) {
 
-					int cell_idx = i + j * VEC<VType>::n.x + k * VEC<VType>::n.x*VEC<VType>::n.y;
-					int shift_cell_idx = cell_idx - cells_shift;
+		int j = shift_box.s.y + row % rows_y;
+		int k = shift_box.s.z + row / rows_y;
 
-					if ((ngbrFlags[cell_idx] & NF_NOTEMPTY) && (ngbrFlags[shift_cell_idx] & NF_NOTEMPTY)) {
-						
-						VEC<VType>::quantity[cell_idx] = VEC<VType>::quantity[shift_cell_idx];
-					}
-				}
-			}
+		int row_idx = j * VEC<VType>::n.x + k * VEC<VType>::n.x*VEC<VType>::n.y;
+
+		VType* prow = VEC<VType>::quantity.data() + row_idx;
+		int* prow_flags = ngbrFlags.data() + row_idx;
+
+		//if all cells in the row segment are non-empty (usual case) this is a single contiguous move
+		bool row_full = true;
+		for (int i = shift_box.s.x; i < shift_box.e.x; i++) {
+
+			if (!(prow_flags[i] & NF_NOTEMPTY)) { row_full = false; break; }
 		}
-	}
-	else {
 
-		for (int i = shift_box.e.x - 1; i >= shift_box.s.x + cells_shift; i--) {
-#pragma omp parallel for
-			for (int j = shift_box.s.y; j < shift_box.e.y; j++) {
-				for (int k = shift_box.s.z; k < shift_box.e.z; k++) {
+		if (row_full) {
 
-					int cell_idx = i + j * VEC<VType>::n.x + k * VEC<VType>::n.x*VEC<VType>::n.y;
-					int shift_cell_idx = cell_idx - cells_shift;
+			if (cells_shift < 0) std::copy(prow + i_start - cells_shift, prow + i_end - cells_shift, prow + i_start);
+			else std::copy_backward(prow + i_start - cells_shift, prow + i_end - cells_shift, prow + i_end);
+		}
+		else if (cells_shift < 0) {
 
-					if ((ngbrFlags[cell_idx] & NF_NOTEMPTY) && (ngbrFlags[shift_cell_idx] & NF_NOTEMPTY)) {
+			//go in the direction of the shift, so source values are read before they are overwritten
+			for (int i = i_start; i < i_end; i++) {
 
-						VEC<VType>::quantity[cell_idx] = VEC<VType>::quantity[shift_cell_idx];
-					}
-				}
+				if ((prow_flags[i] & NF_NOTEMPTY) && (prow_flags[i - cells_shift] & NF_NOTEMPTY)) prow[i] = prow[i - cells_shift];
+			}
+		}
+		else {
+
+			for (int i = i_end - 1; i >= i_start; i--) {
+
+				if ((prow_flags[i] & NF_NOTEMPTY) && (prow_flags[i - cells_shift] & NF_NOTEMPTY)) prow[i] = prow[i - cells_shift];
 			}
 		}
 	}
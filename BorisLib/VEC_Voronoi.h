@@ -2,12 +2,9 @@
 
 #include "VEC.h"
 #include "BLib_prng.h"
+#include "VoronoiSiteIndex.h"
 
-//simple brute-force Voronoi diagram generation.
-//when you have time use a proper algorithm:
-//1. Steven Fortune's algorithm
-//2. Bowyer-Watson algorithm for Delaunay triangulation, then obtain Voronoi diagram from it
-//Need to  look into a better algorithm for 3D also
+//Voronoi diagram generation : each mesh cell takes the value of the nearest site, found using a bucket grid index of the sites (VoronoiSiteIndex.h)
 
 //----------------------------------------------------- GENERATE 2D
 
@@ -36,36 +33,22 @@ void VEC<VType>::aux_generate_Voronoi2D(double spacing, BorisRand& prng, std::fu
 		sites[idx].second = value_generator();
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL2 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx].first, meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
+	//mesh cells in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
+	for (int idx = 0; idx < n.x * n.y; idx++) {
 
-			DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
+		int i = idx % n.x;
+		int j = idx / n.x;
 
-			int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
 
-			quantity[i + j * n.x] = sites[cellidx].second;
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		quantity[idx] = sites[cellidx].second;
 	}
 }
 
@@ -101,36 +84,22 @@ void VEC<VType>::aux_generate_uVoronoi2D(double spacing, double variation, Boris
 		sites[idx].second = value_generator();
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL2 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx].first, meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
+	//mesh cells in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
+	for (int idx = 0; idx < n.x * n.y; idx++) {
 
-			DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
+		int i = idx % n.x;
+		int j = idx / n.x;
 
-			int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
 
-			quantity[i + j * n.x] = sites[cellidx].second;
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		quantity[idx] = sites[cellidx].second;
 	}
 }
 
@@ -162,38 +131,23 @@ void VEC<VType>::aux_generate_Voronoi3D(double spacing, BorisRand& prng, std::fu
 		sites[idx].second = value_generator();
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL3 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y, rect.size().z);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx].first, meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
+	//mesh cells in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
-			for (int k = 0; k < n.z; k++) {
+	for (int idx = 0; idx < n.dim(); idx++) {
 
-				DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x * n.y);
 
-				int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
 
-				quantity[i + j * n.x + k * n.x * n.y] = sites[cellidx].second;
-			}
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		quantity[idx] = sites[cellidx].second;
 	}
 }
 
@@ -217,7 +171,7 @@ void VEC<VType>::aux_generate_uVoronoi3D(double spacing, double variation, Boris
 
 				double start_x = spacing / 2 - (num_cells_x * spacing - (rect.e.x - rect.s.x)) / 2;
 				double start_y = spacing / 2 - (num_cells_y * spacing - (rect.e.y - rect.s.y)) / 2;
-				double start_z = spacing / 2 - (num_cells_y * spacing - (rect.e.z - rect.s.z)) / 2;
+				double start_z = spacing / 2 - (num_cells_z * spacing - (rect.e.z - rect.s.z)) / 2;
 
 				double x_pos = start_x + spacing * i + (-0.5 + prng.rand()) * variation;
 				double y_pos = start_y + spacing * j + (-0.5 + prng.rand()) * variation;
@@ -234,38 +188,23 @@ void VEC<VType>::aux_generate_uVoronoi3D(double spacing, double variation, Boris
 		sites[idx].second = value_generator();
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL3 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y, rect.size().z);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx].first, meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
+	//mesh cells in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
-			for (int k = 0; k < n.z; k++) {
+	for (int idx = 0; idx < n.dim(); idx++) {
 
-				DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x * n.y);
 
-				int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
 
-				quantity[i + j * n.x + k * n.x * n.y] = sites[cellidx].second;
-			}
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		quantity[idx] = sites[cellidx].second;
 	}
 }
 
@@ -294,37 +233,22 @@ void VEC<VType>::aux_generate_VoronoiBoundary2D(double spacing, VType base_value
 		sites[idx] = DBL2(x_pos, y_pos);
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL2 meshcell_pos) -> int {
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
-		double distance = GetMagnitude(rect.size().x, rect.size().y);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
+	for (int idx = 0; idx < n.x * n.y; idx++) {
 
-			DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
+		int i = idx % n.x;
+		int j = idx / n.x;
 
-			int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
 
-			markers[i + j * n.x] = cellidx;
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	set(base_value);
@@ -389,37 +313,22 @@ void VEC<VType>::aux_generate_uVoronoiBoundary2D(double spacing, double variatio
 		}
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL2 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y);
-		int cellidx = 0;
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
+	for (int idx = 0; idx < n.x * n.y; idx++) {
 
-			DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
+		int i = idx % n.x;
+		int j = idx / n.x;
 
-			int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL2 meshcell_pos = DBL2(i + 0.5, j + 0.5) & DBL2(h.x, h.y);
 
-			markers[i + j * n.x] = cellidx;
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	set(base_value);
@@ -480,39 +389,23 @@ void VEC<VType>::aux_generate_VoronoiBoundary3D(double spacing, VType base_value
 		sites[idx] = DBL3(x_pos, y_pos, z_pos);
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL3 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y);
-		int cellidx = 0;
-
-		for (int idx = 0; idx < sites.size(); idx++) {
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
-			for (int k = 0; k < n.z; k++) {
+	for (int idx = 0; idx < n.dim(); idx++) {
 
-				DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x * n.y);
 
-				int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
 
-				markers[i + j * n.x + k * n.x * n.y] = cellidx;
-			}
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	set(base_value);
@@ -572,7 +465,7 @@ void VEC<VType>::aux_generate_uVoronoiBoundary3D(double spacing, double variatio
 
 				double start_x = spacing / 2 - (num_cells_x * spacing - (rect.e.x - rect.s.x)) / 2;
 				double start_y = spacing / 2 - (num_cells_y * spacing - (rect.e.y - rect.s.y)) / 2;
-				double start_z = spacing / 2 - (num_cells_y * spacing - (rect.e.z - rect.s.z)) / 2;
+				double start_z = spacing / 2 - (num_cells_z * spacing - (rect.e.z - rect.s.z)) / 2;
 
 				double x_pos = start_x + spacing * i + (-0.5 + prng.rand()) * variation;
 				double y_pos = start_y + spacing * j + (-0.5 + prng.rand()) * variation;
@@ -583,39 +476,23 @@ void VEC<VType>::aux_generate_uVoronoiBoundary3D(double spacing, double variatio
 		}
 	}
 
-	//naive method : for each mesh cell just search the sites vector to find coefficient to apply
-	auto find_voronoi_cellidx = [&](DBL3 meshcell_pos) -> int {
-
-		double distance = GetMagnitude(rect.size().x, rect.size().y);
-		int cellidx = 0;
+	//nearest site look-up, with the index built once and shared by all mesh cells
+	VoronoiSiteIndex site_index;
+	if (!site_index.build(sites)) return;
 
-		for (int idx = 0; idx < sites.size(); idx++) {
-
-			double new_distance = get_distance(sites[idx], meshcell_pos);
-
-			if (new_distance < distance) {
-
-				distance = new_distance;
-				cellidx = idx;
-			}
-		}
-
-		return cellidx;
-	};
-
-	//mark cells in markers
+	//mark cells in markers, in storage order so each thread writes a contiguous block
 #pragma omp parallel for
-	for (int i = 0; i < n.x; i++) {
-		for (int j = 0; j < n.y; j++) {
-			for (int k = 0; k < n.z; k++) {
+	for (int idx = 0; idx < n.dim(); idx++) {
 
-				DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
+		int i = idx % n.x;
+		int j = (idx / n.x) % n.y;
+		int k = idx / (n.x * n.y);
 
-				int cellidx = find_voronoi_cellidx(meshcell_pos);
+		DBL3 meshcell_pos = DBL3(i + 0.5, j + 0.5, k + 0.5) & h;
 
-				markers[i + j * n.x + k * n.x * n.y] = cellidx;
-			}
-		}
+		int cellidx = site_index.nearest(meshcell_pos);
+
+		markers[idx] = cellidx;
 	}
 
 	set(base_value);
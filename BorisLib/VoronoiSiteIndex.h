@@ -0,0 +1,206 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <limits>
+
+#include "BLib_Types.h"
+#include "Funcs_Vectors.h"
+
+//Nearest site look-up for Voronoi tessellations, used by all the Voronoi generators (VEC_Voronoi.h, VEC_VC_Voronoi.h).
+//Sites are binned in a uniform grid of buckets covering their bounding box, with about one site per bucket.
+//The nearest site to a point is found by searching buckets in shells of increasing size around the point, stopping as soon as no unsearched bucket can contain a closer site.
+//For the site distributions used here (random or perturbed regular) a look-up is O(1) on average, instead of O(number of sites) for a full scan.
+//Equidistant sites resolve to the lowest site index, same as a full scan in index order.
+
+class VoronoiSiteIndex {
+
+private:
+
+	std::vector<DBL3> sites;
+
+	//bucket grid : origin, bucket size (same along all axes) and number of buckets along each axis
+	DBL3 origin;
+	double bucket = 1.0;
+	INT3 nb;
+
+	//site indexes ordered by bucket : sites in bucket b are bucket_sites[bucket_start[b]] to bucket_sites[bucket_start[b + 1] - 1]
+	std::vector<int> bucket_sites;
+	std::vector<int> bucket_start;
+
+private:
+
+	static DBL3 position(const DBL2& pos) { return DBL3(pos.x, pos.y, 0.0); }
+	static DBL3 position(const DBL3& pos) { return pos; }
+
+	//bucket index along axis for given coordinate, clamped to the grid (points outside the sites bounding box are allowed)
+	static int bucket_coordinate(double pos, double origin, double bucket_size, int num_buckets)
+	{
+		int b = floor((pos - origin) / bucket_size);
+		return (b < 0 ? 0 : (b >= num_buckets ? num_buckets - 1 : b));
+	}
+
+	//make the bucket grid once sites are set
+	bool make_buckets(void)
+	{
+		if (!sites.size()) return false;
+
+		DBL3 smin = sites[0], smax = sites[0];
+
+		for (int idx = 1; idx < sites.size(); idx++) {
+
+			smin = DBL3(std::min(smin.x, sites[idx].x), std::min(smin.y, sites[idx].y), std::min(smin.z, sites[idx].z));
+			smax = DBL3(std::max(smax.x, sites[idx].x), std::max(smax.y, sites[idx].y), std::max(smax.z, sites[idx].z));
+		}
+
+		double extent[3] = { smax.x - smin.x, smax.y - smin.y, smax.z - smin.z };
+
+		//bucket size for about one site per bucket, using only the dimensions the sites extend along (2D sites lie in a plane)
+		double volume = 1.0;
+		int dimensions = 0;
+		for (int axis = 0; axis < 3; axis++) if (extent[axis] > 0) { volume *= extent[axis]; dimensions++; }
+
+		double bucket_size = (dimensions ? pow(volume / sites.size(), 1.0 / dimensions) : 1.0);
+
+		int num_buckets[3] = { 1, 1, 1 };
+		for (int axis = 0; axis < 3; axis++) if (extent[axis] > 0) num_buckets[axis] = std::max((int)ceil(extent[axis] / bucket_size), 1);
+
+		origin = smin;
+		bucket = bucket_size;
+		nb = INT3(num_buckets[0], num_buckets[1], num_buckets[2]);
+
+		//counting sort of sites by bucket
+		if (!malloc_vector(bucket_start, nb.dim() + 1, 0)) return false;
+		if (!malloc_vector(bucket_sites, sites.size())) return false;
+
+		std::vector<int> site_bucket;
+		if (!malloc_vector(site_bucket, sites.size())) return false;
+
+		for (int idx = 0; idx < sites.size(); idx++) {
+
+			INT3 ijk = INT3(
+				bucket_coordinate(sites[idx].x, origin.x, bucket, nb.x),
+				bucket_coordinate(sites[idx].y, origin.y, bucket, nb.y),
+				bucket_coordinate(sites[idx].z, origin.z, bucket, nb.z));
+
+			site_bucket[idx] = ijk.i + ijk.j * nb.x + ijk.k * nb.x * nb.y;
+			bucket_start[site_bucket[idx] + 1]++;
+		}
+
+		for (int b = 0; b < nb.dim(); b++) bucket_start[b + 1] += bucket_start[b];
+
+		//filling in site index order keeps each bucket sorted by site index
+		std::vector<int> fill = bucket_start;
+		for (int idx = 0; idx < sites.size(); idx++) bucket_sites[fill[site_bucket[idx]]++] = idx;
+
+		return true;
+	}
+
+	void search_bucket(int b, const DBL3& pos, double& best_distance2, int& best_idx) const
+	{
+		for (int sidx = bucket_start[b]; sidx < bucket_start[b + 1]; sidx++) {
+
+			int idx = bucket_sites[sidx];
+			DBL3 d = sites[idx] - pos;
+			double distance2 = d * d;
+
+			if (distance2 < best_distance2 || (distance2 == best_distance2 && idx < best_idx)) {
+
+				best_distance2 = distance2;
+				best_idx = idx;
+			}
+		}
+	}
+
+public:
+
+	//build index for given site positions (DBL2 or DBL3) : return false if not built (no sites or out of memory)
+	template <typename PType>
+	bool build(const std::vector<PType>& positions)
+	{
+		if (!malloc_vector(sites, positions.size())) return false;
+		for (int idx = 0; idx < positions.size(); idx++) sites[idx] = position(positions[idx]);
+
+		return make_buckets();
+	}
+
+	//as above but for sites stored with their values
+	template <typename PType, typename VType>
+	bool build(const std::vector<std::pair<PType, VType>>& sites_values)
+	{
+		if (!malloc_vector(sites, sites_values.size())) return false;
+		for (int idx = 0; idx < sites_values.size(); idx++) sites[idx] = position(sites_values[idx].first);
+
+		return make_buckets();
+	}
+
+	//index of site nearest to given position. Thread-safe once built.
+	template <typename PType>
+	int nearest(const PType& pos_) const
+	{
+		DBL3 pos = position(pos_);
+
+		INT3 c = INT3(
+			bucket_coordinate(pos.x, origin.x, bucket, nb.x),
+			bucket_coordinate(pos.y, origin.y, bucket, nb.y),
+			bucket_coordinate(pos.z, origin.z, bucket, nb.z));
+
+		double best_distance2 = std::numeric_limits<double>::max();
+		int best_idx = 0;
+
+		for (int r = 0; ; r++) {
+
+			//search all buckets on the shell at distance r (in buckets) from the centre bucket
+			int i_min = std::max(c.i - r, 0), i_max = std::min(c.i + r, nb.i - 1);
+			int j_min = std::max(c.j - r, 0), j_max = std::min(c.j + r, nb.j - 1);
+			int k_min = std::max(c.k - r, 0), k_max = std::min(c.k + r, nb.k - 1);
+
+			for (int k = k_min; k <= k_max; k++) {
+				for (int j = j_min; j <= j_max; j++) {
+
+					bool shell_jk = (abs(k - c.k) == r || abs(j - c.j) == r);
+
+					for (int i = i_min; i <= i_max; i++) {
+
+						//interior buckets were searched at smaller r
+						if (!shell_jk && abs(i - c.i) != r) {
+
+							i = std::max(i, c.i + r - 1);
+							continue;
+						}
+
+						search_bucket(i + j * nb.x + k * nb.x * nb.y, pos, best_distance2, best_idx);
+					}
+				}
+			}
+
+			//distance from position to the closest face of the searched box, only for faces inside the grid (nothing to search outside)
+			double bound = std::numeric_limits<double>::max();
+			bool covered = true;
+
+			int c_[3] = { c.i, c.j, c.k };
+			int nb_[3] = { nb.i, nb.j, nb.k };
+			double pos_[3] = { pos.x, pos.y, pos.z };
+			double origin_[3] = { origin.x, origin.y, origin.z };
+
+			for (int axis = 0; axis < 3; axis++) {
+
+				if (c_[axis] - r > 0) {
+
+					covered = false;
+					bound = std::min(bound, pos_[axis] - (origin_[axis] + (c_[axis] - r) * bucket));
+				}
+
+				if (c_[axis] + r < nb_[axis] - 1) {
+
+					covered = false;
+					bound = std::min(bound, origin_[axis] + (c_[axis] + r + 1) * bucket - pos_[axis]);
+				}
+			}
+
+			if (covered || (bound > 0 && best_distance2 < bound * bound)) break;
+		}
+
+		return best_idx;
+	}
+};
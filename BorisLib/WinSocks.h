@@ -10,16 +10,19 @@
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <map>
+
+#include "NetSocks_Protocol.h"
 
 #pragma comment (lib, "Ws2_32.lib")
 
 #define DEFAULT_BUFLEN 1048576
 #define DEFAULT_PORT "1542"
 
-//Used for non-blocking calls to recv : after each call sleep this number of ms to avoid hogging too much CPU time 
-//Calling recv too often will put a slight load on one of the CPU cores which can affect parallelized computations
+//The server waits for network events (new connections, incoming data) with WSAPoll, so messages are picked up as soon as they arrive.
+//Listen returns to the caller if nothing happens within the wait time below, so the calling thread can be stopped.
 
-//receive commands from client sleep
+//maximum time to wait for network events (ms)
 #define RECVSLEEPMS		5
 //error - make listen socket sleep
 #define SERRSLEEPMS		500
@@ -40,8 +43,13 @@ class NetSocks {
 private:
 
     SOCKET ListenSocket;
+
+	//client which sent the last message : replies go to this client
     SOCKET ClientSocket;
 
+	//all connected clients, each with its own receive state. Clients using the framed protocol keep their connection open and can pipeline messages.
+	std::map<SOCKET, NetSocksConnection> clients;
+
 	//receive buffer and length
     char *recvbuf;
     int recvbuflen;
@@ -53,6 +61,10 @@ private:
 	//commands processed by Simulation may return parameters. These are placed in this std::vector to be sent to Client in winsocks thread
 	std::vector<std::string> dataParams;
 
+	//alternatively commands can return a large array of values : these are sent as a typed buffer to framed clients (and as text to legacy clients)
+	std::vector<double> dataBuffer;
+	int dataBuffer_components = 0;
+
 	//the last received message
 	std::string last_message;
 
@@ -67,6 +79,23 @@ private:
 	//Make non-blocking listen socket on DEFAULT_PORT to accept incoming connections - done in the constructor
 	void MakeListenSocket(void);
 
+	//close all sockets (clients and listen socket)
+	void CloseSockets(void);
+
+	//accept all pending connections on the listen socket
+	void AcceptClients(void);
+
+	//read all available data from given client into its receive state : return false if connection was closed
+	bool ReceiveFromClient(SOCKET socket);
+
+	void CloseClient(SOCKET socket);
+
+	//get the next complete message from any client, setting it as the client to reply to
+	bool NextMessage(std::string& message);
+
+	//send all of message to client (socket is non-blocking so wait if the send buffer fills up)
+	bool SendAll(SOCKET socket, const std::string& message);
+
 public:
 
 	NetSocks(std::string port = DEFAULT_PORT, int recvsleepms = RECVSLEEPMS, int buffer_size = DEFAULT_BUFLEN);
@@ -81,11 +110,14 @@ public:
 	//Non-blocking call to Listen for incoming messages - return message when received
 	std::string Listen(void);
 
-	//set data to be sent to client - not intended to send massive amounts of data, e.g. shouldn't use it to send the entire mesh data
+	//set data to be sent to client
 	//SetSendData just loads values in dataParams std::vector whilst the SendDataParams actually sends data
 	void SetSendData(const std::vector<std::string>& newdataParams);
 	void SetSendData(std::vector<std::string>&& newdataParams);
 
+	//set a large array of values to be sent to client (components is the number of components per element, e.g. 3 for vector quantities)
+	void SetSendData_Buffer(const std::vector<double>& newdataBuffer, int components = 1);
+
 	//send prepared data to client
 	void SendDataParams(void);
 
@@ -115,42 +147,39 @@ inline NetSocks::NetSocks(std::string port, int recvsleepms, int buffer_size)
 
 inline NetSocks::~NetSocks() 
 {
-	if (clientConnected) {
-
-		// shutdown the connection since we're done
-		shutdown(ClientSocket, SD_SEND);
-		closesocket(ClientSocket);
-	}
-
-	if (listenSocketActive) {
-
-		closesocket(ListenSocket);
-	}
-
-	WSACleanup();
-
-	delete recvbuf;
+	CloseSockets();
+	
+	delete[] recvbuf;
 }
 
 inline void NetSocks::Change_Port(std::string port)
 {
 	server_port = port;
 
-	if (clientConnected) {
+	CloseSockets();
+
+	MakeListenSocket();
+}
+
+inline void NetSocks::CloseSockets(void)
+{
+	for (auto& client : clients) {
 
 		// shutdown the connection since we're done
-		shutdown(ClientSocket, SD_SEND);
-		closesocket(ClientSocket);
+		shutdown(client.first, SD_SEND);
+		closesocket(client.first);
 	}
 
+	clients.clear();
+	clientConnected = false;
+
 	if (listenSocketActive) {
 
 		closesocket(ListenSocket);
+		listenSocketActive = false;
 	}
 
 	WSACleanup();
-
-	MakeListenSocket();
 }
 
 inline void NetSocks::MakeListenSocket(void) 
@@ -230,113 +259,200 @@ inline void NetSocks::MakeListenSocket(void)
 	listenSocketActive = true;
 }
 
-inline std::string NetSocks::Listen(void) 
-{	
-	if (!listenSocketActive) { 
-		
-		std::this_thread::sleep_for(std::chrono::milliseconds(SERRSLEEPMS)); 
-		MakeListenSocket(); 
-		return ""; 
+inline void NetSocks::AcceptClients(void)
+{
+	while (true) {
+
+		SOCKET socket = accept(ListenSocket, nullptr, nullptr);
+		if (socket == INVALID_SOCKET) break;
+
+		//Set client socket as non-blocking (iMode = 1 for non-blocking, iMode = 0 for blocking)
+		u_long iMode = 1;
+		ioctlsocket(socket, FIONBIO, &iMode);
+
+		//replies are small and latency matters more than throughput
+		BOOL option = TRUE;
+		setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&option, sizeof(option));
+
+		clients[socket] = NetSocksConnection();
 	}
+}
 
-	// Accept a client socket if one not available already. Asynchronous since ListenSocket was made non-blocking.
-	if (!clientConnected) {
+inline bool NetSocks::ReceiveFromClient(SOCKET socket)
+{
+	while (true) {
 
-		ClientSocket = accept(ListenSocket, nullptr, nullptr);
+		int iResult = recv(socket, recvbuf, recvbuflen, 0);
 
-		if (ClientSocket != INVALID_SOCKET) {
+		//Client connection was closed
+		if (iResult == 0) return false;
 
-			//Set ClientSocket as non-blocking (iMode = 1 for non-blocking, iMode = 0 for blocking)
-			u_long iMode = 1;
-			ioctlsocket(ClientSocket, FIONBIO, &iMode);
+		if (iResult == SOCKET_ERROR) {
 
-			//mark new client connection established
-			clientConnected = true;
+			//WSAEWOULDBLOCK is issued for non-blocking sockets when all data has been read, but respond to all other errors
+			return (WSAGetLastError() == WSAEWOULDBLOCK);
 		}
-		else {
 
-			std::this_thread::sleep_for(std::chrono::milliseconds(ACPTSLEEPMS));
-			return "";
-		}
+		clients[socket].recv_data.append(recvbuf, iResult);
 	}
+}
 
-	//client is connected : listen for message
-	int iResult = recv(ClientSocket, recvbuf, recvbuflen, 0);
+inline void NetSocks::CloseClient(SOCKET socket)
+{
+	// Shutdown our socket
+	shutdown(socket, SD_SEND);
+	closesocket(socket);
 
-	if (iResult == 0) {
+	clients.erase(socket);
 
-		//Client connection was closed
-		closesocket(ClientSocket);
-		clientConnected = false;
-		return "";
+	if (socket == ClientSocket) clientConnected = false;
+}
+
+inline bool NetSocks::NextMessage(std::string& message)
+{
+	for (auto& client : clients) {
+
+		if (client.second.next_message(message)) {
+
+			ClientSocket = client.first;
+			clientConnected = true;
+			return true;
+		}
 	}
 
-	//WSAEWOULDBLOCK is issued for non-blocking sockets so ignore it, but respond to all other errors
-	int nError = WSAGetLastError();
-	if (nError && nError != WSAEWOULDBLOCK) {
+	return false;
+}
 
-		//error
-		// Shutdown our socket
-		shutdown(ClientSocket, SD_SEND);
-		closesocket(ClientSocket);
-		clientConnected = false;
-		return "";
+inline std::string NetSocks::Listen(void) 
+{	
+	if (!listenSocketActive) { 
+		
+		std::this_thread::sleep_for(std::chrono::milliseconds(SERRSLEEPMS)); 
+		MakeListenSocket(); 
+		return ""; 
 	}
 
-	//all good, return the received message
-	if (iResult > 0) {
+	//messages already received (pipelined by a client) are handled first, otherwise wait for network events
+	if (!NextMessage(last_message)) {
 
-		//received message, return it to be processed after password check
-		last_message = std::string(recvbuf).substr(0, iResult);
+		//listen socket first, then all clients
+		std::vector<WSAPOLLFD> pfds(1 + clients.size());
 
-		if (last_message.length() > password.length()) {
+		pfds[0].fd = ListenSocket;
+		pfds[0].events = POLLRDNORM;
 
-			if (last_message.substr(0, password.length()) == password) return last_message.substr(password.length());
+		int idx = 1;
+		for (auto& client : clients) {
+
+			pfds[idx].fd = client.first;
+			pfds[idx++].events = POLLRDNORM;
 		}
 
-		//failed password check
-		return "";
+		if (WSAPoll(pfds.data(), (ULONG)pfds.size(), server_recvsleepms) > 0) {
+
+			for (idx = 1; idx < pfds.size(); idx++) {
+
+				if (pfds[idx].revents && !ReceiveFromClient(pfds[idx].fd)) {
+
+					//connection closed or error : any complete messages already received are dropped as there's nobody to reply to
+					CloseClient(pfds[idx].fd);
+				}
+			}
+
+			if (pfds[0].revents) AcceptClients();
+		}
+
+		if (!NextMessage(last_message)) return "";
 	}
 
-	//sleep before calling the non-blocking recv function (client socket is not blocking)
-	std::this_thread::sleep_for(std::chrono::milliseconds(server_recvsleepms));
+	//received message, return it to be processed after password check
+	if (last_message.length() > password.length()) {
+
+		if (last_message.substr(0, password.length()) == password) return last_message.substr(password.length());
+	}
 
+	//failed password check
 	return "";
 }
 
 inline void NetSocks::SetSendData(const std::vector<std::string>& newdataParams) 
 {
 	dataParams = newdataParams;
+	dataBuffer.clear();
+	dataBuffer_components = 0;
 }
 
 inline void NetSocks::SetSendData(std::vector<std::string>&& newdataParams) 
 {
 	dataParams = move(newdataParams);
+	dataBuffer.clear();
+	dataBuffer_components = 0;
+}
+
+inline void NetSocks::SetSendData_Buffer(const std::vector<double>& newdataBuffer, int components)
+{
+	dataParams.clear();
+	dataBuffer = newdataBuffer;
+	dataBuffer_components = components;
+}
+
+inline bool NetSocks::SendAll(SOCKET socket, const std::string& message)
+{
+	size_t sent = 0;
+
+	while (sent < message.length()) {
+
+		int iSendResult = send(socket, message.c_str() + sent, (int)(message.length() - sent), 0);
+
+		if (iSendResult == SOCKET_ERROR) {
+
+			if (WSAGetLastError() != WSAEWOULDBLOCK) return false;
+
+			//send buffer full : wait until it can accept more data
+			WSAPOLLFD pfd = { socket, POLLWRNORM, 0 };
+			if (WSAPoll(&pfd, 1, ACPTSLEEPMS) == SOCKET_ERROR) return false;
+		}
+		else sent += iSendResult;
+	}
+
+	return true;
 }
 
 inline void NetSocks::SendDataParams(void) 
 {
 	if (clientConnected) {
 
-		//form message std::string : tab value tab value tab value etc. If no values then just a tab
-		std::string message = GetDataParams_String();
+		auto client = clients.find(ClientSocket);
+
+		std::string message;
+
+		//framed clients get a frame, with typed buffers sent as raw values. Legacy clients get the text message : tab value tab value tab value etc. If no values then just a tab
+		if (client != clients.end() && client->second.framed == 1) {
+
+			if (dataBuffer_components && dataParams.empty()) message = NetSocks_MakeFrame(NetSocks_MakeBufferPayload(dataBuffer, dataBuffer_components));
+			else message = NetSocks_MakeFrame(GetDataParams_String());
+		}
+		else message = GetDataParams_String();
 
 		//message client
-		int iSendResult = send(ClientSocket, message.c_str(), (int)message.length(), 0);
-		if (iSendResult == SOCKET_ERROR) {
+		if (!SendAll(ClientSocket, message)) {
 			
 			//error
-			return;
+			CloseClient(ClientSocket);
 		}
 	}
 
-	//done so reset std::vector to zero size
+	//done so reset to zero size
 	dataParams.resize(0);
+	dataBuffer.clear();
+	dataBuffer_components = 0;
 }
 
 //get prepare data as a string (this is the string which SendDataParams will send)
 inline std::string NetSocks::GetDataParams_String(void)
 {
+	if (dataBuffer_components && dataParams.empty()) return NetSocks_MakeBufferText(dataBuffer);
+
 	//form message std::string : tab value tab value tab value etc. If no values then just a tab
 	std::stringstream ss;
 
@@ -356,13 +356,10 @@ class NSClient:
         
         if not embedded_mode:
                 
-            with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as sock:
-        
-                try:
-                    sock.connect((self.scriptserverip, self.scriptserverport))
-                except:
-                    if scriptserverip == 'localhost':
-                        print("No server found on port %d. Make sure a Boris instance is started and configured for this port." % self.scriptserverport)
+            #persistent connection used for all commands
+            if not self.__connect():
+                if scriptserverip == 'localhost':
+                    print("No server found on port %d. Make sure a Boris instance is started and configured for this port." % self.scriptserverport)
                             
         #make sure working directory matches that in Boris
         else: os.chdir(self.chdir())
@@ -373,6 +370,78 @@ class NSClient:
             self.runscriptnewinstance(sys.argv[0])
             sys.exit(0)
 
+    def __del__(self):
+        self.__disconnect()
+
+    #################### CONNECTION
+    
+    #Commands are sent on a persistent connection using the framed protocol (see BorisLib/NetSocks_Protocol.h):
+    #client frame : 0x01, uint32 length (little endian), password + command
+    #server frame : 0x01, uint32 length (little endian), tab-separated text, or typed buffer (0x02, type character, uint32 components, raw values)
+    
+    FRAME_MARKER = 1
+    BUFFER_MARKER = 2
+    
+    sock = None
+    
+    def __connect(self):
+        
+        self.__disconnect()
+        
+        try:
+            self.sock = socket.create_connection((self.scriptserverip, self.scriptserverport))
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self.sock.settimeout(self.timeout_ms / 1000)
+            return True
+        except:
+            self.sock = None
+            return False
+        
+    def __disconnect(self):
+        
+        if self.sock is not None:
+            try: self.sock.close()
+            except: pass
+            self.sock = None
+    
+    #send framed message (password added here), connecting first if needed
+    def __send_frame(self, message):
+        
+        if self.sock is None and not self.__connect(): raise ConnectionError("No server found on port %d." % self.scriptserverport)
+        
+        payload = bytes(self.scriptserverpwd + message, 'utf-8')
+        self.sock.sendall(struct.pack('<BI', self.FRAME_MARKER, len(payload)) + payload)
+        
+    def __recv_exact(self, length):
+        
+        data = bytearray()
+        while len(data) < length:
+            chunk = self.sock.recv(min(length - len(data), 1048576))
+            if not chunk: raise ConnectionError("Connection closed by server.")
+            data += chunk
+        return bytes(data)
+        
+    #receive a frame and decode it : text replies are returned as fields (first one always empty as replies start with a tab), typed buffers as a numpy array
+    def __recv_frame(self):
+        
+        marker, length = struct.unpack('<BI', self.__recv_exact(5))
+        payload = self.__recv_exact(length)
+        
+        if len(payload) >= 6 and payload[0] == self.BUFFER_MARKER:
+            components = struct.unpack('<I', payload[2:6])[0]
+            values = np.frombuffer(payload[6:], dtype = '<f8')
+            if components > 1: values = values.reshape(-1, components)
+            return values
+        
+        return str(payload, 'utf-8').split('\t')
+    
+    #receive reply to a command : 'stopped' messages are sent when a simulation stops, not in reply to a command, so skip them
+    def __recv_reply(self):
+        
+        while True:
+            reply = self.__recv_frame()
+            if isinstance(reply, np.ndarray) or len(reply) != 2 or reply[1] != 'stopped': return reply
+            
     #################### AUXILIARY
 
     #use this on return parameters : returned parameters can either be numbers or a word (text without spaces)
@@ -419,9 +488,66 @@ class NSClient:
             
     #################### PLOTTING HELPERS
     
-    #load columns from tab-spaced data file, e.g. as outputted by a Boris simulation
+    #check if file is a binary data file (as outputted by a Boris simulation if savedatafile has .bdat termination)
+    def is_binary_data_file(self, fileName):
+        try:
+            with open(fileName, 'rb') as f:
+                return f.read(8) == b'BORISDAT'
+        except:
+            return False
+    
+    #read binary data file : return info text, column labels, column units, and list of chunks, each a 2D numpy array of rows
+    def Read_Binary_Data_File(self, fileName):
+        """Read binary data file (.bdat) : return info, labels, units, chunks (list of 2D arrays of rows)"""
+        with open(fileName, 'rb') as f:
+            data = f.read()
+        
+        if data[0:8] != b'BORISDAT': return '', [], [], []
+        
+        def read_string(pos):
+            length = struct.unpack_from('<I', data, pos)[0]
+            return data[pos + 4 : pos + 4 + length].decode('utf-8', 'replace'), pos + 4 + length
+        
+        pos = 12
+        info, pos = read_string(pos)
+        num_columns = struct.unpack_from('<I', data, pos)[0]
+        pos += 4
+        
+        labels, units = [], []
+        for idx in range(num_columns):
+            label, pos = read_string(pos)
+            unit, pos = read_string(pos)
+            labels.append(label)
+            units.append(unit)
+        
+        chunks = []
+        while pos + 24 <= len(data) and data[pos : pos + 4] == b'CHNK':
+            rows, columns, codec, payload_size = struct.unpack_from('<IIIQ', data, pos + 4)
+            pos += 24
+            #incomplete chunk (file still being written)
+            if pos + payload_size > len(data): break
+            #only raw chunks supported; skip any others
+            if codec == 0 and payload_size == rows * columns * 8:
+                chunks.append(np.frombuffer(data, dtype = '<f8', count = rows * columns, offset = pos).reshape(rows, columns))
+            pos += payload_size
+        
+        return info, labels, units, chunks
+    
+    #load columns from tab-spaced data file, e.g. as outputted by a Boris simulation. Binary data files (.bdat) are also read, without parsing text.
     def Get_Data_Columns(self, fileName, column_indexes = '', separator = '\t'):
-        """Get indexed columns from tab-spaced data file as a list"""
+        """Get indexed columns from tab-spaced or binary data file as a list"""
+        
+        if self.is_binary_data_file(fileName):
+            info, labels, units, chunks = self.Read_Binary_Data_File(fileName)
+            
+            #as for text files, rows which don't have a requested column don't contribute to it
+            def get_column(index):
+                return [value for chunk in chunks if index < chunk.shape[1] for value in chunk[:, index].tolist()]
+            
+            if isinstance(column_indexes, list): return [get_column(index) for index in column_indexes]
+            elif not isinstance(column_indexes, str): return get_column(column_indexes)
+            else: return [row for chunk in chunks for row in chunk.tolist()]
+        
         #Get data locally
         f = open(fileName, 'r')
         if separator == '':
@@ -883,23 +1009,21 @@ class NSClient:
         
         else:
             
-            #Now wait for response using a blocking socket
-            with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as sock:
-            
-                sock.connect((self.scriptserverip, self.scriptserverport))
-                
-                # Look for the response
-                try:
-                    if self.script_verbose: print('TX : run')
-                    if stage == '': sock.sendall(bytes(self.scriptserverpwd + '*' + "run", 'utf-8'))
-                    else: sock.sendall(bytes(self.scriptserverpwd + '*' + "runstage %d" % stage, 'utf-8'))
-                    #receive response to run command and 'stopped' signal
-                    data = str(sock.recv(self.maxLenMessage), 'utf-8')
-                    fields = data.split('\t')
-                    if len(fields) == 2: str(sock.recv(self.maxLenMessage), 'utf-8')
-                    if self.script_verbose: print('RX :')
-                except:
-                    print("SendCommand (receive): timed out.")
+            try:
+                if self.script_verbose: print('TX : run')
+                if stage == '': self.__send_frame('*' + "run")
+                else: self.__send_frame('*' + "runstage %d" % stage)
+                #receive response to run command then wait for the 'stopped' signal, however long the simulation takes
+                self.__recv_reply()
+                self.sock.settimeout(None)
+                while True:
+                    reply = self.__recv_frame()
+                    if not isinstance(reply, np.ndarray) and len(reply) == 2 and reply[1] == 'stopped': break
+                self.sock.settimeout(self.timeout_ms / 1000)
+                if self.script_verbose: print('RX :')
+            except:
+                self.__disconnect()
+                print("SendCommand (receive): timed out.")
                     
     def Run(self, embedded_code = '', *args):
         """Running in embedded mode with Python code to be executed after every iteration"""
@@ -1225,6 +1349,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("delsurfacestress", [index])
     	self.SendCommand("buffercommand", ["delsurfacestress", index])
     
+    def demagsprec(self, status = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("demagsprec", [status])
+    	self.SendCommand("buffercommand", ["demagsprec", status])
+    
     def designateground(self, electrode_index = '', bufferCommand = False):
     	if not bufferCommand: return self.SendCommand("designateground", [electrode_index])
     	self.SendCommand("buffercommand", ["designateground", electrode_index])
@@ -1428,6 +1556,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("dp_getampli", [dp_source, pointsPeriod])
     	self.SendCommand("buffercommand", ["dp_getampli", dp_source, pointsPeriod])
     
+    def dp_getarray(self, dp_arr = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("dp_getarray", [dp_arr])
+    	self.SendCommand("buffercommand", ["dp_getarray", dp_arr])
+    
     def dp_getaveragedprofile(self, meshname = '', start = '', end = '', step = '', dp_index = '', bufferCommand = False):
     	if issubclass(type(meshname), self.Mesh): meshname = meshname.meshname
     	if not bufferCommand: return self.SendCommand("dp_getaveragedprofile", [meshname, start, end, step, dp_index])
@@ -1635,6 +1767,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("evalspeedup", [level])
     	self.SendCommand("buffercommand", ["evalspeedup", level])
     
+    def evalspeeduptol(self, tolerance = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("evalspeeduptol", [tolerance])
+    	self.SendCommand("buffercommand", ["evalspeeduptol", tolerance])
+    
     def exchangecoupledmeshes(self, meshname = '', status = '', bufferCommand = False):
     	if issubclass(type(meshname), self.Mesh): meshname = meshname.meshname
     	if not bufferCommand: return self.SendCommand("exchangecoupledmeshes", [meshname, status])
@@ -1645,6 +1781,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("excludemulticonvdemag", [meshname, status])
     	self.SendCommand("buffercommand", ["excludemulticonvdemag", meshname, status])
     
+    def fftwplanner(self, rigor = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("fftwplanner", [rigor])
+    	self.SendCommand("buffercommand", ["fftwplanner", rigor])
+    
     def flower(self, meshname = '', direction = '', radius = '', thickness = '', centre = '', bufferCommand = False):
     	if issubclass(type(meshname), self.Mesh): meshname = meshname.meshname
     	if not bufferCommand: return self.SendCommand("flower", [meshname, direction, radius, thickness, centre])
@@ -1658,6 +1798,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("fmscellsize", [value])
     	self.SendCommand("buffercommand", ["fmscellsize", value])
     
+    def fusedfields(self, status = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("fusedfields", [status])
+    	self.SendCommand("buffercommand", ["fusedfields", status])
+    
     def generate2dgrains(self, meshname = '', spacing = '', seed = '', bufferCommand = False):
     	if issubclass(type(meshname), self.Mesh): meshname = meshname.meshname
     	if not bufferCommand: return self.SendCommand("generate2dgrains", [meshname, spacing, seed])
@@ -1704,6 +1848,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("halfprecisiontransfer", [status])
     	self.SendCommand("buffercommand", ["halfprecisiontransfer", status])
     
+    def heatsolver(self, method = '', convergence_error = '', iters_timeout = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("heatsolver", [method, convergence_error, iters_timeout])
+    	self.SendCommand("buffercommand", ["heatsolver", method, convergence_error, iters_timeout])
+    
     def imagecropping(self, left = '', bottom = '', right = '', top = '', bufferCommand = False):
     	if not bufferCommand: return self.SendCommand("imagecropping", [left, bottom, right, top])
     	self.SendCommand("buffercommand", ["imagecropping", left, bottom, right, top])
@@ -1730,6 +1878,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("iterupdate", [iterations])
     	self.SendCommand("buffercommand", ["iterupdate", iterations])
     
+    def kernelcache(self, maxsize_MB = '', directory = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("kernelcache", [maxsize_MB, directory])
+    	self.SendCommand("buffercommand", ["kernelcache", maxsize_MB, directory])
+    
     def linkdtelastic(self, flag = '', bufferCommand = False):
     	if not bufferCommand: return self.SendCommand("linkdtelastic", [flag])
     	self.SendCommand("buffercommand", ["linkdtelastic", flag])
@@ -1918,6 +2070,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("openpotentialresistance", [resistance])
     	self.SendCommand("buffercommand", ["openpotentialresistance", resistance])
     
+    def ovf2async(self, status = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("ovf2async", [status])
+    	self.SendCommand("buffercommand", ["ovf2async", status])
+    
     def params(self, meshname = '', bufferCommand = False):
     	if issubclass(type(meshname), self.Mesh): meshname = meshname.meshname
     	if not bufferCommand: return self.SendCommand("params", [meshname])
@@ -1948,6 +2104,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("prngseed", [meshname, seed])
     	self.SendCommand("buffercommand", ["prngseed", meshname, seed])
     
+    def profile(self, status = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("profile", [status])
+    	self.SendCommand("buffercommand", ["profile", status])
+    
     def raapbiasequation(self, meshname = '', text_equation = '', bufferCommand = False):
     	if issubclass(type(meshname), self.Mesh): meshname = meshname.meshname
     	if not bufferCommand: return self.SendCommand("raapbiasequation", [meshname, text_equation])
@@ -2524,6 +2684,10 @@ class NSClient:
     	if not bufferCommand: return self.SendCommand("tsolverconfig", [convergence_error, iters_timeout])
     	self.SendCommand("buffercommand", ["tsolverconfig", convergence_error, iters_timeout])
     
+    def tsolvermethod(self, method = '', bufferCommand = False):
+    	if not bufferCommand: return self.SendCommand("tsolvermethod", [method])
+    	self.SendCommand("buffercommand", ["tsolvermethod", method])
+    
     def updatemdb(self, bufferCommand = False):
     	if not bufferCommand: return self.SendCommand("updatemdb")
     	self.SendCommand("buffercommand", ["updatemdb"])
@@ -2591,47 +2755,52 @@ class NSClient:
     
         else:
 
-            with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as sock:
+            return self.SendCommands([(command, values)])[0]
             
-                sock.connect((self.scriptserverip, self.scriptserverport))
-                sock.settimeout(self.timeout_ms / 1000)
-    
-                message = self.form_message_string(command, values)
-                        
-                try:
-                    # Send data
-                    if self.verbose == True: sock.sendall(bytes(self.scriptserverpwd + '>' + message, 'utf-8'))
-                    else: sock.sendall(bytes(self.scriptserverpwd + '*' + message, 'utf-8'))
+    #Send a number of commands in one go without waiting for each reply (pipelined), then collect all replies in order
+    #commands is a list of (command, values) tuples, e.g. ns.SendCommands([('dp_get', [0, idx]) for idx in range(100)])
+    def SendCommands(self, commands):
+        
+        if embedded_mode: return [self.SendCommand(command, values) for (command, values) in commands]
+        
+        messages = [self.form_message_string(command, values) for (command, values) in commands]
+        prefix = '>' if self.verbose == True else '*'
+        
+        #if the persistent connection was closed (e.g. Boris restarted) reconnect and send again : nothing was received so the commands were not handled
+        for attempt in range(2):
+            
+            try:
+                for message in messages:
+                    self.__send_frame(prefix + message)
                     if self.script_verbose: print('TX : %s' % message)
-                except:
-                    print("SendCommand (send): timed out.")
-                    return
+            except:
+                self.__disconnect()
+                if attempt == 0: continue
+                print("SendCommand (send): timed out.")
+                return [None] * len(messages)
                 
-                # Look for the response
-                try:
-                    data = str(sock.recv(self.maxLenMessage), 'utf-8')
-                except:
-                    print("SendCommand (receive): timed out.")
-                    return
-        
-                #note, the returned data always starts with a tab
-                fields = data.split('\t')
-    
-                if len(fields) >= 2 and fields[1] == 'stopped':
-                        #if we received the 'stopped' message this means a simulation was running when we sent this command. 
-                        #this caused the simulation to stop thus issuing the 'stopped' message since a client is connected.
-                        #since this command is expecting another message to be returned, we need to receive it - issue recv call again
-                        try:
-                            data = str(sock.recv(self.maxLenMessage), 'utf-8')
-                        except:
-                            print("SendCommand (receive): timed out.")
-                            return
-    
-                        #note, the returned data always starts with a tab
-                        fields = data.split('\t')
-    
-                if self.script_verbose: print('RX : %s' % data)
-                return self.extract_return_data(fields)
+            # Look for the responses
+            return_data = []
+            try:
+                for message in messages:
+                    reply = self.__recv_reply()
+                    if isinstance(reply, np.ndarray):
+                        if self.script_verbose: print('RX : %d values' % reply.size)
+                        return_data.append(reply)
+                    else:
+                        if self.script_verbose: print('RX : %s' % '\t'.join(reply))
+                        return_data.append(self.extract_return_data(reply))
+            except ConnectionError:
+                self.__disconnect()
+                if attempt == 0 and not return_data: continue
+                print("SendCommand (receive): connection closed.")
+                return return_data + [None] * (len(messages) - len(return_data))
+            except:
+                self.__disconnect()
+                print("SendCommand (receive): timed out.")
+                return return_data + [None] * (len(messages) - len(return_data))
+                
+            return return_data
 
     #################### COMPOSITE CONSOLE COMMANDS
     